@@ -21,38 +21,467 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Command/Logger.h"
 
+#include <fcntl.h>
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace FOEDAG {
+
+// State of one log file, touched by the logging thread only (or by the
+// thread that drains the queue after the logging thread stopped). The
+// crash handler reads fd, buffer and pending without locking.
+struct LogFile {
+  ~LogFile();
+  std::string path;
+  int fd{-1};
+  char buffer[64 * 1024];
+  std::atomic<size_t> pending{0};  // bytes of buffer not written to fd
+  LogFlushPolicy policy;
+  std::chrono::steady_clock::time_point oldest{};
+  bool tracked{false};  // listed by the logging thread
+};
+
+}  // namespace FOEDAG
+
 using namespace FOEDAG;
 
-Logger::Logger(const std::string& filePath) {
-  m_fileName = filePath;
-  m_stream = new std::ofstream(filePath, std::fstream::out);
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int OpenFd(const std::string& path, bool append) {
+#ifdef _WIN32
+  return _open(path.c_str(),
+               _O_WRONLY | _O_CREAT | _O_TEXT | (append ? _O_APPEND : _O_TRUNC),
+               _S_IREAD | _S_IWRITE);
+#else
+  return ::open(path.c_str(),
+                O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC),
+                0644);
+#endif
+}
+
+// async-signal-safe, used by the crash handler too
+void WriteFd(int fd, const char* data, size_t size) {
+  while (size > 0) {
+#ifdef _WIN32
+    const int written = _write(fd, data, static_cast<unsigned int>(size));
+#else
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0 && errno == EINTR) continue;
+#endif
+    if (written <= 0) return;
+    data += written;
+    size -= written;
+  }
+}
+
+void CloseFd(int fd) {
+#ifdef _WIN32
+  _close(fd);
+#else
+  ::close(fd);
+#endif
+}
+
+/*
+  Open log files the crash handler flushes. Slots are taken by the logging
+  thread when a file opens and released when it closes, files opened when
+  all slots are taken are not flushed on a crash.
+*/
+std::atomic<LogFile*> crashFiles[64];
+
+void TrackCrashFile(LogFile* file) {
+  for (auto& slot : crashFiles) {
+    LogFile* expected{nullptr};
+    if (slot.compare_exchange_strong(expected, file)) return;
+  }
+}
+
+void UntrackCrashFile(LogFile* file) {
+  for (auto& slot : crashFiles) {
+    LogFile* expected{file};
+    if (slot.compare_exchange_strong(expected, nullptr)) return;
+  }
+}
+
+#ifndef _WIN32
+const int crashSignals[] = {SIGSEGV, SIGABRT, SIGBUS};
+struct sigaction previousActions[std::size(crashSignals)];
+
+// Writes the buffered text of every open log file and hands the signal on
+// to the handler that was installed before. Text still queued for the
+// logging thread is lost, text being flushed right now may be repeated.
+void CrashHandler(int signal, siginfo_t* info, void* context) {
+  static std::atomic<bool> flushed{false};
+  if (!flushed.exchange(true)) {
+    for (auto& slot : crashFiles) {
+      LogFile* file = slot.load(std::memory_order_acquire);
+      if (!file || file->fd < 0) continue;
+      WriteFd(file->fd, file->buffer,
+              file->pending.load(std::memory_order_acquire));
+    }
+  }
+  for (size_t i = 0; i < std::size(crashSignals); i++) {
+    if (crashSignals[i] != signal) continue;
+    const struct sigaction& previous = previousActions[i];
+    if (previous.sa_flags & SA_SIGINFO) {
+      previous.sa_sigaction(signal, info, context);
+    } else if (previous.sa_handler == SIG_DFL) {
+      // delivered again once this handler returns, the default action runs
+      sigaction(signal, &previous, nullptr);
+      raise(signal);
+    } else if (previous.sa_handler != SIG_IGN) {
+      previous.sa_handler(signal);
+    }
+  }
+}
+
+void InstallCrashHandler() {
+  struct sigaction action {};
+  action.sa_sigaction = &CrashHandler;
+  action.sa_flags = SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  for (size_t i = 0; i < std::size(crashSignals); i++)
+    sigaction(crashSignals[i], &action, &previousActions[i]);
+}
+#endif
+
+struct LogMessage {
+  enum Kind { Text, Open, Close, Flush, Policy };
+  std::atomic<LogMessage*> next{nullptr};
+  Kind kind{Text};
+  std::shared_ptr<LogFile> file;
+  std::string text;
+  LogSeverity severity{LogSeverity::Info};
+  bool append{true};
+  LogFlushPolicy policy{};
+  // shared with the poster, it may stop waiting before the message is done
+  std::shared_ptr<std::promise<void>> done;
+};
+
+/*
+  Single writer thread for all log files. Producers push to an intrusive
+  multi-producer single-consumer queue (D. Vyukov) with one atomic exchange,
+  the writer sleeps on a condition variable only when the queue is empty.
+*/
+class LogWriter {
+ public:
+  static LogWriter& Instance() {
+    // never destroyed: loggers may outlive static destruction
+    static LogWriter* writer = new LogWriter;
+    return *writer;
+  }
+
+  void post(LogMessage* message) {
+    if (message->kind == LogMessage::Text)
+      m_posted.fetch_add(1, std::memory_order_relaxed);
+    if (m_stopped.load()) {
+      std::lock_guard<std::mutex> lock{m_drainMutex};
+      process(message);
+      flushFiles(true);
+      return;
+    }
+    push(message);
+    if (m_sleeping.load()) {
+      std::lock_guard<std::mutex> lock{m_wakeMutex};
+      m_wake.notify_one();
+    }
+  }
+
+  // posts a message and waits until the writer processed it
+  void postAndWait(LogMessage* message) {
+    auto done = std::make_shared<std::promise<void>>();
+    auto future = done->get_future();
+    message->done = done;
+    post(message);
+    future.wait_for(std::chrono::seconds{10});
+  }
+
+  bool hasUnflushed() const {
+    return m_flushed.load(std::memory_order_acquire) !=
+           m_posted.load(std::memory_order_relaxed);
+  }
+
+  void stop() {
+    if (m_stopped.exchange(true)) return;
+    {
+      std::lock_guard<std::mutex> lock{m_wakeMutex};
+      m_wake.notify_one();
+    }
+    if (m_thread.joinable()) m_thread.join();
+    std::lock_guard<std::mutex> lock{m_drainMutex};
+    drain();
+    flushFiles(true);
+  }
+
+ private:
+  LogWriter() : m_tail(&m_stub), m_head(&m_stub) {
+    m_thread = std::thread{[this]() { run(); }};
+    std::atexit([]() { LogWriter::Instance().stop(); });
+#ifndef _WIN32
+    InstallCrashHandler();
+#endif
+  }
+
+  void push(LogMessage* message) {
+    message->next.store(nullptr, std::memory_order_relaxed);
+    LogMessage* prev = m_head.exchange(message);
+    prev->next.store(message, std::memory_order_release);
+  }
+
+  LogMessage* pop() {
+    LogMessage* tail = m_tail;
+    LogMessage* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &m_stub) {
+      if (!next) return nullptr;
+      m_tail = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      m_tail = next;
+      return tail;
+    }
+    if (tail != m_head.load()) return nullptr;  // push in progress
+    push(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+      m_tail = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  bool empty() const {
+    return m_tail == &m_stub ? m_stub.next.load() == nullptr &&
+                                   m_head.load() == &m_stub
+                             : false;
+  }
+
+  // returns false when nothing was queued
+  bool drain() {
+    bool any{false};
+    while (LogMessage* message = pop()) {
+      if (message == &m_stub) continue;
+      process(message);
+      any = true;
+    }
+    return any;
+  }
+
+  void process(LogMessage* message) {
+    LogFile* file = message->file.get();
+    switch (message->kind) {
+      case LogMessage::Text:
+        if (file->fd >= 0) {
+          if (file->pending.load() == 0) file->oldest = Clock::now();
+          append(*file, message->text);
+          if ((message->severity == LogSeverity::Error &&
+               file->policy.flushOnError) ||
+              file->pending.load() >= file->policy.size)
+            flushFile(*file);
+        }
+        m_processed++;
+        break;
+      case LogMessage::Open:
+        if (file->fd < 0) {
+          file->fd = OpenFd(file->path, message->append);
+          if (file->fd >= 0) TrackCrashFile(file);
+        }
+        break;
+      case LogMessage::Close:
+        if (file->fd >= 0) {
+          flushFile(*file);
+          UntrackCrashFile(file);
+          CloseFd(file->fd);
+          file->fd = -1;
+        }
+        break;
+      case LogMessage::Flush:
+        flushFiles(true);
+        break;
+      case LogMessage::Policy:
+        file->policy = message->policy;
+        break;
+    }
+    if (file && !file->tracked) {
+      file->tracked = true;
+      m_files.push_back(message->file);
+    }
+    auto done = std::move(message->done);
+    delete message;
+    if (done) done->set_value();
+  }
+
+  // buffers text, text larger than the buffer is written at once
+  void append(LogFile& file, const std::string& text) {
+    size_t pending = file.pending.load();
+    if (pending + text.size() > sizeof(file.buffer)) {
+      flushFile(file);
+      pending = 0;
+    }
+    if (text.size() > sizeof(file.buffer)) {
+      WriteFd(file.fd, text.data(), text.size());
+      return;
+    }
+    std::memcpy(file.buffer + pending, text.data(), text.size());
+    file.pending.store(pending + text.size(), std::memory_order_release);
+  }
+
+  void flushFile(LogFile& file) {
+    const size_t pending = file.pending.load();
+    if (pending == 0) return;
+    if (file.fd >= 0) WriteFd(file.fd, file.buffer, pending);
+    file.pending.store(0, std::memory_order_release);
+  }
+
+  // flushes files due to their policy, or all of them with 'all'
+  void flushFiles(bool all) {
+    const auto now = Clock::now();
+    for (auto it = m_files.begin(); it != m_files.end();) {
+      LogFile& file = **it;
+      if (all || now - file.oldest >= file.policy.interval) flushFile(file);
+      // keep files with pending data and files still used by a logger
+      if (file.pending.load() == 0 && it->use_count() == 1) {
+        file.tracked = false;
+        it = m_files.erase(it);
+      } else
+        ++it;
+    }
+    if (all) m_flushed.store(m_processed, std::memory_order_release);
+  }
+
+  void run() {
+    while (true) {
+      const bool any = drain();
+      // queue drained, make everything written so far durable
+      flushFiles(!any);
+      if (any) continue;
+      if (m_stopped.load()) return;
+      std::unique_lock<std::mutex> lock{m_wakeMutex};
+      m_sleeping.store(true);
+      if (empty() && !m_stopped.load())
+        m_wake.wait_for(lock, std::chrono::milliseconds{500});
+      m_sleeping.store(false);
+    }
+  }
+
+  LogMessage m_stub{};
+  LogMessage* m_tail;  // writer only
+  std::atomic<LogMessage*> m_head;
+  std::vector<std::shared_ptr<LogFile>> m_files;  // writer only
+  std::atomic<uint64_t> m_posted{0};
+  uint64_t m_processed{0};  // writer only
+  std::atomic<uint64_t> m_flushed{0};
+  std::atomic<bool> m_sleeping{false};
+  std::atomic<bool> m_stopped{false};
+  std::mutex m_wakeMutex;
+  std::mutex m_drainMutex;
+  std::condition_variable m_wake;
+  std::thread m_thread;
+};
+
+}  // namespace
+
+LogFile::~LogFile() {
+  if (fd >= 0) {
+    UntrackCrashFile(this);
+    WriteFd(fd, buffer, pending.load());
+    CloseFd(fd);
+  }
+}
+
+Logger::Logger(const std::string& filePath)
+    : m_file(std::make_shared<LogFile>()), m_fileName(filePath) {
+  m_file->path = filePath;
+  auto message = new LogMessage;
+  message->kind = LogMessage::Open;
+  message->file = m_file;
+  message->append = false;
+  LogWriter::Instance().postAndWait(message);
+  m_open = true;
 }
 
 void Logger::open() {
-  if (m_stream == nullptr) {
-    m_stream = new std::ofstream(m_fileName, std::fstream::app);
+  if (!m_open) {
+    auto message = new LogMessage;
+    message->kind = LogMessage::Open;
+    message->file = m_file;
+    LogWriter::Instance().postAndWait(message);
+    m_open = true;
   }
 }
 
 void Logger::close() {
-  if (m_stream) {
-    delete m_stream;
-    m_stream = nullptr;
+  if (m_open) {
+    auto message = new LogMessage;
+    message->kind = LogMessage::Close;
+    message->file = m_file;
+    LogWriter::Instance().postAndWait(message);
+    m_open = false;
   }
 }
 
-void Logger::log(const std::string& text) {
-  if (m_stream) {
-    *m_stream << text << std::endl << std::flush;
+void Logger::log(const std::string& text, LogSeverity severity) {
+  if (m_open) {
+    auto message = new LogMessage;
+    message->file = m_file;
+    message->text.reserve(text.size() + 1);
+    message->text.append(text).push_back('\n');
+    message->severity = severity;
+    LogWriter::Instance().post(message);
   }
 }
 
-void Logger::appendLog(const std::string& text) {
-  if (m_stream) {
-    *m_stream << text << std::flush;
+void Logger::appendLog(const std::string& text, LogSeverity severity) {
+  write(text.data(), text.size(), severity);
+}
+
+void Logger::write(const char* text, std::streamsize count,
+                   LogSeverity severity) {
+  if (m_open && count > 0) {
+    auto message = new LogMessage;
+    message->file = m_file;
+    message->text.assign(text, count);
+    message->severity = severity;
+    LogWriter::Instance().post(message);
   }
 }
 
+void Logger::flush() { flushAll(); }
+
+void Logger::flushAll() {
+  auto& writer = LogWriter::Instance();
+  if (!writer.hasUnflushed()) return;
+  auto message = new LogMessage;
+  message->kind = LogMessage::Flush;
+  writer.postAndWait(message);
+}
+
+void Logger::setFlushPolicy(const LogFlushPolicy& policy) {
+  auto message = new LogMessage;
+  message->kind = LogMessage::Policy;
+  message->file = m_file;
+  message->policy = policy;
+  LogWriter::Instance().post(message);
+}
+
 std::string Logger::fileName() const { return m_fileName; }
 
 Logger::~Logger() { close(); }
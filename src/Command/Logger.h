@@ -21,28 +21,60 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <chrono>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace FOEDAG {
 
+enum class LogSeverity { Info, Error };
+
+// When the logging thread flushes a log file to disk. The file is always
+// flushed when the logging thread runs out of queued data.
+struct LogFlushPolicy {
+  std::chrono::milliseconds interval{200};  // max age of unflushed data
+  size_t size{64 * 1024};                   // max unflushed bytes
+  bool flushOnError{true};                  // flush Error text at once
+};
+
+struct LogFile;
+
+/*!
+ * \brief The Logger class is the front end of a log file. Text is queued to
+ * a background thread that writes all log files, so callers never wait for
+ * disk I/O. Queued text is also written when the process exits, text the
+ * logging thread buffered is written when it crashes (SIGSEGV, SIGABRT,
+ * SIGBUS) as well.
+ */
 class Logger {
  private:
  public:
   Logger(const std::string& filePath);
   void open();
   void close();
-  void log(const std::string& text);
-  void appendLog(const std::string& text);
+  void log(const std::string& text, LogSeverity severity = LogSeverity::Info);
+  void appendLog(const std::string& text,
+                 LogSeverity severity = LogSeverity::Info);
+  void write(const char* text, std::streamsize count,
+             LogSeverity severity = LogSeverity::Info);
+  // blocks until the queued text is written and flushed to disk
+  void flush();
   std::string fileName() const;
+  void setFlushPolicy(const LogFlushPolicy& policy);
+
+  // flush() for all loggers, returns at once when nothing is pending
+  static void flushAll();
 
   ~Logger();
   Logger& operator<<(const std::string& log);
 
  private:
-  std::ofstream* m_stream = nullptr;
+  std::shared_ptr<LogFile> m_file;
+  bool m_open{false};
   std::string m_fileName;
 };
 
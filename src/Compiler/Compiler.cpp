@@ -32,6 +32,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <ctime>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <thread>
 
@@ -51,11 +52,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "NewProject/ProjectManager/project_manager.h"
 #include "ProjNavigator/tcl_command_integration.h"
 #include "TaskManager.h"
+#include "Utils/EventBus.h"
 #include "Utils/FileUtils.h"
 #include "Utils/LogUtils.h"
 #include "Utils/ProcessUtils.h"
 #include "Utils/QtUtils.h"
 #include "Utils/StringUtils.h"
+#include "Utils/Tracer.h"
 #include "scope_guard.hpp"
 
 extern FOEDAG::Session* GlobalSession;
@@ -68,10 +71,9 @@ auto CreateDummyLog = [](Compiler::Action action,
                          const std::string& outfileName,
                          Compiler* compiler) -> std::filesystem::path {
   std::filesystem::path outputPath = compiler->FilePath(action, outfileName);
-  if (FileUtils::FileExists(outputPath)) {
-    std::filesystem::remove(outputPath);
-  }
-  FileUtils::WriteToFile(outputPath, "Dummy log for " + outfileName);
+  std::ofstream log;
+  if (LogUtils::OpenLog(log, outputPath))
+    log << "Dummy log for " << outfileName << "\n";
   return outputPath;
 };
 
@@ -164,6 +166,7 @@ void Compiler::Message(const std::string& message,
       (*m_out) << "INFO: " << prefix << message << std::endl;
     }
   }
+  EventBus::message("compiler", "info", message);
 }
 
 void Compiler::ErrorMessage(const std::string& message, bool append,
@@ -177,6 +180,7 @@ void Compiler::ErrorMessage(const std::string& message, bool append,
       (*m_err) << "ERROR: " << prefix << message << std::endl;
     }
   }
+  EventBus::message("compiler", "error", message);
   if (m_interp != nullptr)
     if (append)
       Tcl_AppendResult(m_interp->getInterp(), message.c_str(), nullptr);
@@ -251,6 +255,21 @@ tcl_interp_clone
   return script;
 }
 
+bool Compiler::parseIPGenJobs(int argc, const char* argv[], int& index) {
+  index++;
+  if (index < argc) {
+    auto [jobs, ok] = StringUtils::to_number<unsigned int>(argv[index]);
+    if (ok) {
+      IPGenJobs(jobs);
+      return true;
+    }
+  }
+  ErrorMessage(
+      "Incorrect syntax for ipgenerate -jobs <number>, 0 runs one job per "
+      "core");
+  return false;
+}
+
 bool Compiler::BuildLiteXIPCatalog(std::filesystem::path litexPath,
                                    bool namesOnly) {
   if (m_IPGenerator == nullptr) {
@@ -377,6 +396,54 @@ bool Compiler::RegisterCommands(TclInterpreter* interp, bool batchMode) {
   };
   interp->registerCmd("help", help, this, 0);
 
+  auto flow_trace = [](void* clientData, Tcl_Interp* interp, int argc,
+                       const char* argv[]) -> int {
+    Compiler* compiler = (Compiler*)clientData;
+    const std::string sub = argc > 1 ? argv[1] : std::string{};
+    if (sub == "start" && argc == 2) {
+      Tracer::start();
+      return TCL_OK;
+    }
+    if (sub == "stop" && argc <= 3) {
+      const std::string file = argc > 2 ? argv[2] : "trace.json";
+      std::string error{};
+      if (!Tracer::stop(file, error)) {
+        compiler->ErrorMessage(error);
+        return TCL_ERROR;
+      }
+      compiler->Message("Trace written to " + file);
+      return TCL_OK;
+    }
+    compiler->ErrorMessage(
+        "Incorrect syntax for flow_trace start | stop ?<file>?");
+    return TCL_ERROR;
+  };
+  interp->registerCmd("flow_trace", flow_trace, this, 0);
+
+  auto event_log = [](void* clientData, Tcl_Interp* interp, int argc,
+                      const char* argv[]) -> int {
+    Compiler* compiler = (Compiler*)clientData;
+    const std::string sub = argc > 1 ? argv[1] : std::string{};
+    std::string error{};
+    if (sub == "start" && argc == 3) {
+      if (!EventLog::start(argv[2], error)) {
+        compiler->ErrorMessage(error);
+        return TCL_ERROR;
+      }
+      return TCL_OK;
+    }
+    if (sub == "stop" && argc == 2) {
+      if (!EventLog::stop(error)) {
+        compiler->ErrorMessage(error);
+        return TCL_ERROR;
+      }
+      return TCL_OK;
+    }
+    compiler->ErrorMessage("Usage: event_log start <file.jsonl> | stop");
+    return TCL_ERROR;
+  };
+  interp->registerCmd("event_log", event_log, this, 0);
+
   auto script_path = [](void* clientData, Tcl_Interp* interp, int argc,
                         const char* argv[]) -> int {
     Compiler* compiler = (Compiler*)clientData;
@@ -968,6 +1035,8 @@ bool Compiler::RegisterCommands(TclInterpreter* interp, bool batchMode) {
         std::string arg = argv[i];
         if (arg == "clean") {
           compiler->IPGenOpt(Compiler::IPGenerateOpt::Clean);
+        } else if (arg == "-jobs") {
+          if (!compiler->parseIPGenJobs(argc, argv, i)) return TCL_ERROR;
         } else {
           compiler->ErrorMessage("Unknown option: " + arg);
         }
@@ -1295,6 +1364,8 @@ bool Compiler::RegisterCommands(TclInterpreter* interp, bool batchMode) {
                 "'-modules' tag");
             return TCL_ERROR;
           }
+        } else if (arg == "-jobs") {
+          if (!compiler->parseIPGenJobs(argc, argv, i)) return TCL_ERROR;
         } else {
           compiler->ErrorMessage("Unknown option: " + arg);
         }
@@ -2134,8 +2205,8 @@ void Compiler::writeWaveHelp(std::ostream* out, int frontSpacePadCount,
   writeHelp(out, helpEntries, frontSpacePadCount, descColumn);
 }
 
-// Search the project directory for files ending in .rpt and add our header if
-// the file doesn't have it already
+// Search the project directory for files ending in .rpt that were written by
+// tools and add our header if the file doesn't have it already
 void Compiler::AddHeadersToLogs(Action action) {
   auto projManager = ProjManager();
   if (projManager) {
@@ -2278,13 +2349,56 @@ void Compiler::ClbPackingOption(ClbPacking clbPacking) {
 
 ClbPacking Compiler::ClbPackingOption() const { return m_clbPacking; }
 
+static const char* ActionName(Compiler::Action action) {
+  switch (action) {
+    case Compiler::Action::IPGen:
+      return "ipgenerate";
+    case Compiler::Action::Analyze:
+      return "analyze";
+    case Compiler::Action::Synthesis:
+      return "synthesize";
+    case Compiler::Action::Pack:
+      return "packing";
+    case Compiler::Action::Global:
+      return "global_placement";
+    case Compiler::Action::Placement:
+      return "place";
+    case Compiler::Action::Routing:
+      return "route";
+    case Compiler::Action::STA:
+      return "sta";
+    case Compiler::Action::Power:
+      return "power";
+    case Compiler::Action::Bitstream:
+      return "bitstream";
+    case Compiler::Action::Batch:
+      return "batch";
+    case Compiler::Action::SimulateRTL:
+      return "simulate_rtl";
+    case Compiler::Action::SimulateGate:
+      return "simulate_gate";
+    case Compiler::Action::SimulatePNR:
+      return "simulate_pnr";
+    case Compiler::Action::SimulateBitstream:
+      return "simulate_bitstream";
+    case Compiler::Action::Configuration:
+      return "configuration";
+    case Compiler::Action::NoAction:
+      break;
+  }
+  return "no_action";
+}
+
 bool Compiler::Compile(Action action) {
+  TraceScope trace{"compile", ActionName(action)};
+  EventBus::stageStart("compiler", ActionName(action));
   uint task{toTaskId(static_cast<int>(action), this)};
   if (m_stop) {
     ResetStopFlag();
     if (task != TaskManager::invalid_id && m_taskManager) {
       m_taskManager->task(task)->setStatus(TaskStatus::Fail);
     }
+    EventBus::stageEnd("compiler", ActionName(action), false);
     return false;
   }
   ResetStopFlag();
@@ -2301,9 +2415,39 @@ bool Compiler::Compile(Action action) {
                                              : TaskStatus::Fail);
     if (res) m_taskManager->task(task)->setUtilization(m_utils);
   }
+  if (res) WriteResourceUsage(action);
+  EventBus::stageEnd("compiler", ActionName(action), res);
   return res;
 }
 
+/*
+  Resources used by the tools of the last stage, for build machine sizing.
+  Written next to the stage results as <stage>/resource_usage.json
+*/
+void Compiler::WriteResourceUsage(Action action) {
+  if (m_utils.stats.samples == 0 && m_utils.duration == 0) return;
+  EventBus::metric("compiler", "duration_ms", m_utils.duration);
+  EventBus::metric("compiler", "peak_rss_kib", m_utils.stats.peakRss);
+  const fs::path dir = FilePath(action);
+  std::error_code ec;
+  if (dir.empty() || !fs::is_directory(dir, ec)) return;
+  const ProcessStats& stats = m_utils.stats;
+  json usage;
+  usage["duration_ms"] = m_utils.duration;
+  usage["peak_rss_kib"] = stats.peakRss;
+  usage["peak_pss_kib"] = stats.peakPss;
+  usage["peak_virtual_kib"] = stats.peakVirtual;
+  usage["user_time_ms"] = stats.userTime;
+  usage["system_time_ms"] = stats.systemTime;
+  usage["read_bytes"] = stats.readBytes;
+  usage["write_bytes"] = stats.writeBytes;
+  usage["voluntary_context_switches"] = stats.voluntaryCtxSwitches;
+  usage["involuntary_context_switches"] = stats.involuntaryCtxSwitches;
+  usage["max_processes"] = stats.maxProcesses;
+  usage["samples"] = stats.samples;
+  FileUtils::WriteToFile(dir / "resource_usage.json", usage.dump(2));
+}
+
 void Compiler::GenerateReport(int action) {
   Action act = static_cast<Action>(action);
   auto files = FileUtils::FindFilesByExtension(FilePath(act), ".rpt");
@@ -2360,11 +2504,20 @@ void Compiler::GenerateReport(int action) {
 void Compiler::Stop() {
   m_stop = true;
   ErrorMessage("Interrupted by user");
-  if (m_process) m_process->terminate();
+  CancelToken().cancel();
   FileUtils::terminateSystemCommand();
 }
 
-void Compiler::ResetStopFlag() { m_stop = false; }
+void Compiler::ResetStopFlag() {
+  m_stop = false;
+  std::lock_guard<std::mutex> lock{m_cancelMutex};
+  if (m_cancel.isCancelled()) m_cancel = CancellationToken{};
+}
+
+CancellationToken Compiler::CancelToken() const {
+  std::lock_guard<std::mutex> lock{m_cancelMutex};
+  return m_cancel;
+}
 
 bool Compiler::Analyze() {
   if (!m_projManager->HasDesign()) {
@@ -2877,107 +3030,76 @@ void Compiler::SetEnvironmentVariable(const std::string variable,
 int Compiler::ExecuteAndMonitorSystemCommand(
     const std::string& command, const std::string logFile, bool appendLog,
     const std::filesystem::path& workingDir) {
+  return ExecuteAndMonitorProcess(ProcessExecutor::SplitCommand(command),
+                                  command, logFile, appendLog, workingDir);
+}
+
+int Compiler::ExecuteAndMonitorSystemCommand(
+    const std::vector<std::string>& argv, const std::string& logFile,
+    bool appendLog, const std::filesystem::path& workingDir) {
+  return ExecuteAndMonitorProcess(argv, ProcessExecutor::JoinCommand(argv),
+                                  logFile, appendLog, workingDir);
+}
+
+/*
+  Runs the tool in 'workingDir' (project directory by default) with the
+  extra environment variables of the compiler, without changing the working
+  directory or the environment of this process.
+*/
+int Compiler::ExecuteAndMonitorProcess(const std::vector<std::string>& argv,
+                                       const std::string& command,
+                                       const std::string& logFile,
+                                       bool appendLog,
+                                       const fs::path& workingDir) {
   if (m_errorState) {
     ErrorMessage(m_errorState.message);
     ResetError();
     return -1;
   }
+  TraceScope trace{"process", command};
   auto start = Time::now();
   PERF_LOG("Command: " + command);
   (*m_out) << "Command: " << command << std::endl;
-  std::error_code ec;
-  auto path = std::filesystem::current_path();  // getting path
-  std::filesystem::current_path(
-      workingDir.empty() ? fs::path{ProjManager()->projectPath()} : workingDir,
-      ec);  // setting path
-  // new QProcess must be created here to avoid issues related to creating
-  // QObjects in different threads
-  m_process = new QProcess;
-  if (!workingDir.empty()) {
-    m_process->setWorkingDirectory(QString::fromStdString(workingDir.string()));
+  ProcessRequest request{};
+  request.argv = argv;
+  request.workingDir = workingDir;
+  if (workingDir.empty() && ProjManager()) {
+    std::error_code ec;
+    const fs::path projectPath{ProjManager()->projectPath()};
+    if (fs::is_directory(projectPath, ec)) request.workingDir = projectPath;
+  } else if (!workingDir.empty()) {
     FileUtils::MkDirs(workingDir);
   }
-  QStringList env = QProcess::systemEnvironment();
-  if (!m_environmentVariableMap.empty()) {
-    for (std::map<std::string, std::string>::iterator itr =
-             m_environmentVariableMap.begin();
-         itr != m_environmentVariableMap.end(); itr++) {
-      env << strdup(((*itr).first + "=" + (*itr).second).c_str());
-    }
-  }
-  m_process->setEnvironment(env);
+  request.environment = m_environmentVariableMap;
+  request.cancel = CancelToken();
   std::ofstream ofs;
   if (!logFile.empty()) {
-    std::ios_base::openmode openMode{std::ios_base::out};
-    if (appendLog) openMode = std::ios_base::out | std::ios_base::app;
-    ofs.open(logFile, openMode);
-    QObject::connect(m_process, &QProcess::readyReadStandardOutput,
-                     [this, &ofs]() {
-                       qint64 bytes = m_process->bytesAvailable();
-                       QByteArray bufout = m_process->readAllStandardOutput();
-                       ofs.write(bufout, bytes);
-                       m_out->write(bufout, bytes);
-                     });
-    QObject::connect(m_process, &QProcess::readyReadStandardError,
-                     [this, &ofs]() {
-                       QByteArray data = m_process->readAllStandardError();
-                       int bytes = data.size();
-                       ofs.write(data, bytes);
-                       m_err->write(data, bytes);
-                     });
-  } else {
-    QObject::connect(m_process, &QProcess::readyReadStandardOutput, [this]() {
-      m_out->write(m_process->readAllStandardOutput(),
-                   m_process->bytesAvailable());
-    });
-    QObject::connect(m_process, &QProcess::readyReadStandardError, [this]() {
-      QByteArray data = m_process->readAllStandardError();
-      m_err->write(data, data.size());
-    });
+    // relative log path is relative to the tool working directory
+    fs::path logPath{logFile};
+    if (logPath.is_relative()) logPath = request.workingDir / logPath;
+    LogUtils::OpenLog(ofs, logPath, appendLog);
+    request.out.push_back(&ofs);
+    request.err.push_back(&ofs);
+  }
+  request.out.push_back(m_out);
+  request.err.push_back(m_err);
+  // tool output for the event log, one buffer per pipe so partial lines of
+  // stdout and stderr do not mix. The GUI shows it from the console stream.
+  std::unique_ptr<EventBusStream> eventOut, eventErr;
+  if (EventLog::isActive()) {
+    eventOut = std::make_unique<EventBusStream>("compiler");
+    eventErr = std::make_unique<EventBusStream>("compiler");
+    request.out.push_back(eventOut.get());
+    request.err.push_back(eventErr.get());
   }
   ProcessUtils utils;
-  QObject::connect(m_process, &QProcess::started,
-                   [&utils, this]() { utils.Start(m_process->processId()); });
-
-  QString cmd{command.c_str()};
-  QStringList args = QtUtils::StringSplit(cmd, ' ');
-  QStringList adjustedArgs;
-
-  QString program = args.first();
-  args.pop_front();  // remove program
-  QString current_arg;
-  for (int i = 0; i < args.size(); i++) {
-    QString arg = args[i];
-    if (args[i].front() == '\"' &&
-        args[i].back() != '\"') {      // Starting single-quote
-      current_arg = arg.remove(0, 1);  // remove leading quote
-    } else if (args[i].front() != '\"' &&
-               args[i].back() == '\"') {    // Ending single-quote
-      current_arg += " " + arg.chopped(1);  // remove trailing quote
-      adjustedArgs.push_back(current_arg);
-      current_arg = "";
-    } else if (args[i].front() == '\"' &&
-               args[i].back() == '\"') {  // Single-quoted argument
-      current_arg += " " + arg;
-      adjustedArgs.push_back(current_arg);
-      current_arg = "";
-    } else if (!current_arg.isEmpty()) {  // Continuing single-quoted argument
-      current_arg += " " + arg;
-    } else {  // Non-quoted argument
-      adjustedArgs.push_back(arg);
-    }
-  }
-
-  m_process->start(program, adjustedArgs);
-  std::filesystem::current_path(path);
-  m_process->waitForFinished(-1);
+  request.started = [&utils](int64_t pid) { utils.Start(pid); };
+
+  const ProcessResult result = m_executor.run(request);
   utils.Stop();
-  // DEBUG: (*m_out) << "Changed path to: " << (path).string() << std::endl;
+  if (result.status != ProcessResult::Finished)
+    (*m_err) << command << ": " << result.error << std::endl;
   uint max_utiliation{utils.Utilization()};
-  auto status = m_process->exitStatus();
-  auto exitCode = m_process->exitCode();
-  delete m_process;
-  m_process = nullptr;
   if (!logFile.empty()) {
     ofs.close();
   }
@@ -2990,10 +3112,20 @@ int Compiler::ExecuteAndMonitorSystemCommand(
     stream << max_utiliation << " kiB";
   else
     stream << max_utiliation / 1024 << " MB";
+  const ProcessStats& stats = utils.Stats();
+  stream << " (PSS: " << stats.peakPss / 1024 << " MB"
+         << ", processes: " << stats.maxProcesses << ")"
+         << ". CPU user: " << stats.userTime << " ms"
+         << ", system: " << stats.systemTime << " ms"
+         << ". I/O read: " << stats.readBytes / 1024 << " kiB"
+         << ", write: " << stats.writeBytes / 1024 << " kiB"
+         << ". Context switches: " << stats.voluntaryCtxSwitches << "/"
+         << stats.involuntaryCtxSwitches;
   m_utils.utilization = max_utiliation;
   m_utils.duration = d.count();
+  m_utils.stats = stats;
   PERF_LOG(stream.str());
-  return (status == QProcess::NormalExit) ? exitCode : -1;
+  return result.code();
 }
 
 std::string Compiler::ReplaceAll(std::string_view str, std::string_view from,
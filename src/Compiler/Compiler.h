@@ -45,9 +45,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <unistd.h>
 #endif
 
+#include <atomic>
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -59,6 +61,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Simulation/Simulator.h"
 #include "Task.h"
 #include "Tcl/TclInterpreter.h"
+#include "Utils/ProcessExecutor.h"
 
 class QProcess;
 namespace fs = std::filesystem;
@@ -162,6 +165,8 @@ class Compiler {
   void GenerateReport(int action);
   void Stop();
   void ResetStopFlag();
+  // cancelled by Stop(), passed to the tools and jobs of the current run
+  CancellationToken CancelToken() const;
   TclInterpreter* TclInterp() { return m_interp; }
   virtual bool RegisterCommands(TclInterpreter* interp, bool batchMode);
   void start();
@@ -198,6 +203,7 @@ class Compiler {
 
   bool BuildLiteXIPCatalog(std::filesystem::path litexPath,
                            bool namesOnly = false);
+  bool parseIPGenJobs(int argc, const char* argv[], int& index);
   bool HasIPInstances();
   bool HasIPDefinitions();
 
@@ -262,6 +268,10 @@ class Compiler {
   const std::string& IPGenMoreOpt() { return m_ipGenMoreOpt; }
   void IPGenMoreOpt(const std::string& opt) { m_ipGenMoreOpt = opt; }
 
+  // Number of IP generators run in parallel, 0 means one per core
+  unsigned int IPGenJobs() const { return m_ipGenJobs; }
+  void IPGenJobs(unsigned int jobs) { m_ipGenJobs = jobs; }
+
   void PnROpt(const std::string& opt) { m_pnrOpt = opt; }
   const std::string& PnROpt() { return m_pnrOpt; }
 
@@ -308,6 +318,10 @@ class Compiler {
   virtual int ExecuteAndMonitorSystemCommand(
       const std::string& command, const std::string logFile = std::string{},
       bool appendLog = false, const fs::path& workingDir = {});
+  int ExecuteAndMonitorSystemCommand(const std::vector<std::string>& argv,
+                                     const std::string& logFile = {},
+                                     bool appendLog = false,
+                                     const fs::path& workingDir = {});
 
   void ProgrammerToolExecPath(const std::filesystem::path& path) {
     m_programmerToolExecutablePath = path;
@@ -372,6 +386,7 @@ class Compiler {
    */
   virtual bool VerifyTargetDevice() const;
   bool HasTargetDevice();
+  void WriteResourceUsage(Action action);
 
   std::pair<bool, std::string> CreateDesign(
       const std::string& name, const std::string& type = std::string{},
@@ -381,6 +396,10 @@ class Compiler {
   bool RunBatch();
   bool RunCompileTask(Action action);
   bool SwitchCompileContext(Action action, const std::function<bool(void)>& fn);
+  int ExecuteAndMonitorProcess(const std::vector<std::string>& argv,
+                               const std::string& command,
+                               const std::string& logFile, bool appendLog,
+                               const fs::path& workingDir);
 
   void SetEnvironmentVariable(const std::string variable,
                               const std::string value);
@@ -412,7 +431,7 @@ class Compiler {
   TclInterpreter* m_interp = nullptr;
   Session* m_session = nullptr;
   class ProjectManager* m_projManager = nullptr;
-  bool m_stop = false;
+  std::atomic<bool> m_stop{false};
   State m_state = State::None;
   std::ostream* m_out = &std::cout;
   std::ostream* m_err = &std::cerr;
@@ -450,6 +469,7 @@ class Compiler {
   std::string m_synthMoreOpt;
   std::string m_placeMoreOpt;
   std::string m_ipGenMoreOpt;
+  unsigned int m_ipGenJobs{0};
 
   // VPR, Yosys options
   uint32_t m_channel_width = 100;
@@ -459,7 +479,9 @@ class Compiler {
   std::string m_mapToTechnology;
   bool m_bitstreamEnabled = true;
   bool m_pin_constraintEnabled = true;
-  class QProcess* m_process = nullptr;
+  ProcessExecutor m_executor;
+  CancellationToken m_cancel{};
+  mutable std::mutex m_cancelMutex;
   class DeviceModeling* m_DeviceModeling = nullptr;
   // Sub engines
   IPGenerator* m_IPGenerator = nullptr;
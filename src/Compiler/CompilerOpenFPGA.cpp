@@ -22,19 +22,19 @@
 #include "Compiler/CompilerOpenFPGA.h"
 
 #include <QDebug>
-#include <QDomDocument>
-#include <QFile>
 #include <QTextStream>
 #include <chrono>
 #include <filesystem>
 #include <regex>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 
 #include "Compiler/Constraints.h"
 #include "Configuration/CFGCommon/CFGCommon.h"
 #include "Log.h"
 #include "Main/Settings.h"
+#include "NewProject/ProjectManager/DeviceCatalog.h"
 #include "NewProject/ProjectManager/config.h"
 #include "NewProject/ProjectManager/project_manager.h"
 #include "ProjNavigator/tcl_command_integration.h"
@@ -731,29 +731,18 @@ std::pair<bool, std::string> CompilerOpenFPGA::IsDeviceSizeCorrect(
                           "Please specify target device or architecture file.");
   std::filesystem::path datapath = GetSession()->Context()->DataPath();
   std::filesystem::path devicefile = datapath / "etc" / m_architectureFile;
-  QFile file(devicefile.string().c_str());
-  if (!file.open(QFile::ReadOnly)) {
-    return std::make_pair(false,
-                          "Cannot open device file: " + devicefile.string());
-  }
-  QDomDocument doc;
-  if (!doc.setContent(&file)) {
-    file.close();
-    return std::make_pair(false,
-                          "Incorrect device file: " + devicefile.string());
-  }
-  file.close();
-  auto fixedLayout = doc.elementsByTagName("fixed_layout");
-  if (fixedLayout.isEmpty())
+  QString error{};
+  auto fixedLayouts =
+      DeviceCatalog::Instance()->fixedLayouts(devicefile, error);
+  if (!fixedLayouts) return std::make_pair(false, error.toStdString());
+  if (fixedLayouts->isEmpty())
     return std::make_pair(false, "Architecture file: fixed_layout is missing");
-  for (int i = 0; i < fixedLayout.count(); i++) {
-    auto node = fixedLayout.at(i).toElement();
-    if (node.attribute("name").toStdString() == size) {
-      std::string device_dimension =
-          CFG_print("%sx%s", node.attribute("width").toStdString().c_str(),
-                    node.attribute("height").toStdString().c_str());
-      return std::make_pair(true, device_dimension);
-    }
+  auto layout = fixedLayouts->find(QString::fromStdString(size));
+  if (layout != fixedLayouts->end()) {
+    std::string device_dimension =
+        CFG_print("%sx%s", layout->first.toStdString().c_str(),
+                  layout->second.toStdString().c_str());
+    return std::make_pair(true, device_dimension);
   }
   return std::make_pair(false, std::string{"Device size is not correct"});
 }
@@ -799,8 +788,11 @@ std::filesystem::path CompilerOpenFPGA::copyLog(
     std::filesystem::path src = projectPath / srcFileName;
     if (FileUtils::FileExists(src)) {
       dest = projectPath / destFileName;
-      std::filesystem::remove(dest);
-      std::filesystem::copy_file(src, dest);
+      // header goes first so the report is written only once
+      std::ofstream destLog;
+      std::ifstream srcLog(src, std::ios_base::binary);
+      if (LogUtils::OpenLog(destLog, dest) && srcLog.peek() != EOF)
+        destLog << srcLog.rdbuf();
     }
   }
 
@@ -1150,15 +1142,6 @@ std::string CompilerOpenFPGA::FinishAnalyzeScript(const std::string& script) {
 }
 
 bool CompilerOpenFPGA::Analyze() {
-  // Using a Scope Guard so this will fire even if we exit mid function
-  // This will fire when the containing function goes out of scope
-  auto guard = sg::make_scope_guard([this] {
-    // Log generated by ExecuteAndMonitorSystemCommand, we just need to add
-    // header info to the log
-    std::filesystem::path logPath = FilePath(Action::Analyze, ANALYSIS_LOG);
-    LogUtils::AddHeaderToLog(logPath);
-  });
-
   auto printTopModules = [this](const std::filesystem::path& filePath,
                                 std::ostream* out) {
     // Check for "topModule" in a given json filePath
@@ -1246,17 +1229,19 @@ bool CompilerOpenFPGA::Analyze() {
     ErrorMessage("Cannot find executable: " + m_analyzeExecutablePath.string());
     return false;
   }
+  std::vector<std::string> argv{m_analyzeExecutablePath.string()};
   if (GetParserType() == ParserType::Default ||
       GetParserType() == ParserType::Surelog ||
       GetParserType() == ParserType::GHDL) {
     // Yosys-based analyze
-    command = m_analyzeExecutablePath.string() + " -s " + script_path.string();
+    argv.insert(argv.end(), {"-s", script_path.string()});
   } else {
     // Verific-based analyze
-    command = m_analyzeExecutablePath.string() + " -f " + script_path.string();
+    argv.insert(argv.end(), {"-f", script_path.string()});
   }
+  command = ProcessExecutor::JoinCommand(argv);
   Message("Analyze command: " + command);
-  status = ExecuteAndMonitorSystemCommand(command, analyse_path.string(), false,
+  status = ExecuteAndMonitorSystemCommand(argv, analyse_path.string(), false,
                                           FilePath(Action::Analyze));
 
   if (status) {
@@ -1840,33 +1825,25 @@ bool CompilerOpenFPGA::Synthesize() {
   std::string yosysScript = InitSynthesisScript();
 
   // update constraints
-  const auto& constrFiles = ProjManager()->getConstrFiles();
-  m_constraints->reset();
-  for (const auto& file : constrFiles) {
-    int res{TCL_OK};
-    auto status =
-        m_interp->evalCmd(std::string("read_sdc {" + file + "}").c_str(), &res);
-    if (res != TCL_OK) {
-      ErrorMessage(status);
-      return false;
-    }
-  }
+  if (!ReadConstraints()) return false;
 
   const std::string sdcOut =
       "pin_location_" + ProjManager()->projectName() + ".sdc";
   std::ofstream ofssdc(sdcOut);
-  for (auto constraint : m_constraints->getConstraints()) {
-    constraint = m_constraints->UnmangleName(constraint);
+  for (const auto& command : m_constraints->getCommands()) {
     // pin location constraints have to be translated to .place:
-    if ((constraint.find("set_pin_loc") != std::string::npos)) {
-      ofssdc << constraint << std::endl;
-    } else if (constraint.find("set_mode") != std::string::npos) {
-      ofssdc << constraint << std::endl;
-    } else if ((constraint.find("set_property") != std::string::npos) &&
-               (constraint.find(" mode ") != std::string::npos)) {
-      constraint = ReplaceAll(constraint, " mode ", " ");
-      constraint = ReplaceAll(constraint, "set_property", "set_mode");
-      ofssdc << constraint << std::endl;
+    switch (command.kind) {
+      case SdcCommand::Kind::PinLocation:
+      case SdcCommand::Kind::Mode:
+        ofssdc << command.text << "\n";
+        break;
+      case SdcCommand::Kind::ModeProperty: {
+        std::string constraint = ReplaceAll(command.text, " mode ", " ");
+        ofssdc << ReplaceAll(constraint, "set_property", "set_mode") << "\n";
+        break;
+      }
+      default:
+        break;
     }
   }
   ofssdc.close();
@@ -2192,13 +2169,12 @@ bool CompilerOpenFPGA::Synthesize() {
     ErrorMessage("Cannot find executable: " + m_yosysExecutablePath.string());
     return false;
   }
-  std::string command =
-      m_yosysExecutablePath.string() + " -s " +
-      std::string(script_path + " -l " + ProjManager()->projectName() +
-                  "_synth.log");
-  Message("Synthesis command: " + command);
+  const std::vector<std::string> argv{
+      m_yosysExecutablePath.string(), "-s", script_path, "-l",
+      ProjManager()->projectName() + "_synth.log"};
+  Message("Synthesis command: " + ProcessExecutor::JoinCommand(argv));
   int status = ExecuteAndMonitorSystemCommand(
-      command, {}, false, FilePath(Action::Synthesis).string());
+      argv, {}, false, FilePath(Action::Synthesis).string());
   if (status) {
     if (GetParserType() == ParserType::Default) {
       std::ifstream raptor_log(ProjManager()->projectName() + "_synth.log");
@@ -2265,12 +2241,11 @@ std::string CompilerOpenFPGA::BaseVprCommand() {
 }
 
 std::string CompilerOpenFPGA::BaseVprCommand(BaseVprDefaults defaults) {
-  std::string device_size = "";
-  if (PackOpt() == Compiler::PackingOpt::Debug) {
-    device_size = " --device auto";
-  } else if (!m_deviceSize.empty()) {
-    device_size = " --device " + m_deviceSize;
-  }
+  return ProcessExecutor::JoinCommand(BaseVprArgs(defaults));
+}
+
+std::vector<std::string> CompilerOpenFPGA::BaseVprArgs(
+    BaseVprDefaults defaults) {
   std::string netlistFile;
   switch (GetNetlistType()) {
     case NetlistType::Verilog:
@@ -2311,41 +2286,46 @@ std::string CompilerOpenFPGA::BaseVprCommand(BaseVprDefaults defaults) {
     }
   }
 
-  std::string pnrOptions;
-  if (ClbPackingOption() == ClbPacking::Timing_driven) {
-    pnrOptions += " --allow_unrelated_clustering off";
-  } else {
-    pnrOptions += " --allow_unrelated_clustering on";
-  }
-  if (!PnROpt().empty()) pnrOptions += " " + PnROpt();
-  if (!PerDevicePnROptions().empty()) pnrOptions += " " + PerDevicePnROptions();
   auto sdcFile =
       FilePath(Action::Pack,
                "fabric_" + ProjManager()->projectName() + "_openfpga.sdc")
           .string();
-  std::string command =
-      m_vprExecutablePath.string() + std::string(" ") +
-      m_architectureFile.string() + std::string(" ") +
-      std::string(netlistFile + std::string(" --sdc_file ") + sdcFile +
-                  std::string(" --clock_modeling ideal --route_chan_width ") +
-                  std::to_string(m_channel_width) + device_size + pnrOptions);
+  std::vector<std::string> argv{m_vprExecutablePath.string(),
+                                m_architectureFile.string(), netlistFile,
+                                "--sdc_file", sdcFile, "--clock_modeling",
+                                "ideal", "--route_chan_width",
+                                std::to_string(m_channel_width)};
+  if (PackOpt() == Compiler::PackingOpt::Debug) {
+    argv.insert(argv.end(), {"--device", "auto"});
+  } else if (!m_deviceSize.empty()) {
+    argv.insert(argv.end(), {"--device", m_deviceSize});
+  }
+  argv.push_back("--allow_unrelated_clustering");
+  argv.push_back(ClbPackingOption() == ClbPacking::Timing_driven ? "off"
+                                                                 : "on");
+  // User options are typed as a command line, split them the same way
+  for (const auto& options : {PnROpt(), PerDevicePnROptions()}) {
+    for (const auto& option : ProcessExecutor::SplitCommand(options))
+      argv.push_back(option);
+  }
 
   fs::path netlistFileName{netlistFile};
   netlistFileName = netlistFileName.filename();
   auto name = netlistFileName.stem().string();
   if (m_flatRouting) {
-    command += " --flat_routing on";
+    argv.insert(argv.end(), {"--flat_routing", "on"});
   }
   if (!m_routingGraphFile.empty()) {
-    command += " --read_rr_graph " + m_routingGraphFile.string();
-  }
-  command += " --net_file " + FilePath(Action::Pack, name + ".net").string();
-  command +=
-      " --place_file " + FilePath(Action::Placement, name + ".place").string();
-  command +=
-      " --route_file " + FilePath(Action::Routing, name + ".route").string();
+    argv.insert(argv.end(), {"--read_rr_graph", m_routingGraphFile.string()});
+  }
+  argv.insert(argv.end(),
+              {"--net_file", FilePath(Action::Pack, name + ".net").string(),
+               "--place_file",
+               FilePath(Action::Placement, name + ".place").string(),
+               "--route_file",
+               FilePath(Action::Routing, name + ".route").string()});
   processCustomLayout();
-  return command;
+  return argv;
 }
 
 std::string CompilerOpenFPGA::BaseStaCommand() {
@@ -2383,59 +2363,55 @@ bool CompilerOpenFPGA::WriteTimingConstraints() {
   getNetlistEditData()->ReadData(configJsonPath, fabricJsonPath);
 
   // update constraints
-  const auto& constrFiles = ProjManager()->getConstrFiles();
-  m_constraints->reset();
-  for (const auto& file : constrFiles) {
-    int res{TCL_OK};
-    auto status =
-        m_interp->evalCmd(std::string("read_sdc {" + file + "}").c_str(), &res);
-    if (res != TCL_OK) {
-      ErrorMessage(status);
-      return false;
-    }
-  }
+  if (!ReadConstraints()) return false;
 
   const std::string sdcOut =
       "fabric_" + ProjManager()->projectName() + "_openfpga.sdc";
   std::ofstream ofssdc(sdcOut);
   // TODO: Massage the SDC so VPR can understand them
-  for (auto constraint : m_constraints->getConstraints()) {
-    // Parse RTL and expand the get_ports, get_nets
-    // Temporary dirty filtering:
-    constraint = m_constraints->UnmangleName(constraint);
-    Message("Constraint: " + constraint);
-    std::vector<std::string> tokens;
-    StringUtils::tokenize(constraint, " ", tokens);
-    constraint = "";
-    for (uint32_t i = 0; i < tokens.size(); i++) {
-      const std::string& tok = tokens[i];
-      tokens[i] = getNetlistEditData()->PIO2InnerNet(tok);
-      tokens[i] = m_constraints->SafeParens(tokens[i]);
-    }
-
+  size_t count{0};
+  for (const auto& command : m_constraints->getCommands()) {
+    // pin location, mode and property constraints are not for VPR
+    if (command.kind != SdcCommand::Kind::Timing) continue;
     // VPR does not understand: create_clock -period 2 clk -name <logical_name>
     // Pass the constraint as-is anyway
-    for (uint32_t i = 0; i < tokens.size(); i++) {
-      const std::string& tok = tokens[i];
-      constraint += tok + " ";
-    }
-
-    // pin location constraints have to be translated to .place:
-    if (constraint.find("set_pin_loc") != std::string::npos) {
-      continue;
-    }
-    if (constraint.find("set_mode") != std::string::npos) {
-      continue;
-    }
-    if (constraint.find("set_property") != std::string::npos) {
-      continue;
-    }
-    if (constraint.find("set_clock_pin") != std::string::npos) {
-      continue;
+    std::string constraint;
+    for (const auto& word : command.words) {
+      constraint +=
+          m_constraints->SafeParens(getNetlistEditData()->PIO2InnerNet(word)) +
+          " ";
     }
     ofssdc << constraint << "\n";
+    count++;
   }
   ofssdc.close();
+  Message("Timing constraints: " + std::to_string(count) + " written to " +
+          sdcOut);
+  return true;
+}
+
+bool CompilerOpenFPGA::ReadConstraints() {
+  const auto& constrFiles = ProjManager()->getConstrFiles();
+  // commands expand names through the netlist data, so it is part of the key
+  std::string key = "netlist:" + getNetlistEditData()->DataKey();
+  for (const auto& file : constrFiles) {
+    const std::string content = FileUtils::GetFileContent(file);
+    key +=
+        "\n" + file + ":" + std::to_string(std::hash<std::string>{}(content));
+  }
+  if (key == m_constraints->SourceKey()) return true;
+
+  m_constraints->reset();
+  for (const auto& file : constrFiles) {
+    int res{TCL_OK};
+    auto status =
+        m_interp->evalCmd(std::string("read_sdc {" + file + "}").c_str(), &res);
+    if (res != TCL_OK) {
+      ErrorMessage(status);
+      return false;
+    }
+  }
+  m_constraints->SetSourceKey(key);
   return true;
 }
 
@@ -2467,21 +2443,7 @@ bool CompilerOpenFPGA::Packing() {
   Message("##################################################");
   Message("Packing for design: " + ProjManager()->projectName());
   Message("##################################################");
-  if (ProjManager()->projectType() == ProjectType::GateLevel) {
-    // update constraints
-    const auto& constrFiles = ProjManager()->getConstrFiles();
-    m_constraints->reset();
-    for (const auto& file : constrFiles) {
-      int res{TCL_OK};
-      auto status = m_interp->evalCmd(
-          std::string("read_sdc {" + file + "}").c_str(), &res);
-      if (res != TCL_OK) {
-        ErrorMessage(status);
-        return false;
-      }
-    }
-  }
-
+  // constraints are read by WriteTimingConstraints(), gate level designs too
   if (!WriteTimingConstraints()) {
     return false;
   }
@@ -2489,9 +2451,10 @@ bool CompilerOpenFPGA::Packing() {
   auto prevOpt = PackOpt();
   PackOpt(PackingOpt::None);
 
-  std::string command = BaseVprCommand({}) + " --pack";
+  auto argv = BaseVprArgs({});
+  argv.push_back("--pack");
   auto file = ProjManager()->projectName() + "_pack.cmd";
-  FileUtils::WriteToFile(file, command);
+  FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(argv));
 
   fs::path netlistPath = GetNetlistPath();
   netlistPath = netlistPath.filename();
@@ -2505,13 +2468,14 @@ bool CompilerOpenFPGA::Packing() {
 
   PackOpt(prevOpt);
   auto workingDir = FilePath(Action::Pack);
-  int status = ExecuteAndMonitorSystemCommand(command, {}, false, workingDir);
+  int status = ExecuteAndMonitorSystemCommand(argv, {}, false, workingDir);
   if (status) {
     ErrorMessage("Design " + ProjManager()->projectName() + " packing failed");
     if (PackOpt() == PackingOpt::Debug) {
-      std::string command = BaseVprCommand({}) + " --pack";
-      FileUtils::WriteToFile(file, command);
-      ExecuteAndMonitorSystemCommand(command, {}, false, workingDir);
+      auto debugArgv = BaseVprArgs({});
+      debugArgv.push_back("--pack");
+      FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(debugArgv));
+      ExecuteAndMonitorSystemCommand(debugArgv, {}, false, workingDir);
     }
     return false;
   }
@@ -2667,29 +2631,33 @@ bool CompilerOpenFPGA::Placement() {
 #else
   {
 #endif
-    for (auto constraint : m_constraints->getConstraints()) {
-      constraint = m_constraints->UnmangleName(constraint);
+    for (const auto& command : m_constraints->getCommands()) {
+      std::string constraint = command.text;
       // pin location constraints have to be translated to .place:
-      if ((constraint.find("set_pin_loc") != std::string::npos)) {
-        userConstraint = true;
-        constraint = ReplaceAll(constraint, "set_pin_loc", "set_io");
-        constraints.push_back(constraint);
-      } else if (constraint.find("set_mode") != std::string::npos) {
-        constraints.push_back(constraint);
-        userConstraint = true;
-      } else if ((constraint.find("set_property") != std::string::npos) &&
-                 (constraint.find(" mode ") != std::string::npos)) {
-        constraint = ReplaceAll(constraint, " mode ", " ");
-        constraint = ReplaceAll(constraint, "set_property", "set_mode");
-        constraints.push_back(constraint);
-        userConstraint = true;
-      } else if (constraint.find("set_clock_pin") != std::string::npos) {
-        set_clks.push_back(constraint);
-        repackConstraint = true;
-        constraints.push_back("# " +
-                              constraint);  // so there is a diff if changed
-      } else {
-        continue;
+      switch (command.kind) {
+        case SdcCommand::Kind::PinLocation:
+          userConstraint = true;
+          constraint = ReplaceAll(constraint, "set_pin_loc", "set_io");
+          constraints.push_back(constraint);
+          break;
+        case SdcCommand::Kind::Mode:
+          constraints.push_back(constraint);
+          userConstraint = true;
+          break;
+        case SdcCommand::Kind::ModeProperty:
+          constraint = ReplaceAll(constraint, " mode ", " ");
+          constraint = ReplaceAll(constraint, "set_property", "set_mode");
+          constraints.push_back(constraint);
+          userConstraint = true;
+          break;
+        case SdcCommand::Kind::ClockPin:
+          set_clks.push_back(constraint);
+          repackConstraint = true;
+          // so there is a diff if changed
+          constraints.push_back("# " + constraint);
+          break;
+        default:
+          break;
       }
     }
   }
@@ -2752,10 +2720,12 @@ bool CompilerOpenFPGA::Placement() {
     }
   }
 
-  std::string command = BaseVprCommand({}) + " --place";
-  std::string pincommand = m_pinConvExecutablePath.string();
+  auto argv = BaseVprArgs({});
+  argv.push_back("--place");
+  std::vector<std::string> pinArgv{m_pinConvExecutablePath.string()};
   if ((PinAssignOpts() != PinAssignOpt::Pin_constraint_disabled) &&
-      FileUtils::FileExists(pincommand) && (!m_PinMapCSV.empty())) {
+      FileUtils::FileExists(m_pinConvExecutablePath) &&
+      (!m_PinMapCSV.empty())) {
     if (!std::filesystem::is_regular_file(m_PinMapCSV)) {
       ErrorMessage(
           "No pin description csv file available for this device, required "
@@ -2765,40 +2735,42 @@ bool CompilerOpenFPGA::Placement() {
     // pin_c executable can work with either xml and csv or csv only file
     if (!m_OpenFpgaPinMapXml.empty() &&
         std::filesystem::is_regular_file(m_OpenFpgaPinMapXml)) {
-      pincommand += " --xml " + m_OpenFpgaPinMapXml.string();
+      pinArgv.insert(pinArgv.end(), {"--xml", m_OpenFpgaPinMapXml.string()});
     }
-    pincommand += " --csv " + m_PinMapCSV.string();
+    pinArgv.insert(pinArgv.end(), {"--csv", m_PinMapCSV.string()});
 
     if (userConstraint) {
-      pincommand += " --pcf " +
-                    std::string(ProjManager()->projectName() + "_openfpga.pcf");
+      pinArgv.insert(pinArgv.end(),
+                     {"--pcf", ProjManager()->projectName() + "_openfpga.pcf"});
     }
 
     if (GetNetlistType() == NetlistType::Edif) {
-      pincommand += " --port_info ";
-      pincommand += FilePath(Action::Pack, "post_synth_ports.json").string();
+      pinArgv.insert(
+          pinArgv.end(),
+          {"--port_info",
+           FilePath(Action::Pack, "post_synth_ports.json").string()});
     } else if (netlistInput == true) {
-      pincommand += " --blif " + GetNetlistPath();
+      pinArgv.insert(pinArgv.end(), {"--blif", GetNetlistPath()});
     } else {
-      pincommand += " --blif " + netlistFile;
+      pinArgv.insert(pinArgv.end(), {"--blif", netlistFile});
     }
 
     std::string pin_locFile = ProjManager()->projectName() + "_pin_loc.place";
-    pincommand += " --output " + pin_locFile;
+    pinArgv.insert(pinArgv.end(), {"--output", pin_locFile});
 
     // for design pins that are not explicitly constrained by user,
     // pin_c will assign legal device pins to them
     // this is configured at top level raptor shell/gui through command
     // "pin_loc_assign_method"
-    pincommand += " --assign_unconstrained_pins";
+    pinArgv.push_back("--assign_unconstrained_pins");
     if (PinAssignOpts() == PinAssignOpt::Random) {
-      pincommand += " random";
+      pinArgv.push_back("random");
     } else if (PinAssignOpts() == PinAssignOpt::In_Define_Order) {
-      pincommand += " in_define_order";
+      pinArgv.push_back("in_define_order");
     } else if (PinAssignOpts() == PinAssignOpt::Pin_constraint_disabled) {
-      pincommand += " free";
+      pinArgv.push_back("free");
     } else {  // default behavior
-      pincommand += " in_define_order";
+      pinArgv.push_back("in_define_order");
     }
 
     // user want to map its design clocks to fabric
@@ -2819,28 +2791,27 @@ bool CompilerOpenFPGA::Placement() {
         ofsclkmap << constraint << "\n";
       }
       ofspcf.close();
-      pincommand += " --clk_map " + std::string(ProjManager()->projectName() +
-                                                ".temp_file_clkmap");
-      pincommand +=
-          " --read_repack " + m_OpenFpgaRepackConstraintsFile.string();
-      pincommand += " --write_repack " + repack_constraints;
+      pinArgv.insert(pinArgv.end(),
+                     {"--clk_map", repack_out, "--read_repack",
+                      m_OpenFpgaRepackConstraintsFile.string(),
+                      "--write_repack", repack_constraints});
     }
 
     // pass config.json dumped during synthesis stage by design edit plugin
     std::filesystem::path configJsonPath =
         FilePath(Action::Synthesis) / "config.json";
     if (FileUtils::FileExists(configJsonPath)) {
-      pincommand += " --edits " + configJsonPath.string();
+      pinArgv.insert(pinArgv.end(), {"--edits", configJsonPath.string()});
     }
 
     std::string pin_loc_constraint_file;
 
     auto file = ProjManager()->projectName() + "_pin_loc.cmd";
-    FileUtils::WriteToFile(file, pincommand);
+    FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(pinArgv));
 
     auto workingDir = FilePath(Action::Placement);
     int status =
-        ExecuteAndMonitorSystemCommand(pincommand, {}, false, workingDir);
+        ExecuteAndMonitorSystemCommand(pinArgv, {}, false, workingDir);
 
     if (status) {
       ErrorMessage("Design " + ProjManager()->projectName() +
@@ -2852,14 +2823,14 @@ bool CompilerOpenFPGA::Placement() {
 
     if ((PinAssignOpts() != PinAssignOpt::Pin_constraint_disabled) &&
         PinConstraintEnabled() && (!pin_loc_constraint_file.empty())) {
-      command += " --fix_clusters " + pin_loc_constraint_file;
+      argv.insert(argv.end(), {"--fix_clusters", pin_loc_constraint_file});
     }
   }
 
   auto file = ProjManager()->projectName() + "_place.cmd";
-  FileUtils::WriteToFile(file, command);
+  FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(argv));
   auto workingDir = FilePath(Action::Placement);
-  int status = ExecuteAndMonitorSystemCommand(command, {}, false, workingDir);
+  int status = ExecuteAndMonitorSystemCommand(argv, {}, false, workingDir);
   if (status) {
     ErrorMessage("Design " + ProjManager()->projectName() +
                  " placement failed");
@@ -2870,19 +2841,10 @@ bool CompilerOpenFPGA::Placement() {
   return true;
 }
 
-static std::string find_gbox_mode(const std::vector<std::string>* A, int i,
-                                  const std::string& gbox) noexcept {
-  for (; i >= 0; i--) {
-    const std::vector<std::string>& line = A[i];
-    if (line.size() < 3 or line.front() != "set_mode") continue;
-    if (line[2] == gbox) return line[1];
-  }
-  return {};
-}
-
 bool CompilerOpenFPGA::ConvertSdcPinConstrainToPcf(
     std::vector<std::string>& constraints) {
   using std::string;
+  using std::string_view;
   using std::vector;
 
   size_t in_sz = constraints.size();
@@ -2900,66 +2862,60 @@ bool CompilerOpenFPGA::ConvertSdcPinConstrainToPcf(
     ::puts("--- end trace-in -\n");
   }
 
+  // One forward pass. Tokens and the gbox modes are views into the input
+  // lines, which stay alive until the output replaces them. set_io takes the
+  // mode of the latest set_mode of its gbox seen so far.
   vector<string> constraint_and_mode;
-  vector<vector<string>> tokenized(in_sz);
-  string constraint_with_mode;
-
-  // tokenize all lines
-  for (size_t i = 0; i < in_sz; i++)
-    StringUtils::tokenize(constraints[i], " ", tokenized[i]);
-
-  // error-check
+  constraint_and_mode.reserve(in_sz);
+  std::unordered_map<string_view, string_view> gbox_modes;
+  vector<string_view> tokens;
   for (size_t i = 0; i < in_sz; i++) {
-    if (constraints[i].find("set_mode") == string::npos) continue;
-    const vector<string>& tokens = tokenized[i];
-    if (tokens.size() != 3) {
-      ErrorMessage("Invalid set_mode command: <" + constraints[i] + ">");
-      return false;
-    }
-  }
+    const string& constraint = constraints[i];
+    const bool is_mode = constraint.find("set_mode") != string::npos;
+    const bool is_io = constraint.find("set_io") != string::npos;
+    if (!is_mode && !is_io) continue;
+    tokens.clear();
+    StringUtils::tokenize(constraint, " ", tokens);
 
-  for (size_t i = 0; i < in_sz; i++) {
-    if (constraints[i].find("set_io") == string::npos) continue;
+    if (is_mode) {
+      if (tokens.size() != 3) {
+        ErrorMessage("Invalid set_mode command: <" + constraint + ">");
+        return false;
+      }
+      if (tokens[0] == "set_mode") gbox_modes[tokens[2]] = tokens[1];
+    }
+    if (!is_io) continue;
 
-    const vector<string>& tokens = tokenized[i];
     if (!(tokens.size() == 3 || tokens.size() == 4 ||
           (tokens.size() == 7 && tokens[0] == "set_io" &&
            tokens[3] == "-mode" && tokens[5] == "-internal_pin"))) {
-      ErrorMessage("Invalid set_pin_loc command: <" + constraints[i] + ">");
+      ErrorMessage("Invalid set_pin_loc command: <" + constraint + ">");
       return false;
     }
     if (tokens.size() == 7) {
-      constraint_with_mode = constraints[i];
-    } else {
-      constraint_with_mode = tokens[0];
-      constraint_with_mode.push_back(' ');
-      constraint_with_mode += tokens[1];
-      constraint_with_mode.push_back(' ');
-      constraint_with_mode += tokens[2];
-
-      string mod = find_gbox_mode(tokenized.data(), i, tokens[2]);
-      if (mod.empty()) mod = "Mode_GPIO";
-
-      constraint_with_mode += " -mode ";
-      constraint_with_mode += mod;
-
-      if (tokens.size() == 4) {
-        constraint_with_mode += string(" -internal_pin ") + tokens[3];
-      }
+      constraint_and_mode.push_back(constraint);
+      continue;
     }
-    constraint_and_mode.push_back(constraint_with_mode);
+    auto mode = gbox_modes.find(tokens[2]);
+    const string_view mod =
+        mode != gbox_modes.end() ? mode->second : string_view{"Mode_GPIO"};
+    string constraint_with_mode;
+    constraint_with_mode.reserve(constraint.size() + mod.size() + 24);
+    constraint_with_mode.append(tokens[0]).append(" ");
+    constraint_with_mode.append(tokens[1]).append(" ");
+    constraint_with_mode.append(tokens[2]).append(" -mode ").append(mod);
+    if (tokens.size() == 4)
+      constraint_with_mode.append(" -internal_pin ").append(tokens[3]);
+    constraint_and_mode.push_back(std::move(constraint_with_mode));
   }
 
-  size_t out_sz = constraint_and_mode.size();
-  constraints.clear();
-  for (size_t i = 0; i < out_sz; i++) {
-    constraints.push_back(constraint_and_mode[i]);
-  }
+  constraints.swap(constraint_and_mode);
+  size_t out_sz = constraints.size();
 
   if (trace) {
     ::printf(" TRACE-OUT compilerOpenFPGA: PCF output (%zu)\n\n", out_sz);
     for (size_t i = 0; i < out_sz; i++) {
-      const string& ss = constraint_and_mode[i];
+      const string& ss = constraints[i];
       ::printf("\t |%zu|  %s\n", i, ss.c_str());
     }
     ::puts("\n");
@@ -3015,12 +2971,13 @@ bool CompilerOpenFPGA::Route() {
   }
 
   auto routingPath = FilePath(Action::Routing);
-  std::string command = BaseVprCommand({}) + " --route";
+  auto argv = BaseVprArgs({});
+  argv.push_back("--route");
   FileUtils::WriteToFile(
       routingPath / std::string(ProjManager()->projectName() + "_route.cmd"),
-      command);
+      ProcessExecutor::JoinCommand(argv));
+  int status = ExecuteAndMonitorSystemCommand(argv, {}, false, routingPath);
   routingUtilization = m_utils;
-  int status = ExecuteAndMonitorSystemCommand(command, {}, false, routingPath);
   if (status) {
     ErrorMessage("Design " + ProjManager()->projectName() + " routing failed");
     return false;
@@ -3037,9 +2994,9 @@ bool CompilerOpenFPGA::Route() {
   std::filesystem::path ReConstructInFile = routingPath / postRouteVfile;
   std::filesystem::path ReConstructOutFile =
       routingPath / std::string(postRouteVfile + "_");
-  std::string reconstruct_cmd = m_ReConstructVExecPath.string() + "  " +
-                                ReConstructInFile.string() + " " +
-                                ReConstructOutFile.string();
+  const std::vector<std::string> reconstruct_cmd{
+      m_ReConstructVExecPath.string(), ReConstructInFile.string(),
+      ReConstructOutFile.string()};
   int status_ =
       ExecuteAndMonitorSystemCommand(reconstruct_cmd, {}, false, routingPath);
   if (status_) {
@@ -3099,9 +3056,10 @@ bool CompilerOpenFPGA::TimingAnalysis() {
   auto workingDir = FilePath(Action::STA).string();
   if (TimingAnalysisOpt() == STAOpt::View) {
     TimingAnalysisOpt(STAOpt::None);
-    const std::string command = BaseVprCommand({}) + " --analysis --disp on";
+    auto argv = BaseVprArgs({});
+    argv.insert(argv.end(), {"--analysis", "--disp", "on"});
     const int status =
-        ExecuteAndMonitorSystemCommand(command, {}, false, workingDir);
+        ExecuteAndMonitorSystemCommand(argv, {}, false, workingDir);
     if (status) {
       ErrorMessage("Design " + ProjManager()->projectName() +
                    " place and route view failed");
@@ -3120,15 +3078,15 @@ bool CompilerOpenFPGA::TimingAnalysis() {
     return true;
   }
   int status = 0;
-  std::string taCommand;
+  std::vector<std::string> taArgv;
   // use OpenSTA to do the job
   if (TimingAnalysisEngineOpt() == STAEngineOpt::Opensta) {
     // allows SDF to be generated for OpenSTA
-    std::string command =
-        BaseVprCommand({}) + " --gen_post_synthesis_netlist on";
+    auto argv = BaseVprArgs({});
+    argv.insert(argv.end(), {"--gen_post_synthesis_netlist", "on"});
     auto file = std::string(ProjManager()->projectName() + "_sta.cmd");
-    FileUtils::WriteToFile(file, command);
-    int status = ExecuteAndMonitorSystemCommand(command, {}, false, workingDir);
+    FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(argv));
+    int status = ExecuteAndMonitorSystemCommand(argv, {}, false, workingDir);
     if (status) {
       ErrorMessage("Design " + ProjManager()->projectName() +
                    " timing analysis failed");
@@ -3145,11 +3103,12 @@ bool CompilerOpenFPGA::TimingAnalysis() {
         std::filesystem::is_regular_file(netlistFileName) &&
         std::filesystem::is_regular_file(sdfFileName) &&
         std::filesystem::is_regular_file(sdcFileName)) {
-      taCommand = BaseStaCommand() + " " +
-                  BaseStaScript(libFileName.string(), netlistFileName.string(),
-                                sdfFileName.string(), sdcFileName.string());
+      taArgv = ProcessExecutor::SplitCommand(BaseStaCommand());
+      taArgv.push_back(
+          BaseStaScript(libFileName.string(), netlistFileName.string(),
+                        sdfFileName.string(), sdcFileName.string()));
       auto file = std::string(ProjManager()->projectName() + "_sta.cmd");
-      FileUtils::WriteToFile(file, taCommand);
+      FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(taArgv));
     } else {
       auto fileList =
           StringUtils::join({libFileName.string(), netlistFileName.string(),
@@ -3162,12 +3121,14 @@ bool CompilerOpenFPGA::TimingAnalysis() {
       return false;
     }
   } else {  // use vpr/tatum engine
-    taCommand = BaseVprCommand({}) + " --analysis";
+    taArgv = BaseVprArgs({});
+    taArgv.push_back("--analysis");
     auto file = std::string(ProjManager()->projectName() + "_sta.cmd");
-    FileUtils::WriteToFile(file, taCommand + " --disp on");
+    FileUtils::WriteToFile(
+        file, ProcessExecutor::JoinCommand(taArgv) + " --disp on");
   }
 
-  status = ExecuteAndMonitorSystemCommand(taCommand, {}, false, workingDir);
+  status = ExecuteAndMonitorSystemCommand(taArgv, {}, false, workingDir);
   if (status) {
     ErrorMessage("Design " + ProjManager()->projectName() +
                  " timing analysis failed");
@@ -3216,16 +3177,17 @@ bool CompilerOpenFPGA::PowerAnalysis() {
     return true;
   }
 
-  std::string command = BaseVprCommand({}) + " --analysis";
+  auto argv = BaseVprArgs({});
+  argv.push_back("--analysis");
   if (!FileUtils::FileExists(m_vprExecutablePath)) {
     ErrorMessage("Cannot find executable: " + m_vprExecutablePath.string());
     return false;
   }
 
   auto file = ProjManager()->projectName() + "_power.cmd";
-  FileUtils::WriteToFile(file, command);
+  FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(argv));
 
-  int status = ExecuteAndMonitorSystemCommand(command, {}, false,
+  int status = ExecuteAndMonitorSystemCommand(argv, {}, false,
                                               FilePath(Action::Power).string());
   if (status) {
     ErrorMessage("Design " + ProjManager()->projectName() +
@@ -3632,8 +3594,9 @@ bool CompilerOpenFPGA::GenerateBitstream() {
     m_runtime_OpenFpgaBitstreamSettingFile = m_OpenFpgaBitstreamSettingFile;
   }
 
-  std::string command = m_openFpgaExecutablePath.string() + " -batch -f " +
-                        ProjManager()->projectName() + ".openfpga";
+  const std::vector<std::string> argv{
+      m_openFpgaExecutablePath.string(), "-batch", "-f",
+      ProjManager()->projectName() + ".openfpga"};
 
   std::string script = InitOpenFPGAScript();
 
@@ -3663,9 +3626,9 @@ bool CompilerOpenFPGA::GenerateBitstream() {
   }
 
   auto file = ProjManager()->projectName() + "_bitstream.cmd";
-  FileUtils::WriteToFile(file, command);
+  FileUtils::WriteToFile(file, ProcessExecutor::JoinCommand(argv));
   auto workingDir = FilePath(Action::Bitstream);
-  int status = ExecuteAndMonitorSystemCommand(command, {}, false, workingDir);
+  int status = ExecuteAndMonitorSystemCommand(argv, {}, false, workingDir);
   if (status) {
     ErrorMessage("Design " + ProjManager()->projectName() +
                  " bitstream generation failed");
@@ -3909,176 +3872,149 @@ bool CompilerOpenFPGA::LoadDeviceData(
     const std::string& deviceName, const std::filesystem::path& deviceListFile,
     const std::filesystem::path& devicesBase, bool& deviceFound) {
   bool status = true;
-  QFile file(deviceListFile.string().c_str());
-  if (!file.open(QFile::ReadOnly)) {
+  auto deviceList = DeviceCatalog::Instance()->deviceList(deviceListFile);
+  if (deviceList->status == DeviceList::CannotOpen) {
     ErrorMessage("Cannot open device file: " + deviceListFile.string());
     return false;
   }
-
-  QDomDocument doc;
-  if (!doc.setContent(&file)) {
-    file.close();
+  if (deviceList->status == DeviceList::Malformed) {
     ErrorMessage("Incorrect device file: " + deviceListFile.string());
     return false;
   }
-  file.close();
-
-  QDomElement docElement = doc.documentElement();
-  QDomNode node = docElement.firstChild();
-  while (!node.isNull()) {
-    if (node.isElement()) {
-      QDomElement e = node.toElement();
-
-      std::string name = e.attribute("name").toStdString();
-      std::string family = e.attribute("family").toStdString();
-      std::string series = e.attribute("series").toStdString();
-      std::string package = e.attribute("package").toStdString();
-      if (name == deviceName) {
-        setDeviceData({family, series, package});
-        deviceFound = true;
-        BaseDeviceName(deviceName);
-        QDomNodeList list = e.childNodes();
-        for (int i = 0; i < list.count(); i++) {
-          QDomNode n = list.at(i);
-          if (!n.isNull() && n.isElement()) {
-            if (n.nodeName() == "internal") {
-              std::string file_type =
-                  n.toElement().attribute("type").toStdString();
-              std::string file = n.toElement().attribute("file").toStdString();
-              std::string name = n.toElement().attribute("name").toStdString();
-              std::string num = n.toElement().attribute("num").toStdString();
-              std::filesystem::path fullPath;
-              if (!file.empty()) {
-                if (FileUtils::FileExists(file)) {
-                  fullPath = file;  // Absolute path
-                } else {
-                  fullPath = devicesBase / file;
-                }
-                if (!FileUtils::FileExists(fullPath.string())) {
-                  ErrorMessage("Invalid device config file: " +
-                               fullPath.string() + "\n");
-                  status = false;
-                }
-              }
-              if (file_type == "vpr_arch") {
-                ArchitectureFile(fullPath.string());
-              } else if (file_type == "openfpga_arch") {
-                OpenFpgaArchitectureFile(fullPath.string());
-              } else if (file_type == "bitstream_settings") {
-                OpenFpgaBitstreamSettingFile(fullPath.string());
-              } else if (file_type == "routing_graph") {
-                RoutingGraphFile(fullPath.string());
-              } else if (file_type == "sim_settings") {
-                OpenFpgaSimSettingFile(fullPath.string());
-              } else if (file_type == "repack_settings") {
-                OpenFpgaRepackConstraintsFile(fullPath.string());
-              } else if (file_type == "fabric_key") {
-                OpenFpgaFabricKeyFile(fullPath.string());
-              } else if (file_type == "pinmap_xml") {
-                OpenFpgaPinmapXMLFile(fullPath.string());
-              } else if (file_type == "pcf_xml") {
-                OpenFpgaPinConstraintFile(fullPath.string());
-              } else if (file_type == "ric_model_dir") {
-                OpenFpgaRICModelDir(fullPath.string());
-              } else if (file_type == "pb_pin_fixup") {
-                PbPinFixup(name);
-              } else if (file_type == "pinmap_csv") {
-                PinmapCSVFile(fullPath);
-              } else if (file_type == "plugin_lib") {
-                YosysPluginLibName(name);
-              } else if (file_type == "plugin_func") {
-                YosysPluginName(name);
-              } else if (file_type == "technology") {
-                YosysMapTechnology(name);
-              } else if (file_type == "tag_version") {
-                DeviceTagVersion(name);
-              } else if (file_type == "synth_type") {
-                if (name == "QL")
-                  SynthType(SynthesisType::QL);
-                else if (name == "RS")
-                  SynthType(SynthesisType::RS);
-                else if (name == "Yosys")
-                  SynthType(SynthesisType::Yosys);
-                else {
-                  ErrorMessage("Invalid synthesis type: " + name + "\n");
-                  status = false;
-                }
-              } else if (file_type == "synth_opts") {
-                PerDeviceSynthOptions(name);
-              } else if (file_type == "vpr_opts") {
-                PerDevicePnROptions(name);
-              } else if (file_type == "device_size") {
-                DeviceSize(name);
-              } else if (file_type == "lut_size") {
-                LutSize(std::strtoul(num.c_str(), nullptr, 10));
-              } else if (file_type == "channel_width") {
-                ChannelWidth(std::strtoul(num.c_str(), nullptr, 10));
-              } else if (file_type == "bitstream_enabled") {
-                if (num == "true") {
-                  BitstreamEnabled(true);
-                } else if (num == "false") {
-                  BitstreamEnabled(false);
-                } else {
-                  ErrorMessage("Invalid bitstream_enabled num (true, false): " +
-                               num + "\n");
-                  status = false;
-                }
-              } else if (file_type == "pin_constraint_enabled") {
-                if (num == "true") {
-                  PinConstraintEnabled(true);
-                } else if (num == "false") {
-                  PinConstraintEnabled(false);
-                } else {
-                  ErrorMessage(
-                      "Invalid pin_constraint_enabled num (true, false): " +
-                      num + "\n");
-                  status = false;
-                }
-              } else if (file_type == "flat_routing") {
-                if (num == "true") {
-                  FlatRouting(true);
-                } else if (num == "false") {
-                  FlatRouting(false);
-                } else {
-                  ErrorMessage(
-                      "Invalid flat_routing num (true, false): " + num + "\n");
-                  status = false;
-                }
-              } else if (file_type == "base_device") {
-                BaseDeviceName(name);
-                // field is used for identify base for custom device
-                // no action so far
-              } else {
-                ErrorMessage("Invalid device config type: " + file_type + "\n");
-                status = false;
-              }
-            } else if (n.nodeName() == "resource") {
-              std::string file_type =
-                  n.toElement().attribute("type").toStdString();
-              std::string num = n.toElement().attribute("num").toStdString();
-              if (file_type == "dsp") {
-                MaxDeviceDSPCount(std::strtoul(num.c_str(), nullptr, 10));
-                MaxUserDSPCount(MaxDeviceDSPCount());
-              } else if (file_type == "bram") {
-                MaxDeviceBRAMCount(std::strtoul(num.c_str(), nullptr, 10));
-                MaxUserBRAMCount(MaxDeviceBRAMCount());
-              } else if (file_type == "carry_length") {
-                MaxDeviceCarryLength(std::strtoul(num.c_str(), nullptr, 10));
-                MaxUserCarryLength(MaxDeviceCarryLength());
-              } else if (file_type == "lut") {
-                MaxDeviceLUTCount(std::strtoul(num.c_str(), nullptr, 10));
-              } else if (file_type == "ff") {
-                MaxDeviceFFCount(std::strtoul(num.c_str(), nullptr, 10));
-              } else if (file_type == "io") {
-                MaxDeviceIOCount(std::strtoul(num.c_str(), nullptr, 10));
-              }
-            }
-          }
+
+  for (const DeviceEntry* device :
+       deviceList->find(QString::fromStdString(deviceName))) {
+    setDeviceData({device->family.toStdString(), device->series.toStdString(),
+                   device->package.toStdString()});
+    deviceFound = true;
+    BaseDeviceName(deviceName);
+    for (const auto& internal : device->internals) {
+      std::string file_type = internal.type.toStdString();
+      std::string file = internal.file.toStdString();
+      std::string name = internal.name.toStdString();
+      std::string num = internal.num.toStdString();
+      std::filesystem::path fullPath;
+      if (!file.empty()) {
+        bool exists{false};
+        fullPath =
+            DeviceCatalog::Instance()->resolve(devicesBase, file, exists);
+        if (!exists) {
+          ErrorMessage("Invalid device config file: " + fullPath.string() +
+                       "\n");
+          status = false;
+        }
+      }
+      if (file_type == "vpr_arch") {
+        ArchitectureFile(fullPath.string());
+      } else if (file_type == "openfpga_arch") {
+        OpenFpgaArchitectureFile(fullPath.string());
+      } else if (file_type == "bitstream_settings") {
+        OpenFpgaBitstreamSettingFile(fullPath.string());
+      } else if (file_type == "routing_graph") {
+        RoutingGraphFile(fullPath.string());
+      } else if (file_type == "sim_settings") {
+        OpenFpgaSimSettingFile(fullPath.string());
+      } else if (file_type == "repack_settings") {
+        OpenFpgaRepackConstraintsFile(fullPath.string());
+      } else if (file_type == "fabric_key") {
+        OpenFpgaFabricKeyFile(fullPath.string());
+      } else if (file_type == "pinmap_xml") {
+        OpenFpgaPinmapXMLFile(fullPath.string());
+      } else if (file_type == "pcf_xml") {
+        OpenFpgaPinConstraintFile(fullPath.string());
+      } else if (file_type == "ric_model_dir") {
+        OpenFpgaRICModelDir(fullPath.string());
+      } else if (file_type == "pb_pin_fixup") {
+        PbPinFixup(name);
+      } else if (file_type == "pinmap_csv") {
+        PinmapCSVFile(fullPath);
+      } else if (file_type == "plugin_lib") {
+        YosysPluginLibName(name);
+      } else if (file_type == "plugin_func") {
+        YosysPluginName(name);
+      } else if (file_type == "technology") {
+        YosysMapTechnology(name);
+      } else if (file_type == "tag_version") {
+        DeviceTagVersion(name);
+      } else if (file_type == "synth_type") {
+        if (name == "QL")
+          SynthType(SynthesisType::QL);
+        else if (name == "RS")
+          SynthType(SynthesisType::RS);
+        else if (name == "Yosys")
+          SynthType(SynthesisType::Yosys);
+        else {
+          ErrorMessage("Invalid synthesis type: " + name + "\n");
+          status = false;
+        }
+      } else if (file_type == "synth_opts") {
+        PerDeviceSynthOptions(name);
+      } else if (file_type == "vpr_opts") {
+        PerDevicePnROptions(name);
+      } else if (file_type == "device_size") {
+        DeviceSize(name);
+      } else if (file_type == "lut_size") {
+        LutSize(std::strtoul(num.c_str(), nullptr, 10));
+      } else if (file_type == "channel_width") {
+        ChannelWidth(std::strtoul(num.c_str(), nullptr, 10));
+      } else if (file_type == "bitstream_enabled") {
+        if (num == "true") {
+          BitstreamEnabled(true);
+        } else if (num == "false") {
+          BitstreamEnabled(false);
+        } else {
+          ErrorMessage("Invalid bitstream_enabled num (true, false): " + num +
+                       "\n");
+          status = false;
+        }
+      } else if (file_type == "pin_constraint_enabled") {
+        if (num == "true") {
+          PinConstraintEnabled(true);
+        } else if (num == "false") {
+          PinConstraintEnabled(false);
+        } else {
+          ErrorMessage("Invalid pin_constraint_enabled num (true, false): " +
+                       num + "\n");
+          status = false;
         }
+      } else if (file_type == "flat_routing") {
+        if (num == "true") {
+          FlatRouting(true);
+        } else if (num == "false") {
+          FlatRouting(false);
+        } else {
+          ErrorMessage("Invalid flat_routing num (true, false): " + num + "\n");
+          status = false;
+        }
+      } else if (file_type == "base_device") {
+        BaseDeviceName(name);
+        // field is used for identify base for custom device
+        // no action so far
+      } else {
+        ErrorMessage("Invalid device config type: " + file_type + "\n");
+        status = false;
+      }
+    }
+    for (const auto& resource : device->resources) {
+      std::string file_type = resource.type.toStdString();
+      std::string num = resource.num.toStdString();
+      if (file_type == "dsp") {
+        MaxDeviceDSPCount(std::strtoul(num.c_str(), nullptr, 10));
+        MaxUserDSPCount(MaxDeviceDSPCount());
+      } else if (file_type == "bram") {
+        MaxDeviceBRAMCount(std::strtoul(num.c_str(), nullptr, 10));
+        MaxUserBRAMCount(MaxDeviceBRAMCount());
+      } else if (file_type == "carry_length") {
+        MaxDeviceCarryLength(std::strtoul(num.c_str(), nullptr, 10));
+        MaxUserCarryLength(MaxDeviceCarryLength());
+      } else if (file_type == "lut") {
+        MaxDeviceLUTCount(std::strtoul(num.c_str(), nullptr, 10));
+      } else if (file_type == "ff") {
+        MaxDeviceFFCount(std::strtoul(num.c_str(), nullptr, 10));
+      } else if (file_type == "io") {
+        MaxDeviceIOCount(std::strtoul(num.c_str(), nullptr, 10));
       }
     }
-
-    node = node.nextSibling();
   }
   if (!deviceFound) {
     status = false;
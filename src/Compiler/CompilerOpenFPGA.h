@@ -155,6 +155,7 @@ class CompilerOpenFPGA : public Compiler {
   virtual bool GlobalPlacement();
   virtual bool Placement();
   virtual bool ConvertSdcPinConstrainToPcf(std::vector<std::string>&);
+  virtual bool ReadConstraints();
   virtual bool WriteTimingConstraints();
   virtual bool Route();
   virtual bool TimingAnalysis();
@@ -242,6 +243,7 @@ class CompilerOpenFPGA : public Compiler {
     bool gen_post_synthesis_netlist{true};
   };
   virtual std::string BaseVprCommand(BaseVprDefaults defaults);
+  virtual std::vector<std::string> BaseVprArgs(BaseVprDefaults defaults);
   virtual std::string BaseStaCommand();
   virtual std::string BaseStaScript(std::string libFileName,
                                     std::string netlistFileName,
@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Compiler/Constraints.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "Compiler/Compiler.h"
 #include "Configuration/CFGCommon/CFGCommon.h"
 #include "DesignQuery/DesignQuery.h"
@@ -36,7 +39,9 @@ Constraints::Constraints(Compiler* compiler) : m_compiler(compiler) {
   registerCommands(m_interp);
 }
 
-Constraints::~Constraints() {}
+Constraints::~Constraints() {
+  if (m_sdcInterp) Tcl_DeleteInterp(m_sdcInterp);
+}
 
 bool Constraints::evaluateConstraints(const std::filesystem::path& path) {
   m_interp->evalFile(path.string());
@@ -72,6 +77,51 @@ void Constraints::reset() {
   m_clockDerivedFromMap.clear();
   m_clockPeriodMap.clear();
   m_gbox2mode.clear();
+  // procs and variables of the SDC files read so far are dropped, the next
+  // read_sdc creates a new interpreter. An SDC file calling clear_property
+  // is still running in it, it is deleted at the next read_sdc.
+  if (m_sdcInterp) {
+    if (Tcl_InterpActive(m_sdcInterp))
+      m_sdcInterpStale = true;
+    else
+      Tcl_DeleteInterp(m_sdcInterp);
+  }
+  m_revision++;
+}
+
+const std::vector<SdcCommand>& Constraints::getCommands() {
+  if (m_commandsRevision == m_revision) return m_commands;
+  m_commands.clear();
+  m_commands.reserve(m_constraints.size());
+  for (const auto& constraint : m_constraints) {
+    SdcCommand command;
+    command.text = UnmangleName(constraint);
+    StringUtils::tokenize(command.text, " ", command.words);
+    const std::string name = command.words.empty() ? "" : command.words[0];
+    if (name == "set_pin_loc") {
+      command.kind = SdcCommand::Kind::PinLocation;
+    } else if (name == "set_mode") {
+      command.kind = SdcCommand::Kind::Mode;
+    } else if (name == "set_property") {
+      command.kind = command.text.find(" mode ") != std::string::npos
+                         ? SdcCommand::Kind::ModeProperty
+                         : SdcCommand::Kind::Property;
+    } else if (name == "set_clock_pin") {
+      command.kind = SdcCommand::Kind::ClockPin;
+    }
+    m_commands.push_back(std::move(command));
+  }
+  m_commandsRevision = m_revision;
+  return m_commands;
+}
+
+std::string Constraints::SourceKey() const {
+  return m_sourceRevision == m_revision ? m_sourceKey : std::string{};
+}
+
+void Constraints::SetSourceKey(const std::string& key) {
+  m_sourceKey = key;
+  m_sourceRevision = m_revision;
 }
 
 const std::string Constraints::UnmangleName(const std::string& name) {
@@ -83,11 +133,14 @@ const std::string Constraints::UnmangleName(const std::string& name) {
 }
 
 std::string Constraints::getConstraint(uint64_t argc, const char* argv[]) {
+  NetlistEditData* netlist_data = GetCompiler()->getNetlistEditData();
+  size_t size{0};
+  for (uint64_t i = 0; i < argc; i++) size += ::strlen(argv[i]) + 1;
   std::string command;
+  command.reserve(size);
   for (uint64_t i = 0; i < argc; i++) {
-    command += std::string(
-                   GetCompiler()->getNetlistEditData()->PIO2InnerNet(argv[i])) +
-               " ";
+    command += netlist_data->PIO2InnerNet(argv[i]);
+    command += ' ';
   }
   return command;
 }
@@ -280,74 +333,151 @@ const std::string Constraints::ExpandGetPorts(const std::string& name) {
   return name;
 }
 
+// Records an SDC command and the names it references. Arguments are compared
+// in place, names are only copied when they are kept.
+int Constraints::harvestNames(Tcl_Interp* interp, int argc,
+                              const char* argv[]) {
+  static const std::set<std::string_view> name_options{
+      "-clock",     "-name",      "-from",      "-to",       "-through",
+      "-fall_to",   "-rise_to",   "-rise_from", "-fall_from"};
+  NetlistEditData* netlist_data = GetCompiler()->getNetlistEditData();
+  addConstraint(getConstraint(argc, argv));
+  for (int i = 0; i < argc; i++) {
+    const std::string_view arg{argv[i]};
+    if (name_options.find(arg) == name_options.end() || i + 1 >= argc)
+      continue;
+    const std::string name = argv[++i];
+    if (arg == "-clock" &&
+        GetCompiler()->CompilerState() == Compiler::State::Synthesized) {
+      const std::string fabric_name = netlist_data->PIO2InnerNet(name);
+      const std::set<std::string>& fabric_clocks =
+          netlist_data->getFabricClocks();
+      const std::set<std::string>& virtual_clocks = VirtualClocks();
+      if ((fabric_clocks.find(fabric_name) == fabric_clocks.end()) &&
+          (virtual_clocks.find(name) == virtual_clocks.end())) {
+        std::string message =
+            "ERROR: " + std::string(argv[0]) + ": -clock " + name +
+            " is not a core fabric clock, only core fabric clocks can be "
+            "referenced in timing constraints.";
+        const std::set<std::string>& primary_clocks =
+            netlist_data->getPrimaryClocks();
+        const std::set<std::string>& generated_clocks =
+            netlist_data->getGeneratedClocks();
+        const std::set<std::string> all_clocks = netlist_data->getAllClocks();
+        if (primary_clocks.find(name) != primary_clocks.end()) {
+          message += "\n       " + name +
+                     " is a primary clock declared/used in the Periphery "
+                     "sub-system.";
+        }
+        if (generated_clocks.find(name) != generated_clocks.end()) {
+          message += "\n       " + name +
+                     " is a generated clock declared/used in the Periphery "
+                     "sub-system.";
+        }
+        if (all_clocks.find(name) == all_clocks.end()) {
+          message += "\n       " + name + " is not a design clock.";
+        }
+        Tcl_AppendResult(interp, message.c_str(), nullptr);
+        return TCL_ERROR;
+      }
+    }
+    if (name != "{*}") addKeep(name);
+  }
+  return TCL_OK;
+}
+
+Tcl_Interp* Constraints::sdcInterp(Tcl_Interp* parent) {
+  // read_sdc called from an SDC file
+  if (parent == m_sdcInterp) return parent;
+  if (m_sdcInterp && !Tcl_InterpActive(m_sdcInterp) &&
+      (m_sdcInterpStale || Tcl_GetMaster(m_sdcInterp) != parent)) {
+    Tcl_DeleteInterp(m_sdcInterp);
+  }
+  if (!m_sdcInterp) {
+    const std::string name =
+        "sdc" + std::to_string(reinterpret_cast<uintptr_t>(this));
+    m_sdcInterp = Tcl_CreateSlave(parent, name.c_str(), 0);
+    if (!m_sdcInterp) return parent;
+    // Commands are called directly, without the tracing wrapper of the
+    // main interpreter
+    for (const auto& [cmd, proc] : m_sdcHandlers) {
+      Tcl_CreateCommand(m_sdcInterp, cmd.c_str(), proc, this, nullptr);
+    }
+    // Timing constraints get their arguments as objects, no argv is built
+    auto name_harvesting_sdc_command = [](void* clientData, Tcl_Interp* interp,
+                                          int objc,
+                                          Tcl_Obj* const objv[]) -> int {
+      Constraints* constraints = (Constraints*)clientData;
+      std::vector<const char*>& argv = constraints->m_sdcArgv;
+      argv.resize(objc + 1);
+      for (int i = 0; i < objc; i++) argv[i] = Tcl_GetString(objv[i]);
+      argv[objc] = nullptr;
+      return constraints->harvestNames(interp, objc, argv.data());
+    };
+    for (const auto& proc_name : constraint_procs) {
+      Tcl_CreateObjCommand(m_sdcInterp, proc_name.c_str(),
+                           name_harvesting_sdc_command, this, nullptr);
+    }
+    // Other commands (get_ports, user procs...) are run by the parent
+    auto unknown = [](void* clientData, Tcl_Interp* interp, int objc,
+                      Tcl_Obj* const objv[]) -> int {
+      Tcl_Interp* master = Tcl_GetMaster(interp);
+      if (objc < 2 || !master) return TCL_ERROR;
+      int status = Tcl_EvalObjv(master, objc - 1, objv + 1, TCL_EVAL_GLOBAL);
+      Tcl_TransferResult(master, status, interp);
+      return status;
+    };
+    auto unknown_delete = [](void* clientData) {
+      // the interpreter is being deleted
+      Constraints* constraints = static_cast<Constraints*>(clientData);
+      constraints->m_sdcInterp = nullptr;
+      constraints->m_sdcInterpStale = false;
+    };
+    Tcl_CreateObjCommand(m_sdcInterp, "unknown", unknown, this, unknown_delete);
+  }
+  // Global variables of the parent are visible to SDC files
+  if (Tcl_Eval(parent, "info globals") == TCL_OK) {
+    Tcl_Obj* names = Tcl_GetObjResult(parent);
+    Tcl_IncrRefCount(names);
+    int count{0};
+    Tcl_Obj** elements{nullptr};
+    Tcl_ListObjGetElements(nullptr, names, &count, &elements);
+    for (int i = 0; i < count; i++) {
+      const char* var = Tcl_GetString(elements[i]);
+      if (::strcmp(var, "errorInfo") == 0 || ::strcmp(var, "errorCode") == 0)
+        continue;
+      // arrays are not copied
+      Tcl_Obj* value = Tcl_GetVar2Ex(parent, var, nullptr, TCL_GLOBAL_ONLY);
+      if (value)
+        Tcl_SetVar2Ex(m_sdcInterp, var, nullptr, value, TCL_GLOBAL_ONLY);
+    }
+    Tcl_DecrRefCount(names);
+  }
+  Tcl_ResetResult(parent);
+  return m_sdcInterp;
+}
+
 void Constraints::registerCommands(TclInterpreter* interp) {
   // SDC constraints
   // https://github.com/The-OpenROAD-Project/OpenSTA/blob/master/tcl/Sdc.tcl
   // Register all SDC commands, extract the "keeps"
 
+  // The handlers are kept to register them in the SDC interpreter too
+  auto registerSdcCmd = [this, interp](const std::string& name,
+                                       Tcl_CmdProc* proc) {
+    interp->registerCmd(name, proc, this, 0);
+    m_sdcHandlers[name] = proc;
+  };
+
   // Checks for the sub-syntax supported by VPR
 
   auto name_harvesting_sdc_command = [](void* clientData, Tcl_Interp* interp,
                                         int argc, const char* argv[]) -> int {
     Constraints* constraints = (Constraints*)clientData;
-    const std::string constraint = constraints->getConstraint(argc, argv);
-    NetlistEditData* netlist_data =
-        constraints->GetCompiler()->getNetlistEditData();
-    constraints->addConstraint(constraint);
-    for (int i = 0; i < argc; i++) {
-      std::string arg = argv[i];
-      if (arg == "-clock") {
-        std::string name = argv[i + 1];
-        std::string fabric_name = netlist_data->PIO2InnerNet(name);
-        if (constraints->GetCompiler()->CompilerState() ==
-            Compiler::State::Synthesized) {
-          const std::set<std::string>& fabric_clocks =
-              netlist_data->getFabricClocks();
-          const std::set<std::string>& virtual_clocks =
-              constraints->VirtualClocks();
-          if ((fabric_clocks.find(fabric_name) == fabric_clocks.end()) &&
-              (virtual_clocks.find(name) == virtual_clocks.end())) {
-            std::string message =
-                "ERROR: " + std::string(argv[0]) + ": -clock " + name +
-                " is not a core fabric clock, only core fabric clocks can be "
-                "referenced in timing constraints.";
-            const std::set<std::string>& primary_clocks =
-                netlist_data->getPrimaryClocks();
-            const std::set<std::string>& generated_clocks =
-                netlist_data->getGeneratedClocks();
-            const std::set<std::string> all_clocks =
-                netlist_data->getAllClocks();
-            if (primary_clocks.find(name) != primary_clocks.end()) {
-              message += "\n       " + name +
-                         " is a primary clock declared/used in the Periphery "
-                         "sub-system.";
-            }
-            if (generated_clocks.find(name) != generated_clocks.end()) {
-              message += "\n       " + name +
-                         " is a generated clock declared/used in the Periphery "
-                         "sub-system.";
-            }
-            if (all_clocks.find(name) == all_clocks.end()) {
-              message += "\n       " + name + " is not a design clock.";
-            }
-            Tcl_AppendResult(interp, message.c_str(), nullptr);
-            return TCL_ERROR;
-          }
-        }
-      }
-
-      if (arg == "-clock" || arg == "-name" || arg == "-from" || arg == "-to" ||
-          arg == "-through" || arg == "-fall_to" || arg == "-rise_to" ||
-          arg == "-rise_from" || arg == "-fall_from") {
-        i++;
-        arg = argv[i];
-        if (arg != "{*}") constraints->addKeep(arg);
-      }
-    }
-    return TCL_OK;
+    return constraints->harvestNames(interp, argc, argv);
   };
   for (auto proc_name : constraint_procs) {
-    interp->registerCmd(proc_name, name_harvesting_sdc_command, this, 0);
+    registerSdcCmd(proc_name, name_harvesting_sdc_command);
   }
 
   auto create_generated_clock = [](void* clientData, Tcl_Interp* interp,
@@ -572,8 +702,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
       constraints->addConstraint(constraint);
     return TCL_OK;
   };
-  interp->registerCmd("create_generated_clock", create_generated_clock, this,
-                      0);
+  registerSdcCmd("create_generated_clock", create_generated_clock);
 
   auto create_clock = [](void* clientData, Tcl_Interp* interp, int argc,
                          const char* argv[]) -> int {
@@ -811,7 +940,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
       constraints->addConstraint(constraint);
     return TCL_OK;
   };
-  interp->registerCmd("create_clock", create_clock, this, 0);
+  registerSdcCmd("create_clock", create_clock);
 
   auto set_clock_groups = [](void* clientData, Tcl_Interp* interp, int argc,
                              const char* argv[]) -> int {
@@ -853,7 +982,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     constraints->addConstraint(constraint);
     return TCL_OK;
   };
-  interp->registerCmd("set_clock_groups", set_clock_groups, this, 0);
+  registerSdcCmd("set_clock_groups", set_clock_groups);
 
   auto getter_sdc_command = [](void* clientData, Tcl_Interp* interp, int argc,
                                const char* argv[]) -> int {
@@ -877,10 +1006,10 @@ void Constraints::registerCommands(TclInterpreter* interp) {
 
   // get_ports is already defined in DesignQuery
   // TODO: All of the below commands needs to be defined in DesignQuery too.
-  interp->registerCmd("get_clocks", getter_sdc_command, this, 0);
-  interp->registerCmd("get_nets", getter_sdc_command, this, 0);
-  interp->registerCmd("get_pins", getter_sdc_command, this, 0);
-  interp->registerCmd("get_cells", getter_sdc_command, this, 0);
+  registerSdcCmd("get_clocks", getter_sdc_command);
+  registerSdcCmd("get_nets", getter_sdc_command);
+  registerSdcCmd("get_pins", getter_sdc_command);
+  registerSdcCmd("get_cells", getter_sdc_command);
 
   // Physical constraints
   auto pin_loc = [](void* clientData, Tcl_Interp* interp, int argc,
@@ -927,7 +1056,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     }
     return TCL_OK;
   };
-  interp->registerCmd("set_pin_loc", pin_loc, this, 0);
+  registerSdcCmd("set_pin_loc", pin_loc);
 
   auto set_mode = [](void* clientData, Tcl_Interp* interp, int argc,
                      const char* argv[]) -> int {
@@ -946,7 +1075,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     }
     return TCL_OK;
   };
-  interp->registerCmd("set_mode", set_mode, this, 0);
+  registerSdcCmd("set_mode", set_mode);
 
   auto set_property = [](void* clientData, Tcl_Interp* interp, int argc,
                          const char* argv[]) -> int {
@@ -1018,7 +1147,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     constraints->set_property(objects, properties);
     return TCL_OK;
   };
-  interp->registerCmd("set_property", set_property, this, 0);
+  registerSdcCmd("set_property", set_property);
 
   auto clear_property = [](void* clientData, Tcl_Interp* interp, int argc,
                            const char* argv[]) -> int {
@@ -1026,7 +1155,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     constraints->clear_property();
     return TCL_OK;
   };
-  interp->registerCmd("clear_property", clear_property, this, 0);
+  registerSdcCmd("clear_property", clear_property);
 
   auto write_property = [](void* clientData, Tcl_Interp* interp, int argc,
                            const char* argv[]) -> int {
@@ -1041,7 +1170,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     constraints->write_property(argv[1]);
     return TCL_OK;
   };
-  interp->registerCmd("write_property", write_property, this, 0);
+  registerSdcCmd("write_property", write_property);
 
   auto write_simplified_property = [](void* clientData, Tcl_Interp* interp,
                                       int argc, const char* argv[]) -> int {
@@ -1057,8 +1186,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     constraints->write_simplified_property(argv[1]);
     return TCL_OK;
   };
-  interp->registerCmd("write_simplified_property", write_simplified_property,
-                      this, 0);
+  registerSdcCmd("write_simplified_property", write_simplified_property);
 
   auto set_clock_pin = [](void* clientData, Tcl_Interp* interp, int argc,
                           const char* argv[]) -> int {
@@ -1097,7 +1225,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     constraints->addConstraint(constraint);
     return TCL_OK;
   };
-  interp->registerCmd("set_clock_pin", set_clock_pin, this, 0);
+  registerSdcCmd("set_clock_pin", set_clock_pin);
 
   auto script_path = [](void* clientData, Tcl_Interp* interp, int argc,
                         const char* argv[]) -> int {
@@ -1109,7 +1237,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     Tcl_SetResult(interp, (char*)scriptPath.c_str(), TCL_VOLATILE);
     return TCL_OK;
   };
-  interp->registerCmd("script_path", script_path, this, 0);
+  registerSdcCmd("script_path", script_path);
 
   auto region_loc = [](void* clientData, Tcl_Interp* interp, int argc,
                        const char* argv[]) -> int {
@@ -1128,7 +1256,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     }
     return TCL_OK;
   };
-  interp->registerCmd("set_region_loc", region_loc, this, 0);
+  registerSdcCmd("set_region_loc", region_loc);
 
   auto read_sdc = [](void* clientData, Tcl_Interp* interp, int argc,
                      const char* argv[]) -> int {
@@ -1150,54 +1278,72 @@ void Constraints::registerCommands(TclInterpreter* interp) {
           (char*)NULL);
       return TCL_ERROR;
     }
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    stream.close();
+    const std::string content = buffer.str();
+    size_t pos{0};
+    auto get = [&content, &pos]() -> int {
+      return (pos < content.size()) ? (unsigned char)content[pos++] : EOF;
+    };
     std::string text;
-    char c = stream.get();
-    while (stream.good()) {
-      text += c;
-      c = stream.get();
+    text.reserve(content.size());
+    int c = get();
+    while (c != EOF) {
+      text += static_cast<char>(c);
+      c = get();
       if (c == '[') {
-        c = stream.get();
+        c = get();
         if (isdigit(c)) {
           text += "@";
-          while (c != ']') {
-            text += c;
-            c = stream.get();
+          while (c != ']' && c != EOF) {
+            text += static_cast<char>(c);
+            c = get();
           }
-          c = stream.get();
+          c = get();
           text += "%";
         } else {
           text += '[';
         }
       }
     }
-    stream.close();
     text = StringUtils::replaceAll(text, "[*]", "@*@");
     text = StringUtils::replaceAll(text, "{*}", "@*@");
+    // One constraint per line at most
+    if (constr) {
+      constr->m_constraints.reserve(constr->m_constraints.size() +
+                                    std::count(text.begin(), text.end(), '\n') +
+                                    1);
+    }
+    Tcl_Interp* sdc = constr ? constr->sdcInterp(interp) : interp;
     if (designQuery) designQuery->SetReadSdc(true);
-    int status = Tcl_Eval(interp, text.c_str());
+    int status = Tcl_Eval(sdc, text.c_str());
     if (designQuery) designQuery->SetReadSdc(false);
     if (status) {
-      Tcl_Obj* errorDict = Tcl_GetReturnOptions(interp, status);
+      Tcl_Obj* errorDict = Tcl_GetReturnOptions(sdc, status);
       Tcl_Obj* errorInfo = Tcl_NewStringObj("-errorinfo", -1);
       Tcl_Obj* errorMsg;
       Tcl_IncrRefCount(errorDict);
-      Tcl_DictObjGet(interp, errorDict, errorInfo, &errorMsg);
+      Tcl_DictObjGet(sdc, errorDict, errorInfo, &errorMsg);
+      std::string msgString = Tcl_GetString(errorMsg);  // Get stackTrace
       Tcl_DecrRefCount(errorDict);
-      char* msgString = Tcl_GetString(errorMsg);  // Get stackTrace
       Tcl_DecrRefCount(errorInfo);
+      const int errorLine = Tcl_GetErrorLine(sdc);
+      Tcl_ResetResult(sdc);
       Tcl_ResetResult(interp);
       Tcl_AppendResult(
           interp,
           strdup((std::string("SDC file syntax error ") + fileName + ":" +
-                  std::to_string(Tcl_GetErrorLine(interp)))
+                  std::to_string(errorLine))
                      .c_str()),
-          "\n", msgString, (char*)NULL);
+          "\n", msgString.c_str(), (char*)NULL);
       return TCL_ERROR;
     }
+    if (sdc != interp) Tcl_TransferResult(sdc, status, interp);
     return TCL_OK;
   };
 
-  interp->registerCmd("read_sdc", read_sdc, this, 0);
+  registerSdcCmd("read_sdc", read_sdc);
 
   auto write_sdc = [](void* clientData, Tcl_Interp* interp, int argc,
                       const char* argv[]) -> int {
@@ -1224,7 +1370,7 @@ void Constraints::registerCommands(TclInterpreter* interp) {
     stream.close();
     return TCL_OK;
   };
-  interp->registerCmd("write_sdc", write_sdc, this, 0);
+  registerSdcCmd("write_sdc", write_sdc);
 }
 
 bool Constraints::AddVirtualClock(const std::string& vClock) {
@@ -1232,12 +1378,14 @@ bool Constraints::AddVirtualClock(const std::string& vClock) {
   if (it != m_virtualClocks.end()) return false;
   if (m_virtualClocks.size() == 1) return false;
   m_virtualClocks.insert(vClock);
+  m_revision++;
   return true;
 }
 
 void Constraints::set_property(std::vector<std::string> objects,
                                std::vector<PROPERTY> properties) {
   m_object_properties.push_back(OBJECT_PROPERTY(objects, properties));
+  m_revision++;
 }
 
 void Constraints::clear_property() { reset(); }
@@ -55,6 +55,22 @@ struct OBJECT_PROPERTY {
   const std::vector<PROPERTY> properties;
 };
 
+/* Stored constraint parsed once for the flow stages: unmangled, split into
+ * words and classified by what the stages do with it */
+struct SdcCommand {
+  enum class Kind {
+    Timing,        // passed to VPR
+    PinLocation,   // set_pin_loc
+    Mode,          // set_mode
+    ModeProperty,  // set_property mode
+    Property,      // other set_property
+    ClockPin       // set_clock_pin
+  };
+  Kind kind{Kind::Timing};
+  std::string text;                // unmangled constraint
+  std::vector<std::string> words;  // text split on spaces, command first
+};
+
 class Constraints {
  public:
   Constraints(Compiler* compiler);
@@ -70,8 +86,23 @@ class Constraints {
   const std::vector<std::string>& getConstraints() { return m_constraints; }
   const std::set<std::string>& GetKeeps() { return m_keeps; }
   void registerCommands(TclInterpreter* interp);
-  void addKeep(const std::string& name) { m_keeps.insert(name); }
-  void addConstraint(const std::string& name) { m_constraints.push_back(name); }
+  // Interpreter read_sdc evaluates SDC files in: a child of \a parent holding
+  // only the SDC commands, any other command is run by the parent
+  Tcl_Interp* sdcInterp(Tcl_Interp* parent);
+  void addKeep(const std::string& name) {
+    m_keeps.insert(name);
+    m_revision++;
+  }
+  void addConstraint(const std::string& name) {
+    m_constraints.push_back(name);
+    m_revision++;
+  }
+  // Parsed constraints, rebuilt only after the constraints change
+  const std::vector<SdcCommand>& getCommands();
+  // Identifies the sources the constraints were read from. Empty after
+  // reset() and after any change made after SetSourceKey().
+  std::string SourceKey() const;
+  void SetSourceKey(const std::string& key);
   Compiler* GetCompiler() { return m_compiler; }
 
   const std::set<std::string>& VirtualClocks() const {
@@ -107,6 +138,7 @@ class Constraints {
 
  protected:
   std::string getConstraint(uint64_t argc, const char* argv[]);
+  int harvestNames(Tcl_Interp* interp, int argc, const char* argv[]);
   Compiler* m_compiler = nullptr;
   std::ostream* m_out = &std::cout;
   TclInterpreter* m_interp = nullptr;
@@ -119,6 +151,15 @@ class Constraints {
   std::vector<OBJECT_PROPERTY> m_object_properties;
   ConstraintPolicy m_constraintPolicy = ConstraintPolicy::SDCCompatible;
   std::map<std::string, std::string> m_gbox2mode;
+  uint64_t m_revision{1};  // incremented on every change
+  std::vector<SdcCommand> m_commands;
+  uint64_t m_commandsRevision{0};
+  std::string m_sourceKey;
+  uint64_t m_sourceRevision{0};
+  std::map<std::string, Tcl_CmdProc*> m_sdcHandlers;
+  Tcl_Interp* m_sdcInterp = nullptr;
+  bool m_sdcInterpStale{false};  // reset while an SDC file was running
+  std::vector<const char*> m_sdcArgv;
 };
 
 }  // namespace FOEDAG
@@ -34,6 +34,14 @@ NetlistEditData::NetlistEditData() {}
 
 NetlistEditData::~NetlistEditData() {}
 
+// Identifies a data file by its content, empty if it doesn't exist
+static std::string contentKey(const std::filesystem::path& file) {
+  if (!FileUtils::FileExists(file)) return {};
+  const std::string content = FileUtils::GetFileContent(file);
+  return file.string() + ":" +
+         std::to_string(std::hash<std::string>{}(content)) + "\n";
+}
+
 static void recordGeneratedClock(std::set<std::string>& ports,
                                  nlohmann::json& jsonObject,
                                  const std::string name) {
@@ -73,6 +81,10 @@ static void recordDrivingClock(std::set<std::string>& ports,
 void NetlistEditData::ReadData(std::filesystem::path configJsonFile,
                                std::filesystem::path fabricPortInfo) {
   if (FileUtils::FileExists(configJsonFile)) {
+    // every stage reads the data, parse it again only if it changed
+    const std::string key =
+        contentKey(configJsonFile) + contentKey(fabricPortInfo);
+    if (key == m_dataKey) return;
     ResetData();
     std::ifstream input;
     input.open(configJsonFile.c_str());
@@ -210,6 +222,7 @@ void NetlistEditData::ReadData(std::filesystem::path configJsonFile,
         }
       }
     }
+    m_dataKey = key;
   }
 }
 
@@ -230,6 +243,8 @@ void NetlistEditData::ResetData() {
   m_primary_generated_clocks.clear();
   m_primary_clocks.clear();
   m_fabric_clocks.clear();
+  m_pio2inner_map.clear();
+  m_dataKey.clear();
 }
 
 std::string NetlistEditData::FindAliasInInputOutputMap(
@@ -339,32 +354,19 @@ void NetlistEditData::ComputePrimaryMaps(nlohmann::json& netlist_instances) {
       m_reverse_primary_generated_clocks_map.emplace(pair.second, pair.first);
     }
   }
+  // Inputs take precedence over outputs over generated clocks
+  m_pio2inner_map.clear();
+  for (auto map : {&m_primary_input_map, &m_primary_output_map,
+                   &m_primary_generated_clocks_map}) {
+    for (const auto& [orig, target] : *map) {
+      if (target != orig) m_pio2inner_map.emplace(orig, target);
+    }
+  }
 }
 
 std::string NetlistEditData::PIO2InnerNet(const std::string& orig) {
-  std::string result = orig;
-  {
-    auto itr = m_primary_input_map.find(orig);
-    if (itr != m_primary_input_map.end()) {
-      const std::string& target = (*itr).second;
-      if (target != orig) return target;
-    }
-  }
-  {
-    auto itr = m_primary_output_map.find(orig);
-    if (itr != m_primary_output_map.end()) {
-      const std::string& target = (*itr).second;
-      if (target != orig) return target;
-    }
-  }
-  {
-    auto itr = m_primary_generated_clocks_map.find(orig);
-    if (itr != m_primary_generated_clocks_map.end()) {
-      const std::string& target = (*itr).second;
-      if (target != orig) return target;
-    }
-  }
-  return result;
+  auto itr = m_pio2inner_map.find(orig);
+  return (itr != m_pio2inner_map.end()) ? itr->second : orig;
 }
 
 std::string NetlistEditData::InnerNet2PIO(const std::string& orig) {
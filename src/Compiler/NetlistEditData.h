@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "nlohmann_json/json.hpp"
 
@@ -41,6 +42,8 @@ class NetlistEditData {
   void ReadData(std::filesystem::path configJsonFile,
                 std::filesystem::path fabricPortInfo);
   void ResetData();
+  // Identifies the files the data was read from, empty if none was read
+  const std::string& DataKey() const { return m_dataKey; }
 
   const std::map<std::string, std::string>& getInputOutputMap() const {
     return m_input_output_map;
@@ -105,6 +108,10 @@ class NetlistEditData {
   std::map<std::string, std::string> m_reverse_primary_generated_clocks_map;
   std::set<std::string> m_primary_clocks;
   std::set<std::string> m_fabric_clocks;
+  // Primary input, output and generated clock maps merged for PIO2InnerNet,
+  // only the names that are renamed are kept
+  std::unordered_map<std::string, std::string> m_pio2inner_map;
+  std::string m_dataKey;
 };
 
 }  // namespace FOEDAG
@@ -27,6 +27,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Compiler.h"
 #include "CompilerDefines.h"
 #include "DefaultTaskReport.h"
+#include "Utils/Tracer.h"
 static const QString STATISTIC_SECTION{"Pb types usage..."};
 
 namespace FOEDAG {
@@ -59,6 +60,7 @@ bool BitstreamReportManager::isStatisticalTimingHistogram(const QString &line) {
 void BitstreamReportManager::splitTimingData(const QString &timingStr) {}
 
 void BitstreamReportManager::parseLogFile() {
+  TraceScope trace{"report", "BitstreamReportManager::parseLogFile"};
   auto logFile = createLogFile();
   if (!logFile) return;
 
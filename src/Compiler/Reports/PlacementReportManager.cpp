@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "NewProject/ProjectManager/project.h"
 #include "TableReport.h"
 #include "Utils/FileUtils.h"
+#include "Utils/Tracer.h"
 
 namespace {
 static constexpr const char *RESOURCE_REPORT_NAME{
@@ -127,6 +128,7 @@ std::unique_ptr<ITaskReport> PlacementReportManager::createReport(
 }
 
 void PlacementReportManager::parseLogFile() {
+  TraceScope trace{"report", "PlacementReportManager::parseLogFile"};
   clean();
   auto logFile = createLogFile();
   if (!logFile) return;
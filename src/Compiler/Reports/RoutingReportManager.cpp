@@ -10,6 +10,7 @@
 #include "NewProject/ProjectManager/project.h"
 #include "TableReport.h"
 #include "Utils/FileUtils.h"
+#include "Utils/Tracer.h"
 
 namespace {
 static const QRegularExpression FIND_INIT_ROUTER{
@@ -104,6 +105,7 @@ std::unique_ptr<ITaskReport> RoutingReportManager::createReport(
 }
 
 void RoutingReportManager::parseLogFile() {
+  TraceScope trace{"report", "RoutingReportManager::parseLogFile"};
   clean();
   auto logFile = createLogFile();
   if (!logFile) return;
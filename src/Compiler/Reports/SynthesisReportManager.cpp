@@ -30,6 +30,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "DefaultTaskReport.h"
 #include "TableReport.h"
 #include "Utils/FileUtils.h"
+#include "Utils/Tracer.h"
 
 namespace {
 // Report strings
@@ -197,6 +198,7 @@ std::unique_ptr<ITaskReport> SynthesisReportManager::createReport(
 }
 
 void SynthesisReportManager::parseLogFile() {
+  TraceScope trace{"report", "SynthesisReportManager::parseLogFile"};
   clean();
   auto logFile = createLogFile();
   if (!logFile) return;
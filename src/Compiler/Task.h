@@ -24,6 +24,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QObject>
 #include <QVector>
 
+#include "Utils/ProcessUtils.h"
+
 namespace FOEDAG {
 
 enum class TaskStatus {
@@ -54,6 +56,7 @@ struct CustomData {
 struct ProcessUtilization {
   uint duration{};
   uint utilization{};
+  ProcessStats stats{};
 };
 
 enum SettingType { SYN, IMPL, GEN };
@@ -22,8 +22,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Compiler/WorkerThread.h"
 
 #include <QEventLoop>
+#include <memory>
 
 #include "MainWindow/Session.h"
+#include "Utils/JobPool.h"
 
 using namespace FOEDAG;
 
@@ -39,35 +41,55 @@ WorkerThread::WorkerThread(const std::string& threadName,
   ThreadPool::threads.insert(this);
 }
 
-WorkerThread::~WorkerThread() { delete m_thread; }
+WorkerThread::~WorkerThread() {
+  if (m_result.valid()) m_result.wait();
+}
 
 bool WorkerThread::start() {
-  bool result = true;
   m_compiler->start();
-  QEventLoop* eventLoop{nullptr};
-  const bool processEvents = isGui();
-  if (processEvents) eventLoop = new QEventLoop;
-  m_thread = new std::thread([&, eventLoop] {
-    result = m_compiler->Compile(m_action);
-    if (eventLoop) eventLoop->quit();
-  });
-  if (eventLoop)
-    eventLoop->exec();
-  else
-    m_thread->join();  // batch mode
-  delete eventLoop;
+  const bool result = run([this]() { return m_compiler->Compile(m_action); });
   if (m_postRunTask && result) m_postRunTask(static_cast<int>(m_action));
   m_compiler->finish();
   return result;
 }
 
 bool WorkerThread::stop() {
+  // the running stage sees the stop flag and its tools are terminated
   m_compiler->Stop();
-  delete m_thread;
-  m_thread = nullptr;
   return true;
 }
 
+bool WorkerThread::run(const std::function<bool()>& fn) {
+  QEventLoop* eventLoop{nullptr};
+  const bool processEvents = isGui();
+  if (processEvents) eventLoop = new QEventLoop;
+  // quits the event loop when the pool releases the job, also when a
+  // cancel drops it unrun; queued, so the quit is not lost before exec()
+  auto quitLoop = [eventLoop](void*) {
+    if (eventLoop)
+      QMetaObject::invokeMethod(eventLoop, &QEventLoop::quit,
+                                Qt::QueuedConnection);
+  };
+  std::shared_ptr<void> quit{nullptr, quitLoop};
+  // the compiler token is cancelled by Stop() and by JobPool::cancelAll(),
+  // the tools of the running stage watch the same token
+  m_result = JobPool::global().submit(
+      m_threadName,
+      [fn, quit = std::move(quit)](const CancellationToken& token) {
+        return !token.isCancelled() && fn();
+      },
+      m_compiler->CancelToken());
+  if (eventLoop) eventLoop->exec();
+  bool result{false};
+  try {
+    result = m_result.get();
+  } catch (const JobCancelled&) {
+    result = false;  // stopped before the stage started
+  }
+  delete eventLoop;
+  return result;
+}
+
 bool WorkerThread::isGui() const {
   const bool processEvents = m_compiler->GetSession()->CmdLine()->WithQt() ||
                              m_compiler->GetSession()->CmdLine()->WithQml();
@@ -21,12 +21,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef WORKER_THREAD_H
 #define WORKER_THREAD_H
 
-#include <QEventLoop>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <set>
 #include <string>
-#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -59,36 +59,30 @@ class WorkerThread {
    */
   template <typename Func, typename... Args>
   bool Start(const Func& fn, Args&&... args) {
-    bool result = true;
     m_compiler->start();
-    QEventLoop* eventLoop{nullptr};
-    const bool processEvents = isGui();
-    if (processEvents) eventLoop = new QEventLoop;
-    m_thread =
-        // pack args as tuple for capturing
-        new std::thread([&, args = std::make_tuple(std::forward<Args>(args)...),
-                         eventLoop]() mutable {
+    // pack args as tuple for capturing
+    const bool result =
+        run([fn, args = std::make_tuple(std::forward<Args>(args)...)]() {
           // pass arguments to callback
-          std::apply([&result, fn](auto&&... args) { result = fn(args...); },
-                     std::move(args));
-          if (eventLoop) eventLoop->quit();
+          return std::apply([fn](auto&&... args) { return fn(args...); },
+                            args);
         });
-    if (eventLoop)
-      eventLoop->exec();
-    else
-      m_thread->join();  // batch mode
     m_compiler->finish();
-    delete eventLoop;
     return result;
   }
 
  private:
   bool isGui() const;
+  /*!
+   * \brief run executes \a fn as a job of the global pool and waits for it,
+   * processing GUI events meanwhile.
+   */
+  bool run(const std::function<bool()>& fn);
 
  private:
   std::string m_threadName;
   Compiler::Action m_action = Compiler::Action::NoAction;
-  std::thread* m_thread = nullptr;
+  std::future<bool> m_result{};
   Compiler* m_compiler = nullptr;
   const std::function<void(int)>& m_postRunTask{};
 };
@@ -23,6 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef _WIN32
 #include <Windows.h>
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
@@ -33,10 +36,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <mutex>
 
 static cfg_callback_post_msg_function m_msg_function = nullptr;
 static cfg_callback_post_err_function m_err_function = nullptr;
 static cfg_callback_execute_command m_execute_cmd_function = nullptr;
+static cfg_callback_execute_command_output m_execute_cmd_output_function =
+    nullptr;
+static cfg_callback_trace_function m_trace_function = nullptr;
+static cfg_callback_progress_function m_progress_function = nullptr;
+
+struct CFG_TRACE_SCOPE {
+  CFG_TRACE_SCOPE(const std::string& name) : trace(m_trace_function) {
+    if (trace != nullptr) trace(name, true);
+  }
+  ~CFG_TRACE_SCOPE() {
+    if (trace != nullptr) trace("", false);
+  }
+  const cfg_callback_trace_function trace = nullptr;
+};
 
 class CFG_Exception : public std::exception {
  public:
@@ -161,6 +180,32 @@ void CFG_unset_callback_exec_cmd_function() {
   m_execute_cmd_function = nullptr;
 }
 
+void CFG_set_callback_exec_cmd_output_function(
+    cfg_callback_execute_command_output exec) {
+  m_execute_cmd_output_function = exec;
+}
+
+void CFG_unset_callback_exec_cmd_output_function() {
+  m_execute_cmd_output_function = nullptr;
+}
+
+void CFG_set_callback_trace_function(cfg_callback_trace_function trace) {
+  m_trace_function = trace;
+}
+
+void CFG_unset_callback_trace_function() { m_trace_function = nullptr; }
+
+void CFG_set_callback_progress_function(
+    cfg_callback_progress_function progress) {
+  m_progress_function = progress;
+}
+
+void CFG_unset_callback_progress_function() { m_progress_function = nullptr; }
+
+void CFG_post_progress(const std::string& name, double percent) {
+  if (m_progress_function != nullptr) m_progress_function(name, percent);
+}
+
 void CFG_post_msg(const std::string& message, const std::string pre_msg,
                   const bool new_line) {
   if (m_msg_function != nullptr) {
@@ -511,46 +556,35 @@ int CFG_compiler_execute_cmd(const std::string& command,
 
 int CFG_execute_cmd(const std::string& cmd, std::string& output,
                     std::ostream* outStream, std::atomic<bool>& stopCommand) {
-#ifdef _WIN32
-#define POPEN _popen
-#define PCLOSE _pclose
-#define WEXITSTATUS
-#else
-#define POPEN popen
-#define PCLOSE pclose
-#endif
-
-  FILE* pipe = POPEN(cmd.c_str(), "r");
-  if (pipe == nullptr) {
-    return -1;
-  }
+  return CFG_execute_cmd_with_callback(cmd, output, outStream, std::regex{},
+                                       stopCommand);
+}
 
-  // Read the output of the command and store it in the output string.
-  char buffer[1024];
-  std::string newline;
-  while (fgets(buffer, sizeof(buffer), pipe) != nullptr && !stopCommand) {
-    output += buffer;
-    newline = buffer;
+int CFG_execute_cmd_with_callback(
+    const std::string& cmd, std::string& output, std::ostream* outStream,
+    std::regex patternToMatch, std::atomic<bool>& stopCommand,
+    std::function<void(const std::string&)> progressCallback,
+    std::function<void(const std::string&)> generalCallback) {
+  CFG_TRACE_SCOPE trace(cmd);
+  auto line = [&](const std::string& newline) {
+    output += newline;
+    if (generalCallback != nullptr) {
+      generalCallback(newline);
+    }
 
     if (outStream) {
       *outStream << newline;
     }
 
-    if (stopCommand) {
-      break;
+    std::smatch matches;
+    if (progressCallback &&
+        std::regex_search(newline, matches, patternToMatch)) {
+      progressCallback(matches.str());
     }
+  };
+  if (m_execute_cmd_output_function != nullptr) {
+    return m_execute_cmd_output_function(cmd, stopCommand, line);
   }
-
-  int status = PCLOSE(pipe);
-  int exit_code = WEXITSTATUS(status);
-  return exit_code;
-}
-
-int CFG_execute_cmd_with_callback(
-    const std::string& cmd, std::string& output, std::ostream* outStream,
-    std::regex patternToMatch, std::atomic<bool>& stopCommand,
-    std::function<void(const std::string&)> progressCallback,
-    std::function<void(const std::string&)> generalCallback) {
 #ifdef _WIN32
 #define POPEN _popen
 #define PCLOSE _pclose
@@ -567,27 +601,8 @@ int CFG_execute_cmd_with_callback(
 
   // Read the output of the command and store it in the output string.
   char buffer[1024];
-  std::string newline;
   while (fgets(buffer, sizeof(buffer), pipe) != nullptr && !stopCommand) {
-    output += buffer;
-    newline = buffer;
-    if (generalCallback != nullptr) {
-      generalCallback(newline);
-    }
-
-    if (outStream) {
-      *outStream << newline;
-    }
-
-    if (stopCommand) {
-      break;
-    }
-
-    std::smatch matches;
-    if (progressCallback &&
-        std::regex_search(newline, matches, patternToMatch)) {
-      progressCallback(matches.str());
-    }
+    line(buffer);
   }
 
   int status = PCLOSE(pipe);
@@ -666,9 +681,122 @@ void CFG_write_binary_file(const std::string& filepath, const uint8_t* data,
   file.close();
 }
 
+// Bytes compared per memcmp() call before narrowing a difference down
+static constexpr size_t CFG_COMPARE_BLOCK_SIZE = 4096;
+
+namespace {
+
+// Read-only view of a whole file. The file is memory mapped so comparing
+// images does not copy them; if it can not be mapped it is read instead
+class CFG_MAPPED_FILE {
+ public:
+  explicit CFG_MAPPED_FILE(const std::string& filepath) {
+#ifdef _WIN32
+    m_file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                         nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                         nullptr);
+    LARGE_INTEGER size;
+    if (m_file != INVALID_HANDLE_VALUE && GetFileSizeEx(m_file, &size)) {
+      m_size = (size_t)(size.QuadPart);
+      m_open = m_size == 0;
+      if (m_size) {
+        m_mapping =
+            CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping != nullptr) {
+          m_data = (const uint8_t*)(MapViewOfFile(m_mapping, FILE_MAP_READ,
+                                                  0, 0, 0));
+          m_open = m_data != nullptr;
+        }
+      }
+    }
+#else
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      struct stat st;
+      if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        m_size = (size_t)(st.st_size);
+        m_open = m_size == 0;
+        if (m_size) {
+          void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (data != MAP_FAILED) {
+            madvise(data, m_size, MADV_SEQUENTIAL);
+            m_data = (const uint8_t*)(data);
+            m_open = true;
+          }
+        }
+      }
+      close(fd);
+    }
+#endif
+    if (!m_open) {
+      unmap();
+      std::ifstream file(filepath.c_str(), std::ios::in | std::ios::binary);
+      if (file.is_open()) {
+        m_buffer.assign(std::istreambuf_iterator<char>(file),
+                        std::istreambuf_iterator<char>());
+        m_data = m_buffer.size() ? (const uint8_t*)(&m_buffer[0]) : nullptr;
+        m_size = m_buffer.size();
+        m_open = true;
+      }
+    }
+  }
+  ~CFG_MAPPED_FILE() { unmap(); }
+  CFG_MAPPED_FILE(const CFG_MAPPED_FILE&) = delete;
+  CFG_MAPPED_FILE& operator=(const CFG_MAPPED_FILE&) = delete;
+  bool is_open() const { return m_open; }
+  const uint8_t* data() const { return m_data; }
+  size_t size() const { return m_size; }
+
+ private:
+  void unmap() {
+#ifdef _WIN32
+    if (m_data != nullptr) {
+      UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr) {
+      CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+      CloseHandle(m_file);
+    }
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if (m_data != nullptr && m_buffer.empty()) {
+      munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+  }
+#ifdef _WIN32
+  HANDLE m_file = INVALID_HANDLE_VALUE;
+  HANDLE m_mapping = nullptr;
+#endif
+  std::vector<char> m_buffer;
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+  bool m_open = false;
+};
+
+}  // namespace
+
 bool CFG_compare_two_text_files(const std::string& filepath1,
                                 const std::string& filepath2,
                                 bool debug_if_diff) {
+  {
+    // Identical images are the common case, they need no line splitting
+    CFG_MAPPED_FILE file1(filepath1);
+    CFG_MAPPED_FILE file2(filepath2);
+    CFG_ASSERT_MSG(file1.is_open(), "Fail to open %s", filepath1.c_str());
+    CFG_ASSERT_MSG(file2.is_open(), "Fail to open %s", filepath2.c_str());
+    if (file1.size() == file2.size() &&
+        (file1.size() == 0 ||
+         memcmp(file1.data(), file2.data(), file1.size()) == 0)) {
+      return true;
+    }
+  }
+  // Different bytes can still be the same lines (line ending, last newline)
   std::vector<std::string> data1;
   std::vector<std::string> data2;
   CFG_read_text_file(filepath1, data1, false);
@@ -717,12 +845,82 @@ bool CFG_compare_two_text_files(const std::string& filepath1,
 
 bool CFG_compare_two_binary_files(const std::string& filepath1,
                                   const std::string& filepath2) {
-  std::vector<uint8_t> data1;
-  std::vector<uint8_t> data2;
-  CFG_read_binary_file(filepath1, data1);
-  CFG_read_binary_file(filepath2, data2);
-  return (data1.size() == data2.size()) &&
-         (data1.size() == 0 || memcmp(&data1[0], &data2[0], data1.size()) == 0);
+  CFG_MAPPED_FILE file1(filepath1);
+  CFG_MAPPED_FILE file2(filepath2);
+  CFG_ASSERT_MSG(file1.is_open(), "Fail to open binary file %s",
+                 filepath1.c_str());
+  CFG_ASSERT_MSG(file2.is_open(), "Fail to open binary file %s",
+                 filepath2.c_str());
+  CFG_ASSERT(file1.size() > 0 && file2.size() > 0);
+  return file1.size() == file2.size() &&
+         memcmp(file1.data(), file2.data(), file1.size()) == 0;
+}
+
+bool CFG_diff_binary_data(const uint8_t* data1, size_t size1,
+                          const uint8_t* data2, size_t size2,
+                          std::vector<CFG_BIT_RANGE>& ranges,
+                          size_t max_ranges) {
+  CFG_ASSERT(size1 == 0 || data1 != nullptr);
+  CFG_ASSERT(size2 == 0 || data2 != nullptr);
+  ranges.clear();
+  bool full = false;
+  auto add_bits = [&ranges, &full, max_ranges](uint64_t start, uint64_t size) {
+    if (ranges.size() && (ranges.back().start + ranges.back().size) == start) {
+      ranges.back().size += size;
+    } else if (max_ranges != 0 && ranges.size() >= max_ranges) {
+      full = true;
+    } else {
+      ranges.push_back({start, size});
+    }
+  };
+  bool same = size1 == size2;
+  size_t common = std::min(size1, size2);
+  for (size_t block = 0; block < common && !full;
+       block += CFG_COMPARE_BLOCK_SIZE) {
+    size_t block_end = std::min(common, block + CFG_COMPARE_BLOCK_SIZE);
+    if (memcmp(&data1[block], &data2[block], block_end - block) == 0) {
+      continue;
+    }
+    same = false;
+    for (size_t i = block; i < block_end && !full; i += sizeof(uint64_t)) {
+      size_t n = std::min(sizeof(uint64_t), block_end - i);
+      uint64_t word1 = 0;
+      uint64_t word2 = 0;
+      memcpy(&word1, &data1[i], n);
+      memcpy(&word2, &data2[i], n);
+      if (word1 == word2) {
+        continue;
+      }
+      for (size_t j = i; j < (i + n) && !full; j++) {
+        uint8_t bits = data1[j] ^ data2[j];
+        for (uint64_t bit = (uint64_t)(j) * 8; bits != 0 && !full;
+             bit++, bits >>= 1) {
+          if (bits & 1) {
+            add_bits(bit, 1);
+          }
+        }
+      }
+    }
+  }
+  if (size1 != size2 && !full) {
+    add_bits((uint64_t)(common) * 8,
+             (uint64_t)(std::max(size1, size2) - common) * 8);
+  }
+  return same;
+}
+
+bool CFG_diff_two_binary_files(const std::string& filepath1,
+                               const std::string& filepath2,
+                               std::vector<CFG_BIT_RANGE>& ranges,
+                               size_t max_ranges) {
+  CFG_MAPPED_FILE file1(filepath1);
+  CFG_MAPPED_FILE file2(filepath2);
+  CFG_ASSERT_MSG(file1.is_open(), "Fail to open binary file %s",
+                 filepath1.c_str());
+  CFG_ASSERT_MSG(file2.is_open(), "Fail to open binary file %s",
+                 filepath2.c_str());
+  return CFG_diff_binary_data(file1.data(), file1.size(), file2.data(),
+                              file2.size(), ranges, max_ranges);
 }
 
 static CFG_Python_OBJ CFG_Python_get_result(PyObject*& value,
@@ -799,12 +997,57 @@ static void CFG_Python_get_result(PyObject* list,
   }
 }
 
+static void CFG_Python_finalize() {
+  PyGILState_Ensure();
+  Py_Finalize();
+}
+
+/*
+  Start the interpreter once per process. The GIL is released right after
+  initialization and re-acquired by CFG_Python_LOCK around every call, so
+  the interpreter can be used from whichever thread runs the command.
+*/
+static void CFG_Python_initialize() {
+  static std::once_flag flag;
+  std::call_once(flag, []() {
+    if (!Py_IsInitialized()) {
+      Py_Initialize();
+      PyEval_SaveThread();
+      std::atexit(CFG_Python_finalize);
+    }
+  });
+}
+
+struct CFG_Python_LOCK {
+  CFG_Python_LOCK() {
+    CFG_Python_initialize();
+    state = PyGILState_Ensure();
+  }
+  ~CFG_Python_LOCK() { PyGILState_Release(state); }
+  PyGILState_STATE state;
+};
+
+/*
+  Source file signature of every module imported through set_file(), used to
+  decide whether a reusable module is still up to date
+*/
+static std::map<std::string, std::string> m_python_module_signatures;
+
+static std::string CFG_Python_file_signature(
+    const std::filesystem::path& file) {
+  std::error_code ec;
+  auto size = std::filesystem::file_size(file, ec);
+  auto time = std::filesystem::last_write_time(file, ec);
+  return CFG_print("%s:%lld:%lld", file.string().c_str(), (long long)(size),
+                   (long long)(time.time_since_epoch().count()));
+}
+
 std::map<std::string, CFG_Python_OBJ> CFG_Python(
     std::vector<std::string> commands, const std::vector<std::string> results,
     void* dict_ptr) {
+  CFG_Python_LOCK lock;
   PyObject* dict = nullptr;
   if (dict_ptr == nullptr) {
-    Py_Initialize();
     dict = PyDict_New();
   } else {
     dict = static_cast<PyObject*>(dict_ptr);
@@ -825,7 +1068,6 @@ std::map<std::string, CFG_Python_OBJ> CFG_Python(
   }
   if (dict_ptr == nullptr) {
     Py_DECREF(dict);
-    Py_Finalize();
   }
   return result_objs;
 }
@@ -937,7 +1179,7 @@ std::vector<std::string> CFG_Python_OBJ::get_strs(const std::string& name) {
 
 CFG_Python_MGR::CFG_Python_MGR(const std::string& filepath,
                                const std::vector<std::string> results) {
-  Py_Initialize();
+  CFG_Python_LOCK lock;
   if (filepath.size()) {
     main_module = set_file(filepath, results);
     CFG_ASSERT(main_module.size());
@@ -951,6 +1193,7 @@ CFG_Python_MGR::CFG_Python_MGR(const std::string& filepath,
 }
 
 CFG_Python_MGR::~CFG_Python_MGR() {
+  CFG_Python_LOCK lock;
   if (main_module.empty() && dict_ptr != nullptr) {
     PyObject* dict = static_cast<PyObject*>(dict_ptr);
     Py_DECREF(dict);
@@ -959,14 +1202,15 @@ CFG_Python_MGR::~CFG_Python_MGR() {
   for (auto& iter : module_objs) {
     Py_XDECREF((PyObject*)(iter.second));
   }
-  Py_Finalize();
   main_module = "";
 }
 
 std::string CFG_Python_MGR::get_main_module() { return main_module; }
 
 std::string CFG_Python_MGR::set_file(const std::string& file,
-                                     const std::vector<std::string> results) {
+                                     const std::vector<std::string> results,
+                                     bool reuse) {
+  CFG_Python_LOCK lock;
   std::filesystem::path fullpath = std::filesystem::absolute(file.c_str());
   CFG_ASSERT_MSG(std::filesystem::exists(fullpath),
                  "Python file %s does not exist", fullpath.c_str());
@@ -975,14 +1219,28 @@ std::string CFG_Python_MGR::set_file(const std::string& file,
   std::filesystem::path dir = fullpath.parent_path();
   std::filesystem::path filename = fullpath.filename();
   std::string standard_dir = CFG_change_directory_to_linux_format(dir.string());
+  // The interpreter outlives this manager, move the directory to the front
+  // so that a module with the same name in another directory is not picked
   PyRun_SimpleString(CFG_print("import sys\n"
-                               "if '%s' not in sys.path:\n"
-                               "  sys.path.insert(0, '%s')\n",
-                               standard_dir.c_str(), standard_dir.c_str())
+                               "if '%s' in sys.path:\n"
+                               "  sys.path.remove('%s')\n"
+                               "sys.path.insert(0, '%s')\n",
+                               standard_dir.c_str(), standard_dir.c_str(),
+                               standard_dir.c_str())
                          .c_str());
   std::string module =
       filename.string().substr(0, filename.string().size() - 3);
   CFG_ASSERT(module_objs.find(module) == module_objs.end());
+  std::string signature = CFG_Python_file_signature(fullpath);
+  if (!reuse || m_python_module_signatures[module] != signature) {
+    PyRun_SimpleString(CFG_print("import sys\n"
+                                 "import importlib\n"
+                                 "sys.modules.pop('%s', None)\n"
+                                 "importlib.invalidate_caches()\n",
+                                 module.c_str())
+                           .c_str());
+    m_python_module_signatures[module] = signature;
+  }
   PyObject* pName = PyUnicode_FromString(module.c_str());
   if (pName != nullptr) {
     module_objs[module] = (void*)(PyImport_Import(pName));
@@ -1006,6 +1264,22 @@ std::string CFG_Python_MGR::set_file(const std::string& file,
   return module;
 }
 
+bool CFG_Python_MGR::has_function(const std::string& module,
+                                  const std::string& function) {
+  CFG_Python_LOCK lock;
+  CFG_ASSERT_MSG(module_objs.find(module) != module_objs.end(),
+                 "Module %s is not setup", module.c_str());
+  PyObject* pFunc = PyObject_GetAttrString((PyObject*)(module_objs[module]),
+                                           function.c_str());
+  if (pFunc == nullptr) {
+    PyErr_Clear();
+    return false;
+  }
+  bool status = PyCallable_Check(pFunc) != 0;
+  Py_DECREF(pFunc);
+  return status;
+}
+
 void CFG_Python_MGR::run(std::vector<std::string> commands,
                          const std::vector<std::string> results) {
   CFG_ASSERT(dict_ptr != nullptr);
@@ -1015,6 +1289,7 @@ void CFG_Python_MGR::run(std::vector<std::string> commands,
 std::vector<CFG_Python_OBJ> CFG_Python_MGR::run_file(
     const std::string& module, const std::string& function,
     std::vector<CFG_Python_OBJ> args) {
+  CFG_Python_LOCK lock;
   CFG_ASSERT(dict_ptr != nullptr);
   CFG_ASSERT_MSG(module_objs.find(module) != module_objs.end(),
                  "Module %s is not setup", module.c_str());
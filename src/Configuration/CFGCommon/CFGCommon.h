@@ -31,6 +31,15 @@ typedef void (*cfg_callback_post_err_function)(const std::string& message,
 typedef int (*cfg_callback_execute_command)(const std::string& command,
                                             const std::string logFile,
                                             bool appendLog);
+// runs 'command' and calls 'line' with each line of its standard output,
+// returns the exit code
+typedef int (*cfg_callback_execute_command_output)(
+    const std::string& command, std::atomic<bool>& stop,
+    const std::function<void(const std::string& line)>& line);
+typedef void (*cfg_callback_trace_function)(const std::string& name,
+                                            bool begin);
+typedef void (*cfg_callback_progress_function)(const std::string& name,
+                                               double percent);
 
 class CFGArg;
 struct CFGCommon_ARG {
@@ -81,14 +90,24 @@ struct CFG_Python_OBJ {
   std::vector<std::string> strs = {};
 };
 
+/*
+  The embedded interpreter is started by the first CFG_Python_MGR (or
+  CFG_Python call) and stays alive until the process exits, so modules and
+  their state can be reused across managers. Every entry point holds the
+  GIL only for the duration of the call.
+*/
 class CFG_Python_MGR {
  public:
   CFG_Python_MGR(const std::string& filepath = "",
                  const std::vector<std::string> results = {});
   ~CFG_Python_MGR();
   std::string get_main_module();
+  // By default the module is imported fresh. With reuse, a module imported
+  // earlier in this process is kept as long as its file is unchanged.
   std::string set_file(const std::string& file,
-                       const std::vector<std::string> results = {});
+                       const std::vector<std::string> results = {},
+                       bool reuse = false);
+  bool has_function(const std::string& module, const std::string& function);
   void run(std::vector<std::string> commands,
            const std::vector<std::string> results);
   std::vector<CFG_Python_OBJ> run_file(const std::string& module,
@@ -163,6 +182,22 @@ void CFG_unset_callback_post_msg_function();
 void CFG_unset_callback_post_err_function();
 void CFG_unset_callback_exec_cmd_function();
 
+// CFG_execute_cmd runs the commands through this function once it is set,
+// through popen otherwise
+void CFG_set_callback_exec_cmd_output_function(
+    cfg_callback_execute_command_output exec);
+void CFG_unset_callback_exec_cmd_output_function();
+
+// Called when an external command starts (begin) and finishes
+void CFG_set_callback_trace_function(cfg_callback_trace_function trace);
+void CFG_unset_callback_trace_function();
+
+// Called with the progress of a long operation, in percent
+void CFG_set_callback_progress_function(
+    cfg_callback_progress_function progress);
+void CFG_unset_callback_progress_function();
+void CFG_post_progress(const std::string& name, double percent);
+
 void CFG_post_msg(const std::string& message,
                   const std::string pre_msg = "INFO: ",
                   const bool new_line = true);
@@ -254,6 +289,24 @@ bool CFG_compare_two_text_files(const std::string& filepath1,
 bool CFG_compare_two_binary_files(const std::string& filepath1,
                                   const std::string& filepath2);
 
+struct CFG_BIT_RANGE {
+  uint64_t start = 0;  // bit address: byte index * 8 + bit index (LSB first)
+  uint64_t size = 0;
+};
+
+// Collect the ranges of bits that differ between the two buffers. Bytes past
+// the end of the shorter buffer count as different. When max_ranges is not
+// zero, stop once that many ranges are found. Return true if identical
+bool CFG_diff_binary_data(const uint8_t* data1, size_t size1,
+                          const uint8_t* data2, size_t size2,
+                          std::vector<CFG_BIT_RANGE>& ranges,
+                          size_t max_ranges = 0);
+
+bool CFG_diff_two_binary_files(const std::string& filepath1,
+                               const std::string& filepath2,
+                               std::vector<CFG_BIT_RANGE>& ranges,
+                               size_t max_ranges = 0);
+
 std::map<std::string, CFG_Python_OBJ> CFG_Python(
     std::vector<std::string> commands, const std::vector<std::string> results,
     void* dict_ptr = nullptr);
@@ -15,8 +15,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "CFGCompiler.h"
 
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
 #include <filesystem>
+#include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "Compiler/Log.h"
 #include "Compiler/TclInterpreterHandler.h"
@@ -24,11 +30,25 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "ModelConfig/ModelConfig.h"
 #include "NewProject/ProjectManager/project_manager.h"
 #include "Programmer/Programmer.h"
+#include "Utils/EventBus.h"
+#include "Utils/ProcessExecutor.h"
+#include "Utils/Tracer.h"
 
 using namespace FOEDAG;
 
 static const CFGCompiler* m_CFGCompiler = nullptr;
 
+static void TraceCommand(const std::string& name, bool begin) {
+  if (begin)
+    Tracer::begin("process", name);
+  else
+    Tracer::end("process");
+}
+
+static void ProgressCommand(const std::string& name, double percent) {
+  EventBus::progress("programmer", name, percent, 100);
+}
+
 static bool programmer_flow(CFGCompiler* cfgcompiler, int argc,
                             const char* argv[]) {
   // Do some customize flow to check the arguments
@@ -68,11 +88,17 @@ CFGCompiler::CFGCompiler(Compiler* compiler) : m_compiler(compiler) {
   m_CFGCompiler = this;
   CFG_set_callback_message_function(Message, ErrorMessage,
                                     ExecuteAndMonitorSystemCommand);
+  CFG_set_callback_exec_cmd_output_function(ExecuteCommandWithOutput);
+  CFG_set_callback_trace_function(TraceCommand);
+  CFG_set_callback_progress_function(ProgressCommand);
 }
 
 CFGCompiler::~CFGCompiler() {
   m_CFGCompiler = nullptr;
   CFG_unset_callback_message_function();
+  CFG_unset_callback_exec_cmd_output_function();
+  CFG_unset_callback_trace_function();
+  CFG_unset_callback_progress_function();
 }
 
 Compiler* CFGCompiler::GetCompiler() const { return m_compiler; }
@@ -247,6 +273,95 @@ int CFGCompiler::ExecuteAndMonitorSystemCommand(const std::string& command,
   }
 }
 
+namespace {
+// Calls the callback with each complete line written to the stream
+class LineStream : public std::ostream {
+ public:
+  explicit LineStream(const std::function<void(const std::string&)>& line)
+      : std::ostream(nullptr), m_buffer(line) {
+    rdbuf(&m_buffer);
+  }
+  ~LineStream() override { m_buffer.flushLine(); }
+
+ private:
+  class Buffer : public std::streambuf {
+   public:
+    explicit Buffer(const std::function<void(const std::string&)>& line)
+        : m_line(line) {}
+    void flushLine() {
+      if (m_pending.empty()) return;
+      m_line(m_pending);
+      m_pending.clear();
+    }
+
+   protected:
+    int_type overflow(int_type c) override {
+      if (traits_type::eq_int_type(c, traits_type::eof())) return 0;
+      m_pending.push_back(traits_type::to_char_type(c));
+      if (c == '\n') flushLine();
+      return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+      for (std::streamsize i = 0; i < n; i++) {
+        m_pending.push_back(s[i]);
+        if (s[i] == '\n') flushLine();
+      }
+      return n;
+    }
+
+   private:
+    const std::function<void(const std::string&)> m_line;
+    std::string m_pending{};
+  };
+  Buffer m_buffer;
+};
+}  // namespace
+
+int CFGCompiler::ExecuteCommandWithOutput(
+    const std::string& command, std::atomic<bool>& stop,
+    const std::function<void(const std::string& line)>& line) {
+  ProcessRequest request{};
+  // leading NAME=VALUE words set the environment of the tool, as in a shell
+  for (const auto& word : ProcessExecutor::SplitCommand(command)) {
+    const size_t equal = word.find('=');
+    const bool assignment =
+        request.argv.empty() && equal != std::string::npos && equal != 0 &&
+        std::all_of(word.begin(), word.begin() + equal, [](char c) {
+          return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        });
+    if (assignment)
+      request.environment[word.substr(0, equal)] = word.substr(equal + 1);
+    else
+      request.argv.push_back(word);
+  }
+  LineStream out{line};
+  request.out.push_back(&out);
+  request.err.push_back(&std::cerr);
+  // the stop flag is polled, the token terminates the tool
+  std::mutex mutex;
+  std::condition_variable finished;
+  bool done{false};
+  std::thread watcher{[&]() {
+    std::unique_lock<std::mutex> lock{mutex};
+    while (!finished.wait_for(lock, std::chrono::milliseconds{50},
+                              [&done]() { return done; })) {
+      if (stop) {
+        request.cancel.cancel();
+        return;
+      }
+    }
+  }};
+  ProcessExecutor executor;
+  const ProcessResult result = executor.run(request);
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    done = true;
+  }
+  finished.notify_all();
+  watcher.join();
+  return result.code();
+}
+
 /*
   This is single point entry to all configuration functions
 
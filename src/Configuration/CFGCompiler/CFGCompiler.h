@@ -33,6 +33,9 @@ class CFGCompiler {
   static int ExecuteAndMonitorSystemCommand(const std::string& command,
                                             const std::string logFile,
                                             bool appendLog);
+  static int ExecuteCommandWithOutput(
+      const std::string& command, std::atomic<bool>& stop,
+      const std::function<void(const std::string& line)>& line);
 
  public:
   CFGCommon_ARG m_cmdarg;
@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "HardwareManager.h"
 
+#include <algorithm>
+
 #include "Configuration/CFGCommon/CFGCommon.h"
 #include "libusb.h"
 
@@ -31,17 +33,104 @@ const std::vector<HardwareManager_CABLE_INFO> HardwareManager::m_cable_db = {
     {"RsFtdi", FTDI, 0x0403, 0x6014},
     {"Jlink", JLINK, 0x1366, 0x0101}};
 
-const std::vector<HardwareManager_DEVICE_INFO> HardwareManager::m_device_db = {
+struct HM_DEVICE_ENTRY {
+  const char* name;
+  uint32_t idcode;
+  uint32_t irlength;
+  uint32_t irmask;
+  DeviceType type;
+};
+
+static constexpr HM_DEVICE_ENTRY HM_DEVICE_TABLE[] = {
     {"Gemini", 0x1000563d, 5, 0xffffffff, GEMINI},
     {"OCLA", 0x10000db3, 5, 0xffffffff, OCLA}};
 
-HardwareManager::HardwareManager(JtagAdapter* adapter) : m_adapter(adapter) {
+// An idcode must match one entry at most, then the lookup by masked idcode
+// below finds the same entry as a scan of the table in order
+static constexpr bool HM_device_table_unambiguous() {
+  constexpr size_t count = sizeof(HM_DEVICE_TABLE) / sizeof(HM_DEVICE_TABLE[0]);
+  for (size_t i = 0; i < count; i++) {
+    for (size_t j = i + 1; j < count; j++) {
+      uint32_t mask = HM_DEVICE_TABLE[i].irmask & HM_DEVICE_TABLE[j].irmask;
+      if ((HM_DEVICE_TABLE[i].idcode & mask) ==
+          (HM_DEVICE_TABLE[j].idcode & mask)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+static_assert(HM_device_table_unambiguous(),
+              "an idcode matches more than one device DB entry");
+
+static std::vector<HardwareManager_DEVICE_INFO> HM_build_device_db() {
+  std::vector<HardwareManager_DEVICE_INFO> db;
+  for (const auto& entry : HM_DEVICE_TABLE) {
+    db.push_back({entry.name, entry.idcode, entry.irlength, entry.irmask,
+                  entry.type});
+  }
+  return db;
+}
+
+const std::vector<HardwareManager_DEVICE_INFO> HardwareManager::m_device_db =
+    HM_build_device_db();
+
+void HardwareManager_SNAPSHOT::invalidate() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cables_valid = false;
+  m_cables.clear();
+  m_cable_by_index.clear();
+  m_cable_by_name.clear();
+  m_idcodes.clear();
+}
+
+HardwareManager::HardwareManager(
+    JtagAdapter* adapter, std::shared_ptr<HardwareManager_SNAPSHOT> snapshot)
+    : m_adapter(adapter), m_snapshot(snapshot) {
   CFG_ASSERT(m_adapter != nullptr);
+  if (m_snapshot == nullptr) {
+    m_snapshot = std::make_shared<HardwareManager_SNAPSHOT>();
+  }
 }
 
 HardwareManager::~HardwareManager() {}
 
+std::shared_ptr<HardwareManager_SNAPSHOT> HardwareManager::shared_snapshot() {
+  static std::shared_ptr<HardwareManager_SNAPSHOT> snapshot =
+      std::make_shared<HardwareManager_SNAPSHOT>();
+  return snapshot;
+}
+
+void HardwareManager::invalidate() { m_snapshot->invalidate(); }
+
 std::vector<Cable> HardwareManager::get_cables() {
+  {
+    std::lock_guard<std::mutex> lock(m_snapshot->m_mutex);
+    if (m_snapshot->m_cables_valid) return m_snapshot->m_cables;
+  }
+  load_cables();
+  std::lock_guard<std::mutex> lock(m_snapshot->m_mutex);
+  return m_snapshot->m_cables;
+}
+
+void HardwareManager::load_cables() {
+  // USB is enumerated without the lock, other queries are not blocked
+  auto cables = enumerate_cables();
+  std::lock_guard<std::mutex> lock(m_snapshot->m_mutex);
+  auto& snapshot = *m_snapshot;
+  snapshot.m_cables = std::move(cables);
+  snapshot.m_cable_by_index.clear();
+  snapshot.m_cable_by_name.clear();
+  snapshot.m_idcodes.clear();
+  for (size_t i = 0; i < snapshot.m_cables.size(); i++) {
+    snapshot.m_cable_by_index.emplace(snapshot.m_cables[i].index, i);
+    snapshot.m_cable_by_name.emplace(snapshot.m_cables[i].name, i);
+  }
+  // no cable is not kept, the next query enumerates again
+  snapshot.m_cables_valid = !snapshot.m_cables.empty();
+}
+
+std::vector<Cable> HardwareManager::enumerate_cables() {
   struct libusb_context* ctx = nullptr;         /**< Libusb context **/
   struct libusb_device** device_list = nullptr; /**< The usb device list **/
   struct libusb_device_handle* device_handle = nullptr;
@@ -130,13 +219,7 @@ bool HardwareManager::is_cable_exists(uint32_t cable_index) {
   return is_cable_exists(cable_index, cable);
 }
 bool HardwareManager::is_cable_exists(uint32_t cable_index, Cable& out_cable) {
-  for (const auto& cable : get_cables()) {
-    if (cable.index == cable_index) {
-      out_cable = cable;
-      return true;
-    }
-  }
-  return false;
+  return find_cable(cable_index, out_cable);
 }
 
 bool HardwareManager::is_cable_exists(std::string cable_name,
@@ -156,30 +239,115 @@ bool HardwareManager::is_cable_exists(std::string cable_name,
       return is_cable_exists(cable_index, out_cable);
     }
   }
-  for (const auto& cable : get_cables()) {
-    if (cable.name.find(cable_name) == 0) {
-      out_cable = cable;
+  return find_cable(cable_name, out_cable);
+}
+
+bool HardwareManager::find_cable(uint32_t cable_index, Cable& out_cable) {
+  return lookup_cable(cable_index, {}, true, out_cable);
+}
+
+bool HardwareManager::find_cable(const std::string& cable_name,
+                                 Cable& out_cable) {
+  return lookup_cable(0, cable_name, false, out_cable);
+}
+
+bool HardwareManager::lookup_cable(uint32_t cable_index,
+                                   const std::string& cable_name,
+                                   bool by_index, Cable& out_cable) {
+  auto& snapshot = *m_snapshot;
+  bool enumerated = false;
+  while (true) {
+    bool valid = false;
+    {
+      std::lock_guard<std::mutex> lock(snapshot.m_mutex);
+      valid = snapshot.m_cables_valid;
+    }
+    if (!valid) {
+      load_cables();
+      enumerated = true;
+    }
+    std::lock_guard<std::mutex> lock(snapshot.m_mutex);
+    if (by_index) {
+      auto it = snapshot.m_cable_by_index.find(cable_index);
+      if (it != snapshot.m_cable_by_index.end()) {
+        out_cable = snapshot.m_cables[it->second];
+        return true;
+      }
+    } else if (auto it = snapshot.m_cable_by_name.find(cable_name);
+               it != snapshot.m_cable_by_name.end()) {
+      out_cable = snapshot.m_cables[it->second];
       return true;
+    } else {
+      // name can be a prefix of the cable name
+      for (const auto& cable : snapshot.m_cables) {
+        if (cable.name.find(cable_name) == 0) {
+          out_cable = cable;
+          return true;
+        }
+      }
     }
+    // cable can be plugged after the snapshot was taken
+    if (enumerated) return false;
+    snapshot.m_cables_valid = false;
   }
-  return false;
+}
+
+std::vector<uint32_t> HardwareManager::scan(const Cable& cable) {
+  {
+    std::lock_guard<std::mutex> lock(m_snapshot->m_mutex);
+    auto it = m_snapshot->m_idcodes.find(cable.name);
+    if (it != m_snapshot->m_idcodes.end()) return it->second;
+  }
+  // openocd runs without the lock
+  auto idcodes = m_adapter->scan(cable);
+  // no device is not kept, the board may be powered on later
+  if (!idcodes.empty()) {
+    std::lock_guard<std::mutex> lock(m_snapshot->m_mutex);
+    m_snapshot->m_idcodes[cable.name] = idcodes;
+  }
+  return idcodes;
+}
+
+const HardwareManager_DEVICE_INFO* HardwareManager::find_device_info(
+    uint32_t idcode) {
+  // entries bucketed by irmask and masked idcode, built once
+  struct Index {
+    std::vector<uint32_t> masks;
+    std::unordered_map<uint64_t, size_t> entries;
+  };
+  static const Index index = []() {
+    Index index;
+    for (size_t i = 0; i < m_device_db.size(); i++) {
+      const auto& info = m_device_db[i];
+      if (std::find(index.masks.begin(), index.masks.end(), info.irmask) ==
+          index.masks.end()) {
+        index.masks.push_back(info.irmask);
+      }
+      uint64_t key =
+          ((uint64_t)info.irmask << 32) | (info.idcode & info.irmask);
+      index.entries.emplace(key, i);
+    }
+    return index;
+  }();
+  for (auto mask : index.masks) {
+    auto it = index.entries.find(((uint64_t)mask << 32) | (idcode & mask));
+    if (it != index.entries.end()) return &m_device_db[it->second];
+  }
+  return nullptr;
 }
 
 std::vector<Tap> HardwareManager::get_taps(const Cable& cable) {
-  auto idcode_array = m_adapter->scan(cable);
+  auto idcode_array = scan(cable);
   std::vector<Tap> taps;
   uint32_t idx = 1;
 
   for (auto& idcode : idcode_array) {
-    for (auto& device_info : m_device_db) {
-      if ((idcode & device_info.irmask) ==
-          (device_info.idcode & device_info.irmask)) {
-        Tap tap{};
-        tap.idcode = idcode;
-        tap.index = idx++;
-        tap.irlength = device_info.irlength;
-        taps.push_back(tap);
-      }
+    if (auto device_info = find_device_info(idcode)) {
+      Tap tap{};
+      tap.idcode = idcode;
+      tap.index = idx++;
+      tap.irlength = device_info->irlength;
+      taps.push_back(tap);
     }
   }
 
@@ -198,9 +366,8 @@ std::vector<Device> HardwareManager::get_devices() {
 }
 
 std::vector<Device> HardwareManager::get_devices(uint32_t cable_index) {
-  for (const auto& cable : get_cables()) {
-    if (cable.index == cable_index) return get_devices(cable);
-  }
+  Cable cable;
+  if (find_cable(cable_index, cable)) return get_devices(cable);
   return {};
 }
 
@@ -215,9 +382,8 @@ std::vector<Device> HardwareManager::get_devices(std::string cable_name,
     }
   }
 
-  for (const auto& cable : get_cables()) {
-    if (cable.name.find(cable_name) == 0) return get_devices(cable);
-  }
+  Cable cable;
+  if (find_cable(cable_name, cable)) return get_devices(cable);
   return {};
 }
 
@@ -237,36 +403,28 @@ bool HardwareManager::find_device(std::string cable_name, uint32_t device_index,
 }
 
 std::vector<Device> HardwareManager::get_devices(const Cable& cable) {
-  auto idcode_array = m_adapter->scan(cable);
+  auto idcode_array = scan(cable);
   uint32_t device_index = 1;
   uint32_t tap_index = 1;
   std::vector<Device> devices{};
 
   for (auto& idcode : idcode_array) {
-    bool found = false;
-    for (auto& device_info : m_device_db) {
-      if ((idcode & device_info.irmask) ==
-          (device_info.idcode & device_info.irmask)) {
-        found = true;
-        Tap tap{tap_index++, idcode, device_info.irlength};
-        if (device_info.type == GEMINI || device_info.type == OCLA ||
-            device_info.type == VIRGO) {
-          Device device{};
-          device.index = device_index++;
-          device.type = device_info.type;
-          device.name = device_info.name;
-          device.cable = cable;
-          device.tap = tap;
-          // hardcode to 16MB for now until we have a way to query the flash
-          // size
-          device.flashSize = 16384;
-          devices.push_back(device);
-        }
-        break;
-      }
+    auto device_info = find_device_info(idcode);
+    CFG_ASSERT_MSG(device_info != nullptr, "Unknown tap id 0x%08x", idcode);
+    Tap tap{tap_index++, idcode, device_info->irlength};
+    if (device_info->type == GEMINI || device_info->type == OCLA ||
+        device_info->type == VIRGO) {
+      Device device{};
+      device.index = device_index++;
+      device.type = device_info->type;
+      device.name = device_info->name;
+      device.cable = cable;
+      device.tap = tap;
+      // hardcode to 16MB for now until we have a way to query the flash
+      // size
+      device.flashSize = 16384;
+      devices.push_back(device);
     }
-
-    CFG_ASSERT_MSG(found, "Unknown tap id 0x%08x", idcode);
   }
 
   return devices;
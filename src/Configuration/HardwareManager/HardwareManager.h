@@ -24,7 +24,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <atomic>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "Device.h"
 #include "JtagAdapter.h"
@@ -49,9 +53,35 @@ struct HardwareManager_DEVICE_INFO {
   DeviceType type;
 };
 
+/*
+  Cables found on USB and IDCODEs scanned on each cable. HardwareManager
+  answers cable and device queries from it, so USB is enumerated and the
+  JTAG chain scanned once instead of on every query. The programmer commands
+  share one snapshot for the process, it is refreshed by list_cable,
+  list_device and the GUI detect action. No cable and empty scans are not
+  kept, and a lookup that misses on cached cables rescans once before it
+  fails.
+*/
+class HardwareManager_SNAPSHOT {
+ public:
+  void invalidate();
+
+ private:
+  friend class HardwareManager;
+  std::mutex m_mutex;
+  bool m_cables_valid = false;
+  std::vector<Cable> m_cables;
+  std::unordered_map<uint32_t, size_t> m_cable_by_index;
+  std::unordered_map<std::string, size_t> m_cable_by_name;
+  std::map<std::string, std::vector<uint32_t>> m_idcodes;  // by cable name
+};
+
 class HardwareManager {
  public:
-  HardwareManager(JtagAdapter *m_adapter);
+  // without a snapshot the manager caches in its own one
+  HardwareManager(
+      JtagAdapter *m_adapter,
+      std::shared_ptr<HardwareManager_SNAPSHOT> snapshot = nullptr);
   virtual ~HardwareManager();
   std::vector<Tap> get_taps(const Cable &cable);
   std::vector<Cable> get_cables();
@@ -69,12 +99,25 @@ class HardwareManager {
   bool find_device(std::string cable_name, uint32_t device_index,
                    Device &device, std::vector<Tap> &taplist,
                    bool numeric_name_as_index = false);
+  void invalidate();
+  // snapshot shared by the programmer commands
+  static std::shared_ptr<HardwareManager_SNAPSHOT> shared_snapshot();
   static const std::vector<HardwareManager_DEVICE_INFO> &get_device_db();
+  // device DB entry matching the idcode, nullptr if unknown
+  static const HardwareManager_DEVICE_INFO *find_device_info(uint32_t idcode);
 
  private:
+  std::vector<Cable> enumerate_cables();
+  void load_cables();
+  std::vector<uint32_t> scan(const Cable &cable);
+  bool find_cable(uint32_t cable_index, Cable &out_cable);
+  bool find_cable(const std::string &cable_name, Cable &out_cable);
+  bool lookup_cable(uint32_t cable_index, const std::string &cable_name,
+                    bool by_index, Cable &out_cable);
   static const std::vector<HardwareManager_CABLE_INFO> m_cable_db;
   static const std::vector<HardwareManager_DEVICE_INFO> m_device_db;
   JtagAdapter *m_adapter;
+  std::shared_ptr<HardwareManager_SNAPSHOT> m_snapshot;
 };
 
 }  // namespace FOEDAG
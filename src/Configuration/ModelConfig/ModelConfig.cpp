@@ -19,6 +19,8 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "ModelConfig.h"
+
 #include "CFGCommon/CFGArg.h"
 #include "CFGCommon/CFGCommon.h"
 #include "DeviceModeling/Model.h"
@@ -151,6 +153,10 @@ struct ModelConfig_API {
       delete m_setting.begin()->second;
       m_setting.erase(m_setting.begin());
     }
+    while (m_resolved_setting.size()) {
+      delete m_resolved_setting.begin()->second;
+      m_resolved_setting.erase(m_resolved_setting.begin());
+    }
   }
   ModelConfig_API_SETTING*& add_setting(const std::string& setting) {
 #if DEBUG_PRINT_API
@@ -160,7 +166,20 @@ struct ModelConfig_API {
     m_setting[setting] = new ModelConfig_API_SETTING();
     return m_setting[setting];
   }
-  ModelConfig_API_SETTING* get_setting(const std::string& setting) {
+  const ModelConfig_API_SETTING* get_setting(const std::string& setting) {
+    // The same API value is usually applied to many instances, resolve it once
+    auto iter = m_resolved_setting.find(setting);
+    if (iter == m_resolved_setting.end()) {
+      iter =
+          m_resolved_setting.emplace(setting, resolve_setting(setting)).first;
+    }
+    return iter->second;
+  }
+  const std::string m_name;
+  std::map<std::string, ModelConfig_API_SETTING*> m_setting;
+
+ protected:
+  ModelConfig_API_SETTING* resolve_setting(const std::string& setting) {
     std::string temp = CFG_replace_string(setting, "  ", " ");
     std::vector<std::string> temps = CFG_split_string(temp, " ");
     std::vector<std::string> value;
@@ -205,8 +224,7 @@ struct ModelConfig_API {
     }
     return set;
   }
-  const std::string m_name;
-  std::map<std::string, ModelConfig_API_SETTING*> m_setting;
+  std::map<std::string, ModelConfig_API_SETTING*> m_resolved_setting;
 };
 
 class ModelConfig_DEVICE {
@@ -232,6 +250,13 @@ class ModelConfig_DEVICE {
         CFG_ASSERT(b == 0xFF);
       }
     }
+    // First bitfield in address order wins, like a linear search would
+    for (auto& b : m_bitfields) {
+      m_bitfield_index[b.second->m_block_name].emplace(b.second->m_name,
+                                                       b.second);
+      m_bitfield_index[b.second->m_user_name].emplace(b.second->m_name,
+                                                      b.second);
+    }
   }
   ~ModelConfig_DEVICE() {
     while (m_bitfields.size()) {
@@ -330,21 +355,28 @@ class ModelConfig_DEVICE {
   }
   void set_attr(const std::map<std::string, std::string>& options,
                 std::string reason = "") {
-    std::string instance = options.at("instance");
-    std::string name = options.at("name");
-    std::string value = options.at("value");
+    apply_attr(options.at("instance"), options.at("name"), options.at("value"),
+               reason);
+  }
+  void set_attrs(const std::vector<ModelConfig_ATTR>& attrs) {
+    for (auto& attr : attrs) {
+      apply_attr(attr.instance, attr.name, attr.value, "");
+    }
+  }
+  void apply_attr(const std::string& instance, const std::string& name,
+                  const std::string& value, std::string reason) {
     if (reason.empty()) {
       reason = CFG_print("set_attr %s [%s:%s]", instance.c_str(), name.c_str(),
                          value.c_str());
     }
-    if (m_api.find(name) != m_api.end()) {
-      const ModelConfig_API_SETTING* setting = m_api[name]->get_setting(value);
+    auto api = m_api.find(name);
+    if (api != m_api.end()) {
+      const ModelConfig_API_SETTING* setting = api->second->get_setting(value);
       CFG_ASSERT_MSG(setting != nullptr, "Could not find '%s' API setting '%s'",
                      name.c_str(), value.c_str());
       for (auto& attr : setting->m_attributes) {
         set_attr(instance, attr.m_name, attr.m_value, reason);
       }
-      delete setting;
     } else {
       set_attr(instance, name, value, reason);
     }
@@ -403,10 +435,7 @@ class ModelConfig_DEVICE {
       printf("DEBUG: Design Set Attr 0: %s : %s -> %s\n",
              final_instance.c_str(), key_str.c_str(), value_str.c_str());
 #endif
-      set_attr({{"instance", final_instance},
-                {"name", key_str},
-                {"value", value_str}},
-               reason);
+      apply_attr(final_instance, key_str, value_str, reason);
     }
   }
   bool set_design_attributes(const std::string& instance,
@@ -634,8 +663,115 @@ class ModelConfig_DEVICE {
       b.second->reset();
     }
   }
+  void diff(const std::map<std::string, std::string>& options,
+            const std::string& filepath1, const std::string& filepath2) {
+    CFG_ASSERT(m_total_bits);
+    std::string format = options.at("format");
+    CFG_ASSERT_MSG(format == "WORD" || format == "BIN",
+                   "model_config diff does not support '%s' format",
+                   format.c_str());
+    std::vector<uint8_t> data1;
+    std::vector<uint8_t> data2;
+    read_image(format, filepath1, data1);
+    read_image(format, filepath2, data2);
+    std::vector<CFG_BIT_RANGE> ranges;
+    CFG_diff_binary_data(data1.data(), data1.size(), data2.data(),
+                         data2.size(), ranges);
+    // Map every differing range back to the attributes it covers
+    std::vector<std::string> details;
+    const ModelConfig_BITFIELD* previous = nullptr;
+    uint64_t diff_bits = 0;
+    uint64_t outside_bits = 0;
+    for (auto& range : ranges) {
+      uint64_t end = range.start + range.size;
+      diff_bits += range.size;
+      if (end > m_total_bits) {
+        outside_bits += end - std::max(range.start, (uint64_t)(m_total_bits));
+      }
+      auto iter = m_bitfields.upper_bound((size_t)(range.start));
+      if (iter != m_bitfields.begin()) {
+        iter--;
+      }
+      for (; iter != m_bitfields.end() && iter->first < end; iter++) {
+        const ModelConfig_BITFIELD* bitfield = iter->second;
+        if (bitfield == previous ||
+            (bitfield->m_addr + bitfield->m_size) <= range.start) {
+          continue;
+        }
+        previous = bitfield;
+        details.push_back(CFG_print(
+            "Block %s [%s] %s - Addr: 0x%08X, Size: %2d, Value: (0x%08X) -> "
+            "(0x%08X)",
+            bitfield->m_block_name.c_str(), bitfield->m_user_name.c_str(),
+            bitfield->m_name.c_str(), bitfield->m_addr, bitfield->m_size,
+            get_image_value(data1, bitfield),
+            get_image_value(data2, bitfield)));
+      }
+    }
+    std::string summary =
+        CFG_print("Diff %s -> %s: %d bit(s) differ in %d attribute(s)",
+                  filepath1.c_str(), filepath2.c_str(), (uint32_t)(diff_bits),
+                  (uint32_t)(details.size()));
+    if (outside_bits) {
+      details.push_back(CFG_print("%d bit(s) differ outside of model %s",
+                                  (uint32_t)(outside_bits), m_model.c_str()));
+    }
+    std::ofstream file;
+    if (options.find("report") != options.end()) {
+      file.open(options.at("report").c_str());
+      CFG_ASSERT_MSG(file.is_open(), "Fail to open %s",
+                     options.at("report").c_str());
+      file << summary.c_str() << "\n";
+    }
+    CFG_POST_MSG("%s", summary.c_str());
+    for (auto& detail : details) {
+      CFG_POST_MSG("  %s", detail.c_str());
+      if (file.is_open()) {
+        file << "  " << detail.c_str() << "\n";
+      }
+    }
+    if (file.is_open()) {
+      file.close();
+    }
+  }
 
  protected:
+  void read_image(const std::string& format, const std::string& filepath,
+                  std::vector<uint8_t>& data) {
+    if (format == "BIN") {
+      CFG_read_binary_file(filepath, data);
+      return;
+    }
+    // WORD image: one little endian 32 bits hex word per line
+    std::vector<std::string> lines;
+    CFG_read_text_file(filepath, lines, true);
+    for (auto& line : lines) {
+      std::string word = line.substr(0, line.find("//"));
+      CFG_get_rid_whitespace(word);
+      if (word.empty()) {
+        continue;
+      }
+      bool status = false;
+      uint32_t value =
+          (uint32_t)(CFG_convert_string_to_u64("0x" + word, true, &status));
+      CFG_ASSERT_MSG(status && word.size() <= 8, "Invalid word '%s' in %s",
+                     line.c_str(), filepath.c_str());
+      for (uint32_t i = 0; i < 4; i++) {
+        data.push_back((uint8_t)(value >> (i * 8)));
+      }
+    }
+  }
+  uint32_t get_image_value(const std::vector<uint8_t>& data,
+                           const ModelConfig_BITFIELD* bitfield) {
+    uint32_t value = 0;
+    uint32_t addr = bitfield->m_addr;
+    for (uint32_t i = 0; i < bitfield->m_size; i++, addr++) {
+      if ((addr >> 3) < data.size() && (data[addr >> 3] & (1 << (addr & 7)))) {
+        value |= ((uint32_t)(1) << i);
+      }
+    }
+    return value;
+  }
   bool is_number(const std::string& str, uint32_t& value) {
     bool status = false;
     value = (uint32_t)(CFG_convert_string_to_u64(str, true, &status));
@@ -687,12 +823,11 @@ class ModelConfig_DEVICE {
   ModelConfig_BITFIELD* get_bitfield(const std::string& instance,
                                      const std::string& name) {
     ModelConfig_BITFIELD* bitfield = nullptr;
-    for (auto& b : m_bitfields) {
-      if ((b.second->m_block_name == instance ||
-           b.second->m_user_name == instance) &&
-          b.second->m_name == name) {
-        bitfield = b.second;
-        break;
+    auto block = m_bitfield_index.find(instance);
+    if (block != m_bitfield_index.end()) {
+      auto iter = block->second.find(name);
+      if (iter != block->second.end()) {
+        bitfield = iter->second;
       }
     }
     return bitfield;
@@ -761,6 +896,8 @@ class ModelConfig_DEVICE {
   uint32_t m_total_bits = 0;
   uint32_t m_max_attr_name_length = 0;
   std::map<size_t, ModelConfig_BITFIELD*> m_bitfields;
+  std::map<std::string, std::map<std::string, ModelConfig_BITFIELD*>>
+      m_bitfield_index;
   std::map<std::string, ModelConfig_API*> m_api;
 };
 
@@ -795,6 +932,11 @@ static class ModelConfig_MRG {
     set_feature("set_attr", options);
     m_current_device->set_attr(options);
   }
+  void set_attrs(const std::map<std::string, std::string>& options,
+                 const std::vector<ModelConfig_ATTR>& attrs) {
+    set_feature("set_attrs", options);
+    m_current_device->set_attrs(attrs);
+  }
   void set_design(const std::map<std::string, std::string>& options,
                   const std::string& filepath) {
     set_feature("set_design", options);
@@ -809,6 +951,11 @@ static class ModelConfig_MRG {
     set_feature("reset", options);
     m_current_device->reset();
   }
+  void diff(const std::map<std::string, std::string>& options,
+            const std::string& filepath1, const std::string& filepath2) {
+    set_feature("diff", options);
+    m_current_device->diff(options, filepath1, filepath2);
+  }
   void dump_ric(const std::string& model, const std::string& output) {
     device* dev = Model::get_modler().get_device_model(model);
     CFG_ASSERT_MSG(dev != nullptr, "Could not find device model '%s'",
@@ -915,6 +1062,79 @@ static class ModelConfig_MRG {
   std::map<std::string, ModelConfig_DEVICE*> m_feature_devices;
 } ModelConfig_DEVICE_DLL;
 
+// Split a Tcl style list: words are separated by whitespace, {} or "" group
+// words together and are removed from the word
+static std::vector<std::string> ModelConfig_split_list(
+    const std::string& list) {
+  std::vector<std::string> words;
+  size_t i = 0;
+  while (i < list.size()) {
+    if (isspace((unsigned char)(list[i]))) {
+      i++;
+    } else if (list[i] == '{') {
+      size_t start = ++i;
+      uint32_t depth = 1;
+      while (i < list.size() && depth) {
+        if (list[i] == '{') {
+          depth++;
+        } else if (list[i] == '}') {
+          depth--;
+        }
+        i++;
+      }
+      CFG_ASSERT_MSG(depth == 0, "Missing close-brace in '%s'", list.c_str());
+      words.push_back(list.substr(start, i - start - 1));
+    } else if (list[i] == '"') {
+      size_t end = list.find('"', i + 1);
+      CFG_ASSERT_MSG(end != std::string::npos, "Missing close-quote in '%s'",
+                     list.c_str());
+      words.push_back(list.substr(i + 1, end - i - 1));
+      i = end + 1;
+    } else {
+      size_t start = i;
+      while (i < list.size() && !isspace((unsigned char)(list[i]))) {
+        i++;
+      }
+      words.push_back(list.substr(start, i - start));
+    }
+  }
+  return words;
+}
+
+static void ModelConfig_add_attr(const std::string& triple,
+                                 std::vector<ModelConfig_ATTR>& attrs) {
+  std::vector<std::string> words = ModelConfig_split_list(triple);
+  CFG_ASSERT_MSG(words.size() == 3,
+                 "model_config set_attrs expects {instance name value} but "
+                 "found '%s'",
+                 triple.c_str());
+  attrs.push_back({words[0], words[1], words[2]});
+}
+
+static void ModelConfig_read_attrs(const std::string& filepath,
+                                   std::vector<ModelConfig_ATTR>& attrs) {
+  std::vector<std::string> lines;
+  CFG_read_text_file(filepath, lines, true);
+  attrs.reserve(attrs.size() + lines.size());
+  for (auto& line : lines) {
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line[start] == '#' ||
+        line.find("//", start) == start) {
+      continue;
+    }
+    ModelConfig_add_attr(line, attrs);
+  }
+}
+
+void model_config_set_attrs(const std::vector<ModelConfig_ATTR>& attrs,
+                            const std::string& feature) {
+  std::map<std::string, std::string> options;
+  if (feature.size()) {
+    options["feature"] = feature;
+  }
+  ModelConfig_DEVICE_DLL.set_attrs(options, attrs);
+}
+
 void model_config_entry(CFGCommon_ARG* cmdarg) {
   CFG_ASSERT(cmdarg->raws.size());
   std::vector<std::string> flag_options;
@@ -935,6 +1155,18 @@ void model_config_entry(CFGCommon_ARG* cmdarg) {
                   &cmdarg->raws[0], flag_options, options, positional_options,
                   {}, {"instance", "name", "value"}, {"feature"}, 0);
     ModelConfig_DEVICE_DLL.set_attr(options);
+  } else if (cmdarg->raws[0] == "set_attrs") {
+    CFGArg::parse("model_config|set_attrs", cmdarg->raws.size(),
+                  &cmdarg->raws[0], flag_options, options, positional_options,
+                  {}, {}, {"feature", "file"}, -1);
+    std::vector<ModelConfig_ATTR> attrs;
+    if (options.find("file") != options.end()) {
+      ModelConfig_read_attrs(options.at("file"), attrs);
+    }
+    for (auto& triple : positional_options) {
+      ModelConfig_add_attr(triple, attrs);
+    }
+    ModelConfig_DEVICE_DLL.set_attrs(options, attrs);
   } else if (cmdarg->raws[0] == "set_design") {
     CFGArg::parse("model_config|set_design", cmdarg->raws.size(),
                   &cmdarg->raws[0], flag_options, options, positional_options,
@@ -950,6 +1182,12 @@ void model_config_entry(CFGCommon_ARG* cmdarg) {
                   flag_options, options, positional_options, {}, {},
                   {"feature"}, 0);
     ModelConfig_DEVICE_DLL.reset(options);
+  } else if (cmdarg->raws[0] == "diff") {
+    CFGArg::parse("model_config|diff", cmdarg->raws.size(), &cmdarg->raws[0],
+                  flag_options, options, positional_options, {}, {"format"},
+                  {"feature", "report"}, 2);
+    ModelConfig_DEVICE_DLL.diff(options, positional_options[0],
+                                positional_options[1]);
   } else if (cmdarg->raws[0] == "dump_ric") {
     CFGArg::parse("model_config|dump_ric", cmdarg->raws.size(),
                   &cmdarg->raws[0], flag_options, options, positional_options,
@@ -961,7 +1199,7 @@ void model_config_entry(CFGCommon_ARG* cmdarg) {
                   &cmdarg->raws[0], flag_options, options, positional_options,
                   {"is_unittest"}, {"netlist_ppdb", "config_mapping"},
                   {"routing_config", "routing_config_model", "property_json",
-                   "pll_workaround"},
+                   "pll_workaround", "routing_json"},
                   1);
     ModelConfig_IO io(flag_options, options, positional_options[0]);
   } else if (cmdarg->raws[0] == "gen_bitstream_setting_xml") {
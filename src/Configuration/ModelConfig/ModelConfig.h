@@ -26,8 +26,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 namespace FOEDAG {
 
+struct ModelConfig_ATTR {
+  std::string instance;
+  std::string name;
+  std::string value;
+};
+
 void model_config_entry(CFGCommon_ARG* cmdarg);
 
+// Same as "model_config set_attr" for every attribute, without going through
+// the Tcl command and option parsing for each of them. Empty feature means
+// the current feature
+void model_config_set_attrs(const std::vector<ModelConfig_ATTR>& attrs,
+                            const std::string& feature = "");
+
 }  // namespace FOEDAG
 
 #endif
@@ -87,6 +87,9 @@ ModelConfig_IO::ModelConfig_IO(
   std::string property_json = options.find("property_json") != options.end()
                                   ? options.at("property_json")
                                   : "";
+  if (options.find("routing_json") != options.end()) {
+    m_routing_json = options.at("routing_json");
+  }
   bool is_unittest = std::find(flag_options.begin(), flag_options.end(),
                                "is_unittest") != flag_options.end();
   if (options.find("pll_workaround") != options.end()) {
@@ -224,7 +227,10 @@ void ModelConfig_IO::initialize_python(bool is_unittest,
     m_routing_config = rfullpath.filename().string();
     m_routing_config = m_routing_config.substr(0, m_routing_config.size() - 3);
     CFG_ASSERT(m_routing_config.size());
-    CFG_ASSERT(m_python->set_file(standard_rfullpath) == m_routing_config);
+    // Keep the configurator module (and the routing models it has loaded)
+    // alive across ModelConfig_IO instances while the file is unchanged
+    CFG_ASSERT(m_python->set_file(standard_rfullpath, {}, true) ==
+               m_routing_config);
   } else {
     m_routing_config = "";
   }
@@ -1087,29 +1093,11 @@ void ModelConfig_IO::solve_routing_json(nlohmann::json& routings,
   POST_INFO_MSG(0, "Solve routing");
   CFG_ASSERT(routings.is_array());
   if (routings.size()) {
-    // Write it to file
-    std::filesystem::path fullpath =
-        std::filesystem::absolute("io_routing.json");
-    std::string json_fullpath =
-        CFG_change_directory_to_linux_format(fullpath.string());
-    std::ofstream io_routing_json(json_fullpath);
-    CFG_ASSERT(io_routing_json.is_open());
-    io_routing_json << std::setw(2) << routings << std::endl;
-    io_routing_json.close();
     // Solve it
-    std::vector<CFG_Python_OBJ> results = m_python->run_file(
-        m_routing_config, "cpp_entry",
-        std::vector<CFG_Python_OBJ>(
-            {CFG_Python_OBJ((std::string)(route_model.c_str())),
-             CFG_Python_OBJ(json_fullpath)}));
+    std::vector<nlohmann::json> results =
+        solve_routings({route_model}, {routings}, {m_routing_json});
     CFG_ASSERT(results.size() == 1);
-    CFG_ASSERT(results[0].type == CFG_Python_OBJ::TYPE::BOOL);
-    CFG_ASSERT(results[0].get_bool());
-    // Retrieve it
-    std::ifstream input(json_fullpath.c_str());
-    CFG_ASSERT(input.is_open() && input.good());
-    nlohmann::json solved_routings = nlohmann::json::parse(input);
-    input.close();
+    nlohmann::json& solved_routings = results[0];
     // Real work
     CFG_ASSERT(solved_routings.is_array());
     CFG_ASSERT(routings.size() == solved_routings.size());
@@ -1205,6 +1193,86 @@ void ModelConfig_IO::solve_routing_json(nlohmann::json& routings,
   }
 }
 
+
+/*
+  Solve routing requests of one or more routing models in a single call.
+  The configurator runs in the long-lived interpreter and keeps its loaded
+  models, requests and results are exchanged as JSON text in memory.
+  If a json_files entry is not empty, the solved routings are also written
+  to it for debugging
+*/
+std::vector<nlohmann::json> ModelConfig_IO::solve_routings(
+    const std::vector<std::string>& route_models,
+    const std::vector<nlohmann::json>& routings,
+    const std::vector<std::string>& json_files) {
+  CFG_ASSERT(m_python != nullptr);
+  CFG_ASSERT(route_models.size() == routings.size());
+  CFG_ASSERT(route_models.size() == json_files.size());
+  std::vector<nlohmann::json> solved_routings;
+  if (!m_python->has_function(m_routing_config, "cpp_entry_batch")) {
+    // Older configurator, solve through the routing JSON file
+    for (size_t i = 0; i < route_models.size(); i++) {
+      solved_routings.push_back(
+          solve_routing_by_file(route_models[i], routings[i], json_files[i]));
+    }
+    return solved_routings;
+  }
+  std::vector<std::string> models;
+  std::vector<std::string> requests;
+  std::vector<std::string> files;
+  for (size_t i = 0; i < route_models.size(); i++) {
+    CFG_ASSERT(routings[i].is_array());
+    models.push_back(route_models[i]);
+    requests.push_back(routings[i].dump());
+    files.push_back(
+        json_files[i].empty()
+            ? ""
+            : CFG_change_directory_to_linux_format(
+                  std::filesystem::absolute(json_files[i]).string()));
+  }
+  std::vector<CFG_Python_OBJ> results = m_python->run_file(
+      m_routing_config, "cpp_entry_batch",
+      std::vector<CFG_Python_OBJ>({CFG_Python_OBJ(models),
+                                   CFG_Python_OBJ(requests),
+                                   CFG_Python_OBJ(files)}));
+  CFG_ASSERT(results.size() == route_models.size());
+  for (auto& result : results) {
+    nlohmann::json solved = nlohmann::json::parse(result.get_str());
+    CFG_ASSERT(solved.is_array());
+    solved_routings.push_back(solved);
+  }
+  return solved_routings;
+}
+
+/*
+  Legacy flow: write the routings to JSON file, let the configurator solve
+  it in place and read it back
+*/
+nlohmann::json ModelConfig_IO::solve_routing_by_file(
+    const std::string& route_model, const nlohmann::json& routings,
+    const std::string& json_file) {
+  std::filesystem::path fullpath = std::filesystem::absolute(
+      json_file.empty() ? "io_routing.json" : json_file);
+  std::string json_fullpath =
+      CFG_change_directory_to_linux_format(fullpath.string());
+  std::ofstream io_routing_json(json_fullpath);
+  CFG_ASSERT(io_routing_json.is_open());
+  io_routing_json << std::setw(2) << routings << std::endl;
+  io_routing_json.close();
+  std::vector<CFG_Python_OBJ> results = m_python->run_file(
+      m_routing_config, "cpp_entry",
+      std::vector<CFG_Python_OBJ>(
+          {CFG_Python_OBJ((std::string)(route_model.c_str())),
+           CFG_Python_OBJ(json_fullpath)}));
+  CFG_ASSERT(results.size() == 1);
+  CFG_ASSERT(results[0].type == CFG_Python_OBJ::TYPE::BOOL);
+  CFG_ASSERT(results[0].get_bool());
+  std::ifstream input(json_fullpath.c_str());
+  CFG_ASSERT(input.is_open() && input.good());
+  nlohmann::json solved_routings = nlohmann::json::parse(input);
+  input.close();
+  return solved_routings;
+}
 /*
   Determine the PLL model port name from primitive port name
 */
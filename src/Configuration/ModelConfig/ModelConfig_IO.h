@@ -135,6 +135,13 @@ class ModelConfig_IO {
   nlohmann::json prepare_routing_json();
   void solve_routing_json(nlohmann::json& routings,
                           const std::string& route_model);
+  std::vector<nlohmann::json> solve_routings(
+      const std::vector<std::string>& route_models,
+      const std::vector<nlohmann::json>& routings,
+      const std::vector<std::string>& json_files);
+  nlohmann::json solve_routing_by_file(const std::string& route_model,
+                                       const nlohmann::json& routings,
+                                       const std::string& json_file);
   std::string get_pll_port_name(std::string& pritimive_port_name);
   std::string get_iserdes_clk_mode(nlohmann::json& instance);
   void validate_routings_result(
@@ -231,6 +238,7 @@ class ModelConfig_IO {
   std::map<std::string, std::string> m_global_args;
   std::vector<ModelConfig_IO_MSG*> m_messages;
   std::string m_routing_config = "";
+  std::string m_routing_json = "";
   std::map<uint32_t, int> m_routing_instance_tracker;
 };
 
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Programmer.h"
 
+#include <cstdlib>  // for std::strtod
 #include <numeric>  // for std::accumulate
 #include <sstream>  // for std::stringstream
 #include <thread>   // for std::this_thread::sleep_for
@@ -73,7 +74,8 @@ void programmer_entry(CFGCommon_ARG* cmdarg) {
   }
   // setup hardware manager and its depencencies
   OpenocdAdapter openOcd{cmdarg->toolPath.string()};
-  HardwareManager hardware_manager{&openOcd};
+  HardwareManager hardware_manager{&openOcd,
+                                   HardwareManager::shared_snapshot()};
 
   std::string subCmd = arg->get_sub_arg_name();
   if (cmdarg->compilerName == "dummy") {
@@ -217,6 +219,10 @@ void programmer_entry(CFGCommon_ARG* cmdarg) {
     }
     int status = 0;
     InitLibrary(openOcdExecPath.string());
+    if (subCmd == "list_device" || subCmd == "list_cable") {
+      // listing commands always report the hardware as it is now
+      hardware_manager.invalidate();
+    }
     if (subCmd == "list_device") {
       auto list_device_arg =
           static_cast<const CFGArg_PROGRAMMER_LIST_DEVICE*>(arg->get_sub_arg());
@@ -346,6 +352,7 @@ void programmer_entry(CFGCommon_ARG* cmdarg) {
           [](std::string msg) {
             CFG_post_msg(CFG_print("Progress....%s%%", msg.c_str()),
                          "INFO: ", false);
+            CFG_post_progress("fpga", std::strtod(msg.c_str(), nullptr));
           },
           progress);
       if (Gui::GuiInterface()) {
@@ -410,6 +417,7 @@ void programmer_entry(CFGCommon_ARG* cmdarg) {
           [](std::string msg) {
             CFG_post_msg(CFG_print("Progress....%s%%", msg.c_str()),
                          "INFO: ", false);
+            CFG_post_progress("otp", std::strtod(msg.c_str(), nullptr));
           },
           progress);
       if (Gui::GuiInterface()) {
@@ -468,6 +476,7 @@ void programmer_entry(CFGCommon_ARG* cmdarg) {
           [](std::string msg) {
             CFG_post_msg(CFG_print("Progress....%s%%", msg.c_str()),
                          "INFO: ", false);
+            CFG_post_progress("flash", std::strtod(msg.c_str(), nullptr));
           },
           progress);
       if (Gui::GuiInterface()) {
@@ -540,15 +549,18 @@ std::string GetErrorMessage(int errorCode) {
 
 int GetAvailableCables(std::vector<Cable>& cables) {
   OpenocdAdapter openOcd{libOpenOcdExecPath};
-  HardwareManager hardware_manager{&openOcd};
+  HardwareManager hardware_manager{&openOcd,
+                                   HardwareManager::shared_snapshot()};
   cables.clear();
+  hardware_manager.invalidate();
   cables = hardware_manager.get_cables();
   return ProgrammerErrorCode::NoError;
 }
 
 int ListDevices(const Cable& cable, std::vector<Device>& devices) {
   OpenocdAdapter openOcd{libOpenOcdExecPath};
-  HardwareManager hardware_manager{&openOcd};
+  HardwareManager hardware_manager{&openOcd,
+                                   HardwareManager::shared_snapshot()};
   if (!hardware_manager.is_cable_exists(cable.name)) {
     return ProgrammerErrorCode::CableNotFound;
   }
@@ -563,7 +575,8 @@ int ListDevices(const Cable& cable, std::vector<Device>& devices) {
 int GetFpgaStatus(const Cable& cable, const Device& device,
                   CfgStatus& cfgStatus, std::string& statusOutputPrint) {
   OpenocdAdapter openOcd{libOpenOcdExecPath};
-  HardwareManager hardware_manager{&openOcd};
+  HardwareManager hardware_manager{&openOcd,
+                                   HardwareManager::shared_snapshot()};
   ProgrammerTool programmer{&openOcd};
   Device detectedDevice;
   std::vector<Tap> taplist{};
@@ -581,7 +594,8 @@ int ProgramFpga(const Cable& cable, const Device& device,
                 OutputMessageCallback callbackMsg /*=nullptr*/,
                 ProgressCallback callbackProgress /*=nullptr*/) {
   OpenocdAdapter openOcd{libOpenOcdExecPath};
-  HardwareManager hardware_manager{&openOcd};
+  HardwareManager hardware_manager{&openOcd,
+                                   HardwareManager::shared_snapshot()};
   Device detectedDevice;
   std::vector<Tap> taplist{};
   std::string statusPrintOut;
@@ -602,7 +616,8 @@ int ProgramOTP(const Cable& cable, const Device& device,
                OutputMessageCallback callbackMsg /*=nullptr*/,
                ProgressCallback callbackProgress /*=nullptr*/) {
   OpenocdAdapter openOcd{libOpenOcdExecPath};
-  HardwareManager hardware_manager{&openOcd};
+  HardwareManager hardware_manager{&openOcd,
+                                   HardwareManager::shared_snapshot()};
   Device detectedDevice;
   std::vector<Tap> taplist{};
   std::string statusPrintOut;
@@ -626,7 +641,8 @@ int ProgramFlash(const Cable& cable, const Device& device,
                  OutputMessageCallback callbackMsg /*=nullptr*/,
                  ProgressCallback callbackProgress /*=nullptr*/) {
   OpenocdAdapter openOcd{libOpenOcdExecPath};
-  HardwareManager hardware_manager{&openOcd};
+  HardwareManager hardware_manager{&openOcd,
+                                   HardwareManager::shared_snapshot()};
   Device detectedDevice;
   std::vector<Tap> taplist{};
   std::string statusPrintOut;
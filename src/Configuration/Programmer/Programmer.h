@@ -85,7 +85,8 @@ std::string GetErrorMessage(int errorCode);
 
 /**
  * Returns a vector containing the available cables that is connected on the
- * host machine.
+ * host machine. The cables are scanned again and the cached cable and device
+ * information used by the other programmer functions is refreshed.
  *
  * @param cables A vector to store the available cables in.
  * @return 0 if the cables were retrieved successfully, or a non-zero error code
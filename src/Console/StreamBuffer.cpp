@@ -20,10 +20,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "StreamBuffer.h"
 
-#include "Command/Logger.h"
+#include <QTimer>
+#include <cstring>
 
 namespace FOEDAG {
 
+// delay between output and its appearance in the console
+static constexpr int consoleFlushDelayMs{30};
+// pending output size that is flushed without waiting for the delay
+static constexpr int consoleFlushSize{64 * 1024};
+
 StreamBuffer::StreamBuffer() : m_stream(this) {}
 
 std::ostream &StreamBuffer::getStream() { return m_stream; }
@@ -40,19 +46,117 @@ std::streamsize StreamBuffer::xsputn(const char_type *s,
   return count;
 }
 
-BatchModeBuffer::BatchModeBuffer(Logger *logger) : m_logger(logger) {}
+BatchModeBuffer::BatchModeBuffer(Logger *logger, LogSeverity severity)
+    : m_logger(logger), m_severity(severity) {
+  setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+BatchModeBuffer::~BatchModeBuffer() { flushBuffer(); }
 
 void BatchModeBuffer::output(const char_type *s, std::streamsize count) {
-  std::string str{s, static_cast<std::string::size_type>(count)};
-  m_logger->appendLog(str);
-  m_stream << str;
+  m_logger->write(s, count, m_severity);
+  m_stream.write(s, count);
 }
 
-TclConsoleBuffer::TclConsoleBuffer(QObject *parent) : QObject(parent) {}
+int BatchModeBuffer::overflow(int c) {
+  flushBuffer();
+  if (traits_type::eq_int_type(c, traits_type::eof()))
+    return traits_type::not_eof(c);
+  const char_type ch = traits_type::to_char_type(c);
+  *pptr() = ch;
+  pbump(1);
+  if (ch == '\n') flushBuffer();
+  return c;
+}
+
+std::streamsize BatchModeBuffer::xsputn(const char_type *s,
+                                        std::streamsize count) {
+  // large blocks bypass the buffer
+  if (count >= static_cast<std::streamsize>(m_buffer.size())) {
+    flushBuffer();
+    output(s, count);
+    return count;
+  }
+  const std::streamsize res = std::streambuf::xsputn(s, count);
+  if (std::memchr(s, '\n', count)) flushBuffer();
+  return res;
+}
+
+int BatchModeBuffer::sync() {
+  flushBuffer();
+  m_stream.flush();
+  return 0;
+}
+
+void BatchModeBuffer::flushBuffer() {
+  const std::streamsize count = pptr() - pbase();
+  if (count > 0) output(pbase(), count);
+  setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+TclConsoleBuffer::TclConsoleBuffer(QObject *parent)
+    : QObject(parent), m_timer(new QTimer{this}) {
+  m_timer->setSingleShot(true);
+  m_timer->setInterval(consoleFlushDelayMs);
+  connect(m_timer, &QTimer::timeout, this, &TclConsoleBuffer::flush);
+}
 
 void TclConsoleBuffer::output(const char_type *s, std::streamsize count) {
-  QByteArray array = QByteArray::fromRawData(s, count);
-  emit ready(array);
+  bool full{false};
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_pending.append(s, count);
+    full = m_pending.size() >= consoleFlushSize;
+  }
+  // one queued call per batch instead of one signal per write
+  if (full && !m_flushPosted.exchange(true)) {
+    QMetaObject::invokeMethod(this, &TclConsoleBuffer::flush,
+                              Qt::QueuedConnection);
+  } else if (!m_scheduled.exchange(true)) {
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+          if (!m_timer->isActive()) m_timer->start();
+        },
+        Qt::QueuedConnection);
+  }
+}
+
+// length of an incomplete UTF-8 sequence at the end of data
+static int incompleteUtf8Tail(const QByteArray &data) {
+  for (int i = 1; i <= 3 && i <= data.size(); i++) {
+    const uchar c = static_cast<uchar>(data.at(data.size() - i));
+    if ((c & 0xC0) == 0x80) continue;  // continuation byte
+    int length{1};
+    if ((c & 0xE0) == 0xC0)
+      length = 2;
+    else if ((c & 0xF0) == 0xE0)
+      length = 3;
+    else if ((c & 0xF8) == 0xF0)
+      length = 4;
+    return length > i ? i : 0;
+  }
+  return 0;
+}
+
+void TclConsoleBuffer::flush() {
+  m_flushPosted = false;
+  m_scheduled = false;
+  m_timer->stop();
+  if (m_peer) m_peer->flush();
+  QByteArray data;
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    data.swap(m_pending);
+    const int tail = incompleteUtf8Tail(data);
+    if (tail != 0) {
+      m_pending = data.right(tail);
+      data.chop(tail);
+    }
+  }
+  if (!data.isEmpty()) emit ready(QString::fromUtf8(data));
 }
 
+void TclConsoleBuffer::setPeer(TclConsoleBuffer *peer) { m_peer = peer; }
+
 }  // namespace FOEDAG
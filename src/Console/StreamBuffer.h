@@ -20,10 +20,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
 
+#include <QByteArray>
 #include <QObject>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <streambuf>
 
+#include "Command/Logger.h"
+
+class QTimer;
+
 namespace FOEDAG {
 
 class StreamBuffer : public std::streambuf {
@@ -41,24 +49,60 @@ class StreamBuffer : public std::streambuf {
   std::ostream m_stream;
 };
 
-class Logger;
+/*!
+ * \brief The BatchModeBuffer class is line buffered: writes are collected
+ * and passed to the log and the console once per line or when the buffer is
+ * full. Log text is queued with \a severity, see Logger flush policies.
+ */
 class BatchModeBuffer : public StreamBuffer {
  public:
-  explicit BatchModeBuffer(Logger *logger);
+  explicit BatchModeBuffer(Logger *logger,
+                           LogSeverity severity = LogSeverity::Info);
+  ~BatchModeBuffer() override;
   void output(const char_type *s, std::streamsize count) override;
 
+ protected:
+  int overflow(int c) override;
+  std::streamsize xsputn(const char_type *s, std::streamsize count) override;
+  int sync() override;
+
  private:
+  void flushBuffer();
+
   Logger *m_logger{};
+  LogSeverity m_severity{LogSeverity::Info};
+  std::array<char_type, 4096> m_buffer{};
 };
 
+/*!
+ * \brief The TclConsoleBuffer class collects console output written from
+ * any thread and emits it with ready() in batches: after a short delay or
+ * as soon as a size threshold is reached. ready() is emitted in the thread
+ * of the buffer (GUI thread).
+ */
 class TclConsoleBuffer : public QObject, public StreamBuffer {
   Q_OBJECT
  public:
   TclConsoleBuffer(QObject *parent = nullptr);
   void output(const char_type *s, std::streamsize count) override;
 
+  /*!
+   * \brief flush emits pending output immediately. Output of the peer buffer
+   * is emitted first.
+   */
+  void flush();
+  void setPeer(TclConsoleBuffer *peer);
+
  signals:
   void ready(const QString &str);
+
+ private:
+  QTimer *m_timer{nullptr};
+  TclConsoleBuffer *m_peer{nullptr};
+  std::mutex m_mutex;
+  QByteArray m_pending;
+  std::atomic_bool m_scheduled{false};
+  std::atomic_bool m_flushPosted{false};
 };
 
 }  // namespace FOEDAG
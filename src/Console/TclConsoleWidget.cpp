@@ -31,6 +31,8 @@ TclConsoleWidget::TclConsoleWidget(TclInterp *interp,
   connect(m_buffer, &TclConsoleBuffer::ready, this, &TclConsoleWidget::put);
   connect(m_errorBuffer, &TclConsoleBuffer::ready, this,
           &TclConsoleWidget::putError);
+  // output written before an error is shown before it
+  m_errorBuffer->setPeer(m_buffer);
   m_formatter.setTextEdit(this);
   if (m_console) {
     connect(m_console.get(), &ConsoleInterface::done, this,
@@ -159,6 +161,9 @@ void TclConsoleWidget::putError(const QString &str) {
 }
 
 void TclConsoleWidget::commandDone() {
+  // pending output must be shown before the prompt
+  m_errorBuffer->flush();
+  m_buffer->flush();
   if (!hasPrompt()) displayPrompt();
   setState(State::IDLE);
 }
@@ -169,9 +174,29 @@ void FOEDAG::TclConsoleWidget::putMessage(const QString &message,
     moveCursor(QTextCursor::End);
     LOG_OUTPUT(message);
     m_formatter.appendMessage(message, format);
+    trimScrollback();
   }
 }
 
+void TclConsoleWidget::trimScrollback() {
+  // trimmed in steps, not on every line once the limit is reached
+  constexpr int slack{MaxScrollback / 10};
+  if (document()->blockCount() <= MaxScrollback + slack) return;
+  int remove = document()->blockCount() - MaxScrollback;
+  // the prompt and the command being edited are kept
+  if (!isRunning()) remove = std::min(remove, promptParagraph);
+  if (remove <= 0) return;
+  const bool undo = isUndoRedoEnabled();
+  setUndoRedoEnabled(false);
+  QTextCursor cursor{document()};
+  cursor.movePosition(QTextCursor::Start);
+  cursor.movePosition(QTextCursor::NextBlock, QTextCursor::KeepAnchor, remove);
+  cursor.removeSelectedText();
+  setUndoRedoEnabled(undo);
+  // QConsole keeps the absolute block number of the prompt
+  promptParagraph = std::max(0, promptParagraph - remove);
+}
+
 void TclConsoleWidget::handleLink(const QPoint &p) {
   const QString anchor{anchorAt(p)};
   if (!anchor.isEmpty()) {
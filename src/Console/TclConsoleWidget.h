@@ -36,6 +36,7 @@ class TclConsoleWidget : public QConsole {
   TclConsoleBuffer *getBuffer();
   TclConsoleBuffer *getErrorBuffer();
   static const char *consoleObjectName();
+  static constexpr int MaxScrollback{100000};  // lines
 
   State state() const;
 
@@ -74,6 +75,7 @@ class TclConsoleWidget : public QConsole {
 
  private:
   void putMessage(const QString &message, OutputFormat format);
+  void trimScrollback();
   void setState(const State &state);
   void handleLink(const QPoint &p);
   void registerCommands(TclInterp *interp);
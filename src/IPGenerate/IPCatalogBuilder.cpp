@@ -35,8 +35,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Compiler/Log.h"
 #include "Compiler/WorkerThread.h"
+#include "IPGenerate/IPTemplateCache.h"
 #include "MainWindow/Session.h"
+#include "NewProject/ProjectManager/config.h"
 #include "Utils/FileUtils.h"
+#include "Utils/JobPool.h"
 #include "Utils/StringUtils.h"
 #include "nlohmann_json/json.hpp"
 
@@ -75,6 +78,7 @@ bool IPCatalogBuilder::buildLiteXCatalog(
     }
     m_compiler->Message("IP Catalog, browsing directory for IP generator(s): " +
                         execPath.string());
+    std::vector<std::filesystem::path> generators{};
     for (const std::filesystem::path& entry :
          std::filesystem::recursive_directory_iterator(
              execPath,
@@ -83,12 +87,16 @@ bool IPCatalogBuilder::buildLiteXCatalog(
       if (exec_name.find("__init__.py") != std::string::npos) continue;
       if (exec_name.find("_gen.py") != std::string::npos) {
         foundCount++;
-        bool res = namesOnly ? buildLiteXIPFromGeneratorInternal(catalog, entry)
-                             : buildLiteXIPFromGenerator(catalog, entry);
-        if (res == false) {
+        generators.push_back(entry);
+      }
+    }
+    if (namesOnly) {
+      for (const auto& generator : generators) {
+        if (!buildLiteXIPFromGeneratorInternal(catalog, generator))
           result = false;
-        }
       }
+    } else if (!buildLiteXIPFromGenerators(catalog, generators)) {
+      result = false;
     }
     std::string msg =
         std::string("IP Catalog, found ") + std::to_string(foundCount) + " IPs";
@@ -131,11 +139,14 @@ std::vector<std::string> JsonArrayToStringVector(
   return vals;
 }
 
-bool IPCatalogBuilder::buildLiteXIPFromGenerator(
-    IPCatalog* catalog, const std::filesystem::path& pythonConverterScript) {
+std::filesystem::path IPCatalogBuilder::pythonPath() const {
+  // Resolved once per session, the lookup walks the litex environment
+  static std::filesystem::path s_pythonPath{};
+  if (!s_pythonPath.empty()) return s_pythonPath;
+
   // Find path to litex enabled python interpreter
-  std::filesystem::path pythonPath = IPCatalog::getPythonPath();
-  if (pythonPath.empty()) {
+  s_pythonPath = IPCatalog::getPythonPath();
+  if (s_pythonPath.empty()) {
     std::filesystem::path python3Path = FileUtils::LocateExecFile("python3");
     if (python3Path.empty()) {
       m_compiler->ErrorMessage(
@@ -145,9 +156,9 @@ bool IPCatalogBuilder::buildLiteXIPFromGenerator(
           "interpreter.\n");
 
       // don't specify a path and hope the system finds something in its path
-      pythonPath = "python3";
+      s_pythonPath = "python3";
     } else {
-      pythonPath = python3Path;
+      s_pythonPath = python3Path;
       m_compiler->ErrorMessage(
           "IP Catalog, unable to find python interpreter in local "
           "environment, using system copy '" +
@@ -156,20 +167,68 @@ bool IPCatalogBuilder::buildLiteXIPFromGenerator(
           "interpreter.\n");
     }
   }
+  return s_pythonPath;
+}
 
-  std::ostringstream help;
-  std::string command = pythonPath.string() + " " +
-                        pythonConverterScript.string() + " --json-template";
-  StringVector args{pythonConverterScript.string(), "--json-template"};
-  if (FileUtils::ExecuteSystemCommand(pythonPath.string(), args, &help).code) {
-    m_compiler->ErrorMessage("IP Catalog, no IP information for " +
-                             pythonConverterScript.string() + "\n" +
-                             help.str());
-    return false;
+std::filesystem::path IPCatalogBuilder::templateCacheDir() {
+  return Config::Instance()->userSpacePath() / "ip_templates";
+}
+
+bool IPCatalogBuilder::buildLiteXIPFromGenerator(
+    IPCatalog* catalog, const std::filesystem::path& pythonConverterScript) {
+  return buildLiteXIPFromGenerators(catalog, {pythonConverterScript});
+}
+
+bool IPCatalogBuilder::buildLiteXIPFromGenerators(
+    IPCatalog* catalog, const std::vector<std::filesystem::path>& generators) {
+  const std::filesystem::path python = pythonPath();
+  const IPTemplateCache cache{templateCacheDir(), python};
+
+  std::vector<std::string> templates(generators.size());
+  std::vector<size_t> misses{};
+  for (size_t i = 0; i < generators.size(); i++) {
+    if (!cache.lookup(generators[i], templates[i])) misses.push_back(i);
   }
 
-  return buildLiteXIPFromJson(catalog, pythonConverterScript, help.str(),
-                              command);
+  // Generators are independent, query the missing templates on the shared
+  // pool
+  std::vector<Return> results(generators.size());
+  JobPool::global().parallelFor(
+      "ip_catalog", misses.size(), 0,
+      [&](size_t k, const CancellationToken& token) {
+        const size_t i = misses[k];
+        if (token.isCancelled()) {
+          results[i].code = -1;
+          return;
+        }
+        std::ostringstream help;
+        StringVector args{generators[i].string(), "--json-template"};
+        results[i] =
+            FileUtils::ExecuteSystemCommand(python.string(), args, &help);
+        templates[i] = help.str();
+      },
+      m_compiler->CancelToken());
+
+  bool result = true;
+  for (size_t i = 0; i < generators.size(); i++) {
+    const auto& script = generators[i];
+    if (results[i].code) {
+      m_compiler->ErrorMessage("IP Catalog, no IP information for " +
+                               script.string() + "\n" + templates[i]);
+      result = false;
+      continue;
+    }
+    std::string command =
+        python.string() + " " + script.string() + " --json-template";
+    const bool miss =
+        std::find(misses.begin(), misses.end(), i) != misses.end();
+    if (buildLiteXIPFromJson(catalog, script, templates[i], command)) {
+      if (miss) cache.store(script, templates[i]);
+    } else {
+      result = false;
+    }
+  }
+  return result;
 }
 
 bool IPCatalogBuilder::buildLiteXIPFromJson(
@@ -315,6 +374,17 @@ bool IPCatalogBuilder::buildLiteXIPFromGeneratorInternal(
   auto info = FOEDAG::getIpInfoFromPath(pythonConverterScript);
   IPName += "_" + info.version;
 
+  // Template is known from a previous session, no need to defer loading
+  std::string jsonTemplate{};
+  const IPTemplateCache cache{templateCacheDir(), pythonPath()};
+  if (cache.lookup(pythonConverterScript, jsonTemplate)) {
+    command = pythonPath().string() + " " + pythonConverterScript.string() +
+              " --json-template";
+    if (buildLiteXIPFromJson(catalog, pythonConverterScript, jsonTemplate,
+                             command))
+      return result;
+  }
+
   IPDefinition* def =
       new IPDefinition(IPDefinition::IPType::LiteXGenerator, IPName,
                        std::string{}, pythonConverterScript, {}, {});
@@ -52,6 +52,10 @@ class IPCatalogBuilder {
  protected:
   bool buildLiteXIPFromGeneratorInternal(
       IPCatalog* catalog, const std::filesystem::path& pythonConverterScript);
+  bool buildLiteXIPFromGenerators(
+      IPCatalog* catalog, const std::vector<std::filesystem::path>& generators);
+  std::filesystem::path pythonPath() const;
+  static std::filesystem::path templateCacheDir();
   Compiler* m_compiler = nullptr;
 };
 
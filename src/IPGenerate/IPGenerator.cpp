@@ -40,6 +40,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "MainWindow/Session.h"
 #include "NewProject/ProjectManager/project_manager.h"
 #include "Utils/FileUtils.h"
+#include "Utils/JobPool.h"
 #include "Utils/StringUtils.h"
 
 extern FOEDAG::Session* GlobalSession;
@@ -428,6 +429,9 @@ void IPGenerator::DeleteIPInstance(const std::string& moduleName) {
 bool IPGenerator::Generate() {
   bool status = true;
   Compiler* compiler = GetCompiler();
+  // -jobs applies to one ipgenerate call only
+  const unsigned int workers = compiler->IPGenJobs();
+  compiler->IPGenJobs(0);
   std::vector<IPInstance*> instances{};
 
   if (compiler->IPGenOpt() == Compiler::IPGenerateOpt::List) {
@@ -445,6 +449,8 @@ bool IPGenerator::Generate() {
     instances = m_instances;
   }
 
+  std::vector<GenerateJob> jobs{};
+
   for (IPInstance* inst : instances) {
     // Create output directory
     const std::filesystem::path& out_path = inst->OutputFile();
@@ -460,111 +466,144 @@ bool IPGenerator::Generate() {
       case IPDefinition::IPType::LiteXGenerator: {
         const std::filesystem::path executable = def->FilePath();
         std::filesystem::path jsonFile = GetCachePath(inst);
-        std::stringstream previousbuffer;
-        if (FileUtils::FileExists(jsonFile)) {
-          std::ifstream previous(jsonFile);
-          std::stringstream buffer;
-          previousbuffer << previous.rdbuf();
-        }
-
-        // Create directory path if it doesn't exist otherwise the following
-        // ofstream command will fail
-        FileUtils::MkDirs(jsonFile.parent_path());
-        std::ofstream jsonF(jsonFile);
-        jsonF << "{" << std::endl;
-        for (const auto& param : inst->Parameters()) {
-          std::string value;
-          // The configure_ip command loses type info because we go from full
-          // json meta data provided by the ip_catalog generators to a single
-          // -Pname=val argument in a tcl command line. As such, we'll use the
-          // ip catalog's definition for parameter type info
-          auto catalogParam = GetCatalogParam(inst, param.Name());
-          if (catalogParam) {
-            switch (catalogParam->GetType()) {
-              case Value::Type::ParamIpVal: {
-                value = param.GetSValue();
-                auto type = ((IPParameter*)catalogParam)->GetParamType();
-                if (type == IPParameter::ParamType::FilePath ||
-                    type == IPParameter::ParamType::String) {
-                  value = "\"" + value + "\"";
-                }
-                break;
-              }
-              case Value::Type::ParamString:
-                value = param.GetSValue();
-                value = "\"" + value + "\"";
-                break;
-              case Value::Type::ParamInt:
-                value = param.GetSValue();
-                break;
-              case Value::Type::ConstInt:
-                value = param.GetSValue();
-            }
-          }
-          jsonF << "   \"" << param.Name() << "\": " << value << ","
-                << std::endl;
-        }
-        jsonF << "   \"build_dir\": " << inst->OutputFile().parent_path() << ","
-              << std::endl;
-        jsonF << "   \"build_name\": " << inst->OutputFile().filename() << ","
-              << std::endl;
-        jsonF << "   \"build\": true," << std::endl;
-        jsonF << "   \"json\": \"" << jsonFile.filename().string() << "\","
-              << std::endl;
-        jsonF << "   \"json_template\": false" << std::endl;
-        jsonF << "}" << std::endl;
-        jsonF.close();
-        std::stringstream newbuffer;
-        if (FileUtils::FileExists(jsonFile)) {
-          std::ifstream newfile(jsonFile);
-          std::stringstream buffer;
-          newbuffer << newfile.rdbuf();
-        }
-        if (newbuffer.str() == previousbuffer.str()) {
+        const std::string previous = FileUtils::GetFileContent(jsonFile);
+        const std::string config = GetGeneratorConfig(inst, jsonFile);
+        if (FileUtils::FileExists(jsonFile) && config == previous) {
           m_compiler->Message("IP Generate, reusing IP " +
                               GetBuildDir(inst).string());
           continue;
         }
 
-        // Find path to litex enabled python interpreter
-        std::filesystem::path pythonPath = IPCatalog::getPythonPath();
-        if (pythonPath.empty()) {
-          std::filesystem::path python3Path =
-              FileUtils::LocateExecFile("python3");
-          if (python3Path.empty()) {
-            m_compiler->ErrorMessage(
-                "IP Generate, unable to find python interpreter in local "
-                "environment.\n");
-            return false;
-          } else {
-            pythonPath = python3Path;
-            m_compiler->ErrorMessage(
-                "IP Generate, unable to find python interpreter in local "
-                "environment, using system copy '" +
-                python3Path.string() +
-                "'. Some IP Catalog features might not work with this "
-                "interpreter.\n");
-          }
-        }
+        // Create directory path if it doesn't exist otherwise the following
+        // write will fail
+        FileUtils::MkDirs(jsonFile.parent_path());
+        FileUtils::WriteToFile(jsonFile, config, false);
 
         StringVector args{executable.string(), "--build", "--json",
                           FileUtils::GetFullPath(jsonFile).string()};
-        std::ostringstream help;
-        m_compiler->Message("IP Generate, generating IP " +
-                            GetBuildDir(inst).string());
-        if (FileUtils::ExecuteSystemCommand(pythonPath.string(), args, &help)
-                .code) {
-          m_compiler->ErrorMessage("IP Generate, " + help.str());
-          return false;
-        }
-
+        jobs.push_back({inst, args});
         break;
       }
     }
   }
+  if (jobs.empty()) return status;
+
+  // Find path to litex enabled python interpreter
+  std::filesystem::path pythonPath = IPCatalog::getPythonPath();
+  if (pythonPath.empty()) {
+    std::filesystem::path python3Path = FileUtils::LocateExecFile("python3");
+    if (python3Path.empty()) {
+      m_compiler->ErrorMessage(
+          "IP Generate, unable to find python interpreter in local "
+          "environment.\n");
+      return false;
+    } else {
+      pythonPath = python3Path;
+      m_compiler->ErrorMessage(
+          "IP Generate, unable to find python interpreter in local "
+          "environment, using system copy '" +
+          python3Path.string() +
+          "'. Some IP Catalog features might not work with this "
+          "interpreter.\n");
+    }
+  }
+
+  return RunGenerators(pythonPath, jobs, workers);
+}
+
+bool IPGenerator::RunGenerators(const std::filesystem::path& python,
+                                std::vector<GenerateJob>& jobs,
+                                unsigned int workers) {
+  bool status = true;
+  // IP instances are independent, run the generators on the shared pool.
+  // Output is captured per IP and reported below in instance order.
+  for (const auto& job : jobs) {
+    m_compiler->Message("IP Generate, generating IP " +
+                        GetBuildDir(job.inst).string());
+  }
+  JobPool::global().parallelFor(
+      "ip_generate", jobs.size(), workers,
+      [&jobs, &python](size_t i, const CancellationToken& token) {
+        auto& job = jobs[i];
+        if (token.isCancelled()) {
+          job.code = -1;
+          job.output = "Cancelled";
+          return;
+        }
+        std::ostringstream help;
+        auto start = Time::now();
+        job.code =
+            FileUtils::ExecuteSystemCommand(python.string(), job.args, &help)
+                .code;
+        job.duration = std::chrono::duration_cast<ms>(Time::now() - start);
+        job.output = help.str();
+      },
+      m_compiler->CancelToken());
+
+  for (const auto& job : jobs) {
+    const std::string name = job.inst->ModuleName();
+    const std::string duration = std::to_string(job.duration.count()) + " ms";
+    if (job.code) {
+      m_compiler->ErrorMessage("IP Generate, " + name + " failed after " +
+                               duration + "\n" + job.output);
+      // Remove configuration so the next run doesn't reuse a failed build
+      FileUtils::removeFile(GetCachePath(job.inst));
+      status = false;
+    } else {
+      m_compiler->Message("IP Generate, " + name + " generated in " +
+                          duration);
+    }
+  }
   return status;
 }
 
+std::string IPGenerator::GetGeneratorConfig(
+    IPInstance* inst, const std::filesystem::path& jsonFile) {
+  std::ostringstream jsonF;
+  jsonF << "{" << std::endl;
+  for (const auto& param : inst->Parameters()) {
+    std::string value;
+    // The configure_ip command loses type info because we go from full
+    // json meta data provided by the ip_catalog generators to a single
+    // -Pname=val argument in a tcl command line. As such, we'll use the
+    // ip catalog's definition for parameter type info
+    auto catalogParam = GetCatalogParam(inst, param.Name());
+    if (catalogParam) {
+      switch (catalogParam->GetType()) {
+        case Value::Type::ParamIpVal: {
+          value = param.GetSValue();
+          auto type = ((IPParameter*)catalogParam)->GetParamType();
+          if (type == IPParameter::ParamType::FilePath ||
+              type == IPParameter::ParamType::String) {
+            value = "\"" + value + "\"";
+          }
+          break;
+        }
+        case Value::Type::ParamString:
+          value = param.GetSValue();
+          value = "\"" + value + "\"";
+          break;
+        case Value::Type::ParamInt:
+          value = param.GetSValue();
+          break;
+        case Value::Type::ConstInt:
+          value = param.GetSValue();
+      }
+    }
+    jsonF << "   \"" << param.Name() << "\": " << value << "," << std::endl;
+  }
+  jsonF << "   \"build_dir\": " << inst->OutputFile().parent_path() << ","
+        << std::endl;
+  jsonF << "   \"build_name\": " << inst->OutputFile().filename() << ","
+        << std::endl;
+  jsonF << "   \"build\": true," << std::endl;
+  jsonF << "   \"json\": \"" << jsonFile.filename().string() << "\","
+        << std::endl;
+  jsonF << "   \"json_template\": false" << std::endl;
+  jsonF << "}" << std::endl;
+  return jsonF.str();
+}
+
 std::pair<bool, std::string> IPGenerator::IsSimulateIpSupported(
     const std::string& name) const {
   auto it =
@@ -22,6 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef IPGENERATOR_H
 #define IPGENERATOR_H
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -57,6 +58,17 @@ class IPGenerator {
     m_instances.erase(m_instances.begin(), m_instances.end());
   }
   bool Generate();
+  struct GenerateJob {
+    IPInstance* inst{nullptr};
+    std::vector<std::string> args{};
+    std::string output{};
+    int code{0};
+    std::chrono::milliseconds duration{0};
+  };
+  // Runs the generators on at most 'workers' threads (0: pool size), the
+  // results are reported in the order of 'jobs'
+  bool RunGenerators(const std::filesystem::path& python,
+                     std::vector<GenerateJob>& jobs, unsigned int workers);
   std::pair<bool, std::string> IsSimulateIpSupported(
       const std::string& name) const;
   void SimulateIp(const std::string& name);
@@ -77,6 +89,8 @@ class IPGenerator {
 
  protected:
   std::pair<bool, std::string> SimulateIpTcl(const std::string& name);
+  std::string GetGeneratorConfig(IPInstance* inst,
+                                 const std::filesystem::path& jsonFile);
 
  protected:
   IPCatalog* m_catalog = nullptr;
@@ -0,0 +1,97 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "IPGenerate/IPTemplateCache.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+
+#include "Utils/FileUtils.h"
+#include "nlohmann_json/json.hpp"
+
+using json = nlohmann::ordered_json;
+using namespace FOEDAG;
+
+IPTemplateCache::IPTemplateCache(const std::filesystem::path& cacheDir,
+                                 const std::filesystem::path& interpreter)
+    : m_cacheDir(cacheDir), m_interpreterId(interpreterId(interpreter)) {}
+
+std::string IPTemplateCache::interpreterId(
+    const std::filesystem::path& interpreter) {
+  QFileInfo info{QString::fromStdString(interpreter.string())};
+  // follow virtual environment links to the real binary
+  QString target = info.canonicalFilePath();
+  if (target.isEmpty()) return interpreter.string();
+  QFileInfo real{target};
+  return QString{"%1:%2:%3"}
+      .arg(target)
+      .arg(real.size())
+      .arg(real.lastModified().toSecsSinceEpoch())
+      .toStdString();
+}
+
+std::string IPTemplateCache::fileHash(const std::filesystem::path& file) {
+  QFile f{QString::fromStdString(file.string())};
+  if (!f.open(QFile::ReadOnly)) return {};
+  QCryptographicHash hash{QCryptographicHash::Sha1};
+  hash.addData(&f);
+  return hash.result().toHex().toStdString();
+}
+
+std::filesystem::path IPTemplateCache::entryFile(
+    const std::filesystem::path& generator) const {
+  const QByteArray path =
+      QByteArray::fromStdString(generator.lexically_normal().string());
+  const auto name =
+      QCryptographicHash::hash(path, QCryptographicHash::Sha1).toHex();
+  return m_cacheDir / (name.toStdString() + ".json");
+}
+
+bool IPTemplateCache::lookup(const std::filesystem::path& generator,
+                             std::string& jsonTemplate) const {
+  if (m_cacheDir.empty()) return false;
+  const auto entry = entryFile(generator);
+  if (!FileUtils::FileExists(entry)) return false;
+  try {
+    json cached = json::parse(FileUtils::GetFileContent(entry));
+    if (cached.value("interpreter", std::string{}) != m_interpreterId)
+      return false;
+    if (cached.value("hash", std::string{}) != fileHash(generator))
+      return false;
+    jsonTemplate = cached.value("template", std::string{});
+  } catch (json::exception&) {
+    return false;
+  }
+  return !jsonTemplate.empty();
+}
+
+void IPTemplateCache::store(const std::filesystem::path& generator,
+                            const std::string& jsonTemplate) const {
+  if (m_cacheDir.empty()) return;
+  if (!FileUtils::FileExists(m_cacheDir) && !FileUtils::MkDirs(m_cacheDir))
+    return;
+  json entry;
+  entry["generator"] = generator.string();
+  entry["interpreter"] = m_interpreterId;
+  entry["hash"] = fileHash(generator);
+  entry["template"] = jsonTemplate;
+  FileUtils::WriteToFile(entryFile(generator), entry.dump(), false);
+}
@@ -0,0 +1,55 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace FOEDAG {
+
+// On-disk cache of the '--json-template' output of LiteX IP generators.
+// Entries are keyed by the generator content hash and the interpreter used to
+// produce them, so editing a generator or switching the python environment
+// invalidates the entry.
+class IPTemplateCache {
+ public:
+  IPTemplateCache(const std::filesystem::path& cacheDir,
+                  const std::filesystem::path& interpreter);
+
+  bool lookup(const std::filesystem::path& generator,
+              std::string& jsonTemplate) const;
+  void store(const std::filesystem::path& generator,
+             const std::string& jsonTemplate) const;
+
+  // Identifies the interpreter without launching it: resolved path, size and
+  // modification time of the executable
+  static std::string interpreterId(const std::filesystem::path& interpreter);
+  static std::string fileHash(const std::filesystem::path& file);
+
+ private:
+  std::filesystem::path entryFile(
+      const std::filesystem::path& generator) const;
+
+  std::filesystem::path m_cacheDir;
+  std::string m_interpreterId;
+};
+
+}  // namespace FOEDAG
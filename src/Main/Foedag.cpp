@@ -60,7 +60,9 @@ extern "C" {
 #include "ProjNavigator/tcl_command_integration.h"
 #include "ProjectFile/ProjectFileLoader.h"
 #include "Tcl/TclInterpreter.h"
+#include "Utils/EventBus.h"
 #include "Utils/FileUtils.h"
+#include "Utils/JobPool.h"
 #include "qttclnotifier.hpp"
 
 #if defined(_MSC_VER)
@@ -145,6 +147,15 @@ static std::filesystem::path GetProgramNameAbsolutePath(const char* progname) {
   return progname;  // Didn't find anything, return progname as-is.
 }
 
+// Wait and run time of every pool job goes to the event bus as metrics
+static void InstallJobMetrics() {
+  JobPool::global().setTimingHook([](const JobTiming& timing) {
+    const std::string name = timing.name.empty() ? "job" : timing.name;
+    EventBus::metric("jobs", name + "_wait_ms", timing.waitMs());
+    EventBus::metric("jobs", name + "_run_ms", timing.runMs());
+  });
+}
+
 void loadTclInitFile(CommandStack* commandStack, ToolContext* context) {
   if (!commandStack) return;
 
@@ -191,6 +202,7 @@ Foedag::Foedag(FOEDAG::CommandLine* cmdLine, MainWindowBuilder* mainWinBuilder,
     m_context->DataPath(dataDir);
     Config::Instance()->executable(m_context->ExecutableName());
   }
+  InstallJobMetrics();
 }
 
 Foedag::~Foedag() { delete m_tclChannelHandler; }
@@ -418,7 +430,8 @@ bool Foedag::initBatch() {
   auto tmp = std::cout.rdbuf(outBuffer);
   outBuffer->getStream().rdbuf(mute ? nullptr : tmp);
 
-  BatchModeBuffer* errBuffer = new BatchModeBuffer{commands->OutLogger()};
+  BatchModeBuffer* errBuffer =
+      new BatchModeBuffer{commands->OutLogger(), LogSeverity::Error};
   tmp = std::cerr.rdbuf(errBuffer);
   errBuffer->getStream().rdbuf(mute ? nullptr : tmp);
   if (!mute) {
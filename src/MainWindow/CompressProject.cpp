@@ -21,14 +21,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "CompressProject.h"
 
 #include <QBoxLayout>
+#include <QCheckBox>
+#include <QCoreApplication>
+#include <QFileDialog>
 #include <QGroupBox>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QRadioButton>
+#include <QToolButton>
 
 #include "MainWindow/PathEdit.h"
 #include "Utils/FileUtils.h"
+#include "Utils/ProjectArchive.h"
 #include "Utils/StringUtils.h"
 
 namespace FOEDAG {
@@ -50,7 +56,6 @@ CompressProject::CompressProject(const fs::path &project, QWidget *parent)
   QVBoxLayout *layout = new QVBoxLayout{};
   layout->addLayout(grid);
 
-#ifndef _WIN32
   QGroupBox *groupBox = new QGroupBox("Select compress parameter");
   QRadioButton *radio1 = new QRadioButton("*.zip");
   radio1->setProperty("ext", ".zip");
@@ -66,8 +71,48 @@ CompressProject::CompressProject(const fs::path &project, QWidget *parent)
           &CompressProject::extensionHasChanged);
   connect(radio2, &QRadioButton::toggled, this,
           &CompressProject::extensionHasChanged);
+
+  // *.tar.gz archives are written by ProjectArchive, which filters files and
+  // leaves out files unchanged since a previous archive
+  m_tarOptions = new QWidget;
+  QGridLayout *tarLayout = new QGridLayout;
+  tarLayout->setContentsMargins(0, 0, 0, 0);
+  const std::vector<std::pair<QString, uint32_t>> artifacts{
+      {"Sources", ArchiveSources},
+      {"Synthesis", ArchiveSynthesis},
+      {"Place && Route", ArchivePlaceRoute},
+      {"Bitstream", ArchiveBitstream},
+      {"Reports", ArchiveReports},
+      {"Logs", ArchiveLogs},
+      {"Other files", ArchiveOther}};
+  int column{0};
+  for (const auto &[name, artifact] : artifacts) {
+    auto checkBox = new QCheckBox{name};
+    checkBox->setObjectName("artifact");
+    checkBox->setProperty("artifact", artifact);
+    checkBox->setChecked(true);
+    tarLayout->addWidget(checkBox, column / 4, column % 4);
+    column++;
+  }
+  QLineEdit *previousArchive = new QLineEdit;
+  previousArchive->setObjectName("previousArchive");
+  previousArchive->setPlaceholderText("Store all files");
+  QToolButton *browse = new QToolButton;
+  browse->setText("...");
+  connect(browse, &QToolButton::clicked, this, [this, previousArchive]() {
+    auto file = QFileDialog::getOpenFileName(
+        this, "Select Previous Archive", previousArchive->text(),
+        "Archives (*.tar.gz)", nullptr, QFileDialog::DontUseNativeDialog);
+    if (!file.isEmpty()) previousArchive->setText(file);
+  });
+  QHBoxLayout *previousLayout = new QHBoxLayout;
+  previousLayout->addWidget(new QLabel{"Skip files unchanged since:"});
+  previousLayout->addWidget(previousArchive);
+  previousLayout->addWidget(browse);
+  tarLayout->addLayout(previousLayout, 2, 0, 1, 4);
+  m_tarOptions->setLayout(tarLayout);
+  layout->addWidget(m_tarOptions);
   radio1->setChecked(true);
-#endif
 
   initDialogBox(layout, Dialog::Ok | Dialog::Cancel);
   setLayout(layout);
@@ -111,18 +156,9 @@ void CompressProject::compressProject() {
     auto projectPath = projectPathLine->text().toStdString();
     auto originalProjectPath = m_projectPath.parent_path().string();
     if (m_extension == ".tar.gz") {
-      // tar -czvf file.tar.gz directory
-      StringVector args{"-czvf", projectName + m_extension.toStdString(), "-C",
-                        originalProjectPath, m_projectPath.filename().string()};
-      args = std::accumulate(
-          m_additionalPath.begin(), m_additionalPath.end(), args,
-          [](StringVector &vec, const fs::path &path) {
-            vec.push_back("-C");  // change directory before add file
-            vec.push_back(path.parent_path().string());
-            vec.push_back(path.filename().string());
-            return vec;
-          });
-      if (auto res = ExecuteSystemCommand("tar", args, projectPath); !res.first)
+      auto archive =
+          fs::path{projectPath} / (projectName + m_extension.toStdString());
+      if (auto res = CompressTarGz(archive); !res.first)
         showErrorMessage(res.second, this);
     } else {
       // zip -r foo.zip foo
@@ -147,6 +183,42 @@ void CompressProject::compressProject() {
 
 void CompressProject::extensionHasChanged(bool checked) {
   if (checked) m_extension = sender()->property("ext").toString();
+  if (m_tarOptions) m_tarOptions->setEnabled(m_extension == ".tar.gz");
+}
+
+std::pair<bool, std::string> CompressProject::CompressTarGz(
+    const fs::path &archive) {
+  ProjectArchive projectArchive;
+  projectArchive.addPath(m_projectPath);
+  for (const auto &path : m_additionalPath) projectArchive.addPath(path);
+
+  ArchiveOptions options;
+  options.artifacts = 0;
+  for (auto checkBox : findChildren<QCheckBox *>("artifact")) {
+    if (checkBox->isChecked())
+      options.artifacts |= checkBox->property("artifact").toUInt();
+  }
+  if (auto previous = findChild<QLineEdit *>("previousArchive");
+      previous && !previous->text().isEmpty()) {
+    options.previousManifest = ProjectArchive::manifestPath(
+        previous->text().toStdString());
+    if (!fs::exists(options.previousManifest))
+      return {false, "No manifest found for " + previous->text().toStdString()};
+  }
+
+  QProgressDialog progress{"Compressing project...", "Cancel", 0, 1000,
+                           parentWidget()};
+  progress.setWindowTitle(windowTitle());
+  progress.setWindowModality(Qt::WindowModal);
+  progress.setMinimumDuration(500);
+  std::atomic<bool> cancel{false};
+  options.cancel = &cancel;
+  options.progress = [&progress, &cancel](uint64_t done, uint64_t total) {
+    if (total != 0) progress.setValue(static_cast<int>(done * 1000 / total));
+    QCoreApplication::processEvents();
+    if (progress.wasCanceled()) cancel = true;
+  };
+  return projectArchive.write(archive, options);
 }
 
 std::pair<bool, std::string> CompressProject::ExecuteSystemCommand(
@@ -49,9 +49,13 @@ class CompressProject : public Dialog {
       const std::string& workingDir);
   static void showErrorMessage(const std::string& message, QWidget* parent);
 
+ private:
+  std::pair<bool, std::string> CompressTarGz(const fs::path& archive);
+
  private:
   QString m_extension;
   const fs::path m_projectPath;
   std::vector<fs::path> m_additionalPath{};
+  QWidget* m_tarOptions{nullptr};
 };
 }  // namespace FOEDAG
@@ -31,8 +31,11 @@ namespace FOEDAG {
 PerfomanceTracker::PerfomanceTracker(TaskManager *tManager)
     : m_taskManager(tManager) {
   m_view = new QTableWidget;
-  m_view->setColumnCount(3);
-  m_view->setHorizontalHeaderLabels({"Task", "Duration, s", "Utilization, MB"});
+  const QStringList header{"Task",         "Duration, s",   "Peak RSS, MB",
+                           "Peak PSS, MB", "CPU user, s",   "CPU system, s",
+                           "I/O read, MB", "I/O write, MB", "Context switches"};
+  m_view->setColumnCount(header.size());
+  m_view->setHorizontalHeaderLabels(header);
   m_view->verticalHeader()->hide();
   m_view->resizeColumnsToContents();
   m_view->setColumnWidth(0, 180);
@@ -62,13 +65,28 @@ void PerfomanceTracker::buildTable() {
     auto task = m_taskManager->task(taskId);
     if (!task) continue;
 
-    for (int i = 0; i < 3; i++) m_view->setItem(row, i, new QTableWidgetItem{});
+    for (int i = 0; i < m_view->columnCount(); i++)
+      m_view->setItem(row, i, new QTableWidgetItem{});
 
+    const auto utils = task->utilization();
+    const ProcessStats &stats = utils.stats;
     m_view->item(row, 0)->setText(task->title());
     m_view->item(row, 1)->setText(
-        ToString(static_cast<double>(task->utilization().duration) / 1000));
+        ToString(static_cast<double>(utils.duration) / 1000));
     m_view->item(row, 2)->setText(
-        ToString(static_cast<double>(task->utilization().utilization) / 1024));
+        ToString(static_cast<double>(utils.utilization) / 1024));
+    m_view->item(row, 3)->setText(
+        ToString(static_cast<double>(stats.peakPss) / 1024));
+    m_view->item(row, 4)->setText(
+        ToString(static_cast<double>(stats.userTime) / 1000));
+    m_view->item(row, 5)->setText(
+        ToString(static_cast<double>(stats.systemTime) / 1000));
+    m_view->item(row, 6)->setText(
+        ToString(static_cast<double>(stats.readBytes) / (1024 * 1024)));
+    m_view->item(row, 7)->setText(
+        ToString(static_cast<double>(stats.writeBytes) / (1024 * 1024)));
+    m_view->item(row, 8)->setText(ToString(static_cast<double>(
+        stats.voluntaryCtxSwitches + stats.involuntaryCtxSwitches)));
     row++;
   }
 }
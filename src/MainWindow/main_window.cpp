@@ -80,6 +80,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Tasks.h"
 #include "TextEditor/text_editor.h"
 #include "TextEditor/text_editor_form.h"
+#include "Utils/EventBus.h"
 #include "Utils/FileUtils.h"
 #include "Utils/QtUtils.h"
 #include "Utils/StringUtils.h"
@@ -114,6 +115,7 @@ constexpr const char* DEFAULT_PROJECT_PATH{"defaultProjectPath"};
 constexpr const char* PIN_PLANNER_PIN_NAME{"pinPlannerPinName"};
 
 constexpr const char* WelcomePage{"welcomePage"};
+constexpr int EventFrameInterval{33};  // ms, GUI refresh of bus events
 
 void centerWidget(QWidget& widget) {
   auto screenGeometry = qApp->primaryScreen()->availableGeometry();
@@ -234,6 +236,12 @@ MainWindow::MainWindow(Session* session)
   connect(this, &MainWindow::closeRequest, this, &MainWindow::close,
           Qt::QueuedConnection);
 
+  // simulator and programmer progress, and the event log when it is started
+  // from the console
+  EventBus::attach();
+  connect(&m_eventTimer, &QTimer::timeout, this, &MainWindow::drainEvents);
+  m_eventTimer.start(EventFrameInterval);
+
   // Initially, main window should be maximized.
   showMaximized();
 }
@@ -1893,6 +1901,32 @@ void MainWindow::pinPlannerSaved() {
   }
   QtUtils::AppendToEventQueue([this]() { setVisibleRefreshButtons(false); });
 }
+MainWindow::~MainWindow() {
+  m_eventTimer.stop();
+  EventBus::detach();
+}
+
+void MainWindow::drainEvents() {
+  std::vector<FlowEvent> events;
+  EventBus::drain(events);
+  if (events.empty()) return;
+  EventLog::write(events);
+  EventBus::coalesce(events);
+  // compiler stages, messages and logs already reach the task view and the
+  // console
+  for (const auto& event : events) {
+    if (event.type != FlowEvent::Type::Progress || event.source == "compiler")
+      continue;
+    QString text = QString("%1 %2: ").arg(QString::fromStdString(event.source),
+                                          QString::fromStdString(event.name));
+    if (event.total == 100)
+      text += QString::number(event.value, 'f', 0) + "%";
+    else
+      text += QString("%1/%2").arg(event.value).arg(event.total);
+    setStatusAndProgressText(text);
+  }
+}
+
 void MainWindow::setStatusAndProgressText(const QString& text) {
   m_progressWidgetLbl->setText("<strong>STATUS</strong> " + text);
   m_progressWidgetLbl->setVisible(!text.isEmpty());
@@ -1946,6 +1980,7 @@ void MainWindow::compressProject() {
   auto cmdStack = GlobalSession->CmdStack();
   auto logs = {cmdStack->CmdLogger(), cmdStack->OutLogger(),
                cmdStack->PerfLogger()};
+  Logger::flushAll();
   for (auto logger : logs) {
     cProject.appendPathForArchive(std::filesystem::current_path() /
                                   logger->fileName());
@@ -24,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QMainWindow>
 #include <QSettings>
+#include <QTimer>
 
 #include "Main/AboutWidget.h"
 #include "NewProject/new_project_dialog.h"
@@ -51,6 +52,7 @@ class MainWindow : public QMainWindow, public TopLevelInterface {
 
  public: /*-- Constructor --*/
   MainWindow(Session* session);
+  ~MainWindow() override;
 
   newProjectDialog* NewProjectDialog() { return newProjdialog; }
   void Info(const ProjectInfo& info);
@@ -147,6 +149,7 @@ class MainWindow : public QMainWindow, public TopLevelInterface {
   void createToolBars();
   void createActions();
   void createProgressBar();
+  void drainEvents();
   void createRecentMenu();
   void connectProjectManager();
   void gui_start(bool showWP) override;
@@ -282,6 +285,7 @@ class MainWindow : public QMainWindow, public TopLevelInterface {
   PerfomanceTracker m_perfomanceTracker;
   bool m_closeRequest{false};
   QObjectContainer m_projectEnables{};
+  QTimer m_eventTimer;
 };
 
 }  // namespace FOEDAG
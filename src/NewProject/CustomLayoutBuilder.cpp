@@ -25,6 +25,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QFile>
 #include <cmath>
 
+#include "ProjectManager/DeviceCatalog.h"
 #include "Utils/FileUtils.h"
 #include "nlohmann_json/json.hpp"
 using json = nlohmann::ordered_json;
@@ -182,6 +183,7 @@ std::pair<bool, QString> CustomLayoutBuilder::generateNewDevice(
           stream.setDevice(&targetDevice);
           newDoc.save(stream, 4);
           targetDevice.close();
+          DeviceCatalog::Instance()->invalidate(targetDeviceXml.toStdString());
           return {true, QString{}};
         }
         return {false, "Failed to modify custom device list"};
@@ -222,6 +224,7 @@ std::pair<bool, QString> CustomLayoutBuilder::modifyDevice(
         stream.setDevice(&file);
         doc.save(stream, 4);
         file.close();
+        DeviceCatalog::Instance()->invalidate(targetDeviceXml.toStdString());
         return {true, QString{}};
       }
     }
@@ -259,6 +262,7 @@ std::pair<bool, QString> CustomLayoutBuilder::removeDevice(
       stream.setDevice(&targetDevice);
       newDoc.save(stream, 4);
       targetDevice.close();
+      DeviceCatalog::Instance()->invalidate(deviceXml.toStdString());
     }
   }
   // remove layout file <custom device name>.xml
@@ -0,0 +1,217 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "DeviceCatalog.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QXmlStreamReader>
+
+namespace FOEDAG {
+
+static QString key(const std::filesystem::path &file) {
+  return QString::fromStdString(file.lexically_normal().string());
+}
+
+QVector<const DeviceEntry *> DeviceList::find(const QString &name) const {
+  QVector<const DeviceEntry *> result;
+  auto it = byName.find(name);
+  if (it != byName.end()) {
+    for (int index : it.value()) result.append(&devices.at(index));
+  }
+  return result;
+}
+
+DeviceCatalog *DeviceCatalog::Instance() {
+  static DeviceCatalog catalog{};
+  return &catalog;
+}
+
+DeviceCatalog::Stamp DeviceCatalog::stamp(const QString &file) {
+  QFileInfo info{file};
+  if (!info.exists()) return {};
+  return {info.lastModified(), info.size()};
+}
+
+DeviceListPtr DeviceCatalog::parse(QIODevice *device) {
+  auto list = std::make_shared<DeviceList>();
+  QXmlStreamReader reader{device};
+  // depth 1: device list root, 2: device, 3: resource/internal
+  int depth{0};
+  while (!reader.atEnd()) {
+    auto token = reader.readNext();
+    if (token == QXmlStreamReader::StartElement) {
+      depth++;
+      const auto attr = reader.attributes();
+      if (depth == 2) {
+        DeviceEntry entry{};
+        entry.name = attr.value("name").toString();
+        entry.series = attr.value("series").toString();
+        entry.family = attr.value("family").toString();
+        entry.package = attr.value("package").toString();
+        entry.pinCount = attr.value("pin_count").toString();
+        entry.speedGrade = attr.value("speedgrade").toString();
+        entry.coreVoltage = attr.value("core_voltage").toString();
+        list->devices.append(entry);
+      } else if (depth == 3 && !list->devices.isEmpty()) {
+        auto &entry = list->devices.last();
+        if (reader.name() == QLatin1String("resource")) {
+          entry.resources.append({attr.value("type").toString(),
+                                  attr.value("label").toString(),
+                                  attr.value("num").toString()});
+        } else if (reader.name() == QLatin1String("internal")) {
+          entry.internals.append(
+              {attr.value("type").toString(), attr.value("file").toString(),
+               attr.value("name").toString(), attr.value("num").toString()});
+        }
+      }
+    } else if (token == QXmlStreamReader::EndElement) {
+      depth--;
+    }
+  }
+  if (reader.hasError()) {
+    list->status = DeviceList::Malformed;
+    list->error = reader.errorString();
+    list->devices.clear();
+    return list;
+  }
+  list->status = DeviceList::Ok;
+  for (int i = 0; i < list->devices.size(); i++) {
+    const auto &entry = list->devices.at(i);
+    list->byName[entry.name].append(i);
+    list->bySeries[entry.series][entry.family][entry.package].append(i);
+  }
+  return list;
+}
+
+DeviceListPtr DeviceCatalog::deviceList(const std::filesystem::path &file) {
+  const QString path = key(file);
+  const Stamp current = stamp(path);
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_lists.find(path);
+    if (it != m_lists.end() && it->stamp == current) return it->data;
+  }
+
+  DeviceListPtr list{};
+  QFile xml{path};
+  if (!xml.open(QFile::ReadOnly)) {
+    auto empty = std::make_shared<DeviceList>();
+    empty->status = DeviceList::CannotOpen;
+    empty->error = xml.errorString();
+    list = empty;
+  } else {
+    list = parse(&xml);
+  }
+
+  std::lock_guard<std::mutex> lock{m_mutex};
+  // file content changed, paths it refers to may be different now
+  m_resolved.clear();
+  m_lists.insert(path, {current, list});
+  return list;
+}
+
+std::filesystem::path DeviceCatalog::resolve(const std::filesystem::path &base,
+                                             const std::string &file,
+                                             bool &exists) {
+  std::filesystem::path fullPath{file};
+  std::error_code ec;
+  // a relative file is looked up in the working directory first
+  QString cacheKey = key(base) + QChar('\n') + QString::fromStdString(file);
+  if (fullPath.is_relative()) {
+    cacheKey += QChar('\n') + QString::fromStdString(
+                                  std::filesystem::current_path(ec).string());
+  }
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_resolved.find(cacheKey);
+    if (it != m_resolved.end()) {
+      const std::filesystem::path cached{it->toStdString()};
+      if (std::filesystem::exists(cached, ec)) {
+        exists = true;
+        return cached;
+      }
+      m_resolved.erase(it);
+    }
+  }
+  if (!std::filesystem::exists(fullPath, ec)) fullPath = base / file;
+  exists = std::filesystem::exists(fullPath, ec);
+  // a missing file is looked up again, it may be created later
+  if (exists) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_resolved.insert(cacheKey, QString::fromStdString(fullPath.string()));
+  }
+  return fullPath;
+}
+
+std::shared_ptr<const DeviceCatalog::FixedLayouts>
+DeviceCatalog::fixedLayouts(const std::filesystem::path &archFile,
+                            QString &error) {
+  const QString path = key(archFile);
+  const Stamp current = stamp(path);
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_layouts.find(path);
+    if (it != m_layouts.end() && it->stamp == current) return it->data;
+  }
+
+  QFile xml{path};
+  if (!xml.open(QFile::ReadOnly)) {
+    error = "Cannot open device file: " + path;
+    return nullptr;
+  }
+  auto layouts = std::make_shared<FixedLayouts>();
+  QXmlStreamReader reader{&xml};
+  while (!reader.atEnd()) {
+    if (reader.readNext() == QXmlStreamReader::StartElement &&
+        reader.name() == QLatin1String("fixed_layout")) {
+      const auto attr = reader.attributes();
+      const QString name = attr.value("name").toString();
+      // first definition wins, same as document order lookup
+      if (!layouts->contains(name))
+        layouts->insert(name, {attr.value("width").toString(),
+                               attr.value("height").toString()});
+    }
+  }
+  if (reader.hasError()) {
+    error = "Incorrect device file: " + path;
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_layouts.insert(path, {current, layouts});
+  return layouts;
+}
+
+void DeviceCatalog::invalidate(const std::filesystem::path &file) {
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_lists.remove(key(file));
+  m_layouts.remove(key(file));
+  m_resolved.clear();
+}
+
+void DeviceCatalog::clear() {
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_lists.clear();
+  m_layouts.clear();
+  m_resolved.clear();
+}
+
+}  // namespace FOEDAG
@@ -0,0 +1,124 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QIODevice>
+#include <QMap>
+#include <QStringList>
+#include <QVector>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+namespace FOEDAG {
+
+struct DeviceResource {
+  QString type;
+  QString label;
+  QString num;
+};
+
+struct DeviceInternal {
+  QString type;
+  QString file;
+  QString name;
+  QString num;
+};
+
+struct DeviceEntry {
+  QString name;
+  QString series;
+  QString family;
+  QString package;
+  QString pinCount;
+  QString speedGrade;
+  QString coreVoltage;
+  QVector<DeviceResource> resources;
+  QVector<DeviceInternal> internals;
+};
+
+// Parsed content of one device list file (device.xml, custom_device.xml).
+// Devices are kept in file order, indices below refer to 'devices'.
+struct DeviceList {
+  enum Status { Ok, CannotOpen, Malformed };
+  Status status{CannotOpen};
+  QString error;
+  QVector<DeviceEntry> devices;
+  QHash<QString, QVector<int>> byName;
+  // series -> family -> package -> devices
+  QMap<QString, QMap<QString, QMap<QString, QVector<int>>>> bySeries;
+
+  QVector<const DeviceEntry *> find(const QString &name) const;
+};
+
+using DeviceListPtr = std::shared_ptr<const DeviceList>;
+
+// Process wide cache of device list files. Each file is parsed once with
+// QXmlStreamReader and reparsed only when its size or modification time
+// changes on disk.
+class DeviceCatalog {
+ public:
+  static DeviceCatalog *Instance();
+
+  DeviceListPtr deviceList(const std::filesystem::path &file);
+
+  // Resolves 'file' from a device description: absolute paths are returned
+  // as is, relative paths are looked up in the working directory, then in
+  // 'base'. Found files are memoized per working directory, a missing file
+  // is looked up again on the next call.
+  std::filesystem::path resolve(const std::filesystem::path &base,
+                                const std::string &file, bool &exists);
+
+  // <fixed_layout> name -> (width, height) of a VPR architecture file
+  using FixedLayouts = QHash<QString, QPair<QString, QString>>;
+  std::shared_ptr<const FixedLayouts> fixedLayouts(
+      const std::filesystem::path &archFile, QString &error);
+
+  void invalidate(const std::filesystem::path &file);
+  void clear();
+
+  static DeviceListPtr parse(QIODevice *device);
+
+ private:
+  struct Stamp {
+    QDateTime modified;
+    qint64 size{-1};
+    bool operator==(const Stamp &other) const {
+      return modified == other.modified && size == other.size;
+    }
+  };
+  static Stamp stamp(const QString &file);
+
+  template <class T>
+  struct Entry {
+    Stamp stamp;
+    std::shared_ptr<const T> data;
+  };
+
+  std::mutex m_mutex;
+  QHash<QString, Entry<DeviceList>> m_lists;
+  QHash<QString, Entry<FixedLayouts>> m_layouts;
+  QHash<QString, QString> m_resolved;
+};
+
+}  // namespace FOEDAG
@@ -1,9 +1,8 @@
 #include "config.h"
 
 #include <QDir>
-#include <QDomDocument>
-#include <QFile>
-#include <QTextStream>
+
+#include "DeviceCatalog.h"
 
 using namespace FOEDAG;
 
@@ -12,84 +11,44 @@ Q_GLOBAL_STATIC(Config, config)
 Config *Config::Instance() { return config(); }
 
 int Config::InitConfig(const QString &devicexml) {
-  int ret = 0;
-  QFile file(devicexml);
-  if (!file.open(QFile::ReadOnly)) {
-    return -1;
-  }
-
-  QDomDocument doc;
-  if (!doc.setContent(&file)) {
-    file.close();
-    return -2;
-  }
-  file.close();
+  auto list = DeviceCatalog::Instance()->deviceList(devicexml.toStdString());
+  if (list->status == DeviceList::CannotOpen) return -1;
+  if (list->status == DeviceList::Malformed) return -2;
   m_list_device_item.clear();
 
-  QDomElement docElement = doc.documentElement();
-  QDomNode node = docElement.firstChild();
-  if (!node.isNull() && node.isElement()) {
+  if (!list->devices.isEmpty()) {
     m_list_device_item.append("Name");
     m_list_device_item.append("Pin Count");
     m_list_device_item.append("Speed Grade");
     m_list_device_item.append("Core Voltage");
-    QDomElement e = node.toElement();
-
-    QDomNodeList list = e.childNodes();
-    for (int i = 0; i < list.count(); i++) {
-      QDomNode n = list.at(i);
-      if (!n.isNull() && n.isElement()) {
-        if (n.nodeName() == "resource") {
-          QString type = n.toElement().attribute("type");
-          QString label = n.toElement().attribute("label");
-          if (label == "") {
-            label = type;
-          }
-          m_list_device_item.append(label);
-        }
-      }
+    for (const auto &resource : list->devices.first().resources) {
+      m_list_device_item.append(resource.label.isEmpty() ? resource.type
+                                                         : resource.label);
     }
     m_list_device_item.append("Series");
     m_list_device_item.append("Family");
     m_list_device_item.append("Package");
   }
 
-  while (!node.isNull()) {
-    if (node.isElement()) {
-      QDomElement e = node.toElement();
-
-      QStringList devlist;
-      QString name = e.attribute("name");
-      devlist.append(name);
-      devlist.append(e.attribute("pin_count"));
-      devlist.append(e.attribute("speedgrade"));
-      devlist.append(e.attribute("core_voltage"));
-
-      QDomNodeList list = e.childNodes();
-      for (int i = 0; i < list.count(); i++) {
-        QDomNode n = list.at(i);
-        if (!n.isNull() && n.isElement()) {
-          if (n.nodeName() == "resource")
-            devlist.append(n.toElement().attribute("num"));
-        }
-      }
-      QString series = e.attribute("series");
-      QString family = e.attribute("family");
-      QString package = e.attribute("package");
-      devlist.append(series);
-      devlist.append(family);
-      devlist.append(package);
-
-      // adding name to avoid key collisions when there are multiple devices
-      // with the same series/family/package
-      QString key = series + family + package + "_" + name;
-      m_map_device_info.insert(key, devlist);
-      MakeDeviceMap(series, family, package);
-    }
-
-    node = node.nextSibling();
+  for (const auto &device : list->devices) {
+    QStringList devlist;
+    devlist.append(device.name);
+    devlist.append(device.pinCount);
+    devlist.append(device.speedGrade);
+    devlist.append(device.coreVoltage);
+    for (const auto &resource : device.resources) devlist.append(resource.num);
+    devlist.append(device.series);
+    devlist.append(device.family);
+    devlist.append(device.package);
+
+    // adding name to avoid key collisions when there are multiple devices
+    // with the same series/family/package
+    QString key =
+        device.series + device.family + device.package + "_" + device.name;
+    m_map_device_info.insert(key, devlist);
+    MakeDeviceMap(device.series, device.family, device.package);
   }
-  return ret;
+  return 0;
 }
 
 int Config::InitConfigs(const QStringList &devicexmlList) {
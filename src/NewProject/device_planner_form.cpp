@@ -8,6 +8,7 @@
 #include <filesystem>
 
 #include "CustomLayout.h"
+#include "ProjectManager/DeviceCatalog.h"
 #include "ProjectManager/config.h"
 #include "ProjectManager/project_manager.h"
 #include "Utils/FileUtils.h"
@@ -326,14 +327,15 @@ QStringList devicePlannerForm::getOriginalDeviceList(
                             std::string("etc") / std::string("device.xml"))
                                .string();
   if (!deviceFile.empty()) devicefile = deviceFile.string();
-  Config conf{};
-  conf.InitConfigs({QString::fromStdString(devicefile)});
-  auto deviceInfo = conf.getDevicelist();
-  QStringList devices{};
-  for (const auto &info : deviceInfo) {
-    if (!info.isEmpty()) devices.push_back(info.first());
+  auto list = DeviceCatalog::Instance()->deviceList(devicefile);
+  // keep the series/family/package ordering used by Config::getDevicelist
+  QMap<QString, QString> sorted{};
+  for (const auto &device : list->devices) {
+    sorted.insert(device.series + device.family + device.package + "_" +
+                      device.name,
+                  device.name);
   }
-  return devices;
+  return sorted.values();
 }
 
 Filters devicePlannerForm::currentFilter() const {
@@ -62,7 +62,7 @@ std::pair<bool, QString> PackagePinsLoader::load(const QString &fileName) {
     // -------------
     if (uniquePins.contains(data.at(BallName))) continue;
     uniquePins.insert(data.at(BallName));
-    group.pinData.append({data});
+    group.pinData.append(data);
   }
   if (m_model->userGroups().contains(group.name))
     m_model->append(group);  // append last
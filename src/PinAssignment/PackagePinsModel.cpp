@@ -24,6 +24,43 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 namespace FOEDAG {
 
+int PackagePinTable::count() const { return m_rows; }
+
+int PackagePinTable::columnCount() const { return m_columns.count(); }
+
+QString PackagePinTable::value(int row, int column) const {
+  if (column < 0 || column >= m_columns.count()) return QString{};
+  if (row < 0 || row >= m_rows) return QString{};
+  return m_strings.at(m_columns.at(column).at(row));
+}
+
+QStringList PackagePinTable::row(int row) const {
+  QStringList data;
+  for (int col = 0; col < m_columns.count(); col++)
+    data.append(value(row, col));
+  return data;
+}
+
+void PackagePinTable::append(const QStringList &row) {
+  while (m_columns.count() < row.count())
+    m_columns.append(QVector<quint32>(m_rows, 0));
+  for (int col = 0; col < m_columns.count(); col++)
+    m_columns[col].append(col < row.count() ? id(row.at(col)) : 0);
+  m_rows++;
+}
+
+void PackagePinTable::clear() { *this = PackagePinTable{}; }
+
+quint32 PackagePinTable::id(const QString &str) {
+  if (str.isEmpty()) return 0;
+  auto it = m_ids.constFind(str);
+  if (it != m_ids.constEnd()) return it.value();
+  const quint32 id = static_cast<quint32>(m_strings.count());
+  m_strings.append(str);
+  m_ids.insert(str, id);
+  return id;
+}
+
 PackagePinsModel::PackagePinsModel(QObject *parent)
     : QObject(parent),
       m_listModel(new QStringListModel),
@@ -119,8 +156,9 @@ void PackagePinsModel::initListModel() {
   QStringList pinsList;
   pinsList.append(QString());
   for (const auto &group : std::as_const(m_pinData)) {
-    for (const auto &pin : group.pinData) {
-      pinsList.append(pin.data.at(useBallId() ? BallId : BallName));
+    for (int row = 0; row < group.pinData.count(); row++) {
+      pinsList.append(
+          group.pinData.value(row, useBallId() ? BallId : BallName));
     }
   }
   m_listModel->setStringList(pinsList);
@@ -153,20 +191,24 @@ QString PackagePinsModel::convertPinName(const QString &name) const {
 
 void PackagePinsModel::insertBallData(const QString &name, const QString &id) {
   m_ballData[id] = name;
+  // same lookup result as a scan of m_ballData: the smallest id wins
+  auto ballId = m_ballIds.find(name);
+  if (ballId == m_ballIds.end())
+    m_ballIds.insert(name, id);
+  else if (id < ballId.value())
+    ballId.value() = id;
 }
 
 QString PackagePinsModel::convertPinNameUsage(const QString &nameOrId) {
-  auto iter = m_ballData.cbegin();
-  while (iter != m_ballData.cend()) {
-    if (iter.key() == nameOrId) {  // ball id detected
-      if (useBallId()) return nameOrId;
-      return iter.value();
-    }
-    if (iter.value() == nameOrId) {  // ball name detected
-      if (useBallId()) return iter.key();
-      return nameOrId;
-    }
-    iter++;
+  auto ballName = m_ballData.constFind(nameOrId);
+  if (ballName != m_ballData.cend()) {  // ball id detected
+    if (useBallId()) return nameOrId;
+    return ballName.value();
+  }
+  auto ballId = m_ballIds.constFind(nameOrId);
+  if (ballId != m_ballIds.cend()) {  // ball name detected
+    if (useBallId()) return ballId.value();
+    return nameOrId;
   }
   return QString{};
 }
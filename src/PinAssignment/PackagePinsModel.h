@@ -19,6 +19,7 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
+#include <QHash>
 #include <QObject>
 #include <QStringList>
 #include <QStringListModel>
@@ -47,13 +48,38 @@ enum PinData {
   Voltage2 = 68,
 };
 
-struct PackagePinData {
-  QStringList data;
+/*!
+ * \brief The PackagePinTable class
+ * Keeps the rows of a pin group column by column. Every cell is an index into
+ * the string table of the group, so repeated values like banks, directions or
+ * mode flags are stored once.
+ */
+class PackagePinTable {
+ public:
+  int count() const;
+  int columnCount() const;
+  /*!
+   * \brief value returns the cell at \a row and \a column or an empty string
+   * if the row has less columns.
+   */
+  QString value(int row, int column) const;
+  QStringList row(int row) const;
+  void append(const QStringList &row);
+  void clear();
+
+ private:
+  quint32 id(const QString &str);
+
+ private:
+  QVector<QVector<quint32>> m_columns;
+  QStringList m_strings{QString{}};  // id 0 is the empty string
+  QHash<QString, quint32> m_ids;
+  int m_rows{0};
 };
 
 struct PackagePinGroup {
   QString name;
-  QVector<PackagePinData> pinData;
+  PackagePinTable pinData;
 };
 
 struct HeaderData {
@@ -123,9 +149,10 @@ class PackagePinsModel : public QObject {
   QMap<QString, QString> m_internalPinMap;
   QMap<QString, int> m_modes;
   InternalPins m_internalPinsData;  // <PinName, <ModeId, InternalPins>>
-  PinsBaseModel *m_baseModel;
+  PinsBaseModel *m_baseModel{nullptr};
   bool m_useBallId{false};
   BallData m_ballData;
+  QHash<QString, QString> m_ballIds;  // <name, id>
 };
 
 }  // namespace FOEDAG
@@ -20,14 +20,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "PackagePinsView.h"
 
-#include <QCompleter>
-#include <QHBoxLayout>
 #include <QHeaderView>
-#include <QLabel>
 #include <QStringListModel>
-#include <QToolButton>
+#include <QStyle>
 
-#include "BufferedComboBox.h"
+#include "PinAssignmentDelegate.h"
 
 namespace FOEDAG {
 
@@ -46,44 +43,29 @@ PackagePinsView::PackagePinsView(PinsBaseModel *model, QWidget *parent)
     headerItem()->setText(h.id, h.name);
     headerItem()->setToolTip(h.id, h.description);
   }
+  setIndexedColumn(PortsCol);
 
   QTreeWidgetItem *topLevelPackagePin = new QTreeWidgetItem(this);
   topLevelPackagePin->setText(NameCol, "All Pins");
-  const auto banks = model->packagePinModel()->pinData();
+  const auto &banks = model->packagePinModel()->pinData();
   const bool useBallId{model->packagePinModel()->useBallId()};
   for (const auto &b : banks) {
     QTreeWidgetItem *bank = new QTreeWidgetItem(topLevelPackagePin);
     bank->setText(NameCol, b.name);
     bank->setText(AvailCol, QString::number(b.pinData.count()));
-    const auto pins = b.pinData;
-    for (auto &p : pins) {
-      uint col = PortsCol + 1;
+    const auto &pins = b.pinData;
+    for (int row = 0; row < pins.count(); row++) {
+      int col = PortsCol + 1;
       QTreeWidgetItem *pinItem = new QTreeWidgetItem(bank);
       m_pinItems.append(pinItem);
-      insertData(p.data, useBallId ? BallId : BallName, NameCol, pinItem);
-      insertData(p.data, RefClock, col++, pinItem);
-      insertData(p.data, Bank, col++, pinItem);
-      insertData(p.data, ALT, col++, pinItem);
-      insertData(p.data, DebugMode, col++, pinItem);
-      insertData(p.data, ScanMode, col++, pinItem);
-      insertData(p.data, MbistMode, col++, pinItem);
-      insertData(p.data, Type, col++, pinItem);
-      insertData(p.data, Dir, col++, pinItem);
-      insertData(p.data, Voltage, col++, pinItem);
-      insertData(p.data, PowerPad, col++, pinItem);
-      insertData(p.data, Discription, col++, pinItem);
-      insertData(p.data, Voltage2, col++, pinItem);
+      pinItem->setText(NameCol, pins.value(row, useBallId ? BallId : BallName));
+      for (auto data : {RefClock, Bank, ALT, DebugMode, ScanMode, MbistMode,
+                        Type, Dir, Voltage, PowerPad, Discription, Voltage2})
+        pinItem->setText(col++, pins.value(row, data));
+      m_pinItemsByName.insert(pinItem->text(NameCol), pinItem);
 
       initLine(pinItem);
-
-      auto [widget, button] =
-          prepareButtonWithLabel(pinItem->text(0), QIcon{":/images/add.png"});
-      connect(button, &QToolButton::clicked, this, [=]() {
-        CreateNewLine(pinItem);
-        auto btn = itemWidget(pinItem, NameCol)->findChild<QToolButton *>();
-        if (btn) btn->setDisabled(pinItem->childCount() >= MAX_ROWS);
-      });
-      setItemWidget(pinItem, NameCol, widget);
+      updateButton(pinItem);
     }
     expandItem(bank);
   }
@@ -95,6 +77,9 @@ PackagePinsView::PackagePinsView(PinsBaseModel *model, QWidget *parent)
           &PackagePinsView::portAssignmentChanged);
   connect(model->packagePinModel(), &PackagePinsModel::pinNameChanged, this,
           &PackagePinsView::updatePinNames);
+  auto delegate = qobject_cast<PinAssignmentDelegate *>(itemDelegate());
+  connect(delegate, &PinAssignmentDelegate::decorationClicked, this,
+          &PackagePinsView::decorationClicked);
   expandItem(topLevelPackagePin);
   setAlternatingRowColors(true);
   setColumnWidth(NameCol, 200);
@@ -113,21 +98,15 @@ PackagePinsView::PackagePinsView(PinsBaseModel *model, QWidget *parent)
 }
 
 void PackagePinsView::SetMode(const QString &pin, const QString &mode) {
-  QModelIndexList indexes{match(pin)};
-  for (const auto &index : indexes) {
-    setComboData(index, ModeCol, mode);
-  }
+  const auto rows{pinRows(pin)};
+  for (auto item : rows) setComboData(item, ModeCol, mode);
 }
 
 void PackagePinsView::SetInternalPin(const QString &port,
                                      const QString &intPin) {
-  for (auto it{m_allCombo.cbegin()}; it != m_allCombo.cend(); it++) {
-    if (it.key()->currentIndex() != 0 && it.key()->currentText() == port) {
-      auto index = it.value();
-      setComboData(index, InternalPinCol, intPin);
-      break;
-    }
-  }
+  if (port.isEmpty()) return;
+  const auto items{comboItems(port)};
+  if (!items.isEmpty()) setComboData(items.first(), InternalPinCol, intPin);
 }
 
 void PackagePinsView::SetPort(const QString &pin, const QString &port,
@@ -135,32 +114,18 @@ void PackagePinsView::SetPort(const QString &pin, const QString &port,
   if (pin.isEmpty()) return;
   if (row == -1) return;
 
-  QModelIndexList indexes{match(pin)};
-  if (indexes.count() == 1 && row != 0) {  // make first row as child
-    CreateNewLine(itemFromIndex(indexes.first()));
-  }
-  indexes = match(pin);
-  if (row != 0) {
-    if (!indexes.isEmpty()) {
-      while ((indexes.count() - 1) <= row) {
-        CreateNewLine(itemFromIndex(indexes.first()));
-        indexes = match(pin);
-      }
-    }
-  }
-
-  if (indexes.count() > 1) indexes.pop_front();  // skip first parent item
-
-  if (!indexes.isEmpty()) {
-    auto index = indexes.at(row);
-    setComboData(index, PortsCol, port);
+  auto pinItem = m_pinItemsByName.value(pin);
+  if (!pinItem) return;
+  if (row != 0) {  // first row becomes child
+    while (pinItem->childCount() <= row) CreateNewLine(pinItem);
   }
+  auto item = row < pinItem->childCount() ? pinItem->child(row) : pinItem;
+  setComboData(item, PortsCol, port);
 }
 
 void PackagePinsView::cleanTable() {
-  for (auto it{m_allCombo.cbegin()}; it != m_allCombo.cend(); it++) {
-    it.key()->setCurrentIndex(0);
-  }
+  const auto items{comboItems()};
+  for (auto item : items) setComboText(item, PortsCol, QString{});
   for (const auto &item : m_pinItems) {
     while (item->childCount() != 0) {
       auto child = item->child(0);
@@ -169,209 +134,136 @@ void PackagePinsView::cleanTable() {
   }
 }
 
-void PackagePinsView::ioPortsSelectionHasChanged(const QModelIndex &index) {
-  // update here Mode selection
-  auto item = itemFromIndex(index);
-  auto combo = item ? GetCombo<BufferedComboBox *>(item, PortsCol) : nullptr;
-  if (combo) {
-    updateModeCombo(combo->currentText(), index);
+QStringList PackagePinsView::choices(QTreeWidgetItem *item, int column) const {
+  auto packagePinModel = m_model->packagePinModel();
+  switch (column) {
+    case PortsCol:
+      return m_model->portsModel()->listModel()->stringList();
+    case ModeCol: {
+      const QString port = comboText(item, PortsCol);
+      if (port.isEmpty()) return {};
+      auto ioPort = m_model->portsModel()->GetPort(port);
+      const bool output = ioPort.dir == "Output";
+      return output ? packagePinModel->modeModelTx()->stringList()
+                    : packagePinModel->modeModelRx()->stringList();
+    }
+    case InternalPinCol: {
+      const QString mode = comboText(item, ModeCol);
+      if (mode.isEmpty()) return {};
+      QStringList list{{""}};
+      list.append(packagePinModel->GetInternalPinsList(
+          item->text(NameCol), mode, comboText(item, InternalPinCol)));
+      return list;
+    }
+    default:
+      return {};
   }
+}
 
-  if (combo) {
-    auto port = combo->currentText();
-    removeDuplications(port, combo);
-
-    auto pin = item->text(NameCol);
-    auto prevPort = combo->previousText();
-    int index = item->parent() ? item->parent()->indexOfChild(item) : 0;
-    m_blockUpdate = true;
-    if (!prevPort.isEmpty()) m_model->update(prevPort, QString{}, index);
-    m_model->update(port, pin, index);
-    m_blockUpdate = false;
-    emit selectionHasChanged();
-  }
+bool PackagePinsView::searchable(int column) const {
+  return column == PortsCol;
 }
 
-void PackagePinsView::modeSelectionHasChanged(const QModelIndex &index) {
-  auto item = itemFromIndex(index);
-  if (item) {
-    auto combo = GetCombo(item, ModeCol);
-    if (combo) {
-      m_model->packagePinModel()->updateMode(item->text(NameCol),
-                                             combo->currentText());
-      updateInternalPinCombo(combo->currentText(), index);
-      emit selectionHasChanged();
-    }
+void PackagePinsView::comboDataChanged(QTreeWidgetItem *item, int column,
+                                       const QString &previous) {
+  switch (column) {
+    case PortsCol:
+      ioPortsSelectionHasChanged(item, previous);
+      break;
+    case ModeCol:
+      modeSelectionHasChanged(item);
+      break;
+    case InternalPinCol:
+      internalPinSelectionHasChanged(item);
+      break;
   }
 }
 
-void PackagePinsView::internalPinSelectionHasChanged(const QModelIndex &index) {
-  auto item = itemFromIndex(index);
-  if (item) {
-    auto combo = GetCombo(item, InternalPinCol);
-    if (combo) {
-      m_model->packagePinModel()->updateInternalPin(GetPort(index),
-                                                    combo->currentText());
-      const auto combos{m_intPins[item->text(NameCol)]};
-      for (auto c : combos) {
-        if (combo != c)
-          updateInternalPinSelection(itemFromIndex(index)->text(NameCol), c);
-      }
-      emit selectionHasChanged();
-    }
-  }
+void PackagePinsView::ioPortsSelectionHasChanged(QTreeWidgetItem *item,
+                                                 const QString &prevPort) {
+  // update here Mode selection
+  auto port = comboText(item, PortsCol);
+  updateModeCombo(port, item);
+  removeDuplications(port, item);
+
+  auto pin = item->text(NameCol);
+  int index = rowIndex(item);
+  m_blockUpdate = true;
+  if (!prevPort.isEmpty()) m_model->update(prevPort, QString{}, index);
+  m_model->update(port, pin, index);
+  m_blockUpdate = false;
+  emit selectionHasChanged();
+}
+
+void PackagePinsView::modeSelectionHasChanged(QTreeWidgetItem *item) {
+  const auto mode = comboText(item, ModeCol);
+  m_model->packagePinModel()->updateMode(item->text(NameCol), mode);
+  updateInternalPinCombo(mode, item);
+  emit selectionHasChanged();
 }
 
-void PackagePinsView::insertData(const QStringList &data, int index, int column,
-                                 QTreeWidgetItem *item) {
-  if (data.count() > index) item->setText(column, data.at(index));
+void PackagePinsView::internalPinSelectionHasChanged(QTreeWidgetItem *item) {
+  m_model->packagePinModel()->updateInternalPin(
+      comboText(item, PortsCol), comboText(item, InternalPinCol));
+  emit selectionHasChanged();
 }
 
 void PackagePinsView::updateModeCombo(const QString &port,
-                                      const QModelIndex &index) {
-  auto modeIndex = model()->index(index.row(), ModeCol, index.parent());
-  auto pin = itemFromIndex(modeIndex)->text(NameCol);
-  QComboBox *modeCombo{GetCombo(modeIndex, ModeCol)};
-  if (modeCombo) {
-    modeCombo->setEnabled(!port.isEmpty());
-    if (port.isEmpty()) {
-      const QSignalBlocker blocker{modeCombo};
-      modeCombo->setCurrentIndex(0);
-      // update model here
-      bool resetMode{true};
-      const auto indexes{match(pin)};
-      for (const auto &idx : indexes) {
-        if (auto combo = GetCombo(idx, PortsCol)) {
-          if (combo->currentIndex() != 0) resetMode = false;
-        }
-      }
-      if (resetMode) m_model->packagePinModel()->updateMode(pin, QString{});
-      // cleanup internal pin selection
-      updateInternalPinCombo(QString{}, index);
-    } else {
-      auto currentMode = m_model->packagePinModel()->getMode(pin);
-      auto ioPort = m_model->portsModel()->GetPort(port);
-      const bool output = ioPort.dir == "Output";
-      QAbstractItemModel *modeModel =
-          output ? m_model->packagePinModel()->modeModelTx()
-                 : m_model->packagePinModel()->modeModelRx();
-      modeCombo->blockSignals(!currentMode.isEmpty());
-      if (modeCombo->model() != modeModel) {
-        modeCombo->setModel(modeModel);
-      }
-      if (!currentMode.isEmpty()) {
-        const int index = modeCombo->findData(currentMode, Qt::DisplayRole);
-        if (index > -1) modeCombo->setCurrentIndex(index);
-        updateInternalPinCombo(currentMode, modeIndex);
-      }
-      modeCombo->blockSignals(false);
+                                      QTreeWidgetItem *item) {
+  auto pin = item->text(NameCol);
+  setEditor(item, ModeCol, port.isEmpty() ? EditorDisabled : EditorEnabled);
+  if (port.isEmpty()) {
+    setComboText(item, ModeCol, QString{}, false);
+    // update model here
+    bool resetMode{true};
+    const auto rows{pinRows(pin)};
+    for (auto row : rows) {
+      if (!comboText(row, PortsCol).isEmpty()) resetMode = false;
     }
+    if (resetMode) m_model->packagePinModel()->updateMode(pin, QString{});
+    // cleanup internal pin selection
+    updateInternalPinCombo(QString{}, item);
+  } else {
+    auto currentMode = m_model->packagePinModel()->getMode(pin);
+    // available modes depend on the port direction
+    if (!choices(item, ModeCol).contains(currentMode)) currentMode.clear();
+    setComboText(item, ModeCol, currentMode, false);
+    if (!currentMode.isEmpty()) updateInternalPinCombo(currentMode, item);
   }
 }
 
 void PackagePinsView::updateInternalPinCombo(const QString &mode,
-                                             const QModelIndex &index) {
-  auto intPinIndex =
-      model()->index(index.row(), InternalPinCol, index.parent());
-  QComboBox *intPinCombo{GetCombo(intPinIndex, InternalPinCol)};
-  if (intPinCombo) {
-    if (mode.isEmpty()) {
-      intPinCombo->setCurrentIndex(0);
-      intPinCombo->setEnabled(false);
-    } else {
-      intPinCombo->setEnabled(true);
-      auto current = intPinCombo->currentText();
-      auto pin = itemFromIndex(index)->text(NameCol);
-      auto model = new QStringListModel{};
-      QStringList list{{""}};
-      list.append(m_model->packagePinModel()->GetInternalPinsList(pin, mode));
-      model->setStringList(list);
-      intPinCombo->setModel(model);
-      if (list.contains(current)) {
-        const int index = intPinCombo->findData(current, Qt::DisplayRole);
-        if (index > -1) intPinCombo->setCurrentIndex(index);
-      }
-    }
+                                             QTreeWidgetItem *item) {
+  if (mode.isEmpty()) {
+    setComboText(item, InternalPinCol, QString{});
+    setEditor(item, InternalPinCol, EditorDisabled);
+  } else {
+    setEditor(item, InternalPinCol, EditorEnabled);
+    if (!choices(item, InternalPinCol)
+             .contains(comboText(item, InternalPinCol)))
+      setComboText(item, InternalPinCol, QString{});
   }
 }
 
-std::pair<QWidget *, QToolButton *> PackagePinsView::prepareButtonWithLabel(
-    const QString &text, const QIcon &icon) {
-  QWidget *w = new QWidget;
-  w->setLayout(new QHBoxLayout);
-  w->layout()->setContentsMargins(0, 0, 0, 0);
-  w->layout()->addWidget(new QLabel{text});
-  auto btn = new QToolButton{};
-  btn->setIcon(icon);
-  w->layout()->addWidget(btn);
-  w->setAutoFillBackground(true);
-  return std::make_pair(w, btn);
-}
-
 void PackagePinsView::initLine(QTreeWidgetItem *item) {
-  auto combo = new BufferedComboBox;
-  combo->setModel(m_model->portsModel()->listModel());
-  combo->setAutoFillBackground(true);
-  combo->setEditable(true);
-  auto completer{new QCompleter{m_model->portsModel()->listModel()}};
-  completer->setFilterMode(Qt::MatchContains);
-  combo->setCompleter(completer);
-  combo->setInsertPolicy(QComboBox::NoInsert);
-  connect(combo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
-          [=]() { ioPortsSelectionHasChanged(indexFromItem(item, PortsCol)); });
-  setItemWidget(item, PortsCol, combo);
-  insertCombo(combo, indexFromItem(item));
-
-  auto modeCombo = CreateCombo(nullptr);
-  modeCombo->setEnabled(false);
-  connect(modeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
-          [=]() { modeSelectionHasChanged(indexFromItem(item, ModeCol)); });
-  setItemWidget(item, ModeCol, modeCombo);
-
-  auto internalPinCombo = CreateCombo(nullptr);
-  internalPinCombo->setEnabled(false);
-  internalPinCombo->setMinimumWidth(170);
-  connect(internalPinCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
-          this, [=]() {
-            internalPinSelectionHasChanged(indexFromItem(item, ModeCol));
-          });
-  setItemWidget(item, InternalPinCol, internalPinCombo);
-  m_intPins[item->text(NameCol)].insert(internalPinCombo);
+  setEditor(item, PortsCol, EditorEnabled);
+  setEditor(item, ModeCol, EditorDisabled);
+  setEditor(item, InternalPinCol, EditorDisabled);
 }
 
 void PackagePinsView::copyData(QTreeWidgetItem *from, QTreeWidgetItem *to) {
-  auto fromCombo = GetCombo(from, PortsCol);
-  int portIndex{0};
-  int modeIndex{0};
-  int intPin{0};
-
-  if (fromCombo) portIndex = fromCombo->currentIndex();
-  fromCombo = GetCombo(from, ModeCol);
-  if (fromCombo) modeIndex = fromCombo->currentIndex();
-  fromCombo = GetCombo(from, InternalPinCol);
-  if (fromCombo) {
-    intPin = fromCombo->currentIndex();
-    m_intPins[from->text(NameCol)].remove(fromCombo);
-  }
-
-  for (auto column : {PortsCol, ModeCol, InternalPinCol})
-    removeItemWidget(from, column);
+  const QString port = comboText(from, PortsCol);
+  const QString mode = comboText(from, ModeCol);
+  const QString intPin = comboText(from, InternalPinCol);
 
-  auto toCombo = GetCombo(to, PortsCol);
-  if (toCombo) toCombo->setCurrentIndex(portIndex);
-  toCombo = GetCombo(to, ModeCol);
-  if (toCombo) toCombo->setCurrentIndex(modeIndex);
-  toCombo = GetCombo(to, InternalPinCol);
-  if (toCombo) toCombo->setCurrentIndex(intPin);
-}
+  for (auto column : {PortsCol, ModeCol, InternalPinCol}) {
+    setComboText(from, column, QString{}, false);
+    setEditor(from, column, NoEditor);
+  }
 
-void PackagePinsView::resetItem(QTreeWidgetItem *item) {
-  auto combo = GetCombo(item, InternalPinCol);
-  if (combo) combo->setCurrentIndex(0);
-  combo = GetCombo(item, ModeCol);
-  if (combo) combo->setCurrentIndex(0);
-  combo = GetCombo(item, PortsCol);
-  if (combo) combo->setCurrentIndex(0);
+  setComboText(to, PortsCol, port);
+  setComboText(to, ModeCol, mode);
+  setComboText(to, InternalPinCol, intPin);
 }
 
 void PackagePinsView::removeItem(QTreeWidgetItem *parent,
@@ -380,24 +272,50 @@ void PackagePinsView::removeItem(QTreeWidgetItem *parent,
     initLine(parent);
     copyData(child, parent);
   } else {
-    auto combo = GetCombo(child, PortsCol);
-    if (combo && combo->currentIndex() != 0) {
-      m_model->remove(combo->currentText(), child->text(NameCol),
-                      parent->indexOfChild(child));
+    const auto port = comboText(child, PortsCol);
+    if (!port.isEmpty()) {
+      m_model->remove(port, child->text(NameCol), parent->indexOfChild(child));
     }
-    auto intCombo = GetCombo(child, InternalPinCol);
-    if (intCombo) m_intPins[child->text(NameCol)].remove(intCombo);
+    for (auto column : {PortsCol, ModeCol, InternalPinCol})
+      setComboText(child, column, QString{}, false);
   }
-  parent->removeChild(child);
+  delete child;
+  updateButton(parent);
+}
 
-  auto btn = itemWidget(parent, NameCol)->findChild<QToolButton *>();
-  if (btn) btn->setDisabled(parent->childCount() >= MAX_ROWS);
+void PackagePinsView::updateButton(QTreeWidgetItem *pinItem) {
+  if (pinItem->childCount() < MAX_ROWS) {
+    pinItem->setIcon(NameCol, m_addIcon);
+  } else {
+    const int size{style()->pixelMetric(QStyle::PM_SmallIconSize)};
+    pinItem->setIcon(NameCol, QIcon{m_addIcon.pixmap(size, QIcon::Disabled)});
+  }
+}
+
+void PackagePinsView::lineButtonClicked(QTreeWidgetItem *item) {
+  if (isPinItem(item)) {
+    if (item->childCount() < MAX_ROWS) CreateNewLine(item);
+  } else if (auto parent = item->parent(); parent && isPinItem(parent)) {
+    removeItem(parent, item);
+  }
+}
+
+bool PackagePinsView::isPinItem(QTreeWidgetItem *item) const {
+  return m_pinItemsByName.value(item->text(NameCol)) == item;
 }
 
-QString PackagePinsView::GetPort(const QModelIndex &index) const {
-  auto portIndex = model()->index(index.row(), PortsCol, index.parent());
-  QComboBox *portCombo{GetCombo(portIndex, PortsCol)};
-  return (portCombo) ? portCombo->currentText() : QString{};
+QList<QTreeWidgetItem *> PackagePinsView::pinRows(const QString &pin) const {
+  auto pinItem = m_pinItemsByName.value(pin);
+  if (!pinItem) return {};
+  if (pinItem->childCount() == 0) return {pinItem};
+  QList<QTreeWidgetItem *> rows;
+  for (int i = 0; i < pinItem->childCount(); i++)
+    rows.append(pinItem->child(i));
+  return rows;
+}
+
+int PackagePinsView::rowIndex(QTreeWidgetItem *item) const {
+  return isPinItem(item) ? 0 : item->parent()->indexOfChild(item);
 }
 
 void PackagePinsView::modeChanged(const QString &pin, const QString &mode) {
@@ -422,14 +340,9 @@ void PackagePinsView::portAssignmentChanged(const QString &port,
 QTreeWidgetItem *PackagePinsView::CreateNewLine(QTreeWidgetItem *parent) {
   auto child = new QTreeWidgetItem;
   child->setText(NameCol, parent->text(NameCol));
+  child->setIcon(NameCol, m_removeIcon);
   parent->addChild(child);
 
-  auto [widget, button] = prepareButtonWithLabel(parent->text(NameCol),
-                                                 QIcon{":/images/minus.png"});
-  connect(button, &QToolButton::clicked, this,
-          [=]() { removeItem(parent, child); });
-  setItemWidget(child, NameCol, widget);
-
   initLine(child);
 
   if (parent->childCount() == 1) {  // remove last
@@ -437,22 +350,32 @@ QTreeWidgetItem *PackagePinsView::CreateNewLine(QTreeWidgetItem *parent) {
     expandItem(parent);
   }
 
-  updateEditorGeometries();
+  updateButton(parent);
   return child;
 }
 
 void PackagePinsView::updatePinNames() {
+  m_pinItemsByName.clear();
   for (auto &pinItem : m_pinItems) {
-    auto widget = itemWidget(pinItem, NameCol);
-    QLabel *label = widget->findChild<QLabel *>();
-    if (label) {
-      auto current{label->text()};
-      auto convertedName =
-          m_model->packagePinModel()->convertPinNameUsage(current);
-      label->setText(convertedName);
-      pinItem->setText(NameCol, convertedName);
-    }
+    auto convertedName =
+        m_model->packagePinModel()->convertPinNameUsage(pinItem->text(NameCol));
+    pinItem->setText(NameCol, convertedName);
+    for (int i = 0; i < pinItem->childCount(); i++)
+      pinItem->child(i)->setText(NameCol, convertedName);
+    m_pinItemsByName.insert(convertedName, pinItem);
   }
 }
 
+void PackagePinsView::decorationClicked(const QModelIndex &index) {
+  if (index.column() != NameCol) return;
+  // the line may be removed, so let the view finish the mouse event first
+  const QPersistentModelIndex persistent{index};
+  QMetaObject::invokeMethod(
+      this,
+      [this, persistent]() {
+        if (auto item = itemFromIndex(persistent)) lineButtonClicked(item);
+      },
+      Qt::QueuedConnection);
+}
+
 }  // namespace FOEDAG
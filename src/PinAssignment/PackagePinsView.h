@@ -20,11 +20,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
 
+#include <QHash>
+#include <QIcon>
+
 #include "PinAssignmentBaseView.h"
 #include "PinsBaseModel.h"
 
-class QComboBox;
-class QToolButton;
 namespace FOEDAG {
 
 class PackagePinsView : public PinAssignmentBaseView {
@@ -39,21 +40,31 @@ class PackagePinsView : public PinAssignmentBaseView {
  signals:
   void selectionHasChanged();
 
+ protected:
+  QStringList choices(QTreeWidgetItem *item, int column) const override;
+  bool searchable(int column) const override;
+  void comboDataChanged(QTreeWidgetItem *item, int column,
+                        const QString &previous) override;
+
  private:
-  void ioPortsSelectionHasChanged(const QModelIndex &index);
-  void modeSelectionHasChanged(const QModelIndex &index);
-  void internalPinSelectionHasChanged(const QModelIndex &index);
-  void insertData(const QStringList &data, int index, int column,
-                  QTreeWidgetItem *item);
-  void updateModeCombo(const QString &port, const QModelIndex &index);
-  void updateInternalPinCombo(const QString &mode, const QModelIndex &index);
-  static std::pair<QWidget *, QToolButton *> prepareButtonWithLabel(
-      const QString &text, const QIcon &icon);
+  void ioPortsSelectionHasChanged(QTreeWidgetItem *item,
+                                  const QString &prevPort);
+  void modeSelectionHasChanged(QTreeWidgetItem *item);
+  void internalPinSelectionHasChanged(QTreeWidgetItem *item);
+  void updateModeCombo(const QString &port, QTreeWidgetItem *item);
+  void updateInternalPinCombo(const QString &mode, QTreeWidgetItem *item);
   void initLine(QTreeWidgetItem *item);
   void copyData(QTreeWidgetItem *from, QTreeWidgetItem *to);
-  void resetItem(QTreeWidgetItem *item);
   void removeItem(QTreeWidgetItem *parent, QTreeWidgetItem *child);
-  QString GetPort(const QModelIndex &index) const;
+  void updateButton(QTreeWidgetItem *pinItem);
+  void lineButtonClicked(QTreeWidgetItem *item);
+  bool isPinItem(QTreeWidgetItem *item) const;
+  /*!
+   * \brief pinRows returns the lines of the pin: its children or the pin
+   * item itself if it has only one line.
+   */
+  QList<QTreeWidgetItem *> pinRows(const QString &pin) const;
+  int rowIndex(QTreeWidgetItem *item) const;
 
  private slots:
   void modeChanged(const QString &pin, const QString &mode);
@@ -61,10 +72,14 @@ class PackagePinsView : public PinAssignmentBaseView {
   void portAssignmentChanged(const QString &port, const QString &pin, int row);
   QTreeWidgetItem *CreateNewLine(QTreeWidgetItem *parent);
   void updatePinNames();
+  void decorationClicked(const QModelIndex &index);
 
  private:
   const int MAX_ROWS{};
+  const QIcon m_addIcon{":/images/add.png"};
+  const QIcon m_removeIcon{":/images/minus.png"};
   QVector<QTreeWidgetItem *> m_pinItems;
+  QHash<QString, QTreeWidgetItem *> m_pinItemsByName;
 };
 
 }  // namespace FOEDAG
@@ -20,98 +20,91 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "PinAssignmentBaseView.h"
 
-#include <QComboBox>
-
 #include "ComboBox.h"
+#include "PinAssignmentDelegate.h"
 #include "PinsBaseModel.h"
 
 namespace FOEDAG {
 
 PinAssignmentBaseView::PinAssignmentBaseView(PinsBaseModel *model,
                                              QWidget *parent)
-    : QTreeWidget(parent), m_model(model) {}
+    : QTreeWidget(parent), m_model(model) {
+  setItemDelegate(new PinAssignmentDelegate{this});
+  setEditTriggers(QAbstractItemView::AllEditTriggers);
+}
 
-PinAssignmentBaseView::~PinAssignmentBaseView() {
-  for (auto iter = m_allCombo.begin(); iter != m_allCombo.end(); ++iter) {
-    disconnect(iter.key(), &QComboBox::destroyed, this,
-               &PinAssignmentBaseView::removeFromList);
-  }
+QStringList PinAssignmentBaseView::choices(QTreeWidgetItem * /* unused */,
+                                           int /* unused */) const {
+  return {};
 }
 
-void PinAssignmentBaseView::removeDuplications(const QString &text,
-                                               QComboBox *current) {
-  for (auto it{m_allCombo.cbegin()}; it != m_allCombo.cend(); it++) {
-    if ((it.key() != current) && (it.key()->currentText() == text)) {
-      it.key()->setCurrentIndex(0);
-      break;
-    }
-  }
+bool PinAssignmentBaseView::searchable(int /* unused */) const {
+  return false;
 }
 
-QModelIndexList PinAssignmentBaseView::match(const QString &text) const {
-  int count = topLevelItemCount();
-  QModelIndexList indexList;
-  for (int i = 0; i < count; i++) {
-    indexList = indexFromText(topLevelItem(i), text);
-    if (!indexList.isEmpty()) break;
-  }
-  return indexList;
+void PinAssignmentBaseView::comboDataChanged(QTreeWidgetItem * /* unused */,
+                                             int /* unused */,
+                                             const QString & /* unused */) {}
+
+void PinAssignmentBaseView::setEditor(QTreeWidgetItem *item, int column,
+                                      EditorState state) {
+  if (state != NoEditor) item->setFlags(item->flags() | Qt::ItemIsEditable);
+  item->setData(column, EditorRole, state);
 }
 
-QModelIndexList PinAssignmentBaseView::indexFromText(
-    QTreeWidgetItem *i, const QString &text) const {
-  auto indexList = model()->match(indexFromItem(i), Qt::DisplayRole, text, -1,
-                                  Qt::MatchExactly | Qt::MatchRecursive);
-  return indexList;
+PinAssignmentBaseView::EditorState PinAssignmentBaseView::editorState(
+    QTreeWidgetItem *item, int column) {
+  return static_cast<EditorState>(item->data(column, EditorRole).toInt());
 }
 
-void PinAssignmentBaseView::updateInternalPinSelection(const QString &pin,
-                                                       QComboBox *combo) {
-  auto current = combo->currentText();
-
-  auto mode = m_model->packagePinModel()->getMode(pin);
-  auto model = new QStringListModel{combo};
-  QStringList list{{""}};
-  list.append(
-      m_model->packagePinModel()->GetInternalPinsList(pin, mode, current));
-  model->setStringList(list);
-  combo->blockSignals(true);
-  combo->setModel(model);
-  combo->setCurrentIndex(combo->findData(current, Qt::DisplayRole));
-  combo->blockSignals(false);
+QString PinAssignmentBaseView::comboText(QTreeWidgetItem *item, int column) {
+  return item->data(column, ComboTextRole).toString();
 }
 
-void PinAssignmentBaseView::setComboData(const QModelIndex &index,
-                                         const QString &data) {
-  if (auto combo = GetCombo(index)) {
-    const auto index = combo->findData(data, Qt::DisplayRole);
-    if (index > -1) combo->setCurrentIndex(index);
+void PinAssignmentBaseView::setComboText(QTreeWidgetItem *item, int column,
+                                         const QString &text, bool notify) {
+  const QString previous = comboText(item, column);
+  if (previous == text) return;
+  if (column == m_indexedColumn) {
+    m_comboItems.remove(previous, item);
+    if (!text.isEmpty()) m_comboItems.insert(text, item);
   }
+  item->setData(column, ComboTextRole, text);
+  if (notify) comboDataChanged(item, column, previous);
 }
 
-void PinAssignmentBaseView::setComboData(const QModelIndex &index, int column,
+void PinAssignmentBaseView::setComboData(QTreeWidgetItem *item, int column,
                                          const QString &data) {
-  if (auto combo = GetCombo(index, column)) {
-    const auto index = combo->findData(data, Qt::DisplayRole);
-    if (index > -1) combo->setCurrentIndex(index);
-  }
+  if (choices(item, column).contains(data)) setComboText(item, column, data);
 }
 
-QComboBox *PinAssignmentBaseView::CreateCombo(QWidget *parent) {
-  return new ComboBox{parent};
+void PinAssignmentBaseView::setIndexedColumn(int column) {
+  m_indexedColumn = column;
+}
+
+QList<QTreeWidgetItem *> PinAssignmentBaseView::comboItems(
+    const QString &text) const {
+  return m_comboItems.values(text);
 }
 
-void PinAssignmentBaseView::insertCombo(QComboBox *combo,
-                                        const QModelIndex &index) {
-  connect(combo, &QComboBox::destroyed, this,
-          &PinAssignmentBaseView::removeFromList);
-  m_allCombo.insert(combo, index);
+QList<QTreeWidgetItem *> PinAssignmentBaseView::comboItems() const {
+  return m_comboItems.values();
 }
 
-void PinAssignmentBaseView::removeFromList(QObject *obj) {
-  // Bug: qobject_cast<QComboBox*> returns 0 now the type is ComboBox
-  // Use brute force cast for now.
-  m_allCombo.remove((QComboBox *)obj);
+void PinAssignmentBaseView::removeDuplications(const QString &text,
+                                               QTreeWidgetItem *current) {
+  if (text.isEmpty()) return;
+  const auto items = comboItems(text);
+  for (auto item : items) {
+    if (item != current) {
+      setComboText(item, m_indexedColumn, QString{});
+      break;
+    }
+  }
+}
+
+QComboBox *PinAssignmentBaseView::CreateCombo(QWidget *parent) {
+  return new ComboBox{parent};
 }
 
 }  // namespace FOEDAG
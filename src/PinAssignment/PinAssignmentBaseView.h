@@ -20,7 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
 
-#include <QSet>
+#include <QMultiHash>
 #include <QTreeWidget>
 
 class QComboBox;
@@ -31,46 +31,71 @@ class PinsBaseModel;
 /*!
  * \brief The PinAssignmentBaseView class
  * The implemenation provide common funtionality to Package pin table and Ports
- * table.
+ * table. Combo box cells keep their value in ComboTextRole of the item, the
+ * combo box itself is created by PinAssignmentDelegate only while the cell is
+ * edited.
  */
 class PinAssignmentBaseView : public QTreeWidget {
   Q_OBJECT
  public:
+  enum EditorState { NoEditor = 0, EditorDisabled, EditorEnabled };
+  static constexpr int EditorRole{Qt::UserRole + 1};
+  static constexpr int ComboTextRole{Qt::UserRole + 2};
+
   PinAssignmentBaseView(PinsBaseModel *model, QWidget *parent = nullptr);
-  ~PinAssignmentBaseView();
 
  protected:
-  void removeDuplications(const QString &text, QComboBox *current);
-  QModelIndexList match(const QString &text) const;
-  QModelIndexList indexFromText(QTreeWidgetItem *i, const QString &text) const;
-  void updateInternalPinSelection(const QString &pin, QComboBox *combo);
-
-  template <class ComboPtr = QComboBox *>
-  ComboPtr GetCombo(const QModelIndex &index) const {
-    return qobject_cast<ComboPtr>(indexWidget(index));
-  }
-  template <class ComboPtr = QComboBox *>
-  ComboPtr GetCombo(const QModelIndex &index, int column) const {
-    return qobject_cast<ComboPtr>(itemWidget(itemFromIndex(index), column));
-  }
-  template <class Combo = QComboBox *>
-  Combo GetCombo(QTreeWidgetItem *item, int column) const {
-    return qobject_cast<Combo>(itemWidget(item, column));
-  }
-  void setComboData(const QModelIndex &index, const QString &data);
-  void setComboData(const QModelIndex &index, int column, const QString &data);
+  /*!
+   * \brief choices returns the values offered by the combo box of the cell.
+   * The first value is empty and clears the selection.
+   */
+  virtual QStringList choices(QTreeWidgetItem *item, int column) const;
+  /*!
+   * \brief searchable returns true if the combo box of the column is editable
+   * and filters its values by the typed text.
+   */
+  virtual bool searchable(int column) const;
+  /*!
+   * \brief comboDataChanged called when value of the combo box cell has
+   * changed. \a previous is the value before the change.
+   */
+  virtual void comboDataChanged(QTreeWidgetItem *item, int column,
+                                const QString &previous);
 
-  static QComboBox *CreateCombo(QWidget *parent);
-  void insertCombo(QComboBox *combo, const QModelIndex &index);
+  void setEditor(QTreeWidgetItem *item, int column, EditorState state);
+  static EditorState editorState(QTreeWidgetItem *item, int column);
+  static QString comboText(QTreeWidgetItem *item, int column);
+  /*!
+   * \brief setComboText stores \a text as value of the combo box cell.
+   * comboDataChanged() is called if the value has changed and \a notify is
+   * true.
+   */
+  void setComboText(QTreeWidgetItem *item, int column, const QString &text,
+                    bool notify = true);
+  /*!
+   * \brief setComboData selects \a data if it is one of the cell choices.
+   */
+  void setComboData(QTreeWidgetItem *item, int column, const QString &data);
 
- protected slots:
-  void removeFromList(QObject *obj);
+  /*!
+   * \brief setIndexedColumn values of this column are indexed so that
+   * comboItems() and removeDuplications() don't scan the table.
+   */
+  void setIndexedColumn(int column);
+  QList<QTreeWidgetItem *> comboItems(const QString &text) const;
+  QList<QTreeWidgetItem *> comboItems() const;
+  void removeDuplications(const QString &text, QTreeWidgetItem *current);
+
+  static QComboBox *CreateCombo(QWidget *parent);
 
  protected:
   PinsBaseModel *m_model{nullptr};
-  QMap<QComboBox *, QModelIndex> m_allCombo;
   bool m_blockUpdate{false};
-  QMap<QString, QSet<QComboBox *>> m_intPins;
+
+ private:
+  int m_indexedColumn{-1};
+  QMultiHash<QString, QTreeWidgetItem *> m_comboItems;
+  friend class PinAssignmentDelegate;
 };
 
 }  // namespace FOEDAG
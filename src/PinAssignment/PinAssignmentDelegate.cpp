@@ -0,0 +1,119 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "PinAssignmentDelegate.h"
+
+#include <QApplication>
+#include <QComboBox>
+#include <QCompleter>
+#include <QMouseEvent>
+#include <QStringListModel>
+
+#include "PinAssignmentBaseView.h"
+
+namespace FOEDAG {
+
+PinAssignmentDelegate::PinAssignmentDelegate(PinAssignmentBaseView *view)
+    : QStyledItemDelegate(view), m_view(view) {}
+
+QWidget *PinAssignmentDelegate::createEditor(QWidget *parent,
+                                             const QStyleOptionViewItem &,
+                                             const QModelIndex &index) const {
+  if (index.data(PinAssignmentBaseView::EditorRole).toInt() !=
+      PinAssignmentBaseView::EditorEnabled)
+    return nullptr;
+  auto item = m_view->itemFromIndex(index);
+  if (!item) return nullptr;
+
+  auto combo = PinAssignmentBaseView::CreateCombo(parent);
+  auto model =
+      new QStringListModel{m_view->choices(item, index.column()), combo};
+  combo->setModel(model);
+  combo->setAutoFillBackground(true);
+  if (m_view->searchable(index.column())) {
+    combo->setEditable(true);
+    auto completer{new QCompleter{model, combo}};
+    completer->setFilterMode(Qt::MatchContains);
+    combo->setCompleter(completer);
+    combo->setInsertPolicy(QComboBox::NoInsert);
+  }
+  auto self = const_cast<PinAssignmentDelegate *>(this);
+  connect(combo, QOverload<int>::of(&QComboBox::activated), self,
+          [self, combo]() {
+            emit self->commitData(combo);
+            emit self->closeEditor(combo);
+          });
+  return combo;
+}
+
+void PinAssignmentDelegate::setEditorData(QWidget *editor,
+                                          const QModelIndex &index) const {
+  if (auto combo = qobject_cast<QComboBox *>(editor)) {
+    const int current = combo->findText(
+        index.data(PinAssignmentBaseView::ComboTextRole).toString());
+    if (current > -1) combo->setCurrentIndex(current);
+  }
+}
+
+void PinAssignmentDelegate::setModelData(QWidget *editor, QAbstractItemModel *,
+                                         const QModelIndex &index) const {
+  auto combo = qobject_cast<QComboBox *>(editor);
+  auto item = m_view->itemFromIndex(index);
+  if (!combo || !item) return;
+  // typed text of the searchable combo box must match one of the choices
+  const int selected = combo->findText(combo->currentText());
+  if (selected < 0) return;
+  m_view->setComboText(item, index.column(), combo->itemText(selected));
+}
+
+void PinAssignmentDelegate::initStyleOption(QStyleOptionViewItem *option,
+                                            const QModelIndex &index) const {
+  QStyledItemDelegate::initStyleOption(option, index);
+  const int state = index.data(PinAssignmentBaseView::EditorRole).toInt();
+  if (state == PinAssignmentBaseView::NoEditor) return;
+  // combo box cell shows the selection instead of the item text
+  option->text = index.data(PinAssignmentBaseView::ComboTextRole).toString();
+  option->features |= QStyleOptionViewItem::HasDisplay;
+  if (state == PinAssignmentBaseView::EditorDisabled)
+    option->state &= ~QStyle::State_Enabled;
+}
+
+bool PinAssignmentDelegate::editorEvent(QEvent *event,
+                                        QAbstractItemModel *model,
+                                        const QStyleOptionViewItem &option,
+                                        const QModelIndex &index) {
+  if (event->type() == QEvent::MouseButtonRelease &&
+      !index.data(Qt::DecorationRole).isNull()) {
+    QStyleOptionViewItem opt{option};
+    initStyleOption(&opt, index);
+    auto style = opt.widget ? opt.widget->style() : QApplication::style();
+    const QRect icon =
+        style->subElementRect(QStyle::SE_ItemViewItemDecoration, &opt,
+                              opt.widget);
+    auto mouseEvent = static_cast<QMouseEvent *>(event);
+    if (icon.contains(mouseEvent->position().toPoint())) {
+      emit decorationClicked(index);
+      return true;
+    }
+  }
+  return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
+
+}  // namespace FOEDAG
@@ -0,0 +1,61 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QStyledItemDelegate>
+
+namespace FOEDAG {
+
+class PinAssignmentBaseView;
+
+/*!
+ * \brief The PinAssignmentDelegate class
+ * Creates combo box editors of PinAssignmentBaseView cells on demand. The
+ * choices of the combo box are requested from the view when the editor opens
+ * and the selection is committed back through the view. Click on the item
+ * icon is reported by decorationClicked().
+ */
+class PinAssignmentDelegate : public QStyledItemDelegate {
+  Q_OBJECT
+ public:
+  explicit PinAssignmentDelegate(PinAssignmentBaseView *view);
+
+  QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                        const QModelIndex &index) const override;
+  void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+  void setModelData(QWidget *editor, QAbstractItemModel *model,
+                    const QModelIndex &index) const override;
+
+ signals:
+  void decorationClicked(const QModelIndex &index);
+
+ protected:
+  void initStyleOption(QStyleOptionViewItem *option,
+                       const QModelIndex &index) const override;
+  bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                   const QStyleOptionViewItem &option,
+                   const QModelIndex &index) override;
+
+ private:
+  PinAssignmentBaseView *m_view{nullptr};
+};
+
+}  // namespace FOEDAG
@@ -25,46 +25,37 @@ namespace FOEDAG {
 PinsBaseModel::PinsBaseModel(QObject *parent) : QObject(parent) {}
 
 bool PinsBaseModel::exists(const QString &port, const QString &pin) const {
-  for (auto it = m_pinsMap.constBegin(); it != m_pinsMap.constEnd(); ++it) {
-    if (it.key() == port && it.value().first == pin) return true;
-  }
-  return false;
+  auto it = m_pinsMap.constFind(port);
+  return it != m_pinsMap.constEnd() && it.value().first == pin;
 }
 
 void PinsBaseModel::update(const QString &port, const QString &pin, int index) {
   if (port.isEmpty()) return;
   if (pin.isEmpty()) {
     auto values = m_pinsMap.value(port);
-    m_pinsMap.remove(port);
+    unbind(port);
     emit portAssignmentChanged(port, values.first, values.second);
   } else {
     auto pinPair = m_pinsMap.value(port);
     bool changed = (pinPair.first != pin || pinPair.second != index);
-    m_pinsMap.insert(port, std::make_pair(pin, index));
+    bind(port, pin, index);
     if (changed) emit portAssignmentChanged(port, pin, index);
   }
 }
 
 void PinsBaseModel::remove(const QString &port, const QString &pin, int index) {
-  m_pinsMap.remove(port);
+  unbind(port);
   emit portAssignmentChanged(port, QString{}, index);
 }
 
 QStringList PinsBaseModel::getPort(const QString &pin) const {
-  QStringList ports;
-  for (auto it{m_pinsMap.begin()}; it != m_pinsMap.end(); ++it) {
-    if (it.value().first == pin) ports.append(it.key());
-  }
-  return ports;
+  return m_portsMap.value(pin).keys();
 }
 
 int PinsBaseModel::getIndex(const QString &pin) const {
-  QVector<int> indexes;
-  for (auto it{m_pinsMap.begin()}; it != m_pinsMap.end(); ++it) {
-    if (it.value().first == pin) {
-      indexes.append(it.value().second);
-    }
-  }
+  auto it = m_portsMap.constFind(pin);
+  if (it == m_portsMap.constEnd()) return 0;
+  QVector<int> indexes(it.value().begin(), it.value().end());
   std::sort(indexes.begin(), indexes.end());
   for (int i = 0; i < indexes.count(); i++) {
     if (i != indexes.at(i)) return i;
@@ -90,4 +81,21 @@ const QMap<QString, std::pair<QString, int> > &PinsBaseModel::pinMap() const {
   return m_pinsMap;
 }
 
+void PinsBaseModel::bind(const QString &port, const QString &pin, int index) {
+  unbind(port);
+  m_pinsMap.insert(port, std::make_pair(pin, index));
+  m_portsMap[pin].insert(port, index);
+}
+
+void PinsBaseModel::unbind(const QString &port) {
+  auto it = m_pinsMap.find(port);
+  if (it == m_pinsMap.end()) return;
+  auto ports = m_portsMap.find(it.value().first);
+  if (ports != m_portsMap.end()) {
+    ports.value().remove(port);
+    if (ports.value().isEmpty()) m_portsMap.erase(ports);
+  }
+  m_pinsMap.erase(it);
+}
+
 }  // namespace FOEDAG
@@ -19,6 +19,7 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
+#include <QHash>
 #include <QObject>
 #include <QStringList>
 #include <QVector>
@@ -51,8 +52,14 @@ class PinsBaseModel : public QObject {
  signals:
   void portAssignmentChanged(const QString &port, const QString &pin, int row);
 
+ private:
+  void bind(const QString &port, const QString &pin, int index);
+  void unbind(const QString &port);
+
  private:
   QMap<QString, std::pair<QString, int>> m_pinsMap;  // key - port, value - pin
+  // reverse index of m_pinsMap: key - pin, value - <port, index>
+  QHash<QString, QMap<QString, int>> m_portsMap;
   PackagePinsModel *m_packagePinModel;
   PortsModel *m_portsModel;
 };
@@ -20,26 +20,25 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "PortsView.h"
 
-#include <QCompleter>
 #include <QHeaderView>
 #include <QStringListModel>
 
-#include "BufferedComboBox.h"
 #include "PinsBaseModel.h"
 
 namespace FOEDAG {
 
-constexpr uint PortName{0};
-constexpr uint DirCol{1};
-constexpr uint PackagePinCol{2};
-constexpr uint ModeCol{3};
-constexpr uint InternalPinsCol{4};
-constexpr uint TypeCol{5};
+constexpr int PortName{0};
+constexpr int DirCol{1};
+constexpr int PackagePinCol{2};
+constexpr int ModeCol{3};
+constexpr int InternalPinsCol{4};
+constexpr int TypeCol{5};
 
 PortsView::PortsView(PinsBaseModel *model, QWidget *parent)
     : PinAssignmentBaseView(model, parent) {
   setHeaderLabels(model->portsModel()->headerList());
   header()->resizeSections(QHeaderView::ResizeToContents);
+  setIndexedColumn(PackagePinCol);
 
   QTreeWidgetItem *topLevel = new QTreeWidgetItem(this);
   topLevel->setText(0, "Design ports");
@@ -74,203 +73,142 @@ PortsView::PortsView(PinsBaseModel *model, QWidget *parent)
 }
 
 void PortsView::SetPin(const QString &port, const QString &pin) {
-  QModelIndexList indexes{match(port)};
-  if (!indexes.isEmpty()) {
-    auto index = indexes.first();
-    setComboData(index, PackagePinCol, pin);
+  if (auto item = m_portItems.value(port)) {
+    setComboData(item, PackagePinCol, pin);
   }
 }
 
 void PortsView::cleanTable() {
-  for (auto it{m_allCombo.cbegin()}; it != m_allCombo.cend(); it++) {
-    it.key()->setCurrentIndex(0);
-  }
+  const auto items{comboItems()};
+  for (auto item : items) setComboText(item, PackagePinCol, QString{});
 }
 
-void PortsView::packagePinSelectionHasChanged(const QModelIndex &index) {
-  // update here Mode selection
-  auto item = itemFromIndex(index);
-  auto combo =
-      item ? GetCombo<BufferedComboBox *>(item, PackagePinCol) : nullptr;
-  if (combo) {
-    const QString port =
-        combo->currentText().isEmpty() ? QString{} : item->text(PortName);
-    updateModeCombo(port, index);
+QStringList PortsView::choices(QTreeWidgetItem *item, int column) const {
+  auto packagePinModel = m_model->packagePinModel();
+  switch (column) {
+    case PackagePinCol:
+      return packagePinModel->listModel()->stringList();
+    case ModeCol: {
+      if (comboText(item, PackagePinCol).isEmpty()) return {};
+      const bool output = item->text(DirCol) == "Output";
+      return output ? packagePinModel->modeModelTx()->stringList()
+                    : packagePinModel->modeModelRx()->stringList();
+    }
+    case InternalPinsCol: {
+      const QString mode = comboText(item, ModeCol);
+      if (mode.isEmpty()) return {};
+      QStringList list{{""}};
+      list.append(packagePinModel->GetInternalPinsList(
+          comboText(item, PackagePinCol), mode,
+          comboText(item, InternalPinsCol)));
+      return list;
+    }
+    default:
+      return {};
   }
+}
 
-  if (item) {
-    auto combo = GetCombo<BufferedComboBox *>(item, PackagePinCol);
-    auto internalPinCombo = GetCombo(item, InternalPinsCol);
-    if (combo) {
-      auto pin = combo->currentText();
-      auto prevPin = combo->previousText();
-
-      if (!pin.isEmpty())
-        m_intPins[combo->currentText()].insert(internalPinCombo);
-      if (!prevPin.isEmpty()) m_intPins[prevPin].remove(internalPinCombo);
+bool PortsView::searchable(int column) const {
+  return column == PackagePinCol;
+}
 
-      auto port = item->text(PortName);
-      int index = m_model->getIndex(pin);
-      m_blockUpdate = true;
-      if (!prevPin.isEmpty()) m_model->update(QString{}, prevPin, -1);
-      m_model->update(port, pin, index);
-      m_blockUpdate = false;
-      emit selectionHasChanged();
-    }
+void PortsView::comboDataChanged(QTreeWidgetItem *item, int column,
+                                 const QString &previous) {
+  switch (column) {
+    case PackagePinCol:
+      packagePinSelectionHasChanged(item, previous);
+      break;
+    case ModeCol:
+      modeSelectionHasChanged(item);
+      break;
+    case InternalPinsCol:
+      internalPinSelectionHasChanged(item);
+      break;
   }
 }
 
+void PortsView::packagePinSelectionHasChanged(QTreeWidgetItem *item,
+                                              const QString &prevPin) {
+  // update here Mode selection
+  auto pin = comboText(item, PackagePinCol);
+  auto port = item->text(PortName);
+  updateModeCombo(pin.isEmpty() ? QString{} : port, item);
+
+  int index = m_model->getIndex(pin);
+  m_blockUpdate = true;
+  if (!prevPin.isEmpty()) m_model->update(QString{}, prevPin, -1);
+  m_model->update(port, pin, index);
+  m_blockUpdate = false;
+  emit selectionHasChanged();
+}
+
 void PortsView::insertTableItem(QTreeWidgetItem *parent, const IOPort &port) {
   auto it = new QTreeWidgetItem{parent};
   it->setText(PortName, port.name);
   it->setText(DirCol, port.dir);
   it->setText(TypeCol, port.type);
-
-  auto combo = new BufferedComboBox{this};
-  combo->setModel(m_model->packagePinModel()->listModel());
-  combo->setAutoFillBackground(true);
-  combo->setEditable(true);
-  auto completer{new QCompleter{m_model->packagePinModel()->listModel()}};
-  completer->setFilterMode(Qt::MatchContains);
-  combo->setCompleter(completer);
-  combo->setInsertPolicy(QComboBox::NoInsert);
-  connect(combo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
-          [=]() {
-            packagePinSelectionHasChanged(indexFromItem(it, PackagePinCol));
-          });
-  setItemWidget(it, PackagePinCol, combo);
-  insertCombo(combo, indexFromItem(it));
-
-  auto modeCombo = CreateCombo(this);
-  modeCombo->setEnabled(modeCombo->count() > 0);
-  connect(modeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
-          [=]() { modeSelectionHasChanged(indexFromItem(it, ModeCol)); });
-  setItemWidget(it, ModeCol, modeCombo);
-
-  auto internalPinCombo = CreateCombo(this);
-  internalPinCombo->setEnabled(internalPinCombo->count() > 0);
-  connect(internalPinCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
-          this, [=]() {
-            internalPinSelectionHasChanged(indexFromItem(it, ModeCol));
-          });
-  setItemWidget(it, InternalPinsCol, internalPinCombo);
+  setEditor(it, PackagePinCol, EditorEnabled);
+  setEditor(it, ModeCol, EditorDisabled);
+  setEditor(it, InternalPinsCol, EditorDisabled);
+  m_portItems.insert(port.name, it);
 }
 
-void PortsView::modeSelectionHasChanged(const QModelIndex &index) {
-  auto item = itemFromIndex(index);
-  if (item) {
-    auto comboMode = GetCombo(item, ModeCol);
-    if (comboMode) {
-      m_model->packagePinModel()->updateMode(getPinSelection(index),
-                                             comboMode->currentText());
-      updateIntPinCombo(comboMode->currentText(), index);
-      emit selectionHasChanged();
-    }
-  }
+void PortsView::modeSelectionHasChanged(QTreeWidgetItem *item) {
+  const auto mode = comboText(item, ModeCol);
+  m_model->packagePinModel()->updateMode(comboText(item, PackagePinCol), mode);
+  updateIntPinCombo(mode, item);
+  emit selectionHasChanged();
 }
 
-void PortsView::internalPinSelectionHasChanged(const QModelIndex &index) {
-  auto item = itemFromIndex(index);
-  if (item) {
-    auto comboIntPin = GetCombo(item, InternalPinsCol);
-    if (comboIntPin) {
-      m_model->packagePinModel()->updateInternalPin(item->text(PortName),
-                                                    comboIntPin->currentText());
-      const auto combos{m_intPins[getPinSelection(index)]};
-      for (auto c : combos) {
-        if (comboIntPin != c)
-          updateInternalPinSelection(getPinSelection(index), c);
-      }
-      emit selectionHasChanged();
-    }
-  }
+void PortsView::internalPinSelectionHasChanged(QTreeWidgetItem *item) {
+  m_model->packagePinModel()->updateInternalPin(
+      item->text(PortName), comboText(item, InternalPinsCol));
+  emit selectionHasChanged();
 }
 
-void PortsView::updateModeCombo(const QString &port, const QModelIndex &index) {
-  auto modeIndex = model()->index(index.row(), ModeCol, index.parent());
-  QComboBox *modeCombo{GetCombo(modeIndex, ModeCol)};
-  if (modeCombo) {
-    modeCombo->setEnabled(!port.isEmpty());
-    if (port.isEmpty()) {
-      const QSignalBlocker blocker{modeCombo};
-      modeCombo->setCurrentIndex(0);
-      // update model in PackagePinsView
-      // cleanup internal pin selection
-      updateIntPinCombo(QString{}, index);
-    } else {
-      auto currentMode =
-          m_model->packagePinModel()->getMode(getPinSelection(index));
-
-      auto ioPort = m_model->portsModel()->GetPort(port);
-      const bool output = ioPort.dir == "Output";
-      QAbstractItemModel *modeModel =
-          output ? m_model->packagePinModel()->modeModelTx()
-                 : m_model->packagePinModel()->modeModelRx();
-      modeCombo->blockSignals(!currentMode.isEmpty());
-      if (modeCombo->model() != modeModel) {
-        modeCombo->setModel(modeModel);
-      }
-      if (!currentMode.isEmpty()) {
-        const int idx = modeCombo->findData(currentMode, Qt::DisplayRole);
-        if (idx > -1) modeCombo->setCurrentIndex(idx);
-        updateIntPinCombo(currentMode, index);
-      }
-      modeCombo->blockSignals(false);
-    }
+void PortsView::updateModeCombo(const QString &port, QTreeWidgetItem *item) {
+  setEditor(item, ModeCol, port.isEmpty() ? EditorDisabled : EditorEnabled);
+  if (port.isEmpty()) {
+    setComboText(item, ModeCol, QString{}, false);
+    // update model in PackagePinsView
+    // cleanup internal pin selection
+    updateIntPinCombo(QString{}, item);
+  } else {
+    auto currentMode =
+        m_model->packagePinModel()->getMode(comboText(item, PackagePinCol));
+    // available modes depend on the port direction
+    if (!choices(item, ModeCol).contains(currentMode)) currentMode.clear();
+    setComboText(item, ModeCol, currentMode, false);
+    if (!currentMode.isEmpty()) updateIntPinCombo(currentMode, item);
   }
 }
 
-void PortsView::updateIntPinCombo(const QString &mode,
-                                  const QModelIndex &index) {
-  auto intPinIndex =
-      model()->index(index.row(), InternalPinsCol, index.parent());
-  QComboBox *intPinCombo{GetCombo(intPinIndex, InternalPinsCol)};
-  if (intPinCombo) {
-    if (mode.isEmpty()) {
-      intPinCombo->setCurrentIndex(0);
-      intPinCombo->setEnabled(false);
-    } else {
-      intPinCombo->setEnabled(true);
-      auto pin = getPinSelection(index);
-      intPinCombo->setEnabled(true);
-      auto model = new QStringListModel{};
-      QStringList list{{""}};
-      list.append(m_model->packagePinModel()->GetInternalPinsList(pin, mode));
-      model->setStringList(list);
-      intPinCombo->setModel(model);
-    }
+void PortsView::updateIntPinCombo(const QString &mode, QTreeWidgetItem *item) {
+  if (mode.isEmpty()) {
+    setComboText(item, InternalPinsCol, QString{});
+    setEditor(item, InternalPinsCol, EditorDisabled);
+  } else {
+    setEditor(item, InternalPinsCol, EditorEnabled);
+    if (!choices(item, InternalPinsCol)
+             .contains(comboText(item, InternalPinsCol)))
+      setComboText(item, InternalPinsCol, QString{});
   }
 }
 
-QString PortsView::getPinSelection(const QModelIndex &index) const {
-  auto pinIndex = model()->index(index.row(), PackagePinCol, index.parent());
-  QComboBox *pinCombo{GetCombo(pinIndex, PackagePinCol)};
-  return pinCombo ? pinCombo->currentText() : QString{};
-}
-
 void PortsView::modeChanged(const QString &pin, const QString &mode) {
   if (pin.isEmpty()) return;
 
   const auto ports = m_model->getPort(pin);
   for (const auto &port : ports) {
-    QModelIndexList indexes{match(port)};
-    for (const auto &index : indexes) {
-      QModelIndex modeIndex =
-          model()->index(index.row(), ModeCol, index.parent());
-      setComboData(modeIndex, ModeCol, mode);
-    }
+    if (auto item = m_portItems.value(port)) setComboData(item, ModeCol, mode);
   }
 }
 
 void PortsView::intPinChanged(const QString &port, const QString &intPin) {
   if (port.isEmpty()) return;
 
-  QModelIndexList indexes{match(port)};
-  if (!indexes.isEmpty()) {
-    auto index = indexes.first();
-    QModelIndex modeIndex =
-        model()->index(index.row(), InternalPinsCol, index.parent());
-    setComboData(modeIndex, InternalPinsCol, intPin);
+  if (auto item = m_portItems.value(port)) {
+    setComboData(item, InternalPinsCol, intPin);
   }
 }
 
@@ -20,9 +20,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
 
+#include <QHash>
+
 #include "PinAssignmentBaseView.h"
 
-class QComboBox;
 namespace FOEDAG {
 
 struct IOPort;
@@ -36,19 +37,28 @@ class PortsView : public PinAssignmentBaseView {
  signals:
   void selectionHasChanged();
 
+ protected:
+  QStringList choices(QTreeWidgetItem *item, int column) const override;
+  bool searchable(int column) const override;
+  void comboDataChanged(QTreeWidgetItem *item, int column,
+                        const QString &previous) override;
+
  private:
-  void packagePinSelectionHasChanged(const QModelIndex &index);
+  void packagePinSelectionHasChanged(QTreeWidgetItem *item,
+                                     const QString &prevPin);
   void insertTableItem(QTreeWidgetItem *parent, const IOPort &port);
-  void modeSelectionHasChanged(const QModelIndex &index);
-  void internalPinSelectionHasChanged(const QModelIndex &index);
-  void updateModeCombo(const QString &port, const QModelIndex &index);
-  void updateIntPinCombo(const QString &mode, const QModelIndex &index);
-  QString getPinSelection(const QModelIndex &index) const;
+  void modeSelectionHasChanged(QTreeWidgetItem *item);
+  void internalPinSelectionHasChanged(QTreeWidgetItem *item);
+  void updateModeCombo(const QString &port, QTreeWidgetItem *item);
+  void updateIntPinCombo(const QString &mode, QTreeWidgetItem *item);
 
  private slots:
   void modeChanged(const QString &pin, const QString &mode);
   void intPinChanged(const QString &port, const QString &intPin);
   void portAssignmentChanged(const QString &port, const QString &pin, int row);
+
+ private:
+  QHash<QString, QTreeWidgetItem *> m_portItems;
 };
 
 }  // namespace FOEDAG
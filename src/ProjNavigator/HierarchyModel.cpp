@@ -0,0 +1,372 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "HierarchyModel.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+
+#include "Utils/StringUtils.h"
+#include "nlohmann_json/json.hpp"
+using json = nlohmann::ordered_json;
+
+namespace FOEDAG {
+
+struct HierarchyModel::Node {
+  Node *parent{nullptr};
+  int row{0};
+  bool top{false};
+  QString name;  // module name of a top, instance name otherwise
+  QString module;
+  QString file;
+  int line{0};
+  QString instFile;
+  int instLine{0};
+  bool expandable{false};
+  bool fetched{false};
+  std::vector<std::unique_ptr<Node>> children;
+
+  QString key() const { return name + QChar{'\n'} + module; }
+  QString title() const {
+    const QString fileName = QFileInfo{file}.fileName();
+    if (top) return QString{"%1 (%2)"}.arg(name, fileName);
+    return QString{"%1 : %2 (%3)"}.arg(name, module, fileName);
+  }
+  // copies what is shown, returns true if anything changed
+  bool assign(const Node &other) {
+    const bool changed = file != other.file || line != other.line ||
+                         instFile != other.instFile ||
+                         instLine != other.instLine ||
+                         expandable != other.expandable;
+    file = other.file;
+    line = other.line;
+    instFile = other.instFile;
+    instLine = other.instLine;
+    expandable = other.expandable;
+    return changed;
+  }
+  void renumber(size_t from) {
+    for (size_t i = from; i < children.size(); i++) {
+      children[i]->parent = this;
+      children[i]->row = static_cast<int>(i);
+    }
+  }
+};
+
+std::shared_ptr<const HierarchyData> HierarchyData::load(
+    const std::filesystem::path &file, QString &error) {
+  QFile jsonFile{QString::fromStdString(file.string())};
+  if (!jsonFile.exists()) return nullptr;  // no analysis yet
+  if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    error = QString{"Failed to open %1"}.arg(jsonFile.fileName());
+    return nullptr;
+  }
+  auto data = std::make_shared<HierarchyData>();
+  try {
+    const json jsonObject = json::parse(jsonFile.readAll().toStdString());
+    QHash<int, QString> files{{0, QString{}}};
+    const auto &fileIds = jsonObject.at("fileIDs");
+    for (auto it = fileIds.begin(); it != fileIds.end(); it++) {
+      const auto &[id, ok] = StringUtils::to_number<int>(it.key());
+      if (!ok) continue;
+      auto path = std::filesystem::path{it.value().get<std::string>()};
+      if (path.is_relative())
+        path = (file.parent_path() / path).lexically_normal();
+      files.insert(id, QString::fromStdString(path.string()));
+    }
+    auto fileOf = [&files](const json &object) {
+      const auto &[id, ok] =
+          StringUtils::to_number<int>(object.at("file").get<std::string>());
+      return ok ? files.value(id) : QString{};
+    };
+    auto parseModule = [&fileOf](const json &object, HierarchyModule &module) {
+      module.file = fileOf(object);
+      module.line = object.at("line").get<int>();
+      if (!object.contains("moduleInsts")) return;
+      for (const auto &inst : object.at("moduleInsts")) {
+        HierarchyInstance instance{};
+        instance.module =
+            QString::fromStdString(inst.at("module").get<std::string>());
+        instance.instName =
+            QString::fromStdString(inst.at("instName").get<std::string>());
+        instance.instFile = fileOf(inst);
+        instance.instLine = inst.at("line").get<int>();
+        module.instances.append(instance);
+      }
+    };
+    const auto &modules = jsonObject.at("modules");
+    for (auto it = modules.begin(); it != modules.end(); it++) {
+      HierarchyModule module{};
+      module.name = QString::fromStdString(it.key());
+      parseModule(it.value(), module);
+      data->modules.insert(module.name, module);
+    }
+    for (const auto &top : jsonObject.at("hierTree")) {
+      HierarchyModule module{};
+      module.name =
+          QString::fromStdString(top.at("topModule").get<std::string>());
+      parseModule(top, module);
+      data->topModuleFile = module.file;
+      data->tops.append(module);
+    }
+  } catch (std::exception &e) {
+    error = QString{"Failed to parse %1. Error: %2"}.arg(
+        jsonFile.fileName(), QString::fromUtf8(e.what()));
+    return nullptr;
+  }
+  return data;
+}
+
+HierarchyModel::HierarchyModel(QObject *parent)
+    : QAbstractItemModel(parent), m_root(std::make_unique<Node>()) {
+  m_root->fetched = true;
+}
+
+HierarchyModel::~HierarchyModel() = default;
+
+void HierarchyModel::update(const std::shared_ptr<const HierarchyData> &data) {
+  if (!data) {
+    clear();
+    return;
+  }
+  m_data = data;
+  merge(m_root.get());
+}
+
+void HierarchyModel::clear() {
+  beginResetModel();
+  m_data.reset();
+  m_root->children.clear();
+  endResetModel();
+}
+
+QModelIndex HierarchyModel::index(int row, int column,
+                                  const QModelIndex &parent) const {
+  Node *p = node(parent);
+  if (column != 0 || row < 0 || row >= static_cast<int>(p->children.size()))
+    return {};
+  return createIndex(row, column, p->children[row].get());
+}
+
+QModelIndex HierarchyModel::parent(const QModelIndex &child) const {
+  if (!child.isValid()) return {};
+  return indexOf(node(child)->parent);
+}
+
+int HierarchyModel::rowCount(const QModelIndex &parent) const {
+  if (parent.column() > 0) return 0;
+  return static_cast<int>(node(parent)->children.size());
+}
+
+int HierarchyModel::columnCount(const QModelIndex &parent) const { return 1; }
+
+QVariant HierarchyModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid()) return {};
+  const Node *n = node(index);
+  switch (role) {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+      return n->title();
+    case FileRole:
+      return n->file;
+    case LineRole:
+      return n->line;
+    case InstFileRole:
+      return n->instFile;
+    case InstLineRole:
+      return n->instLine;
+    case TopItemRole:
+      return n->top;
+    default:
+      return {};
+  }
+}
+
+bool HierarchyModel::hasChildren(const QModelIndex &parent) const {
+  const Node *n = node(parent);
+  return n->fetched ? !n->children.empty() : n->expandable;
+}
+
+bool HierarchyModel::canFetchMore(const QModelIndex &parent) const {
+  const Node *n = node(parent);
+  return !n->fetched && n->expandable;
+}
+
+void HierarchyModel::fetchMore(const QModelIndex &parent) {
+  Node *n = node(parent);
+  if (n->fetched) return;
+  n->fetched = true;
+  auto children = createChildren(n);
+  if (children.empty()) return;
+  beginInsertRows(parent, 0, static_cast<int>(children.size()) - 1);
+  n->children = std::move(children);
+  n->renumber(0);
+  endInsertRows();
+}
+
+HierarchyModel::Node *HierarchyModel::node(const QModelIndex &index) const {
+  return index.isValid() ? static_cast<Node *>(index.internalPointer())
+                         : m_root.get();
+}
+
+QModelIndex HierarchyModel::indexOf(Node *node) const {
+  if (node == nullptr || node == m_root.get()) return {};
+  return createIndex(node->row, 0, node);
+}
+
+const QVector<HierarchyInstance> *HierarchyModel::definition(
+    const QString &module) const {
+  auto it = m_data->modules.find(module);
+  return it == m_data->modules.end() ? nullptr : &it->instances;
+}
+
+std::vector<std::unique_ptr<HierarchyModel::Node>>
+HierarchyModel::createChildren(Node *parent) const {
+  std::vector<std::unique_ptr<Node>> children;
+  if (!m_data) return children;
+  if (parent == m_root.get()) {
+    for (const auto &top : m_data->tops) {
+      auto n = std::make_unique<Node>();
+      n->top = true;
+      n->name = top.name;
+      n->module = top.name;
+      n->file = top.file;
+      n->line = top.line;
+      n->expandable = !top.instances.empty();
+      children.push_back(std::move(n));
+    }
+    return children;
+  }
+  const QVector<HierarchyInstance> *instances{nullptr};
+  if (parent->top) {
+    for (const auto &top : m_data->tops)
+      if (top.name == parent->name) instances = &top.instances;
+  } else {
+    instances = definition(parent->module);
+  }
+  if (!instances) return children;
+  children.reserve(instances->size());
+  for (const auto &inst : *instances) {
+    auto n = std::make_unique<Node>();
+    n->name = inst.instName;
+    n->module = inst.module;
+    n->instFile = inst.instFile;
+    n->instLine = inst.instLine;
+    auto it = m_data->modules.find(inst.module);
+    if (it != m_data->modules.end()) {
+      n->file = it->file;
+      n->line = it->line;
+      n->expandable = !it->instances.empty();
+    }
+    children.push_back(std::move(n));
+  }
+  return children;
+}
+
+/*
+  Brings the fetched children of parent in line with the current data.
+  Rows of unchanged instances are kept with their fetched subtrees, only
+  removed and added instances change rows. If instances were reordered the
+  children are replaced.
+*/
+void HierarchyModel::merge(Node *parent) {
+  const QModelIndex parentIndex = indexOf(parent);
+  auto fresh = createChildren(parent);
+  auto &old = parent->children;
+
+  // keys are unique unless the design is broken, then children are replaced
+  bool unique{true};
+  QHash<QString, int> freshRows;
+  for (size_t i = 0; i < fresh.size(); i++) {
+    if (freshRows.contains(fresh[i]->key())) unique = false;
+    freshRows.insert(fresh[i]->key(), static_cast<int>(i));
+  }
+  QSet<QString> oldKeys;
+  for (const auto &n : old) {
+    if (oldKeys.contains(n->key())) unique = false;
+    oldKeys.insert(n->key());
+  }
+
+  // instances no longer there, removed by contiguous ranges
+  for (int last = static_cast<int>(old.size()) - 1; unique && last >= 0;) {
+    if (freshRows.contains(old[last]->key())) {
+      last--;
+      continue;
+    }
+    int first = last;
+    while (first > 0 && !freshRows.contains(old[first - 1]->key())) first--;
+    beginRemoveRows(parentIndex, first, last);
+    old.erase(old.begin() + first, old.begin() + last + 1);
+    parent->renumber(first);
+    endRemoveRows();
+    last = first - 1;
+  }
+  bool ordered{unique};
+  for (size_t i = 1; i < old.size() && ordered; i++) {
+    ordered =
+        freshRows.value(old[i - 1]->key()) < freshRows.value(old[i]->key());
+  }
+
+  if (!ordered) {
+    if (!old.empty()) {
+      beginRemoveRows(parentIndex, 0, static_cast<int>(old.size()) - 1);
+      old.clear();
+      endRemoveRows();
+    }
+    if (!fresh.empty()) {
+      beginInsertRows(parentIndex, 0, static_cast<int>(fresh.size()) - 1);
+      old = std::move(fresh);
+      parent->renumber(0);
+      endInsertRows();
+    }
+    return;
+  }
+
+  // kept rows are in order now, insert the new ones between them
+  size_t pos{0};
+  for (size_t i = 0; i < fresh.size();) {
+    if (pos < old.size() && old[pos]->key() == fresh[i]->key()) {
+      Node *kept = old[pos].get();
+      if (kept->assign(*fresh[i])) {
+        const QModelIndex index = indexOf(kept);
+        emit dataChanged(index, index);
+      }
+      if (kept->fetched) merge(kept);
+      pos++;
+      i++;
+      continue;
+    }
+    size_t end = i;
+    while (end < fresh.size() &&
+           (pos >= old.size() || old[pos]->key() != fresh[end]->key()))
+      end++;
+    const int first = static_cast<int>(pos);
+    beginInsertRows(parentIndex, first, first + static_cast<int>(end - i) - 1);
+    old.insert(old.begin() + pos, std::make_move_iterator(fresh.begin() + i),
+               std::make_move_iterator(fresh.begin() + end));
+    parent->renumber(pos);
+    endInsertRows();
+    pos += end - i;
+    i = end;
+  }
+}
+
+}  // namespace FOEDAG
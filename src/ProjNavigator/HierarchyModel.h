@@ -0,0 +1,113 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace FOEDAG {
+
+struct HierarchyInstance {
+  QString instName;
+  QString module;
+  QString instFile;
+  int instLine{0};
+};
+
+struct HierarchyModule {
+  QString name;
+  QString file;
+  int line{0};
+  QVector<HierarchyInstance> instances;
+};
+
+/*!
+ * \brief The HierarchyData struct is the parsed content of hier_info.json.
+ * Instances refer to their module by name, the tree is expanded from the
+ * module definitions when it is shown.
+ */
+struct HierarchyData {
+  QVector<HierarchyModule> tops;
+  QHash<QString, HierarchyModule> modules;
+  QString topModuleFile;
+
+  /*!
+   * \brief load reads and parses \a file. Safe to call from any thread.
+   * \return nullptr if the file does not exist or can't be parsed, in the
+   * latter case the reason is in \a error.
+   */
+  static std::shared_ptr<const HierarchyData> load(
+      const std::filesystem::path &file, QString &error);
+};
+
+/*!
+ * \brief The HierarchyModel class shows the design hierarchy. The children
+ * of a module instance are created when the view expands it, so large
+ * designs cost only what is visible. A new hierarchy is merged into the
+ * rows already created: unchanged instances keep their indexes, so the view
+ * keeps expansion and selection.
+ */
+class HierarchyModel : public QAbstractItemModel {
+  Q_OBJECT
+
+ public:
+  enum Roles {
+    FileRole = Qt::UserRole + 1,
+    LineRole,
+    InstFileRole,
+    InstLineRole,
+    TopItemRole
+  };
+
+  explicit HierarchyModel(QObject *parent = nullptr);
+  ~HierarchyModel() override;
+
+  void update(const std::shared_ptr<const HierarchyData> &data);
+  void clear();
+
+  QModelIndex index(int row, int column,
+                    const QModelIndex &parent = {}) const override;
+  QModelIndex parent(const QModelIndex &child) const override;
+  int rowCount(const QModelIndex &parent = {}) const override;
+  int columnCount(const QModelIndex &parent = {}) const override;
+  QVariant data(const QModelIndex &index, int role) const override;
+  bool hasChildren(const QModelIndex &parent = {}) const override;
+  bool canFetchMore(const QModelIndex &parent) const override;
+  void fetchMore(const QModelIndex &parent) override;
+
+ private:
+  struct Node;
+  Node *node(const QModelIndex &index) const;
+  QModelIndex indexOf(Node *node) const;
+  const QVector<HierarchyInstance> *definition(const QString &module) const;
+  std::vector<std::unique_ptr<Node>> createChildren(Node *parent) const;
+  void merge(Node *parent);
+
+  std::shared_ptr<const HierarchyData> m_data{};
+  std::unique_ptr<Node> m_root;
+};
+
+}  // namespace FOEDAG
@@ -20,60 +20,64 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
 
-#include <QMap>
 #include <QObject>
 #include <QString>
-#include <QVector>
+#include <cstdint>
 #include <filesystem>
+#include <future>
+#include <memory>
+#include <vector>
 
-#include "nlohmann_json/json.hpp"
-using json = nlohmann::ordered_json;
-
-class QTreeWidget;
-class QTreeWidgetItem;
+class QModelIndex;
+class QPoint;
+class QTreeView;
 
 namespace FOEDAG {
 
-struct Module {
-  QString name;
-  QString instName;
-  QString file;
-  QString line;
-  QString instFile;
-  QString instLine;
-  QVector<Module *> moduleInst;
-};
+class HierarchyModel;
+struct HierarchyData;
 
+/*!
+ * \brief The HierarchyView class shows hier_info.json of the analysis. The
+ * file is parsed in the job pool and the result is merged into the model,
+ * so the view keeps its expanded items when the design is analyzed again.
+ */
 class HierarchyView : public QObject {
   Q_OBJECT
 
  public:
   HierarchyView(const std::filesystem::path &ports);
+  ~HierarchyView() override;
   void setPortsFile(const std::filesystem::path &ports);
   void update();
   void clean();
 
-  QTreeWidget *widget();
+  QTreeView *widget();
+  HierarchyModel *model();
 
  signals:
   void openFile(const QString &file, int line);
   void topModuleFile(const QString &);
+  // the last update() is shown
+  void updated();
 
  private slots:
   void treeWidgetContextMenu(const QPoint &pos);
-  void OpenModuleInstance(QTreeWidgetItem *item, int column);
+  void OpenModuleInstance(const QModelIndex &index);
 
  private:
-  QTreeWidgetItem *addItem(QTreeWidgetItem *parent, Module *module);
-  void parseJson(json &jsonObject);
-  void emitOpenFile(QTreeWidgetItem *item, int column);
-  void emitOpenInstFile(QTreeWidgetItem *item, int column);
+  void apply(uint64_t generation,
+             const std::shared_ptr<const HierarchyData> &data,
+             const QString &error);
+  void emitOpenFile(const QModelIndex &index);
+  void emitOpenInstFile(const QModelIndex &index);
 
  private:
-  QTreeWidget *m_treeWidget{};
+  QTreeView *m_treeView{};
+  HierarchyModel *m_model{};
   std::filesystem::path m_portsFile;
-  QMap<int, QString> m_files;
-  QVector<Module> m_topVector;
+  uint64_t m_generation{0};  // results of older updates are dropped
+  std::vector<std::future<void>> m_loads;
 };
 
 }  // namespace FOEDAG
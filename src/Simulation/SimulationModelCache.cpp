@@ -0,0 +1,318 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "SimulationModelCache.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <set>
+#include <sstream>
+
+namespace FOEDAG {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// FNV-1a, the key only has to detect changes
+class Hash {
+ public:
+  void add(const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      m_value ^= static_cast<unsigned char>(data[i]);
+      m_value *= 1099511628211ull;
+    }
+  }
+  void add(const std::string& str) {
+    add(str.data(), str.size());
+    add("\0", 1);
+  }
+  void add(uint64_t value) { add(std::to_string(value)); }
+  uint64_t value() const { return m_value; }
+
+ private:
+  uint64_t m_value{14695981039346656037ull};
+};
+
+std::string toHex(uint64_t value) {
+  std::ostringstream out;
+  out << std::hex << std::setw(16) << std::setfill('0') << value;
+  return out.str();
+}
+
+bool isSourceFile(const fs::path& file) {
+  static const std::set<std::string> extensions{
+      ".v",   ".sv", ".vh", ".svh", ".vhd", ".vhdl", ".h",
+      ".hpp", ".c",  ".cc", ".cpp", ".inc", ".vlt"};
+  return extensions.count(file.extension().string()) != 0;
+}
+
+// Words of a -f/-F file list, // and # start a comment
+std::vector<std::string> readFileList(const fs::path& file) {
+  std::vector<std::string> words;
+  std::ifstream in{file};
+  std::string line;
+  while (std::getline(in, line)) {
+    line = line.substr(0, line.find("//"));
+    std::istringstream stream{line};
+    std::string word;
+    while (stream >> word) {
+      if (word[0] == '#') break;
+      words.push_back(word);
+    }
+  }
+  return words;
+}
+
+// Inputs of a make dependency file ("targets: inputs" with '\' line
+// continuations), as written by Verilator in obj_dir/V<top>__ver.d
+std::vector<std::string> readDependencyFile(const fs::path& file) {
+  std::ifstream in{file};
+  std::string text{std::istreambuf_iterator<char>{in},
+                   std::istreambuf_iterator<char>{}};
+  std::vector<std::string> inputs;
+  size_t pos{0};
+  while (pos < text.size()) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string::npos) end = text.size();
+    std::string rule = text.substr(pos, end - pos);
+    pos = end + 1;
+    while (!rule.empty() && rule.back() == '\\' && pos < text.size()) {
+      rule.pop_back();
+      end = text.find('\n', pos);
+      if (end == std::string::npos) end = text.size();
+      rule += " " + text.substr(pos, end - pos);
+      pos = end + 1;
+    }
+    const size_t colon = rule.find(": ");
+    if (colon == std::string::npos) continue;
+    std::istringstream words{rule.substr(colon + 1)};
+    std::string word;
+    while (words >> word) inputs.push_back(word);
+  }
+  return inputs;
+}
+
+int64_t fileTime(const fs::path& file, std::error_code& ec) {
+  return fs::last_write_time(file, ec).time_since_epoch().count();
+}
+
+}  // namespace
+
+SimulationModelCache::SimulationModelCache(const fs::path& modelDir)
+    : m_manifest(modelDir / ManifestName) {
+  std::ifstream in{m_manifest};
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream words{line};
+    std::string kind;
+    words >> kind;
+    if (kind == "key") {
+      words >> m_storedKey;
+    } else if (kind == "dep") {
+      std::string path;
+      std::getline(words >> std::ws, path);
+      if (!path.empty()) m_dependencies.push_back(path);
+    } else if (kind == "file") {
+      FileEntry entry{};
+      std::string hash;
+      words >> hash >> entry.size >> entry.time;
+      std::string path;
+      std::getline(words >> std::ws, path);
+      if (!path.empty()) {
+        entry.hash = std::strtoull(hash.c_str(), nullptr, 16);
+        m_stored[path] = entry;
+      }
+    }
+  }
+}
+
+uint64_t SimulationModelCache::fileHash(const fs::path& file) {
+  std::error_code ec;
+  FileEntry entry{};
+  entry.size = fs::file_size(file, ec);
+  if (ec) return 0;
+  entry.time = fileTime(file, ec);
+  const std::string name = file.string();
+  auto stored = m_stored.find(name);
+  if (stored != m_stored.end() && stored->second.size == entry.size &&
+      stored->second.time == entry.time) {
+    entry.hash = stored->second.hash;
+  } else {
+    Hash hash{};
+    std::ifstream in{file, std::ios_base::binary};
+    std::vector<char> buffer(64 * 1024);
+    while (in) {
+      in.read(buffer.data(), buffer.size());
+      hash.add(buffer.data(), static_cast<size_t>(in.gcount()));
+    }
+    entry.hash = hash.value();
+  }
+  m_files[name] = entry;
+  return entry.hash;
+}
+
+std::string SimulationModelCache::key(const std::vector<std::string>& sources,
+                                      const fs::path& workingDir,
+                                      const std::string& settings,
+                                      const std::vector<fs::path>& tools) {
+  m_files.clear();
+  m_workingDir = workingDir;
+  Hash hash{};
+  hash.add(settings);
+  for (const auto& tool : tools) {
+    std::error_code ec;
+    hash.add(tool.string());
+    hash.add(fs::file_size(tool, ec));
+    hash.add(static_cast<uint64_t>(fileTime(tool, ec)));
+  }
+  // Directories searched for included files: include and library
+  // directories and the directories of the sources, all recursively since
+  // includes may name a subpath
+  std::set<fs::path> searchDirs;
+  // Nested file lists are followed up to a fixed depth, which also stops
+  // lists that include each other
+  std::function<void(const std::vector<std::string>&, const fs::path&, int)>
+      addSources;
+  addSources = [&](const std::vector<std::string>& args, const fs::path& dir,
+                   int depth) {
+    for (size_t i = 0; i < args.size(); i++) {
+      const std::string& arg = args[i];
+      if ((arg == "-f" || arg == "-F") && i + 1 < args.size()) {
+        fs::path list{args[++i]};
+        if (list.is_relative()) list = dir / list;
+        hash.add(arg);
+        hash.add(args[i]);
+        hash.add(fileHash(list));
+        // -F entries are relative to the list, -f entries to the caller
+        if (depth < 8)
+          addSources(readFileList(list),
+                     arg == "-F" ? list.parent_path() : dir, depth + 1);
+        continue;
+      }
+      std::string name = arg;
+      for (const std::string prefix : {"+incdir+", "-I", "-P"}) {
+        if (name.rfind(prefix, 0) == 0) name = name.substr(prefix.size());
+      }
+      if (name.empty()) continue;
+      fs::path path{name};
+      if (path.is_relative()) path = dir / path;
+      std::error_code ec;
+      if (fs::is_regular_file(path, ec)) {
+        hash.add(arg);
+        hash.add(fileHash(path));
+        if (isSourceFile(path))
+          searchDirs.insert(path.parent_path().lexically_normal());
+      } else if (fs::is_directory(path, ec)) {
+        hash.add(arg);
+        searchDirs.insert(path.lexically_normal());
+      }
+    }
+  };
+  addSources(sources, workingDir, 0);
+
+  const fs::path modelDir = m_manifest.parent_path().lexically_normal();
+  const fs::path* covered{nullptr};
+  for (const auto& dir : searchDirs) {
+    // the set is sorted, subdirectories follow their parent
+    if (covered) {
+      auto rel = dir.lexically_relative(*covered);
+      if (!rel.empty() && *rel.begin() != "..") continue;
+    }
+    // sources next to the model, the model's own outputs are not searched
+    const bool recursive = dir != modelDir;
+    if (recursive) covered = &dir;
+    std::vector<fs::path> files;
+    std::error_code ec;
+    fs::recursive_directory_iterator it{
+        dir, fs::directory_options::skip_permission_denied, ec};
+    for (; !ec && it != fs::recursive_directory_iterator{}; it.increment(ec)) {
+      const fs::path& entry = it->path();
+      if (it->is_directory(ec)) {
+        // hidden directories and compiled models (this one included)
+        // change with every build
+        if (!recursive || entry.filename().string().rfind(".", 0) == 0 ||
+            entry.lexically_normal() == modelDir ||
+            fs::exists(entry / ManifestName, ec))
+          it.disable_recursion_pending();
+      } else if (it->is_regular_file(ec) && isSourceFile(entry)) {
+        files.push_back(entry);
+      }
+    }
+    std::sort(files.begin(), files.end());
+    hash.add(dir.string());
+    for (const auto& file : files) {
+      hash.add(file.lexically_relative(dir).string());
+      hash.add(fileHash(file));
+    }
+  }
+  return toHex(hash.value());
+}
+
+bool SimulationModelCache::hit(const std::string& key) {
+  if (m_storedKey.empty() || m_storedKey != key) return false;
+  for (const auto& dependency : m_dependencies) {
+    auto stored = m_stored.find(dependency);
+    if (stored == m_stored.end() ||
+        fileHash(dependency) != stored->second.hash)
+      return false;
+  }
+  return true;
+}
+
+bool SimulationModelCache::store(const std::string& key,
+                                 const fs::path& dependencyFile) {
+  m_dependencies.clear();
+  if (!dependencyFile.empty()) {
+    for (const auto& input : readDependencyFile(dependencyFile)) {
+      fs::path path{input};
+      if (path.is_relative()) path = m_workingDir / path;
+      const std::string name = path.lexically_normal().string();
+      fileHash(name);
+      m_dependencies.push_back(name);
+    }
+  }
+  std::ofstream out{m_manifest};
+  if (!out.is_open()) return false;
+  out << "key " << key << "\n";
+  for (const auto& dependency : m_dependencies)
+    out << "dep " << dependency << "\n";
+  for (const auto& [path, entry] : m_files) {
+    out << "file " << toHex(entry.hash) << " " << entry.size << " "
+        << entry.time << " " << path << "\n";
+  }
+  out.close();
+  m_storedKey = key;
+  m_stored = m_files;
+  return static_cast<bool>(out);
+}
+
+void SimulationModelCache::invalidate() {
+  std::error_code ec;
+  fs::remove(m_manifest, ec);
+  m_storedKey.clear();
+  m_dependencies.clear();
+}
+
+}  // namespace FOEDAG
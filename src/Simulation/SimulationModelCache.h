@@ -0,0 +1,93 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace FOEDAG {
+
+/*!
+ * \brief The SimulationModelCache class decides whether a compiled simulation
+ * model is still valid. The key hashes the content of all sources named on
+ * the compile command line and in its file lists, the source files below the
+ * include and library directories and below the directories of the sources,
+ * the simulator settings and the simulator executables. The inputs listed in
+ * the dependency file of the build, when the simulator writes one, are
+ * checked as well. The key and the file hashes are kept in a manifest next
+ * to the model, a file whose size and modification time did not change is
+ * not read again.
+ */
+class SimulationModelCache {
+ public:
+  explicit SimulationModelCache(const std::filesystem::path& modelDir);
+
+  /*!
+   * \brief key computes the key of a model.
+   * \param sources compile arguments, arguments naming a file or a directory
+   * (also as -I<dir>, +incdir+<dir> or -P<dir>) add the file contents to the
+   * key. The files named in -f/-F file lists are added as well. Include,
+   * library and source directories add their source files recursively.
+   * Relative paths are relative to \a workingDir.
+   * \param settings any text the model depends on, e.g. the full commands.
+   * \param tools simulator executables, identified by size and time.
+   */
+  std::string key(const std::vector<std::string>& sources,
+                  const std::filesystem::path& workingDir,
+                  const std::string& settings,
+                  const std::vector<std::filesystem::path>& tools);
+
+  /*!
+   * \brief hit checks \a key and the inputs recorded by the last store.
+   */
+  bool hit(const std::string& key);
+  /*!
+   * \brief store writes the manifest of a successful build.
+   * \param dependencyFile make dependency file written by the build (e.g.
+   * obj_dir/V<top>__ver.d of Verilator), its inputs are checked by hit().
+   * Relative inputs are relative to the working directory given to key().
+   */
+  bool store(const std::string& key,
+             const std::filesystem::path& dependencyFile = {});
+  void invalidate();
+
+  static constexpr const char* ManifestName{"model_cache.txt"};
+
+ private:
+  struct FileEntry {
+    uintmax_t size{0};
+    int64_t time{0};
+    uint64_t hash{0};
+  };
+  uint64_t fileHash(const std::filesystem::path& file);
+
+  std::filesystem::path m_manifest;
+  std::filesystem::path m_workingDir;
+  std::string m_storedKey;
+  std::map<std::string, FileEntry> m_stored;
+  std::map<std::string, FileEntry> m_files;
+  std::vector<std::string> m_dependencies;
+};
+
+}  // namespace FOEDAG
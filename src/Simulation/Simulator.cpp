@@ -27,22 +27,41 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QCoreApplication>
 #include <QDebug>
 #include <QProcess>
+#include <algorithm>
+#include <atomic>
 #include <charconv>
 #include <chrono>
 #include <ctime>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <thread>
 
 #include "Compiler/Compiler.h"
 #include "Compiler/Log.h"
+#include "Compiler/WorkerThread.h"
 #include "NewProject/ProjectManager/project_manager.h"
 #include "ProjNavigator/tcl_command_integration.h"
+#include "SimulationModelCache.h"
+#include "Utils/EventBus.h"
 #include "Utils/FileUtils.h"
+#include "Utils/JobPool.h"
+#include "Utils/LogUtils.h"
+#include "Utils/ProcessExecutor.h"
 #include "Utils/StringUtils.h"
 
 using namespace FOEDAG;
 
+// Option strings are typed as command lines, paths are single arguments
+static void AppendOptions(std::vector<std::string>& argv,
+                          const std::string& options) {
+  for (const auto& option : ProcessExecutor::SplitCommand(options))
+    argv.push_back(option);
+}
+
 Simulator::SimulationType Simulator::ToSimulationType(const std::string& str,
                                                       bool& ok) {
   ok = true;
@@ -253,6 +272,96 @@ bool Simulator::RegisterCommands(TclInterpreter* interp) {
   };
   interp->registerCmd("simulation_options", simulation_options, this, 0);
 
+  auto simulate_regression = [](void* clientData, Tcl_Interp* interp,
+                                int argc, const char* argv[]) -> int {
+    Simulator* simulator = (Simulator*)clientData;
+    Compiler* compiler = simulator->m_compiler;
+    const std::string usage{
+        "Usage: simulate_regression <level> ?<simulator>? ?-jobs <n>? "
+        "?-timeout <seconds>? ?-waveform? ?-file <test list>? "
+        "?-test <name> <top> ?<plusarg>...??..."};
+    const std::set<std::string> options{"-jobs", "-timeout", "-waveform",
+                                        "-file", "-test"};
+    std::string level;
+    bool sim_tool_valid{false};
+    auto sim_tool{Simulator::SimulatorType::Icarus};
+    Simulator::RegressionOptions regression{};
+    std::vector<Simulator::RegressionTest> tests;
+    for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      bool ok{false};
+      auto sim = Simulator::ToSimulatorType(arg, ok);
+      if (ok) {
+        sim_tool = sim;
+        sim_tool_valid = true;
+      } else if (arg == "rtl" || arg == "gate" || arg == "pnr" ||
+                 arg == "timed_pnr" || arg == "bitstream_fd" ||
+                 arg == "bitstream_bd") {
+        level = arg;
+      } else if (arg == "-jobs" && i + 1 < argc) {
+        auto [jobs, ok] = StringUtils::to_number<unsigned int>(argv[++i]);
+        if (!ok) {
+          compiler->ErrorMessage(
+              "Incorrect syntax for -jobs <number>, 0 runs one job per core");
+          return TCL_ERROR;
+        }
+        regression.jobs = jobs;
+      } else if (arg == "-timeout" && i + 1 < argc) {
+        auto [timeout, ok] = StringUtils::to_number<int>(argv[++i]);
+        if (!ok || timeout < 0) {
+          compiler->ErrorMessage("Incorrect syntax for -timeout <seconds>");
+          return TCL_ERROR;
+        }
+        regression.timeoutSec = timeout;
+      } else if (arg == "-waveform") {
+        regression.waveforms = true;
+      } else if (arg == "-file" && i + 1 < argc) {
+        std::ifstream file{argv[++i]};
+        std::string error;
+        if (!file.is_open()) {
+          error = "Cannot open " + std::string{argv[i]};
+        } else if (!Simulator::ReadRegressionTests(file, tests, error)) {
+          error = std::string{argv[i]} + ": " + error;
+        }
+        if (!error.empty()) {
+          compiler->ErrorMessage(error);
+          return TCL_ERROR;
+        }
+      } else if (arg == "-test" && i + 2 < argc) {
+        Simulator::RegressionTest test{argv[i + 1], argv[i + 2]};
+        // plusargs run up to the next option
+        for (i += 3; i < argc && options.count(argv[i]) == 0; i++)
+          test.plusargs.push_back(argv[i]);
+        i--;
+        tests.push_back(test);
+      } else {
+        compiler->ErrorMessage("Invalid argument: " + arg + ". " + usage);
+        return TCL_ERROR;
+      }
+    }
+    bool ok{false};
+    auto simulation = Simulator::ToSimulationType(
+        level == "timed_pnr" ? std::string{"pnr"} : level, ok);
+    if (!ok) {
+      compiler->ErrorMessage("Unknown simulation type: " + level + ". " +
+                             usage);
+      return TCL_ERROR;
+    }
+    if (!sim_tool_valid) {
+      auto simTool = simulator->UserSimulationType(simulation, ok);
+      if (ok) sim_tool = simTool;
+    }
+    simulator->SetTimedSimulation(level == "timed_pnr");
+    auto fn = [simulator, simulation, sim_tool, tests, regression]() {
+      return simulator->SimulateRegression(simulation, sim_tool, tests,
+                                           regression);
+    };
+    WorkerThread* thread =
+        new WorkerThread{{}, Compiler::Action::NoAction, compiler};
+    return thread->Start(fn) ? TCL_OK : TCL_ERROR;
+  };
+  interp->registerCmd("simulate_regression", simulate_regression, this, 0);
+
   return ok;
 }
 
@@ -265,6 +374,8 @@ bool Simulator::Clean(SimulationType action) {
 }
 
 void Simulator::Message(const std::string& message) {
+  // the per top passes of a regression only collect the models
+  if (m_regressionModels) return;
   m_compiler->Message(message);
 }
 void Simulator::ErrorMessage(const std::string& message) {
@@ -370,6 +481,10 @@ bool Simulator::Simulate(SimulationType action, SimulatorType type,
   } else if (m_waveFile.find(".ghw") != std::string::npos) {
     m_waveType = WaveformType::GHW;
   }
+  return SimulateLevel(action, type);
+}
+
+bool Simulator::SimulateLevel(SimulationType action, SimulatorType type) {
   switch (action) {
     case SimulationType::RTL: {
       return SimulateRTL(type);
@@ -395,10 +510,481 @@ bool Simulator::Simulate(SimulationType action, SimulatorType type,
   return false;
 }
 
+bool Simulator::SimulateRegression(SimulationType simulation,
+                                   SimulatorType type,
+                                   const std::vector<RegressionTest>& tests,
+                                   const RegressionOptions& options) {
+  if (!ProjManager()->HasDesign()) {
+    ErrorMessage("No design specified");
+    return false;
+  }
+  if (ProjManager()->SimulationFiles().empty()) {
+    ErrorMessage("Simulation file(s) missing.");
+    return false;
+  }
+  if (tests.empty()) {
+    ErrorMessage("No regression tests specified");
+    return false;
+  }
+  if (type == SimulatorType::Questa || type == SimulatorType::Xcelium) {
+    ErrorMessage("Regression is not supported for " + ToString(type));
+    return false;
+  }
+  std::set<std::string> names;
+  std::vector<std::string> tops;
+  for (const auto& test : tests) {
+    if (!IsValidRegressionTestName(test.name)) {
+      ErrorMessage("Invalid regression test name: " + test.name +
+                   ", the name is used as a directory name");
+      return false;
+    }
+    if (!names.insert(test.name).second) {
+      ErrorMessage("Duplicate regression test name: " + test.name);
+      return false;
+    }
+    if (std::find(tops.begin(), tops.end(), test.top) == tops.end())
+      tops.push_back(test.top);
+  }
+  m_compiler->ResetStopFlag();
+  m_simType = simulation;
+  // waveform files are named per test
+  m_waveFile.clear();
+  UserSimulationType(simulation, type);
+
+  PERF_LOG("Regression has started");
+  Message("##################################################");
+  Message("Regression of " + std::to_string(tests.size()) +
+          " test(s) for design: " + ProjManager()->projectName());
+  Message("##################################################");
+
+  // Let the regular flow assemble the compilation of each top, the models
+  // are built below
+  std::vector<RegressionModel> models;
+  const auto action = Compiler::ToCompilerAction(simulation);
+  bool ok = m_compiler->SwitchCompileContext(action, [&]() {
+    m_regressionModels = &models;
+    bool result{true};
+    for (const auto& top : tops) {
+      m_simulationTop = top;
+      result = SimulateLevel(simulation, type);
+      if (!result) break;
+    }
+    m_regressionModels = nullptr;
+    m_simulationTop.clear();
+    return result;
+  });
+  if (!ok) return false;
+
+  const auto results = RunRegression(simulation, type, models, tests, options);
+  const std::string summary = RegressionSummary(results);
+  const std::filesystem::path report =
+      m_compiler->FilePath(action) / "regression" / "regression.rpt";
+  std::ofstream ofs;
+  if (LogUtils::OpenLog(ofs, report)) ofs << summary;
+  ofs.close();
+  Message(summary);
+
+  const bool passed =
+      std::all_of(results.begin(), results.end(), [](const auto& result) {
+        return result.status == RegressionResult::Pass;
+      });
+  if (!passed) {
+    ErrorMessage("Regression for design " + ProjManager()->projectName() +
+                 " failed, see " + report.string() + "\n");
+    return false;
+  }
+  Message("Regression for design: " + ProjManager()->projectName() +
+          " had ended");
+  return true;
+}
+
+std::vector<Simulator::RegressionResult> Simulator::RunRegression(
+    SimulationType simulation, SimulatorType type,
+    const std::vector<RegressionModel>& models,
+    const std::vector<RegressionTest>& tests,
+    const RegressionOptions& options) {
+  using Clock = std::chrono::steady_clock;
+  struct Job {
+    std::vector<std::vector<std::string>> steps;
+    std::filesystem::path workingDir;
+    std::filesystem::path log;
+    int timeoutMs{-1};
+    ProcessResult result{};
+    std::chrono::milliseconds duration{0};
+    std::optional<SimulationModelCache> cache{};
+    std::string key{};
+    std::filesystem::path dependencies{};
+  };
+  // Same shared pool as the IP generation
+  auto runJobs = [this, &options](std::vector<Job>& jobs,
+                                  const std::string& stage) {
+    std::atomic<size_t> done{0};
+    EventBus::progress("simulator", stage, 0, jobs.size());
+    auto run = [this, &jobs, &done, &stage](size_t i,
+                                            const CancellationToken& token) {
+      auto& job = jobs[i];
+      if (job.steps.empty()) return;
+      if (m_compiler->m_stop || token.isCancelled()) {
+        job.result.status = ProcessResult::Cancelled;
+        return;
+      }
+      FileUtils::MkDirs(job.workingDir);
+      FileUtils::MkDirs(job.log.parent_path());
+      std::ofstream ofs;
+      LogUtils::OpenLog(ofs, job.log);
+      const auto start = Clock::now();
+      for (const auto& argv : job.steps) {
+        ProcessRequest request{};
+        request.argv = argv;
+        request.workingDir = job.workingDir;
+        request.environment = m_compiler->m_environmentVariableMap;
+        request.cancel = token;
+        request.out.push_back(&ofs);
+        request.err.push_back(&ofs);
+        request.timeoutMs = job.timeoutMs;
+        ofs << "Command: " << ProcessExecutor::JoinCommand(argv) << std::endl;
+        job.result = m_compiler->m_executor.run(request);
+        if (job.result.code() != 0) {
+          if (!job.result.error.empty()) ofs << job.result.error << "\n";
+          break;
+        }
+      }
+      job.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+          Clock::now() - start);
+      EventBus::progress("simulator", stage, ++done, jobs.size());
+    };
+    JobPool::global().parallelFor("simulate_" + stage, jobs.size(),
+                                  options.jobs, run,
+                                  m_compiler->CancelToken());
+  };
+
+  const std::string log{LogFile(simulation)};
+  const std::string execPath =
+      (SimulatorExecPath(type) / SimulatorName(type)).string();
+  const std::filesystem::path simDir =
+      m_compiler->FilePath(Compiler::ToCompilerAction(simulation));
+  const std::filesystem::path rtlDir =
+      m_compiler->FilePath(Compiler::Action::SimulateRTL);
+  const std::filesystem::path regressionDir =
+      std::filesystem::absolute(simDir / "regression");
+  auto modelDir = [&regressionDir](const std::string& top) {
+    return regressionDir / "models" / top;
+  };
+
+  // Compile each model once
+  std::vector<Job> builds;
+  for (const auto& model : models) {
+    const auto dir = modelDir(model.top);
+    Job job{};
+    job.workingDir = simDir;
+    job.log = dir / log;
+    auto compile = SimulatorCompileArgs(simulation, type, model.fileList);
+    const auto sources = compile;
+    switch (type) {
+      case SimulatorType::Verilator: {
+        compile.insert(compile.end(), {"--Mdir", dir.string()});
+        job.steps.push_back(compile);
+        job.dependencies = dir / ("V" + model.top + "__ver.d");
+        std::vector<std::string> make{"make", "-j", "-C", dir.string(), "-f"};
+        make.push_back("V" + model.top + ".mk");
+        make.push_back("V" + model.top);
+        AppendOptions(make, GetSimulatorElaborationOption(simulation, type));
+        job.steps.push_back(make);
+        break;
+      }
+      case SimulatorType::Icarus:
+        compile.insert(compile.end(), {"-o", (dir / "a.out").string()});
+        job.steps.push_back(compile);
+        break;
+      case SimulatorType::GHDL: {
+        // analysis does not depend on the top and runs once before the pool,
+        // the elaborated model stays in the model directory
+        std::vector<std::string> elab{execPath, "-e", "-fsynopsys",
+                                      "-fexplicit"};
+        AppendOptions(elab, GetSimulatorElaborationOption(simulation, type));
+        elab.push_back("--workdir=" + rtlDir.string());
+        elab.push_back(model.top);
+        job.workingDir = dir;
+        job.steps.push_back(elab);
+        break;
+      }
+      case SimulatorType::VCS:
+        compile.insert(compile.end(), {"-o", (dir / "simv").string()});
+        job.steps.push_back(compile);
+        break;
+      default:
+        break;
+    }
+    if (type != SimulatorType::GHDL) {
+      std::string settings;
+      for (const auto& step : job.steps)
+        settings += ProcessExecutor::JoinCommand(step) + "\n";
+      job.cache.emplace(dir);
+      job.key = job.cache->key(sources, simDir, settings, SimulatorTools(type));
+      const std::filesystem::path binary =
+          type == SimulatorType::Verilator ? dir / ("V" + model.top)
+          : type == SimulatorType::VCS     ? dir / "simv"
+                                           : dir / "a.out";
+      if (job.cache->hit(job.key) && FileUtils::FileExists(binary)) {
+        Message("Reusing compiled simulation model of " + model.top);
+        job.steps.clear();
+        job.result.status = ProcessResult::Finished;
+        job.result.exitCode = 0;
+      } else {
+        job.cache->invalidate();
+      }
+    }
+    builds.push_back(job);
+  }
+  bool analyzed{true};
+  if (type == SimulatorType::GHDL && !models.empty()) {
+    std::vector<Job> analysis{Job{}};
+    analysis.front().steps.push_back(
+        SimulatorCompileArgs(simulation, type, models.front().fileList));
+    analysis.front().workingDir = simDir;
+    analysis.front().log = regressionDir / "models" / log;
+    runJobs(analysis, "analysis");
+    analyzed = analysis.front().result.code() == 0;
+  }
+  if (analyzed) runJobs(builds, "build");
+  for (auto& job : builds) {
+    if (job.cache && !job.steps.empty() && job.result.code() == 0)
+      job.cache->store(job.key, job.dependencies);
+  }
+
+  std::map<std::string, const Job*> built;
+  for (size_t i = 0; i < models.size(); i++)
+    built[models.at(i).top] = &builds.at(i);
+
+  // Run the tests on the shared models
+  const std::string waveExt = m_waveType == WaveformType::VCD   ? ".vcd"
+                              : m_waveType == WaveformType::FST ? ".fst"
+                                                                : ".ghw";
+  std::vector<RegressionResult> results;
+  std::vector<Job> runs;
+  std::vector<size_t> runResult;
+  for (const auto& test : tests) {
+    RegressionResult result{};
+    result.name = test.name;
+    result.top = test.top;
+    const auto model = built.find(test.top);
+    if (!analyzed || model == built.end() ||
+        model->second->result.code() != 0) {
+      result.status = RegressionResult::BuildFailed;
+      if (model != built.end()) result.log = model->second->log;
+      results.push_back(result);
+      continue;
+    }
+    const auto dir = modelDir(test.top);
+    const auto testDir = regressionDir / "tests" / test.name;
+    std::string wave;
+    if (options.waveforms) wave = (testDir / (test.name + waveExt)).string();
+    Job job{};
+    job.workingDir = testDir;
+    job.log = testDir / log;
+    if (options.timeoutSec >= 0) job.timeoutMs = options.timeoutSec * 1000;
+    std::vector<std::string> argv;
+    switch (type) {
+      case SimulatorType::Verilator:
+        argv.push_back((dir / ("V" + test.top)).string());
+        AppendOptions(argv, GetSimulatorSimulationOption(simulation, type));
+        if (!wave.empty()) argv.push_back(wave);
+        break;
+      case SimulatorType::Icarus:
+        argv.push_back((SimulatorExecPath(type) / "vvp").string());
+        argv.push_back((dir / "a.out").string());
+        if (m_waveType == WaveformType::FST) argv.push_back("-fst");
+        if (!wave.empty()) argv.push_back("-dumpfile=" + wave);
+        break;
+      case SimulatorType::GHDL: {
+        argv = {execPath, "-r", "-fsynopsys", "-fexplicit",
+                "--workdir=" + rtlDir.string()};
+        AppendOptions(argv, GetSimulatorExtraOption(simulation, type));
+        argv.push_back(test.top);
+        if (!wave.empty()) {
+          switch (m_waveType) {
+            case WaveformType::VCD:
+              argv.push_back("--vcd=" + wave);
+              break;
+            case WaveformType::FST:
+              argv.push_back("--fst=" + wave);
+              break;
+            case WaveformType::GHW:
+              argv.push_back("--wave=" + wave);
+              break;
+          }
+        }
+        AppendOptions(argv, GetSimulatorSimulationOption(simulation, type));
+        // the elaborated executable is looked up in the working directory,
+        // each test gets its copy so tests do not share their output files
+        FileUtils::MkDirs(testDir);
+        for (const auto& name : {test.top, StringUtils::toLower(test.top)}) {
+          std::error_code ec;
+          if (FileUtils::FileExists(dir / name))
+            std::filesystem::copy_file(
+                dir / name, testDir / name,
+                std::filesystem::copy_options::overwrite_existing, ec);
+        }
+        break;
+      }
+      case SimulatorType::VCS:
+        argv.push_back((dir / "simv").string());
+        break;
+      default:
+        break;
+    }
+    argv.insert(argv.end(), test.plusargs.begin(), test.plusargs.end());
+    job.steps.push_back(argv);
+    result.log = job.log;
+    runs.push_back(job);
+    runResult.push_back(results.size());
+    results.push_back(result);
+  }
+  runJobs(runs, "run");
+
+  for (size_t i = 0; i < runs.size(); i++) {
+    const auto& job = runs.at(i);
+    auto& result = results.at(runResult.at(i));
+    result.duration = job.duration;
+    result.exitCode = job.result.code();
+    switch (job.result.status) {
+      case ProcessResult::Finished:
+        result.status = job.result.exitCode == 0 ? RegressionResult::Pass
+                                                 : RegressionResult::Fail;
+        break;
+      case ProcessResult::Timeout:
+        result.status = RegressionResult::Timeout;
+        break;
+      case ProcessResult::Cancelled:
+        result.status = RegressionResult::Cancelled;
+        break;
+      default:
+        result.status = RegressionResult::Fail;
+        break;
+    }
+  }
+  return results;
+}
+
+bool Simulator::IsValidRegressionTestName(const std::string& name) {
+  if (name.empty() || name == "." || name == "..") return false;
+  if (name.find_first_of("/\\:") != std::string::npos) return false;
+  return !std::filesystem::path{name}.is_absolute();
+}
+
+bool Simulator::ReadRegressionTests(std::istream& in,
+                                    std::vector<RegressionTest>& tests,
+                                    std::string& error) {
+  std::string line;
+  int lineNumber{0};
+  while (std::getline(in, line)) {
+    lineNumber++;
+    std::istringstream words{line};
+    RegressionTest test{};
+    if (!(words >> test.name) || test.name.front() == '#') continue;
+    if (!(words >> test.top)) {
+      error = "Line " + std::to_string(lineNumber) +
+              ": expected <name> <top> ?<plusarg>...?";
+      return false;
+    }
+    for (std::string arg; words >> arg;) test.plusargs.push_back(arg);
+    tests.push_back(test);
+  }
+  return true;
+}
+
+std::string Simulator::RegressionSummary(
+    const std::vector<RegressionResult>& results) {
+  auto toString = [](const RegressionResult& result) -> std::string {
+    switch (result.status) {
+      case RegressionResult::Pass:
+        return "PASS";
+      case RegressionResult::Fail:
+        return "FAIL (" + std::to_string(result.exitCode) + ")";
+      case RegressionResult::Timeout:
+        return "TIMEOUT";
+      case RegressionResult::BuildFailed:
+        return "BUILD FAILED";
+      case RegressionResult::Cancelled:
+        return "CANCELLED";
+    }
+    return "Invalid";
+  };
+  size_t nameWidth{4};
+  size_t topWidth{3};
+  for (const auto& result : results) {
+    nameWidth = std::max(nameWidth, result.name.size());
+    topWidth = std::max(topWidth, result.top.size());
+  }
+  std::ostringstream out;
+  out << std::left << std::setw(nameWidth + 2) << "Test"
+      << std::setw(topWidth + 2) << "Top" << std::setw(14) << "Status"
+      << std::setw(12) << "Time (ms)"
+      << "Log\n";
+  size_t passed{0};
+  std::chrono::milliseconds total{0};
+  for (const auto& result : results) {
+    if (result.status == RegressionResult::Pass) passed++;
+    total += result.duration;
+    out << std::setw(nameWidth + 2) << result.name << std::setw(topWidth + 2)
+        << result.top << std::setw(14) << toString(result) << std::setw(12)
+        << result.duration.count() << result.log.string() << "\n";
+  }
+  out << "Tests: " << results.size() << ", passed: " << passed
+      << ", failed: " << results.size() - passed
+      << ", run time: " << total.count() << " ms\n";
+  return out.str();
+}
+
 class ProjectManager* Simulator::ProjManager() const {
   return m_compiler->ProjManager();
 }
 
+std::string Simulator::SimulationTop() const {
+  if (!m_simulationTop.empty()) return m_simulationTop;
+  return ProjManager()->SimulationTopModule();
+}
+
+std::vector<std::filesystem::path> Simulator::SimulatorTools(
+    SimulatorType type) {
+  std::filesystem::path exec = SimulatorExecPath(type) / SimulatorName(type);
+  if (!exec.has_parent_path()) exec = FileUtils::LocateExecFile(exec);
+  std::vector<std::filesystem::path> tools{exec};
+  switch (type) {
+    case SimulatorType::Verilator:
+      tools.push_back(exec.parent_path() / "verilator_bin");
+      break;
+    case SimulatorType::Icarus:
+      tools.push_back(exec.parent_path() / "vvp");
+      break;
+    default:
+      break;
+  }
+  return tools;
+}
+
+bool Simulator::ModelExists(SimulatorType type,
+                            const std::filesystem::path& dir,
+                            const std::string& top) const {
+  switch (type) {
+    case SimulatorType::Verilator:
+      return FileUtils::FileExists(dir / "obj_dir" / ("V" + top));
+    case SimulatorType::Icarus:
+      return FileUtils::FileExists(dir / "a.out");
+    case SimulatorType::GHDL: {
+      // analyzed library
+      std::error_code ec;
+      for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+        if (entry.path().extension() == ".cf") return true;
+      return false;
+    }
+    case SimulatorType::VCS:
+      return FileUtils::FileExists(dir / "simv");
+    default:
+      return false;
+  }
+}
+
 std::string Simulator::FileList(SimulationType action) {
   std::string list;
 
@@ -578,6 +1164,17 @@ std::string Simulator::SimulatorCompilationOptions(SimulationType simulation,
   return "Invalid";
 }
 
+std::vector<std::string> Simulator::SimulatorCompileArgs(
+    SimulationType simulation, SimulatorType type,
+    const std::string& fileList) {
+  std::vector<std::string> argv{
+      (SimulatorExecPath(type) / SimulatorName(type)).string()};
+  AppendOptions(argv, SimulatorCompilationOptions(simulation, type));
+  AppendOptions(argv, GetSimulatorCompileOption(simulation, type));
+  AppendOptions(argv, fileList);
+  return argv;
+}
+
 std::string Simulator::MacroDirective(SimulatorType type) {
   switch (type) {
     case SimulatorType::Verilator:
@@ -784,62 +1381,64 @@ std::string Simulator::LanguageDirective(SimulatorType type,
 
 std::string Simulator::SimulatorRunCommand(SimulationType simulation,
                                            SimulatorType type) {
+  return ProcessExecutor::JoinCommand(SimulatorRunArgs(simulation, type));
+}
+
+std::vector<std::string> Simulator::SimulatorRunArgs(SimulationType simulation,
+                                                     SimulatorType type) {
   std::string execPath =
       (SimulatorExecPath(type) / SimulatorName(type)).string();
-  auto simulationTop{ProjManager()->SimulationTopModule()};
+  auto simulationTop{SimulationTop()};
   switch (type) {
     case SimulatorType::Verilator: {
-      std::string command = "obj_dir/V" + simulationTop;
-      if (!GetSimulatorSimulationOption(simulation, type).empty())
-        command += " " + GetSimulatorSimulationOption(simulation, type);
-      if (!m_waveFile.empty()) command += " " + m_waveFile;
-      return command;
+      std::vector<std::string> argv{"obj_dir/V" + simulationTop};
+      AppendOptions(argv, GetSimulatorSimulationOption(simulation, type));
+      if (!m_waveFile.empty()) argv.push_back(m_waveFile);
+      return argv;
     }
     case SimulatorType::Icarus: {
-      std::string command =
-          (SimulatorExecPath(type) / "vvp").string() + " ./a.out";
+      std::vector<std::string> argv{(SimulatorExecPath(type) / "vvp").string(),
+                                    "./a.out"};
       if (m_waveType == WaveformType::FST) {
-        command += " -fst";
+        argv.push_back("-fst");
       }
-      if (!m_waveFile.empty()) command += " -dumpfile=" + m_waveFile;
-      return command;
+      if (!m_waveFile.empty()) argv.push_back("-dumpfile=" + m_waveFile);
+      return argv;
     }
     case SimulatorType::GHDL: {
-      std::string command = execPath + " -r -fsynopsys -fexplicit";
-      command += " --workdir=" +
-                 m_compiler->FilePath(Compiler::Action::SimulateRTL).string();
-      if (!GetSimulatorExtraOption(simulation, type).empty())
-        command += " " + GetSimulatorExtraOption(simulation, type);
+      std::vector<std::string> argv{execPath, "-r", "-fsynopsys",
+                                    "-fexplicit"};
+      argv.push_back(
+          "--workdir=" +
+          m_compiler->FilePath(Compiler::Action::SimulateRTL).string());
+      AppendOptions(argv, GetSimulatorExtraOption(simulation, type));
       if (!simulationTop.empty()) {
-        command += TopModuleCmd(type) + simulationTop;
+        AppendOptions(argv, TopModuleCmd(type) + simulationTop);
       }
       if (!m_waveFile.empty()) {
-        command += " ";
         switch (m_waveType) {
           case WaveformType::VCD:
-            command += "--vcd=";
+            argv.push_back("--vcd=" + m_waveFile);
             break;
           case WaveformType::FST:
-            command += "--fst=";
+            argv.push_back("--fst=" + m_waveFile);
             break;
           case WaveformType::GHW:
-            command += "--wave=";
+            argv.push_back("--wave=" + m_waveFile);
             break;
         };
-        command += m_waveFile;
       }
-      if (!GetSimulatorSimulationOption(simulation, type).empty())
-        command += " " + GetSimulatorSimulationOption(simulation, type);
-      return command;
+      AppendOptions(argv, GetSimulatorSimulationOption(simulation, type));
+      return argv;
     }
     case SimulatorType::Questa:
-      return "Todo";
+      return {"Todo"};
     case SimulatorType::VCS:
-      return "simv";
+      return {"simv"};
     case SimulatorType::Xcelium:
-      return "Todo";
+      return {"Todo"};
   }
-  return "Invalid";
+  return {"Invalid"};
 }
 
 std::string Simulator::SimulationFileList(SimulationType action,
@@ -848,7 +1447,7 @@ std::string Simulator::SimulationFileList(SimulationType action,
   std::string fileList;
   m_compiler->CustomSimulatorSetup(action);
   if (type != SimulatorType::GHDL) {
-    auto simulationTop{ProjManager()->SimulationTopModule()};
+    auto simulationTop{SimulationTop()};
     if (!simulationTop.empty()) {
       fileList += TopModuleCmd(type) + simulationTop + " ";
     }
@@ -968,81 +1567,121 @@ int Simulator::SimulationJob(SimulationType simulation, SimulatorType type,
     m_compiler->SetEnvironmentVariable("VERILATOR_ROOT", verilator_home);
   }
   */
+  if (m_regressionModels) {
+    if (m_compiler->m_errorState) {
+      ErrorMessage(m_compiler->m_errorState.message);
+      m_compiler->ResetError();
+      return -1;
+    }
+    m_regressionModels->push_back({SimulationTop(), fileList});
+    return 0;
+  }
   ProcessUtilization summaryUtils{};
   auto appendSumUtils = [&summaryUtils](const ProcessUtilization& utils) {
     summaryUtils.duration += utils.duration;
     summaryUtils.utilization =
         std::max(summaryUtils.utilization, utils.utilization);
+    summaryUtils.stats.append(utils.stats);
   };
 
   std::string log{LogFile(simulation)};
   // Simulator Model compilation step
   std::string execPath =
       (SimulatorExecPath(type) / SimulatorName(type)).string();
-  std::string command =
-      execPath + " " + SimulatorCompilationOptions(simulation, type);
-  if (!GetSimulatorCompileOption(simulation, type).empty())
-    command += " " + GetSimulatorCompileOption(simulation, type);
-  command += " " + fileList;
+  const auto argv = SimulatorCompileArgs(simulation, type, fileList);
+  const std::string command = ProcessExecutor::JoinCommand(argv);
   std::string workingDir =
       m_compiler->FilePath(Compiler::ToCompilerAction(simulation)).string();
-  FileUtils::WriteToFile(CommandLogFile("comp"), command);
-  int status = m_compiler->ExecuteAndMonitorSystemCommand(command, log, false,
-                                                          workingDir);
-  appendSumUtils(m_compiler->m_utils);
-  if (status) {
-    ErrorMessage("Design " + ProjManager()->projectName() +
-                 " simulation compilation failed!\n");
-    return status;
-  }
-
-  // Extra Simulator Model compilation step (Elaboration or C++ compilation)
-  auto simulationTop{ProjManager()->SimulationTopModule()};
-  switch (type) {
-    case SimulatorType::Verilator: {
-      std::string command =
-          "make -j -C obj_dir/ -f V" + simulationTop + ".mk V" + simulationTop;
-      if (!GetSimulatorElaborationOption(simulation, type).empty())
-        command += " " + GetSimulatorElaborationOption(simulation, type);
-      FileUtils::WriteToFile(CommandLogFile("make"), command);
-      status = m_compiler->ExecuteAndMonitorSystemCommand(command, log, true,
-                                                          workingDir);
-      appendSumUtils(m_compiler->m_utils);
-      if (status) {
-        ErrorMessage("Design " + ProjManager()->projectName() +
-                     " simulation compilation failed!\n");
-        return status;
-      }
-      break;
+  auto simulationTop{SimulationTop()};
+
+  // Skip compilation and elaboration when the model is built from the same
+  // sources, options and simulator
+  SimulationModelCache cache{workingDir};
+  const std::string key =
+      cache.key(argv, workingDir,
+                command + "\n" +
+                    GetSimulatorElaborationOption(simulation, type) + "\n" +
+                    simulationTop,
+                SimulatorTools(type));
+  const bool reuse = !m_compiler->m_errorState && cache.hit(key) &&
+                     ModelExists(type, workingDir, simulationTop);
+  auto buildModel = [&]() -> int {
+    FileUtils::WriteToFile(CommandLogFile("comp"), command);
+    int status = m_compiler->ExecuteAndMonitorSystemCommand(argv, log, false,
+                                                            workingDir);
+    appendSumUtils(m_compiler->m_utils);
+    if (status) {
+      ErrorMessage("Design " + ProjManager()->projectName() +
+                   " simulation compilation failed!\n");
+      return status;
     }
-    case SimulatorType::GHDL: {
-      std::string command = execPath + " -e -fsynopsys -fexplicit";
-      if (!GetSimulatorElaborationOption(simulation, type).empty())
-        command += " " + GetSimulatorElaborationOption(simulation, type);
-      command += " --workdir=" +
-                 m_compiler->FilePath(Compiler::Action::SimulateRTL).string();
-      if (!simulationTop.empty()) {
-        command += TopModuleCmd(type) + simulationTop;
+
+    // Extra Simulator Model compilation step (Elaboration or C++ compilation)
+    switch (type) {
+      case SimulatorType::Verilator: {
+        std::vector<std::string> make{"make", "-j", "-C", "obj_dir/", "-f"};
+        make.push_back("V" + simulationTop + ".mk");
+        make.push_back("V" + simulationTop);
+        AppendOptions(make, GetSimulatorElaborationOption(simulation, type));
+        FileUtils::WriteToFile(CommandLogFile("make"),
+                               ProcessExecutor::JoinCommand(make));
+        status = m_compiler->ExecuteAndMonitorSystemCommand(make, log, true,
+                                                            workingDir);
+        appendSumUtils(m_compiler->m_utils);
+        if (status) {
+          ErrorMessage("Design " + ProjManager()->projectName() +
+                       " simulation compilation failed!\n");
+          return status;
+        }
+        break;
       }
-      FileUtils::WriteToFile(CommandLogFile("make"), command);
-      status = m_compiler->ExecuteAndMonitorSystemCommand(command, log, true,
-                                                          workingDir);
-      appendSumUtils(m_compiler->m_utils);
-      if (status) {
-        ErrorMessage("Design " + ProjManager()->projectName() +
-                     " simulation compilation failed!\n");
-        return status;
+      case SimulatorType::GHDL: {
+        std::vector<std::string> elab{execPath, "-e", "-fsynopsys",
+                                      "-fexplicit"};
+        AppendOptions(elab, GetSimulatorElaborationOption(simulation, type));
+        elab.push_back(
+            "--workdir=" +
+            m_compiler->FilePath(Compiler::Action::SimulateRTL).string());
+        if (!simulationTop.empty()) {
+          AppendOptions(elab, TopModuleCmd(type) + simulationTop);
+        }
+        FileUtils::WriteToFile(CommandLogFile("make"),
+                               ProcessExecutor::JoinCommand(elab));
+        status = m_compiler->ExecuteAndMonitorSystemCommand(elab, log, true,
+                                                            workingDir);
+        appendSumUtils(m_compiler->m_utils);
+        if (status) {
+          ErrorMessage("Design " + ProjManager()->projectName() +
+                       " simulation compilation failed!\n");
+          return status;
+        }
+        break;
       }
-      break;
+      default:
+        break;
     }
-    default:
-      break;
+    return 0;
+  };
+  int status{0};
+  if (reuse) {
+    Message("Reusing compiled simulation model, sources and options are "
+            "unchanged");
+  } else {
+    cache.invalidate();
+    status = buildModel();
+    if (status) return status;
+    // Verilator lists every file it read, includes found by search too
+    cache.store(key, type == SimulatorType::Verilator
+                         ? std::filesystem::path{workingDir} / "obj_dir" /
+                               ("V" + simulationTop + "__ver.d")
+                         : std::filesystem::path{});
   }
 
   // Actual simulation
-  command = SimulatorRunCommand(simulation, type);
-  FileUtils::WriteToFile(CommandLogFile(std::string{}), command);
-  status = m_compiler->ExecuteAndMonitorSystemCommand(command, log, true,
+  const auto runArgv = SimulatorRunArgs(simulation, type);
+  FileUtils::WriteToFile(CommandLogFile(std::string{}),
+                         ProcessExecutor::JoinCommand(runArgv));
+  status = m_compiler->ExecuteAndMonitorSystemCommand(runArgv, log, !reuse,
                                                       workingDir);
   appendSumUtils(m_compiler->m_utils);
   m_compiler->m_utils = summaryUtils;
@@ -1232,16 +1871,28 @@ bool Simulator::SimulatePNR(SimulatorType type) {
       netlistBlastedFile =
           m_compiler->FilePath(Compiler::Action::Routing, netlistBlastedFile)
               .string();
-      std::string command =
-          std::string(bitblast_exe.string()) +
-          " -nostdout -DSYNTHESIS=1 -top fabric_" +
-          m_compiler->DesignTopModule() + " " + netlistFile + " -v " +
-          primitives_file.string() + " " + dsp_map.string() + " " +
-          ram_map.string() + " -y " + library_path.string() +
-          " -bitblast -sdf_in " + sdfBlastedFilePath.string() + " -sdf_out " +
-          sdfBlastedFilePath.string() + " -write " + netlistBlastedFile;
+      const std::vector<std::string> argv{
+          bitblast_exe.string(),
+          "-nostdout",
+          "-DSYNTHESIS=1",
+          "-top",
+          "fabric_" + m_compiler->DesignTopModule(),
+          netlistFile,
+          "-v",
+          primitives_file.string(),
+          dsp_map.string(),
+          ram_map.string(),
+          "-y",
+          library_path.string(),
+          "-bitblast",
+          "-sdf_in",
+          sdfBlastedFilePath.string(),
+          "-sdf_out",
+          sdfBlastedFilePath.string(),
+          "-write",
+          netlistBlastedFile};
       int status = m_compiler->ExecuteAndMonitorSystemCommand(
-          command, "bitblast.log", false, workingDir);
+          argv, "bitblast.log", false, workingDir);
       if (status) {
         ErrorMessage("Design " + ProjManager()->projectName() +
                      " Post-PnR simulation failed!\n");
@@ -1364,8 +2015,8 @@ bool Simulator::SimulateBitstream(SimulationType sim_type, SimulatorType type) {
               " ";
 
   if (type == SimulatorType::Icarus) {
-    if (!ProjManager()->SimulationTopModule().empty())
-      fileList += TopModuleCmd(type) + ProjManager()->SimulationTopModule();
+    if (!SimulationTop().empty())
+      fileList += TopModuleCmd(type) + SimulationTop();
   } else {
     fileList += TopModuleCmd(type) + "fabric_" + designTopModule +
                 "_top_formal_verification_random_tb";
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef SIMULATOR_H
 #define SIMULATOR_H
 
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <map>
@@ -48,6 +49,26 @@ class Simulator {
   enum class WaveformType { VCD, FST, GHW };
   enum class SimulationOpt { None, Clean };
 
+  struct RegressionTest {
+    std::string name;  // also names the work directory of the test
+    std::string top;
+    std::vector<std::string> plusargs{};
+  };
+  struct RegressionOptions {
+    unsigned int jobs{0};  // 0 runs one job per core
+    int timeoutSec{-1};    // per test, -1 waits forever
+    bool waveforms{false};
+  };
+  struct RegressionResult {
+    enum Status { Pass, Fail, Timeout, BuildFailed, Cancelled };
+    std::string name;
+    std::string top;
+    Status status{BuildFailed};
+    int exitCode{-1};
+    std::chrono::milliseconds duration{0};
+    std::filesystem::path log{};
+  };
+
   static SimulationType ToSimulationType(const std::string& str, bool& ok);
   static SimulatorType ToSimulatorType(
       const std::string& str, bool& ok,
@@ -67,6 +88,32 @@ class Simulator {
   virtual ~Simulator() {}
   bool Simulate(SimulationType action, SimulatorType type,
                 const std::string& wave_file);
+  /*!
+   * \brief SimulateRegression runs \a tests concurrently, at most
+   * \a options.jobs at a time. The model is compiled once per testbench top
+   * and shared by all tests of that top, each test runs in its own work
+   * directory. Results are summarized in regression.rpt.
+   * \return true if all tests passed.
+   */
+  bool SimulateRegression(SimulationType simulation, SimulatorType type,
+                          const std::vector<RegressionTest>& tests,
+                          const RegressionOptions& options);
+  /*!
+   * \brief ReadRegressionTests reads one test per line:
+   * <name> <top> ?<plusarg>...?, empty lines and lines starting with # are
+   * skipped.
+   */
+  static bool ReadRegressionTests(std::istream& in,
+                                  std::vector<RegressionTest>& tests,
+                                  std::string& error);
+  /*!
+   * \brief IsValidRegressionTestName: the name is the test work directory
+   * under regression/tests, it cannot be empty, '.', '..' or contain path
+   * separators.
+   */
+  static bool IsValidRegressionTestName(const std::string& name);
+  static std::string RegressionSummary(
+      const std::vector<RegressionResult>& results);
   TclInterpreter* TclInterp() { return m_interp; }
   bool RegisterCommands(TclInterpreter* interp);
   bool Clean(SimulationType action);
@@ -119,6 +166,20 @@ class Simulator {
   void SetTimedSimulation(bool timed) { m_timed_simulation = timed; }
 
  protected:
+  struct RegressionModel {
+    std::string top;
+    std::string fileList;
+  };
+  bool SimulateLevel(SimulationType action, SimulatorType type);
+  std::vector<RegressionResult> RunRegression(
+      SimulationType simulation, SimulatorType type,
+      const std::vector<RegressionModel>& models,
+      const std::vector<RegressionTest>& tests,
+      const RegressionOptions& options);
+  std::string SimulationTop() const;
+  std::vector<std::filesystem::path> SimulatorTools(SimulatorType type);
+  bool ModelExists(SimulatorType type, const std::filesystem::path& dir,
+                   const std::string& top) const;
   virtual bool SimulateRTL(SimulatorType type);
   virtual bool SimulateGate(SimulatorType type);
   virtual bool SimulatePNR(SimulatorType type);
@@ -143,8 +204,13 @@ class Simulator {
                             const std::string& file_list);
   virtual std::string SimulatorRunCommand(SimulationType simulation,
                                           SimulatorType type);
+  virtual std::vector<std::string> SimulatorRunArgs(SimulationType simulation,
+                                                    SimulatorType type);
   virtual std::string SimulatorCompilationOptions(SimulationType simulation,
                                                   SimulatorType type);
+  std::vector<std::string> SimulatorCompileArgs(SimulationType simulation,
+                                                SimulatorType type,
+                                                const std::string& fileList);
   class ProjectManager* ProjManager() const;
   std::string FileList(SimulationType action);
   static std::string LogFile(SimulationType type);
@@ -174,6 +240,9 @@ class Simulator {
   std::map<SimulationType, SimulatorType> m_simulatorTypes;
   SimulationType m_simType = SimulationType::RTL;
   bool m_timed_simulation = false;
+  // set while a regression collects the models instead of simulating
+  std::vector<RegressionModel>* m_regressionModels{nullptr};
+  std::string m_simulationTop;
 };
 
 }  // namespace FOEDAG
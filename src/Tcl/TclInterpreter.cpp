@@ -23,6 +23,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QString>
 #include <QSysInfo>
 
+#include "Command/Logger.h"
+#include "Utils/Tracer.h"
+#include "scope_guard.hpp"
+
 using namespace FOEDAG;
 
 #include <tcl.h>
@@ -63,10 +67,40 @@ std::string TclInterpreter::evalCmd(const std::string cmd, int *ret) {
   return std::string(Tcl_GetStringResult(interp));
 }
 
+// Registered commands are dispatched through this wrapper so that every
+// call shows up as a span when flow tracing is on
+struct TracedCommand {
+  Tcl_CmdProc *proc;
+  ClientData clientData;
+  Tcl_CmdDeleteProc *deleteProc;
+};
+
+static int TracedCommandProc(ClientData clientData, Tcl_Interp *interp,
+                             int argc, const char *argv[]) {
+  auto command = static_cast<TracedCommand *>(clientData);
+  TraceScope scope{"tcl", argv[0]};
+  static thread_local int depth{0};
+  depth++;
+  // commands may throw, the depth must still drop back
+  auto guard = sg::make_scope_guard([]() {
+    // scripts may read the logs right after a command
+    if (--depth == 0) Logger::flushAll();
+  });
+  return command->proc(command->clientData, interp, argc, argv);
+}
+
+static void TracedCommandDelete(ClientData clientData) {
+  auto command = static_cast<TracedCommand *>(clientData);
+  if (command->deleteProc) command->deleteProc(command->clientData);
+  delete command;
+}
+
 void TclInterpreter::registerCmd(const std::string &cmdName, Tcl_CmdProc proc,
                                  ClientData clientData,
                                  Tcl_CmdDeleteProc *deleteProc) {
-  Tcl_CreateCommand(interp, cmdName.c_str(), proc, clientData, deleteProc);
+  auto command = new TracedCommand{proc, clientData, deleteProc};
+  Tcl_CreateCommand(interp, cmdName.c_str(), TracedCommandProc, command,
+                    TracedCommandDelete);
 }
 
 std::string TclInterpreter::evalGuiTestFile(const std::string &filename) {
@@ -0,0 +1,466 @@
+#include "large_file_viewer.h"
+
+#include <QAbstractScrollArea>
+#include <QCheckBox>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QHash>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPainter>
+#include <QScrollBar>
+#include <QShortcut>
+#include <QSignalBlocker>
+#include <QSpinBox>
+#include <QToolButton>
+#include <QVBoxLayout>
+#include <algorithm>
+#include <climits>
+
+using namespace FOEDAG;
+
+namespace FOEDAG {
+
+/*!
+ * \brief The LargeFileView class paints the lines of the file that
+ * fit into the viewport. Scroll bars count lines and characters.
+ */
+class LargeFileView : public QAbstractScrollArea {
+ public:
+  enum Marker { Error, Warning };
+  static constexpr size_t npos{LargeTextFile::npos};
+
+  LargeFileView(const LargeTextFile &file, QWidget *parent)
+      : QAbstractScrollArea(parent), m_file(file) {
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    setFocusPolicy(Qt::StrongFocus);
+    m_errorIcon = QPixmap{":/images/error.png"};
+    m_warningIcon = QPixmap{":/img/warn.png"};
+  }
+
+  void updateScrollBars() {
+    const int rows = visibleRows();
+    const size_t lines = m_file.lineCount();
+    verticalScrollBar()->setPageStep(rows);
+    verticalScrollBar()->setRange(0, std::max(0, clamp(lines) - rows));
+    const int columns = visibleColumns();
+    const int maxLength = clamp(m_file.maxLineLength());
+    horizontalScrollBar()->setPageStep(columns);
+    horizontalScrollBar()->setRange(0, std::max(0, maxLength - columns + 1));
+  }
+
+  void ensureVisible(size_t line) {
+    const size_t first = verticalScrollBar()->value();
+    const size_t rows = visibleRows();
+    if (line < first || line >= first + rows) {
+      const size_t top = line > rows / 2 ? line - rows / 2 : 0;
+      verticalScrollBar()->setValue(clamp(top));
+    }
+  }
+
+  void ensureColumnVisible(size_t column) {
+    const size_t first = horizontalScrollBar()->value();
+    const size_t columns = visibleColumns();
+    if (column < first || column >= first + columns)
+      horizontalScrollBar()->setValue(
+          clamp(column > columns / 2 ? column - columns / 2 : 0));
+  }
+
+  size_t firstVisibleLine() const { return verticalScrollBar()->value(); }
+
+  void setMarker(size_t line, Marker marker) {
+    m_markers.insert(line, marker);
+    viewport()->update();
+  }
+  void setSelection(size_t from, size_t to) {
+    m_selectionFrom = std::min(from, to);
+    m_selectionTo = std::max(from, to);
+    viewport()->update();
+  }
+  void clearMarkers() {
+    m_markers.clear();
+    m_selectionFrom = m_selectionTo = npos;
+    viewport()->update();
+  }
+
+  void setMatch(size_t offset, size_t length) {
+    m_matchOffset = offset;
+    m_matchLength = length;
+    viewport()->update();
+  }
+  size_t matchOffset() const { return m_matchOffset; }
+  size_t matchLength() const { return m_matchLength; }
+
+ protected:
+  void resizeEvent(QResizeEvent *event) override {
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+  }
+
+  void paintEvent(QPaintEvent *) override {
+    QPainter painter{viewport()};
+    const QRect area = viewport()->rect();
+    const int lineHeight = fontMetrics().height();
+    const int charWidth = this->charWidth();
+    const int gutter = gutterWidth();
+    const int textLeft = gutter + margin;
+    painter.fillRect(area, palette().base());
+    painter.fillRect(QRect{0, 0, gutter, area.height()},
+                     palette().alternateBase());
+
+    const size_t lines = m_file.lineCount();
+    const size_t first = verticalScrollBar()->value();
+    const size_t column = horizontalScrollBar()->value();
+    const size_t columns = visibleColumns() + 1;
+    QColor selection = palette().color(QPalette::Highlight);
+    selection.setAlpha(60);
+    QColor match = palette().color(QPalette::Highlight);
+    match.setAlpha(140);
+    for (int y = 0; y < area.height(); y += lineHeight) {
+      const size_t line = first + y / lineHeight;
+      if (line >= lines) break;
+      const QRect lineRect{gutter, y, area.width() - gutter, lineHeight};
+      if (line >= m_selectionFrom && line <= m_selectionTo)
+        painter.fillRect(lineRect, selection);
+
+      auto text = m_file.line(line);
+      if (m_matchOffset != npos) {
+        const size_t start = m_file.lineOffset(line);
+        if (m_matchOffset >= start && m_matchOffset < start + text.size()) {
+          const size_t matchColumn = m_matchOffset - start;
+          if (matchColumn + m_matchLength > column &&
+              matchColumn < column + columns) {
+            const int x = static_cast<int>(matchColumn) -
+                          static_cast<int>(column);
+            painter.fillRect(QRect{textLeft + x * charWidth, y,
+                                   clamp(m_matchLength) * charWidth,
+                                   lineHeight},
+                             match);
+          }
+        }
+      }
+      if (text.size() > column) {
+        text = text.substr(column, columns);
+        // tabs are drawn as one space to keep a character per column
+        QString str = QString::fromUtf8(text.data(), text.size());
+        str.replace(QLatin1Char('\t'), QLatin1Char(' '));
+        painter.setPen(palette().color(QPalette::Text));
+        painter.setClipRect(lineRect);
+        painter.drawText(textLeft, y + fontMetrics().ascent(), str);
+        painter.setClipping(false);
+      }
+
+      painter.setPen(palette().color(QPalette::PlaceholderText));
+      painter.drawText(QRect{0, y, gutter - margin, lineHeight},
+                       Qt::AlignRight | Qt::AlignVCenter,
+                       QString::number(line + 1));
+      auto marker = m_markers.constFind(line);
+      if (marker != m_markers.cend()) {
+        const QPixmap &icon =
+            marker.value() == Error ? m_errorIcon : m_warningIcon;
+        if (!icon.isNull())
+          painter.drawPixmap(QRect{margin, y, lineHeight, lineHeight}, icon);
+      }
+    }
+  }
+
+ private:
+  static constexpr int margin{4};
+
+  static int clamp(size_t value) {
+    return static_cast<int>(std::min<size_t>(value, INT_MAX));
+  }
+  int charWidth() const {
+    return std::max(1, fontMetrics().horizontalAdvance(QLatin1Char('0')));
+  }
+  int visibleRows() const {
+    return std::max(1, viewport()->height() / fontMetrics().height());
+  }
+  int visibleColumns() const {
+    return std::max(1, (viewport()->width() - gutterWidth() - margin) /
+                           charWidth());
+  }
+  int gutterWidth() const {
+    const int digits = static_cast<int>(
+        QString::number(std::max<size_t>(m_file.lineCount(), 1)).size());
+    // marker icon, line number and margins
+    return fontMetrics().height() + digits * charWidth() + 3 * margin;
+  }
+
+  const LargeTextFile &m_file;
+  QHash<size_t, Marker> m_markers;
+  size_t m_selectionFrom{npos};
+  size_t m_selectionTo{npos};
+  size_t m_matchOffset{npos};
+  size_t m_matchLength{0};
+  QPixmap m_errorIcon;
+  QPixmap m_warningIcon;
+};
+
+}  // namespace FOEDAG
+
+LargeFileViewer::LargeFileViewer(const QString &fileName, QWidget *parent)
+    : QWidget(parent), m_fileName(fileName) {
+  m_view = new LargeFileView{m_file, this};
+
+  m_search = new QLineEdit;
+  m_search->setPlaceholderText(tr("Find"));
+  m_search->setClearButtonEnabled(true);
+  auto previous = new QToolButton;
+  previous->setArrowType(Qt::UpArrow);
+  previous->setToolTip(tr("Find previous"));
+  auto next = new QToolButton;
+  next->setArrowType(Qt::DownArrow);
+  next->setToolTip(tr("Find next"));
+  m_matchCase = new QCheckBox{tr("Match case")};
+  m_lineNumber = new QSpinBox;
+  m_lineNumber->setPrefix(tr("Line: "));
+  m_lineNumber->setRange(1, 1);
+  m_lineNumber->setKeyboardTracking(false);
+  m_status = new QLabel;
+  m_status->setToolTip(tr("Large files are opened read only"));
+
+  auto toolBar = new QHBoxLayout;
+  toolBar->setContentsMargins(4, 4, 4, 4);
+  toolBar->addWidget(m_search, 1);
+  toolBar->addWidget(previous);
+  toolBar->addWidget(next);
+  toolBar->addWidget(m_matchCase);
+  toolBar->addWidget(m_lineNumber);
+  toolBar->addWidget(m_status);
+  auto box = new QVBoxLayout;
+  box->setContentsMargins(0, 0, 0, 0);
+  box->setSpacing(0);
+  box->addLayout(toolBar);
+  box->addWidget(m_view);
+  setLayout(box);
+
+  connect(m_search, &QLineEdit::textChanged, this,
+          &LargeFileViewer::searchTextChanged);
+  connect(m_search, &QLineEdit::returnPressed, this,
+          &LargeFileViewer::findNext);
+  connect(m_matchCase, &QCheckBox::toggled, this,
+          &LargeFileViewer::searchTextChanged);
+  connect(next, &QToolButton::clicked, this, &LargeFileViewer::findNext);
+  connect(previous, &QToolButton::clicked, this,
+          &LargeFileViewer::findPrevious);
+  connect(m_lineNumber, &QSpinBox::valueChanged, this,
+          &LargeFileViewer::goToLine);
+  new QShortcut{QKeySequence::Find, this,
+                [this]() {
+                  m_search->setFocus();
+                  m_search->selectAll();
+                },
+                Qt::WidgetWithChildrenShortcut};
+  new QShortcut{QKeySequence::FindNext, this, [this]() { findNext(); },
+                Qt::WidgetWithChildrenShortcut};
+  new QShortcut{QKeySequence::FindPrevious, this, [this]() { findPrevious(); },
+                Qt::WidgetWithChildrenShortcut};
+
+  m_indexTimer.setInterval(100);
+  connect(&m_indexTimer, &QTimer::timeout, this,
+          &LargeFileViewer::checkIndexing);
+  m_searchTimer.setSingleShot(true);
+  m_searchTimer.setInterval(300);
+  connect(&m_searchTimer, &QTimer::timeout, this,
+          &LargeFileViewer::startIncrementalSearch);
+  load();
+}
+
+LargeFileViewer::~LargeFileViewer() {
+  stopSearch();
+  stopIndexing();
+}
+
+QString LargeFileViewer::getFileName() const { return m_fileName; }
+
+bool LargeFileViewer::fileLoaded() const { return m_file.isOpen(); }
+
+void LargeFileViewer::markLineError(int line) {
+  if (line < 1) return;
+  m_view->setMarker(line - 1, LargeFileView::Error);
+  showLine(line - 1);
+}
+
+void LargeFileViewer::markLineWarning(int line) {
+  if (line < 1) return;
+  m_view->setMarker(line - 1, LargeFileView::Warning);
+  showLine(line - 1);
+}
+
+void LargeFileViewer::clearMarkers() { m_view->clearMarkers(); }
+
+void LargeFileViewer::selectLines(int lineFrom, int lineTo) {
+  if (lineFrom < 1 || lineTo < 1) return;
+  m_view->setSelection(lineFrom - 1, lineTo - 1);
+  showLine(lineFrom - 1);
+}
+
+void LargeFileViewer::goToLine(int line) { showLine(line - 1); }
+
+void LargeFileViewer::reload() {
+  m_view->setMatch(LargeTextFile::npos, 0);
+  load();
+}
+
+void LargeFileViewer::checkIndexing() {
+  // read first: lines indexed after this are picked up by the next check
+  const bool indexed = m_file.indexed();
+  const size_t lines = m_file.lineCount();
+  m_lineNumber->setMaximum(
+      static_cast<int>(std::clamp<size_t>(lines, 1, INT_MAX)));
+  m_view->updateScrollBars();
+  if (m_matchPending) showMatch();
+  if (m_pendingLine != -1 &&
+      (indexed || static_cast<size_t>(m_pendingLine) < lines))
+    showLine(m_pendingLine);
+  if (indexed) m_indexTimer.stop();
+  m_view->viewport()->update();
+  updateStatus();
+}
+
+void LargeFileViewer::searchTextChanged() { m_searchTimer.start(); }
+
+void LargeFileViewer::startIncrementalSearch() {
+  // incremental search keeps the current match while it still matches
+  const size_t match = m_view->matchOffset();
+  find(match != LargeTextFile::npos ? match : firstVisibleOffset(), true);
+}
+
+void LargeFileViewer::findNext() {
+  const size_t match = m_view->matchOffset();
+  find(match != LargeTextFile::npos ? match + 1 : firstVisibleOffset(), true);
+}
+
+void LargeFileViewer::findPrevious() {
+  const size_t match = m_view->matchOffset();
+  find(match != LargeTextFile::npos ? match + m_view->matchLength() - 1
+                                    : firstVisibleOffset(),
+       false);
+}
+
+void LargeFileViewer::load() {
+  stopSearch();
+  stopIndexing();
+  m_error.clear();
+  m_pendingLine = -1;
+  m_matchPending = false;
+  std::string error;
+  if (m_file.open(m_fileName.toStdString(), error)) {
+    m_stopIndexing.store(false);
+    m_indexer = std::thread{[this]() { m_file.indexLines(m_stopIndexing); }};
+    m_indexTimer.start();
+  } else {
+    m_error = QString::fromStdString(error);
+  }
+  m_view->updateScrollBars();
+  m_view->viewport()->update();
+  updateStatus();
+}
+
+void LargeFileViewer::stopIndexing() {
+  m_indexTimer.stop();
+  m_stopIndexing.store(true);
+  if (m_indexer.joinable()) m_indexer.join();
+}
+
+void LargeFileViewer::stopSearch() {
+  m_searchTimer.stop();
+  m_stopSearch.store(true);
+  if (m_searcher.joinable()) m_searcher.join();
+  m_searching = false;
+}
+
+void LargeFileViewer::find(size_t from, bool forward) {
+  stopSearch();
+  const uint64_t search = ++m_searchId;
+  std::string pattern = m_search->text().toStdString();
+  m_notFound = false;
+  m_matchPending = false;
+  if (pattern.empty()) {
+    m_view->setMatch(LargeTextFile::npos, 0);
+    updateStatus();
+    return;
+  }
+  const bool caseSensitive = m_matchCase->isChecked();
+  m_stopSearch.store(false);
+  m_searching = true;
+  updateStatus();
+  m_searcher = std::thread{[this, search, pattern, from, forward,
+                            caseSensitive]() {
+    const size_t size = m_file.size();
+    size_t offset = m_file.find(pattern, from, forward, caseSensitive,
+                                &m_stopSearch);
+    // wrap around, only the part not searched yet
+    if (offset == LargeTextFile::npos && !m_stopSearch.load()) {
+      const size_t overlap = pattern.size() - 1;
+      offset = forward ? m_file.find(pattern, 0, true, caseSensitive,
+                                     &m_stopSearch, from + overlap)
+                       : m_file.find(pattern, size, false, caseSensitive,
+                                     &m_stopSearch,
+                                     from > overlap ? from - overlap : 0);
+    }
+    if (m_stopSearch.load()) return;
+    // the thread is joined before the viewer is destroyed
+    QMetaObject::invokeMethod(
+        this,
+        [this, search, offset, length = pattern.size()]() {
+          searchFinished(search, offset, length);
+        },
+        Qt::QueuedConnection);
+  }};
+}
+
+void LargeFileViewer::searchFinished(uint64_t search, size_t offset,
+                                     size_t length) {
+  if (search != m_searchId) return;
+  m_searching = false;
+  m_notFound = offset == LargeTextFile::npos;
+  m_view->setMatch(offset, length);
+  if (!m_notFound) showMatch();
+  updateStatus();
+}
+
+void LargeFileViewer::showMatch() {
+  const size_t offset = m_view->matchOffset();
+  const size_t line = m_file.lineAt(offset);
+  // the match may be past the last indexed line, wait until it is indexed
+  m_matchPending = !m_file.indexed() && line + 1 >= m_file.lineCount();
+  if (m_matchPending) return;
+  showLine(static_cast<int>(std::min<size_t>(line, INT_MAX)));
+  m_view->ensureColumnVisible(offset - m_file.lineOffset(line));
+}
+
+void LargeFileViewer::showLine(int line) {
+  if (line < 0) return;
+  const size_t lines = m_file.lineCount();
+  if (static_cast<size_t>(line) >= lines) {
+    if (!m_file.indexed()) {
+      m_pendingLine = line;
+      return;
+    }
+    line = static_cast<int>(std::max<size_t>(lines, 1) - 1);
+  }
+  m_pendingLine = -1;
+  m_view->ensureVisible(line);
+  QSignalBlocker blocker{m_lineNumber};
+  m_lineNumber->setValue(line + 1);
+}
+
+size_t LargeFileViewer::firstVisibleOffset() const {
+  const size_t offset = m_file.lineOffset(m_view->firstVisibleLine());
+  return offset != LargeTextFile::npos ? offset : 0;
+}
+
+void LargeFileViewer::updateStatus() {
+  QString status;
+  if (!m_error.isEmpty()) {
+    status = m_error;
+  } else {
+    status = tr("%1 lines").arg(m_file.lineCount());
+    if (!m_file.indexed()) status = tr("Indexing... %1").arg(status);
+    if (m_searching) status += tr(", searching...");
+    if (m_notFound) status += tr(", not found");
+  }
+  m_status->setText(status);
+}
@@ -0,0 +1,91 @@
+#ifndef LARGE_FILE_VIEWER_H
+#define LARGE_FILE_VIEWER_H
+
+#include <QTimer>
+#include <QWidget>
+#include <atomic>
+#include <thread>
+
+#include "Utils/LargeTextFile.h"
+
+class QCheckBox;
+class QLabel;
+class QLineEdit;
+class QSpinBox;
+
+namespace FOEDAG {
+
+class LargeFileView;
+
+/*!
+ * \brief The LargeFileViewer class is a read-only view for logs and reports
+ * too large for the editor. The file is read on demand, its lines are
+ * indexed in a worker thread and only the visible lines are rendered, so the
+ * viewer opens right away whatever the file size is. Search runs in a worker
+ * thread as well.
+ */
+class LargeFileViewer : public QWidget {
+  Q_OBJECT
+
+ public:
+  // files of this size and above are opened in the viewer
+  static constexpr qint64 SizeThreshold{32 * 1024 * 1024};
+
+  explicit LargeFileViewer(const QString &fileName, QWidget *parent = nullptr);
+  ~LargeFileViewer() override;
+
+  QString getFileName() const;
+  bool fileLoaded() const;
+
+  // line numbers are 1-based like in Editor
+  void markLineError(int line);
+  void markLineWarning(int line);
+  void clearMarkers();
+  void selectLines(int lineFrom, int lineTo);
+  void goToLine(int line);
+  void reload();
+
+ private slots:
+  void checkIndexing();
+  void searchTextChanged();
+  void startIncrementalSearch();
+  void findNext();
+  void findPrevious();
+
+ private:
+  void load();
+  void stopIndexing();
+  void stopSearch();
+  // searches in a worker thread, the result comes to searchFinished()
+  void find(size_t from, bool forward);
+  void searchFinished(uint64_t search, size_t offset, size_t length);
+  void showMatch();
+  void showLine(int line);
+  size_t firstVisibleOffset() const;
+  void updateStatus();
+
+  QString m_fileName;
+  LargeTextFile m_file;
+  std::thread m_indexer;
+  std::atomic<bool> m_stopIndexing{false};
+  QTimer m_indexTimer;
+  std::thread m_searcher;
+  std::atomic<bool> m_stopSearch{false};
+  uint64_t m_searchId{0};  // results of older searches are dropped
+  bool m_searching{false};
+  QTimer m_searchTimer;  // incremental search waits for typing to pause
+  QString m_error;
+  int m_pendingLine{-1};  // 0-based line to show once it is indexed
+  bool m_matchPending{false};  // match is past the indexed lines
+  bool m_notFound{false};
+
+  LargeFileView *m_view{nullptr};
+  QLineEdit *m_search{nullptr};
+  QCheckBox *m_matchCase{nullptr};
+  QSpinBox *m_lineNumber{nullptr};
+  QLabel *m_status{nullptr};
+};
+
+}  // namespace FOEDAG
+
+#endif  // LARGE_FILE_VIEWER_H
@@ -63,10 +63,16 @@ int TextEditorForm::OpenFile(const QString &strFileName) {
     m_tab_editor->setCurrentIndex(index);
     return ret;
   }
+  if (auto viewer = m_largeFiles.value(strFileName)) {
+    m_tab_editor->setCurrentWidget(viewer);
+    return viewer->fileLoaded() ? 0 : -1;
+  }
 
   int filetype{FILE_TYPE_UNKOWN};
   QFileInfo fileInfo(strFileName);
   if (!fileInfo.exists()) return -1;
+  if (fileInfo.size() >= LargeFileViewer::SizeThreshold)
+    return OpenLargeFile(strFileName, fileInfo);
   QString filename = fileInfo.fileName();
   QString suffix = fileInfo.suffix();
   static const std::map<FileType, QStringList> types{
@@ -112,10 +118,31 @@ int TextEditorForm::OpenFile(const QString &strFileName) {
   return editor->fileLoaded() ? 0 : -1;
 }
 
+int TextEditorForm::OpenLargeFile(const QString &strFileName,
+                                  const QFileInfo &fileInfo) {
+  auto viewer = new LargeFileViewer{strFileName, this};
+  int index = m_tab_editor->addTab(viewer, fileInfo.fileName());
+  m_tab_editor->setCurrentIndex(index);
+  m_tab_editor->setTabToolTip(index, fileInfo.absoluteFilePath());
+  m_largeFiles.insert(strFileName, viewer);
+  m_fileWatcher.addPath(strFileName);
+  return viewer->fileLoaded() ? 0 : -1;
+}
+
 int TextEditorForm::OpenFileWithLine(const QString &strFileName, int line,
                                      bool error) {
   int res = OpenFile(strFileName);
   if (res == 0) {
+    if (auto viewer = m_largeFiles.value(strFileName)) {
+      if (line != -1) {
+        viewer->clearMarkers();
+        if (error)
+          viewer->markLineError(line);
+        else
+          viewer->markLineWarning(line);
+      }
+      return 0;
+    }
     if (line != -1) {
       auto pair = m_map_file_tabIndex_editor.value(strFileName);
       pair.second->clearMarkers();
@@ -133,6 +160,11 @@ int TextEditorForm::OpenFileWithSelection(const QString &strFileName,
                                           int lineFrom, int lineTo) {
   int res = OpenFile(strFileName);
   if (res == 0) {
+    if (auto viewer = m_largeFiles.value(strFileName)) {
+      viewer->clearMarkers();
+      viewer->selectLines(lineFrom, lineTo);
+      return 0;
+    }
     auto pair = m_map_file_tabIndex_editor.value(strFileName);
     pair.second->clearMarkers();
     pair.second->selectLines(lineFrom, lineTo);
@@ -146,7 +178,12 @@ void TextEditorForm::SlotTabCloseRequested(int index) {
 }
 
 void TextEditorForm::SlotCurrentChanged(int index) {
-  Editor *tabEditor = qobject_cast<Editor *>(m_tab_editor->widget(index));
+  QWidget *widget = m_tab_editor->widget(index);
+  if (auto viewer = qobject_cast<LargeFileViewer *>(widget)) {
+    emit CurrentFileChanged(viewer->getFileName());
+    return;
+  }
+  Editor *tabEditor = qobject_cast<Editor *>(widget);
   emit CurrentFileChanged(tabEditor ? tabEditor->getFileName() : QString{});
 }
 
@@ -171,7 +208,7 @@ void TextEditorForm::SlotShowSearchDialog(const QString &strWord) {
 
 void TextEditorForm::SlotFind(const QString &strFindWord) {
 #ifndef USE_MONACO_EDITOR
-  Editor *tabEditor = (Editor *)m_tab_editor->currentWidget();
+  Editor *tabEditor = qobject_cast<Editor *>(m_tab_editor->currentWidget());
   if (tabEditor) {
     tabEditor->FindFirst(strFindWord);
   }
@@ -180,7 +217,7 @@ void TextEditorForm::SlotFind(const QString &strFindWord) {
 
 void TextEditorForm::SlotFindNext(const QString &strFindWord) {
 #ifndef USE_MONACO_EDITOR
-  Editor *tabEditor = (Editor *)m_tab_editor->currentWidget();
+  Editor *tabEditor = qobject_cast<Editor *>(m_tab_editor->currentWidget());
   if (tabEditor) {
     tabEditor->FindNext(strFindWord);
   }
@@ -190,7 +227,7 @@ void TextEditorForm::SlotFindNext(const QString &strFindWord) {
 void TextEditorForm::SlotReplace(const QString &strFindWord,
                                  const QString &strDesWord) {
 #ifndef USE_MONACO_EDITOR
-  Editor *tabEditor = (Editor *)m_tab_editor->currentWidget();
+  Editor *tabEditor = qobject_cast<Editor *>(m_tab_editor->currentWidget());
   if (tabEditor) {
     tabEditor->Replace(strFindWord, strDesWord);
   }
@@ -200,7 +237,7 @@ void TextEditorForm::SlotReplace(const QString &strFindWord,
 void TextEditorForm::SlotReplaceAndFind(const QString &strFindWord,
                                         const QString &strDesWord) {
 #ifndef USE_MONACO_EDITOR
-  Editor *tabEditor = (Editor *)m_tab_editor->currentWidget();
+  Editor *tabEditor = qobject_cast<Editor *>(m_tab_editor->currentWidget());
   if (tabEditor) {
     tabEditor->ReplaceAndFind(strFindWord, strDesWord);
   }
@@ -210,7 +247,7 @@ void TextEditorForm::SlotReplaceAndFind(const QString &strFindWord,
 void TextEditorForm::SlotReplaceAll(const QString &strFindWord,
                                     const QString &strDesWord) {
 #ifndef USE_MONACO_EDITOR
-  Editor *tabEditor = (Editor *)m_tab_editor->currentWidget();
+  Editor *tabEditor = qobject_cast<Editor *>(m_tab_editor->currentWidget());
   if (tabEditor) {
     tabEditor->ReplaceAll(strFindWord, strDesWord);
   }
@@ -218,6 +255,12 @@ void TextEditorForm::SlotReplaceAll(const QString &strFindWord,
 }
 
 void TextEditorForm::fileModifiedOnDisk(const QString &path) {
+  if (auto viewer = m_largeFiles.value(path)) {
+    // read only, nothing to lose
+    m_fileWatcher.addPath(path);
+    viewer->reload();
+    return;
+  }
   auto editorPair = m_map_file_tabIndex_editor.value(path, {0, nullptr});
   auto editor{editorPair.second};
   if (editor) {
@@ -251,6 +294,15 @@ void TextEditorForm::fileModifiedOnDisk(const QString &path) {
 bool TextEditorForm::TabCloseRequested(int index) {
   if (index == -1) return false;
 
+  if (auto viewer =
+          qobject_cast<LargeFileViewer *>(m_tab_editor->widget(index))) {
+    m_largeFiles.remove(viewer->getFileName());
+    m_fileWatcher.removePath(viewer->getFileName());
+    m_tab_editor->removeTab(index);
+    delete viewer;
+    return true;
+  }
+
   Editor *tabItem = qobject_cast<Editor *>(m_tab_editor->widget(index));
   if (!tabItem) {
     m_tab_editor->removeTab(index);
@@ -1,6 +1,7 @@
 #ifndef TEXT_EDITOR_FORM_H
 #define TEXT_EDITOR_FORM_H
 
+#include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QResizeEvent>
 #include <QTabWidget>
@@ -10,6 +11,7 @@
 #else  // #ifdef USE_MONACO_EDITOR
 #include "editor.h"
 #endif  // #ifdef USE_MONACO_EDITOR
+#include "large_file_viewer.h"
 #include "search_dialog.h"
 
 namespace FOEDAG {
@@ -61,8 +63,12 @@ class TextEditorForm : public QWidget {
   void fileModifiedOnDisk(const QString &path);
 
  private:
+  int OpenLargeFile(const QString &strFileName, const QFileInfo &fileInfo);
+
   TabWidget *m_tab_editor;
   QMap<QString, QPair<int, Editor *>> m_map_file_tabIndex_editor;
+  // files above LargeFileViewer::SizeThreshold are shown read only
+  QMap<QString, LargeFileViewer *> m_largeFiles;
 
 #ifndef USE_MONACO_EDITOR
   SearchDialog *m_searchDialog;
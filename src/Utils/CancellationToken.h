@@ -0,0 +1,48 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace FOEDAG {
+
+/*!
+ * \brief The CancellationToken class is a cancel flag shared by copies of
+ * the token. Work that receives a token checks it between steps, and the
+ * process executor terminates the tools it runs once it is cancelled.
+ * A default constructed token is never cancelled until cancel() is called.
+ */
+class CancellationToken {
+ public:
+  CancellationToken() : m_cancelled(std::make_shared<std::atomic<bool>>()) {}
+
+  void cancel() const { m_cancelled->store(true); }
+  bool isCancelled() const { return m_cancelled->load(); }
+  bool operator==(const CancellationToken &other) const {
+    return m_cancelled == other.m_cancelled;
+  }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+}  // namespace FOEDAG
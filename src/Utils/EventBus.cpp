@@ -0,0 +1,496 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "EventBus.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <tuple>
+
+namespace FOEDAG {
+
+std::atomic<int> EventBus::m_consumers{0};
+
+namespace {
+
+// Bounded queue (D. Vyukov): each cell sequence tells whether it is free for
+// the producer of that position or holds an event for the consumer. Several
+// threads may pop, so producers can drop the oldest event themselves.
+class EventRing {
+ public:
+  explicit EventRing(size_t capacity)
+      : m_cells(capacity), m_mask(capacity - 1) {
+    for (size_t i = 0; i < capacity; i++)
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  // event is moved only on success
+  bool push(FlowEvent &event) {
+    Cell *cell{nullptr};
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (m_tail.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+    cell->event = std::move(event);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  bool pop(FlowEvent &event) {
+    Cell *cell{nullptr};
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (m_head.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;  // empty
+      } else {
+        pos = m_head.load(std::memory_order_relaxed);
+      }
+    }
+    event = std::move(cell->event);
+    cell->event = FlowEvent{};
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence{0};
+    FlowEvent event{};
+  };
+  std::vector<Cell> m_cells;
+  const size_t m_mask;
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+struct EventQueues {
+  static_assert((EventBus::Capacity & (EventBus::Capacity - 1)) == 0,
+                "capacity must be a power of 2");
+  EventRing high{EventBus::Capacity};
+  EventRing low{EventBus::Capacity};
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<uint64_t> dropped{0};
+  const std::chrono::steady_clock::time_point start{
+      std::chrono::steady_clock::now()};
+};
+
+EventQueues &queues() {
+  static EventQueues q{};
+  return q;
+}
+
+// ~10 ms for the consumer to make room before a high priority event drops
+// the oldest one
+constexpr int HighPriorityRetries{100};
+constexpr std::chrono::microseconds RetryDelay{100};
+
+void writeEscaped(std::ostream &out, const std::string &str) {
+  static const char *hex = "0123456789abcdef";
+  for (unsigned char c : str) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (c < 0x20)
+          out << "\\u00" << hex[c >> 4] << hex[c & 0xF];
+        else
+          out << c;
+    }
+  }
+}
+
+void writeNumber(std::ostream &out, double value) {
+  if (!std::isfinite(value))
+    out << 0;
+  else if (value == std::floor(value) && std::fabs(value) < 1e15)
+    out << static_cast<int64_t>(value);
+  else
+    out << value;
+}
+
+struct EventLogState {
+  std::mutex mutex;  // guards the file
+  std::ofstream out;
+  std::filesystem::path file;
+  std::thread thread;
+  std::atomic<bool> active{false};
+  std::atomic<bool> stop{false};
+};
+
+EventLogState &eventLog() {
+  static EventLogState state{};
+  return state;
+}
+
+constexpr std::chrono::milliseconds LogDrainInterval{50};
+constexpr size_t LogChunkSize{4096};
+
+}  // namespace
+
+const char *FlowEvent::typeName(Type type) {
+  switch (type) {
+    case Type::Progress:
+      return "progress";
+    case Type::StageStart:
+      return "stage_start";
+    case Type::StageEnd:
+      return "stage_end";
+    case Type::Message:
+      return "message";
+    case Type::Metric:
+      return "metric";
+    case Type::LogChunk:
+      return "log";
+  }
+  return "unknown";
+}
+
+void EventBus::attach() {
+  if (m_consumers.fetch_add(1) == 0) {
+    auto &q = queues();
+    FlowEvent event{};
+    while (q.high.pop(event)) {
+    }
+    while (q.low.pop(event)) {
+    }
+    q.dropped.store(0);
+  }
+}
+
+void EventBus::detach() { m_consumers.fetch_sub(1); }
+
+void EventBus::post(FlowEvent &&event) {
+  if (!isEnabled()) return;
+  auto &q = queues();
+  event.sequence = q.sequence.fetch_add(1, std::memory_order_relaxed);
+  event.time = std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - q.start)
+                   .count();
+  const bool low = event.lowPriority();
+  EventRing &ring = low ? q.low : q.high;
+  FlowEvent oldest{};
+  for (int attempt = 0; !ring.push(event); attempt++) {
+    if (!low && attempt < HighPriorityRetries) {
+      std::this_thread::sleep_for(RetryDelay);
+      continue;
+    }
+    if (ring.pop(oldest)) q.dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void EventBus::progress(const std::string &source, const std::string &name,
+                        double done, double total, const std::string &text) {
+  if (!isEnabled()) return;
+  FlowEvent event{};
+  event.type = FlowEvent::Type::Progress;
+  event.source = source;
+  event.name = name;
+  event.text = text;
+  event.value = done;
+  event.total = total;
+  post(std::move(event));
+}
+
+void EventBus::stageStart(const std::string &source, const std::string &name) {
+  if (!isEnabled()) return;
+  FlowEvent event{};
+  event.type = FlowEvent::Type::StageStart;
+  event.source = source;
+  event.name = name;
+  post(std::move(event));
+}
+
+void EventBus::stageEnd(const std::string &source, const std::string &name,
+                        bool success) {
+  if (!isEnabled()) return;
+  FlowEvent event{};
+  event.type = FlowEvent::Type::StageEnd;
+  event.source = source;
+  event.name = name;
+  event.value = success ? 1 : 0;
+  post(std::move(event));
+}
+
+void EventBus::message(const std::string &source, const std::string &level,
+                       const std::string &text) {
+  if (!isEnabled()) return;
+  FlowEvent event{};
+  event.type = FlowEvent::Type::Message;
+  event.source = source;
+  event.name = level;
+  event.text = text;
+  post(std::move(event));
+}
+
+void EventBus::metric(const std::string &source, const std::string &name,
+                      double value) {
+  if (!isEnabled()) return;
+  FlowEvent event{};
+  event.type = FlowEvent::Type::Metric;
+  event.source = source;
+  event.name = name;
+  event.value = value;
+  post(std::move(event));
+}
+
+void EventBus::logChunk(const std::string &source, const std::string &text) {
+  if (!isEnabled() || text.empty()) return;
+  FlowEvent event{};
+  event.type = FlowEvent::Type::LogChunk;
+  event.source = source;
+  event.text = text;
+  post(std::move(event));
+}
+
+size_t EventBus::drain(std::vector<FlowEvent> &events, size_t max) {
+  auto &q = queues();
+  const size_t first = events.size();
+  FlowEvent event{};
+  size_t count{0};
+  // stage and message events first so they are never left behind
+  while (count < max && q.high.pop(event)) {
+    events.push_back(std::move(event));
+    count++;
+  }
+  while (count < max && q.low.pop(event)) {
+    events.push_back(std::move(event));
+    count++;
+  }
+  std::stable_sort(events.begin() + first, events.end(),
+                   [](const FlowEvent &a, const FlowEvent &b) {
+                     return a.sequence < b.sequence;
+                   });
+  return count;
+}
+
+void EventBus::coalesce(std::vector<FlowEvent> &events) {
+  std::vector<bool> keep(events.size(), true);
+  std::set<std::tuple<FlowEvent::Type, std::string, std::string>> latest;
+  std::map<std::string, size_t> lastChunk;
+  for (size_t i = events.size(); i-- > 0;) {
+    const auto &event = events[i];
+    if (event.type == FlowEvent::Type::Progress ||
+        event.type == FlowEvent::Type::Metric) {
+      keep[i] = latest.emplace(event.type, event.source, event.name).second;
+    } else if (event.type == FlowEvent::Type::LogChunk) {
+      lastChunk.emplace(event.source, i);
+    }
+  }
+  std::map<std::string, std::string> text;
+  for (size_t i = 0; i < events.size(); i++) {
+    auto &event = events[i];
+    if (event.type != FlowEvent::Type::LogChunk) continue;
+    auto &pending = text[event.source];
+    if (lastChunk[event.source] == i) {
+      if (!pending.empty()) event.text = pending + event.text;
+    } else {
+      pending += event.text;
+      keep[i] = false;
+    }
+  }
+  size_t count{0};
+  for (size_t i = 0; i < events.size(); i++) {
+    if (!keep[i]) continue;
+    if (count != i) events[count] = std::move(events[i]);
+    count++;
+  }
+  events.resize(count);
+}
+
+uint64_t EventBus::dropped() { return queues().dropped.load(); }
+
+bool EventLog::start(const std::filesystem::path &file, std::string &error) {
+  auto &log = eventLog();
+  {
+    std::lock_guard<std::mutex> lock{log.mutex};
+    if (log.active) {
+      error = "Event log is already written to " + log.file.string();
+      return false;
+    }
+    log.out.open(file);
+    if (!log.out.is_open()) {
+      error = "Cannot open event log file " + file.string();
+      return false;
+    }
+    log.file = file;
+    log.stop = false;
+    log.active = true;
+  }
+  // the GUI passes what it drains, otherwise drain here
+  if (!EventBus::isEnabled()) {
+    EventBus::attach();
+    log.thread = std::thread([&log]() {
+      std::vector<FlowEvent> events;
+      bool last{false};
+      while (!last) {
+        last = log.stop.load();
+        events.clear();
+        EventBus::drain(events);
+        EventLog::write(events);
+        if (!last) std::this_thread::sleep_for(LogDrainInterval);
+      }
+    });
+  }
+  return true;
+}
+
+bool EventLog::stop(std::string &error) {
+  auto &log = eventLog();
+  if (!log.active) {
+    error = "Event log is not started";
+    return false;
+  }
+  if (log.thread.joinable()) {
+    log.stop = true;
+    log.thread.join();
+    EventBus::detach();
+  }
+  std::lock_guard<std::mutex> lock{log.mutex};
+  log.active = false;
+  log.out.close();
+  if (!log.out) {
+    error = "Failed to write event log file " + log.file.string();
+    log.out.clear();
+    return false;
+  }
+  return true;
+}
+
+bool EventLog::isActive() { return eventLog().active.load(); }
+
+void EventLog::write(const std::vector<FlowEvent> &events) {
+  auto &log = eventLog();
+  if (events.empty() || !log.active) return;
+  std::lock_guard<std::mutex> lock{log.mutex};
+  if (!log.active) return;
+  for (const auto &event : events) log.out << toJson(event) << '\n';
+  log.out.flush();
+}
+
+std::string EventLog::toJson(const FlowEvent &event) {
+  std::ostringstream out;
+  out << "{\"seq\":" << event.sequence << ",\"time\":" << event.time
+      << ",\"type\":\"" << FlowEvent::typeName(event.type)
+      << "\",\"source\":\"";
+  writeEscaped(out, event.source);
+  out << "\"";
+  if (!event.name.empty()) {
+    out << ",\"name\":\"";
+    writeEscaped(out, event.name);
+    out << "\"";
+  }
+  if (!event.text.empty()) {
+    out << ",\"text\":\"";
+    writeEscaped(out, event.text);
+    out << "\"";
+  }
+  if (event.type != FlowEvent::Type::Message &&
+      event.type != FlowEvent::Type::LogChunk &&
+      event.type != FlowEvent::Type::StageStart) {
+    out << ",\"value\":";
+    writeNumber(out, event.value);
+  }
+  if (event.type == FlowEvent::Type::Progress) {
+    out << ",\"total\":";
+    writeNumber(out, event.total);
+  }
+  out << "}";
+  return out.str();
+}
+
+EventBusStream::EventBusStream(const std::string &source)
+    : std::ostream(nullptr), m_buffer(source) {
+  rdbuf(&m_buffer);
+}
+
+EventBusStream::~EventBusStream() { m_buffer.post(); }
+
+void EventBusStream::Buffer::post() {
+  if (m_pending.empty()) return;
+  EventBus::logChunk(m_source, m_pending);
+  m_pending.clear();
+}
+
+EventBusStream::Buffer::int_type EventBusStream::Buffer::overflow(int_type c) {
+  if (traits_type::eq_int_type(c, traits_type::eof())) return 0;
+  m_pending.push_back(traits_type::to_char_type(c));
+  if (c == '\n' || m_pending.size() >= LogChunkSize) post();
+  return c;
+}
+
+std::streamsize EventBusStream::Buffer::xsputn(const char *s,
+                                               std::streamsize n) {
+  if (n <= 0) return 0;
+  // post complete lines, keep the rest for the next write
+  const std::string_view data{s, static_cast<size_t>(n)};
+  const size_t eol = data.rfind('\n');
+  if (eol == std::string_view::npos) {
+    m_pending.append(data);
+  } else {
+    m_pending.append(data.substr(0, eol + 1));
+    post();
+    m_pending.append(data.substr(eol + 1));
+  }
+  if (m_pending.size() >= LogChunkSize) post();
+  return n;
+}
+
+int EventBusStream::Buffer::sync() {
+  post();
+  return 0;
+}
+
+}  // namespace FOEDAG
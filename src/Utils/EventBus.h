@@ -0,0 +1,162 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace FOEDAG {
+
+struct FlowEvent {
+  enum class Type : uint8_t {
+    Progress,
+    StageStart,
+    StageEnd,
+    Message,
+    Metric,
+    LogChunk
+  };
+  Type type{Type::Message};
+  uint64_t sequence{0};  // posting order
+  uint64_t time{0};      // us since the first event
+  std::string source{};  // compiler, simulator, programmer
+  std::string name{};    // stage, progress or metric name, message level
+  std::string text{};    // message, log output or progress label
+  double value{0};       // progress done, metric value, 1 for stage success
+  double total{0};       // progress total
+
+  // progress, metrics and log chunks can be coalesced or dropped
+  bool lowPriority() const {
+    return type == Type::Progress || type == Type::Metric ||
+           type == Type::LogChunk;
+  }
+  static const char *typeName(Type type);
+};
+
+/*!
+ * \brief The EventBus class carries progress, stage, message, metric and log
+ * events from the compiler, simulator and programmer threads to a single
+ * consumer: the GUI, which drains it at frame rate, or the event log in batch
+ * mode. Posting does not take a lock and the queue memory is bounded. When
+ * low priority events fill their queue the oldest one is dropped. High
+ * priority events wait briefly for the consumer first. Nothing is queued
+ * while no consumer is attached.
+ */
+class EventBus {
+ public:
+  static constexpr size_t Capacity{4096};  // events per priority, power of 2
+
+  /*!
+   * \brief attach/detach count consumers, the first attach clears events
+   * left from a previous consumer.
+   */
+  static void attach();
+  static void detach();
+  static bool isEnabled() {
+    return m_consumers.load(std::memory_order_relaxed) > 0;
+  }
+
+  static void post(FlowEvent &&event);
+  static void progress(const std::string &source, const std::string &name,
+                       double done, double total,
+                       const std::string &text = {});
+  static void stageStart(const std::string &source, const std::string &name);
+  static void stageEnd(const std::string &source, const std::string &name,
+                       bool success);
+  static void message(const std::string &source, const std::string &level,
+                      const std::string &text);
+  static void metric(const std::string &source, const std::string &name,
+                     double value);
+  static void logChunk(const std::string &source, const std::string &text);
+
+  /*!
+   * \brief drain moves up to \a max queued events to \a events, in posting
+   * order within the batch. Only one thread may drain at a time.
+   * \return number of events moved.
+   */
+  static size_t drain(std::vector<FlowEvent> &events,
+                      size_t max = std::numeric_limits<size_t>::max());
+
+  /*!
+   * \brief coalesce keeps the last progress and metric of each source and
+   * name, and joins the log chunks of a source into its last chunk.
+   */
+  static void coalesce(std::vector<FlowEvent> &events);
+
+  /*!
+   * \brief dropped number of events lost since the first attach.
+   */
+  static uint64_t dropped();
+
+ private:
+  static std::atomic<int> m_consumers;
+};
+
+/*!
+ * \brief The EventLog class writes events as JSON lines. If a consumer is
+ * already attached when the log starts, that consumer passes the events it
+ * drains to write(). Otherwise the log drains the bus in its own thread.
+ */
+class EventLog {
+ public:
+  static bool start(const std::filesystem::path &file, std::string &error);
+  static bool stop(std::string &error);
+  static bool isActive();
+  static void write(const std::vector<FlowEvent> &events);
+  static std::string toJson(const FlowEvent &event);
+};
+
+/*!
+ * \brief The EventBusStream class posts what is written to it as log chunks
+ * of \a source. A chunk is posted at the end of each line block or every 4
+ * KiB. Only the event log consumes log chunks, tool output is teed to this
+ * stream while EventLog::isActive().
+ */
+class EventBusStream : public std::ostream {
+ public:
+  explicit EventBusStream(const std::string &source);
+  ~EventBusStream() override;
+
+ private:
+  class Buffer : public std::streambuf {
+   public:
+    explicit Buffer(const std::string &source) : m_source(source) {}
+    void post();
+
+   protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+    int sync() override;
+
+   private:
+    const std::string m_source;
+    std::string m_pending{};
+  };
+  Buffer m_buffer;
+};
+
+}  // namespace FOEDAG
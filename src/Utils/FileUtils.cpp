@@ -34,13 +34,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
 
 #include "Utils/StringUtils.h"
+#include "Utils/Tracer.h"
 
 std::vector<QProcess*> FOEDAG::FileUtils::m_processes{};
+std::mutex FOEDAG::FileUtils::m_processesMutex{};
 
 namespace FOEDAG {
 
@@ -297,14 +300,20 @@ Return FileUtils::ExecuteSystemCommand(const std::string& command,
     auto success = process.startDetached(program, args_);
     return {success ? 0 : -1,
             QString{"%1: Failed to start."}.arg(program).toStdString()};
-  } else {
+  }
+  TraceScope trace{"process", command};
+  {
+    std::lock_guard<std::mutex> lock{m_processesMutex};
     m_processes.push_back(&process);
     process.start(program, args_);
   }
 
   bool finished = process.waitForFinished(timeout_ms);
-  auto it = std::find(m_processes.begin(), m_processes.end(), &process);
-  if (it != m_processes.end()) m_processes.erase(it);
+  {
+    std::lock_guard<std::mutex> lock{m_processesMutex};
+    auto it = std::find(m_processes.begin(), m_processes.end(), &process);
+    if (it != m_processes.end()) m_processes.erase(it);
+  }
 
   std::string message{};
   if (!finished) {
@@ -380,6 +389,7 @@ void FileUtils::printArgs(int argc, const char* argv[]) {
 }
 
 void FileUtils::terminateSystemCommand() {
+  std::lock_guard<std::mutex> lock{m_processesMutex};
   for (auto pr : m_processes) pr->terminate();
 }
 
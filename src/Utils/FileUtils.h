@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <cstdint>
 #include <filesystem>
+#include <mutex>
 #include <regex>
 #include <string>
 #include <string_view>
@@ -120,6 +121,7 @@ class FileUtils final {
   ~FileUtils() = delete;
 
   static std::vector<QProcess*> m_processes;
+  static std::mutex m_processesMutex;
 };
 
 };  // namespace FOEDAG
@@ -0,0 +1,182 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "JobPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace FOEDAG {
+
+namespace {
+// pool the current thread works for, nested jobs of that pool run inline
+thread_local const JobPool *currentPool{nullptr};
+}  // namespace
+
+JobPool::JobPool(unsigned int threads) {
+  if (threads == 0) threads = std::max(2u, std::thread::hardware_concurrency());
+  m_running.resize(threads);
+  m_busy.resize(threads, false);
+  m_threads.reserve(threads);
+  for (size_t i = 0; i < threads; i++)
+    m_threads.emplace_back(&JobPool::worker, this, i);
+}
+
+JobPool::~JobPool() {
+  std::deque<Job> skipped;
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_shutdown = true;
+    skipped.swap(m_queue);
+  }
+  m_wakeup.notify_all();
+  for (auto &job : skipped) {
+    job.token.cancel();
+    execute(job);
+  }
+  for (auto &thread : m_threads) thread.join();
+}
+
+void JobPool::setTimingHook(const TimingHook &hook) {
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_timingHook = hook;
+}
+
+void JobPool::cancelAll() {
+  std::lock_guard<std::mutex> lock{m_mutex};
+  for (auto &job : m_queue) job.token.cancel();
+  for (size_t i = 0; i < m_running.size(); i++)
+    if (m_busy[i]) m_running[i].cancel();
+}
+
+size_t JobPool::pending() const {
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_queue.size();
+}
+
+JobPool &JobPool::global() {
+  static JobPool pool{};
+  return pool;
+}
+
+void JobPool::parallelFor(
+    const std::string &name, size_t count, unsigned int jobs,
+    const std::function<void(size_t, const CancellationToken &)> &fn,
+    const CancellationToken &token) {
+  if (count == 0) return;
+  if (jobs == 0) jobs = size();
+  jobs = static_cast<unsigned int>(std::min<size_t>(jobs, count));
+  // helpers may start after the loop is over, they only see the shared state
+  struct Loop {
+    std::function<void(size_t, const CancellationToken &)> fn;
+    CancellationToken token;
+    size_t count{0};
+    std::atomic<size_t> next{0};
+    size_t done{0};
+    std::exception_ptr error{};
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+  auto loop = std::make_shared<Loop>();
+  loop->fn = fn;
+  loop->token = token;
+  loop->count = count;
+  auto run = [loop]() {
+    for (size_t i = loop->next++; i < loop->count; i = loop->next++) {
+      std::exception_ptr error{};
+      try {
+        loop->fn(i, loop->token);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock{loop->mutex};
+      if (error && !loop->error) loop->error = error;
+      if (++loop->done == loop->count) loop->finished.notify_all();
+    }
+  };
+  for (unsigned int i = 1; i < jobs; i++) {
+    Job job{};
+    job.timing.name = name;
+    job.token = token;
+    // a helper skipped on cancel leaves its share to the other threads
+    job.run = [run](bool cancelled) {
+      if (!cancelled) run();
+    };
+    enqueue(std::move(job), false);
+  }
+  run();
+  std::unique_lock<std::mutex> lock{loop->mutex};
+  loop->finished.wait(lock, [&loop]() { return loop->done == loop->count; });
+  if (loop->error) std::rethrow_exception(loop->error);
+}
+
+void JobPool::enqueue(Job &&job, bool nestedInline) {
+  job.timing.queued = JobTiming::Clock::now();
+  if (nestedInline && currentPool == this) {
+    execute(job);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (!m_shutdown) {
+      m_queue.push_back(std::move(job));
+      m_wakeup.notify_one();
+      return;
+    }
+  }
+  job.token.cancel();
+  execute(job);
+}
+
+void JobPool::execute(Job &job) {
+  const bool cancelled = job.token.isCancelled();
+  job.timing.started = JobTiming::Clock::now();
+  job.run(cancelled);
+  job.timing.finished = JobTiming::Clock::now();
+  job.timing.cancelled = cancelled;
+  TimingHook hook;
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    hook = m_timingHook;
+  }
+  if (hook) hook(job.timing);
+}
+
+void JobPool::worker(size_t index) {
+  currentPool = this;
+  for (;;) {
+    Job job{};
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_wakeup.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+      if (m_queue.empty()) return;  // shutdown
+      job = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_running[index] = job.token;
+      m_busy[index] = true;
+    }
+    execute(job);
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_busy[index] = false;
+  }
+}
+
+}  // namespace FOEDAG
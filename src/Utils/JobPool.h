@@ -0,0 +1,169 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "CancellationToken.h"
+
+namespace FOEDAG {
+
+struct JobTiming {
+  using Clock = std::chrono::steady_clock;
+  std::string name;
+  Clock::time_point queued{};
+  Clock::time_point started{};
+  Clock::time_point finished{};
+  bool cancelled{false};  // skipped because the token was cancelled in queue
+
+  int64_t waitMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(started -
+                                                                 queued)
+        .count();
+  }
+  int64_t runMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(finished -
+                                                                 started)
+        .count();
+  }
+};
+
+/*!
+ * \brief JobCancelled is the exception of the future of a job cancelled
+ * before it started.
+ */
+class JobCancelled : public std::runtime_error {
+ public:
+  JobCancelled() : std::runtime_error("Cancelled") {}
+};
+
+/*!
+ * \brief The JobPool class runs jobs on a fixed set of worker threads.
+ * submit() returns a future of the job result. Each job gets a cancellation
+ * token: a job whose token is cancelled while it waits is not run, a running
+ * job checks the token itself. A job submitted from a worker of the same pool
+ * runs right away in that worker, so jobs waiting for nested jobs never
+ * block the pool.
+ */
+class JobPool {
+ public:
+  using TimingHook = std::function<void(const JobTiming &)>;
+
+  // 0 threads: one per core, at least 2
+  explicit JobPool(unsigned int threads = 0);
+  // cancels the jobs in queue and waits for the running ones
+  ~JobPool();
+  JobPool(const JobPool &) = delete;
+  JobPool &operator=(const JobPool &) = delete;
+
+  unsigned int size() const {
+    return static_cast<unsigned int>(m_threads.size());
+  }
+
+  template <typename Func>
+  auto submit(const std::string &name, Func &&fn,
+              const CancellationToken &token = {})
+      -> std::future<std::invoke_result_t<Func, const CancellationToken &>> {
+    using Result = std::invoke_result_t<Func, const CancellationToken &>;
+    auto promise = std::make_shared<std::promise<Result>>();
+    auto future = promise->get_future();
+    Job job{};
+    job.timing.name = name;
+    job.token = token;
+    job.run = [promise, fn = std::forward<Func>(fn),
+               token](bool cancelled) mutable {
+      if (cancelled) {
+        promise->set_exception(std::make_exception_ptr(JobCancelled{}));
+        return;
+      }
+      try {
+        if constexpr (std::is_void_v<Result>) {
+          fn(token);
+          promise->set_value();
+        } else {
+          promise->set_value(fn(token));
+        }
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    };
+    enqueue(std::move(job));
+    return future;
+  }
+
+  /*!
+   * \brief parallelFor calls fn(i, token) for each i in [0, count) on at most
+   * 'jobs' threads (0: pool size) and returns once all calls returned. The
+   * calling thread takes part, so it also runs in parallel when called from
+   * a worker of the pool. The first exception of fn is rethrown.
+   */
+  void parallelFor(
+      const std::string &name, size_t count, unsigned int jobs,
+      const std::function<void(size_t, const CancellationToken &)> &fn,
+      const CancellationToken &token = {});
+
+  /*!
+   * \brief setTimingHook is called in the worker after each job, also for
+   * jobs skipped on cancel.
+   */
+  void setTimingHook(const TimingHook &hook);
+
+  // cancels the tokens of all queued and running jobs
+  void cancelAll();
+  size_t pending() const;
+
+  /*!
+   * \brief global pool shared by the compiler, simulator and IP generator
+   * workers.
+   */
+  static JobPool &global();
+
+ private:
+  struct Job {
+    JobTiming timing{};
+    CancellationToken token{};
+    std::function<void(bool cancelled)> run{};
+  };
+  void enqueue(Job &&job, bool nestedInline = true);
+  void execute(Job &job);
+  void worker(size_t index);
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::deque<Job> m_queue;
+  std::vector<CancellationToken> m_running;
+  std::vector<bool> m_busy;
+  bool m_shutdown{false};
+  TimingHook m_timingHook{};
+  std::vector<std::thread> m_threads;
+};
+
+}  // namespace FOEDAG
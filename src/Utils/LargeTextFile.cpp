@@ -0,0 +1,290 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "LargeTextFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+namespace FOEDAG {
+
+namespace {
+
+// lines are published to readers in batches of this size, the first batch
+// is small so that the top of the file can be shown right away
+constexpr size_t firstIndexBatch{1024};
+constexpr size_t indexBatch{64 * 1024};
+// indexing and search read the file in blocks of this size
+constexpr size_t readBlock{1024 * 1024};
+
+struct LowerEqual {
+  bool operator()(char a, char b) const {
+    return std::tolower(static_cast<unsigned char>(a)) ==
+           std::tolower(static_cast<unsigned char>(b));
+  }
+};
+
+}  // namespace
+
+LargeTextFile::~LargeTextFile() { close(); }
+
+bool LargeTextFile::open(const std::filesystem::path &file,
+                         std::string &error) {
+  close();
+#ifdef _WIN32
+  HANDLE handle = CreateFileW(file.wstring().c_str(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE |
+                                  FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    error = "Cannot open file " + file.string();
+    return false;
+  }
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(handle, &size)) {
+    CloseHandle(handle);
+    error = "Cannot get size of file " + file.string();
+    return false;
+  }
+  m_file = handle;
+  m_size = static_cast<size_t>(size.QuadPart);
+#else
+  const int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd == -1) {
+    error = "Cannot open file " + file.string();
+    return false;
+  }
+  struct stat info {};
+  if (fstat(fd, &info) != 0) {
+    ::close(fd);
+    error = "Cannot get size of file " + file.string();
+    return false;
+  }
+  m_fd = fd;
+  m_size = static_cast<size_t>(info.st_size);
+#endif
+  m_open = true;
+  return true;
+}
+
+void LargeTextFile::close() {
+#ifdef _WIN32
+  if (m_file) CloseHandle(m_file);
+  m_file = nullptr;
+#else
+  if (m_fd != -1) ::close(m_fd);
+  m_fd = -1;
+#endif
+  m_size = 0;
+  m_open = false;
+  std::lock_guard<std::mutex> lock{m_indexMutex};
+  m_lineStarts.clear();
+  m_indexed.store(false);
+  m_maxLineLength.store(0);
+}
+
+std::string LargeTextFile::read(size_t offset, size_t length) const {
+  if (!m_open || offset >= m_size) return {};
+  length = std::min(length, m_size - offset);
+  std::string data(length, '\0');
+  size_t done{0};
+  while (done < length) {
+#ifdef _WIN32
+    OVERLAPPED position{};
+    const uint64_t at = offset + done;
+    position.Offset = static_cast<DWORD>(at);
+    position.OffsetHigh = static_cast<DWORD>(at >> 32);
+    DWORD count{0};
+    const DWORD chunk = static_cast<DWORD>(
+        std::min<size_t>(length - done, readBlock));
+    if (!ReadFile(m_file, &data[done], chunk, &count, &position) ||
+        count == 0)
+      break;
+#else
+    const ssize_t count =
+        ::pread(m_fd, &data[done], length - done,
+                static_cast<off_t>(offset + done));
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) break;
+#endif
+    done += static_cast<size_t>(count);
+  }
+  // the file was truncated after it was opened
+  data.resize(done);
+  return data;
+}
+
+void LargeTextFile::indexLines(const std::atomic<bool> &stop) {
+  std::vector<size_t> batch;
+  batch.reserve(indexBatch);
+  batch.push_back(0);
+  size_t maxLength{0};
+  size_t limit{firstIndexBatch};
+  auto publish = [&]() {
+    std::lock_guard<std::mutex> lock{m_indexMutex};
+    m_lineStarts.insert(m_lineStarts.end(), batch.begin(), batch.end());
+    m_maxLineLength.store(maxLength);
+    batch.clear();
+    limit = indexBatch;
+  };
+
+  size_t lineStart{0};
+  size_t offset{0};
+  while (offset < m_size) {
+    if (stop.load()) {
+      publish();
+      return;
+    }
+    const std::string block = read(offset, readBlock);
+    if (block.empty()) break;  // truncated
+    const char *data = block.data();
+    size_t start{0};
+    while (start < block.size()) {
+      auto end = static_cast<const char *>(
+          std::memchr(data + start, '\n', block.size() - start));
+      if (!end) break;
+      const size_t next = offset + static_cast<size_t>(end - data) + 1;
+      maxLength = std::max(maxLength, next - lineStart);
+      // a line break at the end of the file doesn't start a new line
+      if (next < m_size) batch.push_back(next);
+      lineStart = next;
+      start = static_cast<size_t>(end - data) + 1;
+      if (batch.size() >= limit) publish();
+    }
+    offset += block.size();
+  }
+  maxLength = std::max(maxLength, offset - std::min(lineStart, offset));
+  publish();
+  m_indexed.store(true);
+}
+
+size_t LargeTextFile::lineCount() const {
+  std::lock_guard<std::mutex> lock{m_indexMutex};
+  return m_lineStarts.size();
+}
+
+std::string LargeTextFile::line(size_t line) const {
+  size_t start{0};
+  size_t end{npos};
+  {
+    std::lock_guard<std::mutex> lock{m_indexMutex};
+    if (line >= m_lineStarts.size()) return {};
+    start = m_lineStarts.at(line);
+    if (line + 1 < m_lineStarts.size()) end = m_lineStarts.at(line + 1);
+  }
+  std::string text;
+  if (end != npos) {
+    text = read(start, end - start);
+  } else {
+    // last indexed line, its end may be unknown yet
+    constexpr size_t lineBlock{4096};
+    for (size_t offset = start; offset < m_size; offset += lineBlock) {
+      std::string block = read(offset, lineBlock);
+      const size_t lineBreak = block.find('\n');
+      if (lineBreak != std::string::npos) {
+        text.append(block, 0, lineBreak + 1);
+        break;
+      }
+      text += block;
+      if (block.size() < lineBlock) break;
+    }
+  }
+  if (!text.empty() && text.back() == '\n') text.pop_back();
+  if (!text.empty() && text.back() == '\r') text.pop_back();
+  return text;
+}
+
+size_t LargeTextFile::lineOffset(size_t line) const {
+  std::lock_guard<std::mutex> lock{m_indexMutex};
+  return line < m_lineStarts.size() ? m_lineStarts.at(line) : npos;
+}
+
+size_t LargeTextFile::lineAt(size_t offset) const {
+  std::lock_guard<std::mutex> lock{m_indexMutex};
+  if (m_lineStarts.empty()) return 0;
+  auto it = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+  return static_cast<size_t>(std::distance(m_lineStarts.begin(), it)) - 1;
+}
+
+size_t LargeTextFile::find(std::string_view pattern, size_t from,
+                           bool forward, bool caseSensitive,
+                           const std::atomic<bool> *stop,
+                           size_t bound) const {
+  if (pattern.empty() || pattern.size() > m_size) return npos;
+  from = std::min(from, m_size);
+  // blocks overlap by the pattern size, a match across blocks is not missed
+  const size_t block = std::max(readBlock, 2 * pattern.size());
+  const size_t overlap = pattern.size() - 1;
+  auto stopped = [stop]() { return stop && stop->load(); };
+  auto search = [&](const std::string &text) -> size_t {
+    if (text.size() < pattern.size()) return npos;
+    if (caseSensitive)
+      return forward ? text.find(pattern)
+                     : text.rfind(pattern, text.size() - pattern.size());
+    auto it = forward ? std::search(text.begin(), text.end(), pattern.begin(),
+                                    pattern.end(), LowerEqual{})
+                      : std::find_end(text.begin(), text.end(),
+                                      pattern.begin(), pattern.end(),
+                                      LowerEqual{});
+    return it == text.end() ? npos : static_cast<size_t>(it - text.begin());
+  };
+  if (forward) {
+    const size_t end = std::min(bound, m_size);
+    for (size_t start = from; start < end; start += block - overlap) {
+      if (stopped()) return npos;
+      const size_t length = std::min(block, end - start);
+      const std::string text = read(start, length);
+      const size_t match = search(text);
+      if (match != npos) return start + match;
+      if (text.size() < block) break;
+    }
+    return npos;
+  }
+  const size_t begin = bound == npos ? 0 : std::min(bound, m_size);
+  size_t end = from;
+  while (end >= begin + pattern.size()) {
+    if (stopped()) return npos;
+    const size_t start = std::max(begin, end > block ? end - block : 0);
+    const size_t match = search(read(start, end - start));
+    if (match != npos) return start + match;
+    if (start == begin) break;
+    end = start + overlap;
+  }
+  return npos;
+}
+
+}  // namespace FOEDAG
@@ -0,0 +1,108 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace FOEDAG {
+
+/*!
+ * \brief The LargeTextFile class gives read-only access to a text file
+ * through positional reads, so large logs and reports are not loaded into
+ * memory. Lines are found through an index of line offsets built by
+ * indexLines(), which is meant to run in a worker thread: lines indexed so
+ * far can be read while it runs. Tools truncate and rewrite their logs, a
+ * read past the current end of the file comes back short.
+ */
+class LargeTextFile {
+ public:
+  static constexpr size_t npos{std::string_view::npos};
+
+  LargeTextFile() = default;
+  ~LargeTextFile();
+  LargeTextFile(const LargeTextFile &) = delete;
+  LargeTextFile &operator=(const LargeTextFile &) = delete;
+
+  bool open(const std::filesystem::path &file, std::string &error);
+  void close();
+  bool isOpen() const { return m_open; }
+  // size of the file when it was opened
+  size_t size() const { return m_size; }
+  /*!
+   * \brief read returns up to \a length bytes at \a offset, less if the
+   * file ends before.
+   */
+  std::string read(size_t offset, size_t length) const;
+
+  /*!
+   * \brief indexLines records the offset of every line of the file. Returns
+   * when the whole file is indexed or \a stop is set.
+   */
+  void indexLines(const std::atomic<bool> &stop);
+  bool indexed() const { return m_indexed.load(); }
+  /*!
+   * \brief lineCount number of lines indexed so far.
+   */
+  size_t lineCount() const;
+  size_t maxLineLength() const { return m_maxLineLength.load(); }
+  /*!
+   * \brief line returns line \a line (0-based) without line break or an
+   * empty string if the line is not indexed yet.
+   */
+  std::string line(size_t line) const;
+  size_t lineOffset(size_t line) const;
+  /*!
+   * \brief lineAt returns the line holding \a offset among indexed lines.
+   */
+  size_t lineAt(size_t offset) const;
+
+  /*!
+   * \brief find returns the offset of the first match of \a pattern at or
+   * after \a from when \a forward is set, otherwise of the last match ending
+   * at or before \a from. The search ends at \a bound: forward matches
+   * end at or before it, backward matches start at or after it. Returns npos
+   * if there is no match or \a stop is set while searching.
+   */
+  size_t find(std::string_view pattern, size_t from, bool forward,
+              bool caseSensitive, const std::atomic<bool> *stop = nullptr,
+              size_t bound = npos) const;
+
+ private:
+  bool m_open{false};
+  size_t m_size{0};
+#ifdef _WIN32
+  void *m_file{nullptr};
+#else
+  int m_fd{-1};
+#endif
+  mutable std::mutex m_indexMutex;
+  std::vector<size_t> m_lineStarts;  // guarded by m_indexMutex
+  std::atomic<bool> m_indexed{false};
+  std::atomic<size_t> m_maxLineLength{0};
+};
+
+}  // namespace FOEDAG
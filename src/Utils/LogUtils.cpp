@@ -34,28 +34,42 @@ extern const char* foedag_git_hash;
 extern const char* foedag_build_type;
 extern const char* release_version;
 
+bool LogUtils::OpenLog(std::ofstream& out,
+                       const std::filesystem::path& logPath,
+                       bool append /* false */) {
+  std::error_code ec;
+  const bool empty = !append || !std::filesystem::exists(logPath, ec) ||
+                     std::filesystem::file_size(logPath, ec) == 0;
+  out.open(logPath, append ? std::ios_base::out | std::ios_base::app
+                           : std::ios_base::out | std::ios_base::trunc);
+  if (!out.is_open()) return false;
+  if (empty) {
+    PrintHeader(&out);
+    out.flush();
+  }
+  return true;
+}
+
 void LogUtils::AddHeaderToLog(const std::filesystem::path& logPath) {
+  if (!FileUtils::FileExists(logPath)) return;
+  std::error_code ec;
+  if (std::filesystem::file_size(logPath, ec) == 0 && !ec) {
+    // Nothing to move, the header goes straight into the log
+    std::ofstream log(logPath, std::ios_base::out | std::ios_base::app);
+    PrintHeader(&log);
+    return;
+  }
+  const std::filesystem::path headerPath = HeaderPath(logPath);
   // Grab first 2 lines of copyright incase the first is a block comment
-  auto lines = GetCopyrightLines(2);
-
-  if (FileUtils::FileExists(logPath) && !HasHeader(logPath, lines)) {
-    std::ifstream srcLog(logPath);
-
-    // new file path w/ temp name
-    std::filesystem::path tempPath = logPath.string() + ".NEW";
-    std::ofstream destLog(tempPath);
-
-    PrintHeader(&destLog);
-
-    // Add original log contents
-    destLog << srcLog.rdbuf();
-
-    // Close new log and replace old
-    srcLog.close();
-    destLog.close();
-    std::filesystem::remove(logPath);
-    std::filesystem::rename(tempPath, logPath);
+  if (HasHeader(logPath, GetCopyrightLines(2))) {
+    // drop a sidecar left by a previous run of the tool
+    std::filesystem::remove(headerPath, ec);
+    return;
   }
+
+  // Log is owned by a tool, keep it as is and put the header next to it
+  std::ofstream header(headerPath);
+  PrintHeader(&header);
 }
 
 // This will search a given directory (non-recursively) for files ending in the
@@ -72,6 +86,11 @@ void LogUtils::AddHeadersToLogs(const std::filesystem::path& logDir,
   }
 }
 
+std::filesystem::path LogUtils::HeaderPath(
+    const std::filesystem::path& logPath) {
+  return logPath.string() + ".header";
+}
+
 static std::vector<std::string> copyrightLines{};
 std::vector<std::string> LogUtils::GetCopyrightLines(int lineCount) {
   // Assume that copyright file doesn't change so we'll only read in the lines
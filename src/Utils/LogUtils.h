@@ -22,6 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -30,9 +31,24 @@ namespace FOEDAG {
 
 class LogUtils final {
  public:
+  /*!
+   * \brief OpenLog opens \a logPath for writing and prints the header first
+   * when the log starts empty, so the log never has to be rewritten later.
+   * \return false if the file cannot be opened.
+   */
+  static bool OpenLog(std::ofstream& out, const std::filesystem::path& logPath,
+                      bool append = false);
+
+  /*!
+   * \brief AddHeaderToLog gives a log written by an external tool a header.
+   * An empty log gets the header in place, a non empty log without header
+   * gets it in the sidecar file HeaderPath(logPath), the log is not copied.
+   */
   static void AddHeaderToLog(const std::filesystem::path& logPath);
   static void AddHeadersToLogs(const std::filesystem::path& logPath,
                                const std::string extension = ".rpt");
+  static std::filesystem::path HeaderPath(
+      const std::filesystem::path& logPath);
   static std::vector<std::string> GetCopyrightLines(int lineCount);
   static std::string GetLogHeader(std::string commentPrefix = "",
                                   bool withLogTime = true);
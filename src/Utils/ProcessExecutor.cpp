@@ -0,0 +1,191 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "ProcessExecutor.h"
+
+#include <QProcess>
+#include <chrono>
+
+namespace FOEDAG {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int pollMs{20};
+constexpr int terminateMs{3000};
+constexpr auto flushPeriod{std::chrono::milliseconds{50}};
+constexpr size_t flushSize{64 * 1024};
+
+// Collects pipe data of one channel and writes it to the sinks in blocks.
+class OutputPump {
+ public:
+  explicit OutputPump(const std::vector<std::ostream*>& sinks)
+      : m_sinks(sinks) {}
+  void append(const QByteArray& data) {
+    m_buffer.append(data.constData(), data.size());
+    if (m_buffer.size() >= flushSize) flush();
+  }
+  void flushIfStale(Clock::time_point now) {
+    if (!m_buffer.empty() && now - m_lastFlush >= flushPeriod) flush();
+  }
+  void flush() {
+    if (!m_buffer.empty()) {
+      for (auto sink : m_sinks) {
+        sink->write(m_buffer.data(), m_buffer.size());
+        sink->flush();
+      }
+      m_buffer.clear();
+    }
+    m_lastFlush = Clock::now();
+  }
+
+ private:
+  const std::vector<std::ostream*>& m_sinks;
+  std::string m_buffer;
+  Clock::time_point m_lastFlush{Clock::now()};
+};
+
+}  // namespace
+
+ProcessResult ProcessExecutor::run(const ProcessRequest& request) {
+  ProcessResult result{};
+  if (request.argv.empty()) {
+    result.error = "Empty command";
+    return result;
+  }
+  const uint64_t cancelled = m_cancelled.load();
+
+  QProcess process;
+  if (!request.workingDir.empty())
+    process.setWorkingDirectory(
+        QString::fromStdString(request.workingDir.string()));
+  if (!request.environment.empty()) {
+    auto env = QProcessEnvironment::systemEnvironment();
+    for (const auto& [name, value] : request.environment)
+      env.insert(QString::fromStdString(name), QString::fromStdString(value));
+    process.setProcessEnvironment(env);
+  }
+
+  OutputPump out{request.out};
+  OutputPump err{request.err};
+  // keep the order of stdout and stderr blocks when both go to one log
+  QObject::connect(&process, &QProcess::readyReadStandardOutput, [&]() {
+    err.flush();
+    out.append(process.readAllStandardOutput());
+  });
+  QObject::connect(&process, &QProcess::readyReadStandardError, [&]() {
+    out.flush();
+    err.append(process.readAllStandardError());
+  });
+  if (request.started) {
+    QObject::connect(&process, &QProcess::started,
+                     [&]() { request.started(process.processId()); });
+  }
+
+  QStringList args;
+  for (size_t i = 1; i < request.argv.size(); i++)
+    args << QString::fromStdString(request.argv.at(i));
+  process.start(QString::fromStdString(request.argv.front()), args);
+  if (!process.waitForStarted(-1)) {
+    result.error = process.errorString().toStdString();
+    return result;
+  }
+
+  const auto start = Clock::now();
+  while (!process.waitForFinished(pollMs)) {
+    if (process.state() == QProcess::NotRunning) break;
+    const auto now = Clock::now();
+    out.flushIfStale(now);
+    err.flushIfStale(now);
+    const bool timeout =
+        request.timeoutMs >= 0 &&
+        now - start >= std::chrono::milliseconds{request.timeoutMs};
+    if (timeout || m_cancelled.load() != cancelled ||
+        request.cancel.isCancelled()) {
+      result.status = timeout ? ProcessResult::Timeout
+                              : ProcessResult::Cancelled;
+      process.terminate();
+      if (!process.waitForFinished(terminateMs)) {
+        process.kill();
+        process.waitForFinished(-1);
+      }
+      break;
+    }
+  }
+  // pick up data that arrived together with the exit
+  out.append(process.readAllStandardOutput());
+  err.append(process.readAllStandardError());
+  out.flush();
+  err.flush();
+
+  if (result.status == ProcessResult::Timeout) {
+    result.error = "Timeout after " + std::to_string(request.timeoutMs) + " ms";
+  } else if (result.status == ProcessResult::Cancelled) {
+    result.error = "Cancelled";
+  } else if (process.exitStatus() == QProcess::CrashExit) {
+    result.status = ProcessResult::Crashed;
+    result.error = process.errorString().toStdString();
+  } else {
+    result.status = ProcessResult::Finished;
+    result.exitCode = process.exitCode();
+  }
+  return result;
+}
+
+void ProcessExecutor::cancel() { m_cancelled.fetch_add(1); }
+
+std::vector<std::string> ProcessExecutor::SplitCommand(
+    const std::string& command) {
+  std::vector<std::string> argv;
+  std::string current;
+  bool quoted{false};
+  bool hasArg{false};
+  for (char c : command) {
+    // A quote only groups when it opens a word or closes a quoted group,
+    // quotes inside a word such as -DX="s" are part of the argument.
+    if (c == '"' && (quoted || !hasArg)) {
+      quoted = !quoted;
+      hasArg = true;
+    } else if (!quoted && (c == ' ' || c == '\t')) {
+      if (hasArg) argv.push_back(current);
+      current.clear();
+      hasArg = false;
+    } else {
+      current.push_back(c);
+      hasArg = true;
+    }
+  }
+  if (hasArg) argv.push_back(current);
+  return argv;
+}
+
+std::string ProcessExecutor::JoinCommand(const std::vector<std::string>& argv) {
+  std::string command;
+  for (const auto& arg : argv) {
+    if (!command.empty()) command.push_back(' ');
+    const bool quote =
+        arg.empty() || arg.find_first_of(" \t") != std::string::npos;
+    command += quote ? "\"" + arg + "\"" : arg;
+  }
+  return command;
+}
+
+}  // namespace FOEDAG
@@ -0,0 +1,85 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "CancellationToken.h"
+
+namespace FOEDAG {
+
+struct ProcessRequest {
+  std::vector<std::string> argv;  // program followed by its arguments
+  // working directory of the child only, empty to inherit the current one
+  std::filesystem::path workingDir{};
+  // added to or overriding the system environment of the child only
+  std::map<std::string, std::string> environment{};
+  // pipe data is accumulated and written to all sinks in blocks
+  std::vector<std::ostream*> out{};
+  std::vector<std::ostream*> err{};
+  int timeoutMs{-1};
+  std::function<void(int64_t pid)> started{};
+  // the child is terminated (SIGTERM), then killed if it does not exit
+  CancellationToken cancel{};
+};
+
+struct ProcessResult {
+  enum Status { Finished, Crashed, FailedToStart, Timeout, Cancelled };
+  Status status{FailedToStart};
+  int exitCode{-1};
+  std::string error{};
+  // exit code of a finished process, -1 otherwise
+  int code() const { return status == Finished ? exitCode : -1; }
+};
+
+/*!
+ * \brief The ProcessExecutor class launches external tools without touching
+ * process wide state: working directory and environment are set for the
+ * child only, so several threads can run tools through the same executor.
+ * run() blocks the calling thread, cancel() is safe to call from any thread
+ * and stops all processes running at that moment. A single process is
+ * stopped through the cancellation token of its request.
+ */
+class ProcessExecutor {
+ public:
+  ProcessResult run(const ProcessRequest& request);
+  void cancel();
+
+  /*!
+   * \brief SplitCommand splits a command line on spaces and tabs. Double
+   * quotes opening a word group words into one argument and are removed,
+   * quotes inside a word are kept.
+   */
+  static std::vector<std::string> SplitCommand(const std::string& command);
+  static std::string JoinCommand(const std::vector<std::string>& argv);
+
+ private:
+  std::atomic<uint64_t> m_cancelled{0};
+};
+
+}  // namespace FOEDAG
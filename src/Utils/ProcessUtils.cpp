@@ -20,67 +20,316 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "ProcessUtils.h"
 
-#include <fstream>
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32) || \
+    defined(_MSC_VER) || defined(__CYGWIN__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#include <direct.h>
+#include <process.h>
+#ifndef __SIZEOF_INT__
+#define __SIZEOF_INT__ sizeof(int)
+#endif
+#include <psapi.h>
+#else
+#include <dirent.h>
+#include <stdlib.h>
+#include <sys/param.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <string>
+#include <vector>
 
 namespace FOEDAG {
 
-ProcessUtils::~ProcessUtils() { cleanup(); }
+// longest period between two measurements, ms
+static constexpr unsigned int MAX_PERIOD{250};
+
+void ProcessStats::append(const ProcessStats &other) {
+  peakRss = std::max(peakRss, other.peakRss);
+  peakPss = std::max(peakPss, other.peakPss);
+  peakVirtual = std::max(peakVirtual, other.peakVirtual);
+  maxProcesses = std::max(maxProcesses, other.maxProcesses);
+  userTime += other.userTime;
+  systemTime += other.systemTime;
+  readBytes += other.readBytes;
+  writeBytes += other.writeBytes;
+  voluntaryCtxSwitches += other.voluntaryCtxSwitches;
+  involuntaryCtxSwitches += other.involuntaryCtxSwitches;
+  samples += other.samples;
+}
+
+ProcessUtils::~ProcessUtils() {
+  Stop();
+  cleanup();
+}
 
 ProcessUtils::uint ProcessUtils::Utilization() const {
-  return m_max_utiliation;
+  return static_cast<uint>(m_stats.peakRss);
 }
 
-void ProcessUtils::Frequency(uint p) { m_frequency = p; }
+const ProcessStats &ProcessUtils::Stats() const { return m_stats; }
 
-void process_mem_usage(int64_t processId, const char *proccessIdStr,
-                       double &vm_usage /*in kiB*/) {
-#if (defined(_MSC_VER) || defined(__CYGWIN__))
-  PROCESS_MEMORY_COUNTERS_EX pmc;
-  auto p = OpenProcess(PROCESS_ALL_ACCESS, FALSE, processId);
-  GetProcessMemoryInfo(p, (PROCESS_MEMORY_COUNTERS *)&pmc, sizeof(pmc));
-  vm_usage = pmc.PrivateUsage / 1024.0;
-#else
-  std::ifstream stat_stream(proccessIdStr, std::ios_base::in);
+void ProcessUtils::Frequency(uint p) { m_frequency = std::max(p, 1u); }
 
-  // dummy vars for leading entries in stat that we don't care about
-  std::string pid, comm, state, ppid, pgrp, session, tty_nr;
-  std::string tpgid, flags, minflt, cminflt, majflt, cmajflt;
-  std::string utime, stime, cutime, cstime, priority, nice;
-  std::string O, itrealvalue, starttime;
+#if !(defined(_MSC_VER) || defined(__CYGWIN__))
+// Reads a small /proc file, returns -1 if it cannot be opened
+static long readFile(const std::string &file, char *buffer, size_t size) {
+  FILE *f = fopen(file.c_str(), "r");
+  if (!f) return -1;
+  size_t read = fread(buffer, 1, size - 1, f);
+  fclose(f);
+  buffer[read] = '\0';
+  return static_cast<long>(read);
+}
+
+// Value of the 'key:' line of /proc files like smaps_rollup or io
+static uint64_t fieldValue(const char *buffer, const char *key) {
+  const char *line = strstr(buffer, key);
+  if (!line) return 0;
+  return strtoull(line + strlen(key), nullptr, 10);
+}
 
-  unsigned long vsize;
+// Children of every thread of 'pid', needs CONFIG_PROC_CHILDREN
+static bool children(int64_t pid, std::vector<int64_t> &result) {
+  std::string tasks = "/proc/" + std::to_string(pid) + "/task";
+  DIR *dir = opendir(tasks.c_str());
+  if (!dir) return false;
+  bool found{false};
+  char buffer[4096];
+  while (dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') continue;
+    if (readFile(tasks + "/" + entry->d_name + "/children", buffer,
+                 sizeof(buffer)) < 0)
+      continue;
+    found = true;
+    char *end{buffer};
+    while (true) {
+      char *next{nullptr};
+      auto child = strtoll(end, &next, 10);
+      if (next == end) break;
+      result.push_back(child);
+      end = next;
+    }
+  }
+  closedir(dir);
+  return found;
+}
 
-  stat_stream >> pid >> comm >> state >> ppid >> pgrp >> session >> tty_nr >>
-      tpgid >> flags >> minflt >> cminflt >> majflt >> cmajflt >> utime >>
-      stime >> cutime >> cstime >> priority >> nice >> O >> itrealvalue >>
-      starttime >> vsize;  // don't care about the rest
+// Fallback for kernels without /proc/<pid>/task/<tid>/children
+static void childrenByParent(int64_t root, std::vector<int64_t> &result) {
+  std::vector<std::pair<int64_t, int64_t>> parents;
+  DIR *dir = opendir("/proc");
+  if (!dir) return;
+  char buffer[1024];
+  while (dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+    std::string stat = std::string{"/proc/"} + entry->d_name + "/stat";
+    if (readFile(stat, buffer, sizeof(buffer)) <= 0) continue;
+    // comm may contain spaces, ppid follows the closing parenthesis
+    const char *comm = strrchr(buffer, ')');
+    if (!comm) continue;
+    char state{};
+    long long ppid{0};
+    if (sscanf(comm + 1, " %c %lld", &state, &ppid) == 2)
+      parents.push_back({ppid, strtoll(entry->d_name, nullptr, 10)});
+  }
+  closedir(dir);
+  std::vector<int64_t> queue{root};
+  while (!queue.empty()) {
+    auto parent = queue.back();
+    queue.pop_back();
+    for (const auto &[ppid, pid] : parents) {
+      if (ppid == parent) {
+        result.push_back(pid);
+        queue.push_back(pid);
+      }
+    }
+  }
+}
 
-  stat_stream.close();
-  vm_usage = vsize / 1024.0;
+static std::vector<int64_t> processTree(int64_t root) {
+  std::vector<int64_t> tree{root};
+  std::vector<int64_t> direct;
+  if (!children(root, direct)) {
+    childrenByParent(root, tree);
+    return tree;
+  }
+  for (size_t i = 0; i < tree.size(); i++) {
+    if (i != 0) children(tree[i], direct);
+    tree.insert(tree.end(), direct.begin(), direct.end());
+    direct.clear();
+  }
+  return tree;
+}
+
+/*
+  CPU time, I/O and context switches of the processes of 'tree'. A process
+  includes the children it already waited for, so nothing is counted twice
+  and processes of other tools running at the same time are not counted.
+*/
+static ProcessStats treeUsage(const std::vector<int64_t> &tree) {
+  static const uint64_t ticks = sysconf(_SC_CLK_TCK);
+  ProcessStats stats{};
+  char buffer[4096];
+  for (auto pid : tree) {
+    const std::string proc = "/proc/" + std::to_string(pid);
+    if (readFile(proc + "/stat", buffer, sizeof(buffer)) <= 0) continue;
+    // comm may contain spaces, fields follow the closing parenthesis
+    const char *comm = strrchr(buffer, ')');
+    if (!comm) continue;
+    unsigned long long utime{0}, stime{0}, cutime{0}, cstime{0};
+    if (sscanf(comm + 1,
+               " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu %llu "
+               "%llu",
+               &utime, &stime, &cutime, &cstime) != 4)
+      continue;
+    stats.userTime += (utime + cutime) * 1000 / ticks;
+    stats.systemTime += (stime + cstime) * 1000 / ticks;
+    if (readFile(proc + "/io", buffer, sizeof(buffer)) > 0) {
+      stats.readBytes += fieldValue(buffer, "read_bytes:");
+      stats.writeBytes += fieldValue(buffer, "\nwrite_bytes:");
+    }
+    // main thread only, the kernel keeps no total for the process
+    if (readFile(proc + "/status", buffer, sizeof(buffer)) > 0) {
+      stats.voluntaryCtxSwitches +=
+          fieldValue(buffer, "\nvoluntary_ctxt_switches:");
+      stats.involuntaryCtxSwitches +=
+          fieldValue(buffer, "\nnonvoluntary_ctxt_switches:");
+    }
+  }
+  return stats;
+}
+#endif
+
+/*
+  Takes one measurement of the whole process tree. 'changed' is set when
+  the tree got a new memory peak or a different number of processes so the
+  caller can sample faster.
+*/
+void ProcessUtils::sample(int64_t processId, bool &changed) {
+  changed = false;
+#if (defined(_MSC_VER) || defined(__CYGWIN__))
+  PROCESS_MEMORY_COUNTERS_EX pmc{};
+  if (!m_handle ||
+      !GetProcessMemoryInfo(static_cast<HANDLE>(m_handle),
+                            (PROCESS_MEMORY_COUNTERS *)&pmc, sizeof(pmc)))
+    return;
+  uint64_t rss = pmc.WorkingSetSize / 1024;
+  uint64_t vm = pmc.PrivateUsage / 1024;
+  changed = rss > m_stats.peakRss;
+  m_stats.peakRss = std::max(m_stats.peakRss, rss);
+  m_stats.peakVirtual = std::max(m_stats.peakVirtual, vm);
+  m_stats.maxProcesses = 1;
+#else
+  static const uint64_t pageSize = sysconf(_SC_PAGESIZE) / 1024;
+  const auto tree = processTree(processId);
+  uint64_t rss{0}, pss{0}, vm{0};
+  char buffer[4096];
+  for (auto pid : tree) {
+    const std::string proc = "/proc/" + std::to_string(pid);
+    unsigned long long size{0}, resident{0};
+    if (readFile(proc + "/statm", buffer, sizeof(buffer)) <= 0 ||
+        sscanf(buffer, "%llu %llu", &size, &resident) != 2)
+      continue;
+    vm += size * pageSize;
+    rss += resident * pageSize;
+    if (readFile(proc + "/smaps_rollup", buffer, sizeof(buffer)) > 0)
+      pss += fieldValue(buffer, "\nPss:");
+  }
+  changed = rss > m_stats.peakRss || tree.size() != m_stats.maxProcesses;
+  m_stats.peakRss = std::max(m_stats.peakRss, rss);
+  m_stats.peakPss = std::max(m_stats.peakPss, pss);
+  m_stats.peakVirtual = std::max(m_stats.peakVirtual, vm);
+  m_stats.maxProcesses =
+      std::max(m_stats.maxProcesses, static_cast<uint64_t>(tree.size()));
+  // counters only grow, a drop means a process exited before its parent
+  // waited for it
+  const ProcessStats usage = treeUsage(tree);
+  m_stats.userTime = std::max(m_stats.userTime, usage.userTime);
+  m_stats.systemTime = std::max(m_stats.systemTime, usage.systemTime);
+  m_stats.readBytes = std::max(m_stats.readBytes, usage.readBytes);
+  m_stats.writeBytes = std::max(m_stats.writeBytes, usage.writeBytes);
+  m_stats.voluntaryCtxSwitches =
+      std::max(m_stats.voluntaryCtxSwitches, usage.voluntaryCtxSwitches);
+  m_stats.involuntaryCtxSwitches =
+      std::max(m_stats.involuntaryCtxSwitches, usage.involuntaryCtxSwitches);
 #endif
+  m_stats.samples++;
 }
 
 void ProcessUtils::Start(int64_t processId) {
+  Stop();
+  cleanup();
+  m_stats = {};
+  m_stop = false;
+#if (defined(_MSC_VER) || defined(__CYGWIN__))
+  m_handle = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE,
+                         static_cast<DWORD>(processId));
+#endif
   auto start = [processId, this]() {
-    auto str = ("/proc/" + std::to_string(processId) + "/stat");
+    uint period{m_frequency};
+    std::unique_lock<std::mutex> lock{m_mutex};
     while (!m_stop) {
-      double vm;
-      process_mem_usage(processId, str.c_str(), vm);
-      m_vm = std::max(m_vm, vm);
-
-      std::chrono::milliseconds dura(m_frequency);
-      std::this_thread::sleep_for(dura);
+      lock.unlock();
+      bool changed{false};
+      sample(processId, changed);
+      period = changed ? m_frequency : std::min(period * 2, MAX_PERIOD);
+      lock.lock();
+      m_wakeup.wait_for(lock, std::chrono::milliseconds{period},
+                        [this]() { return m_stop; });
     }
   };
   m_thread = new std::thread{start};
 }
 
 void ProcessUtils::Stop() {
-  m_stop = true;
-  if (m_thread) m_thread->join();
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_stop = true;
+  }
+  m_wakeup.notify_all();
+  if (!m_thread) return;
+  m_thread->join();
   cleanup();
-  m_max_utiliation = static_cast<uint>(m_vm);
+#if (defined(_MSC_VER) || defined(__CYGWIN__))
+  if (m_handle) {
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(static_cast<HANDLE>(m_handle), &creation, &exit,
+                        &kernel, &user)) {
+      auto toMs = [](const FILETIME &t) -> uint64_t {
+        return ((static_cast<uint64_t>(t.dwHighDateTime) << 32) |
+                t.dwLowDateTime) /
+               10000;
+      };
+      m_stats.userTime = toMs(user);
+      m_stats.systemTime = toMs(kernel);
+    }
+    IO_COUNTERS io{};
+    if (GetProcessIoCounters(static_cast<HANDLE>(m_handle), &io)) {
+      m_stats.readBytes = io.ReadTransferCount;
+      m_stats.writeBytes = io.WriteTransferCount;
+    }
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(static_cast<HANDLE>(m_handle), &pmc,
+                             sizeof(pmc)))
+      m_stats.peakRss = std::max<uint64_t>(m_stats.peakRss,
+                                           pmc.PeakWorkingSetSize / 1024);
+    CloseHandle(static_cast<HANDLE>(m_handle));
+    m_handle = nullptr;
+  }
+#endif
 }
 
 void ProcessUtils::cleanup() {
@@ -20,33 +20,39 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
 
-#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32) || \
-    defined(_MSC_VER) || defined(__CYGWIN__)
-#ifndef NOMINMAX
-#define NOMINMAX
-#endif
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include <Windows.h>
-#include <direct.h>
-#include <process.h>
-#ifndef __SIZEOF_INT__
-#define __SIZEOF_INT__ sizeof(int)
-#endif
-#include <psapi.h>
-#else
-#include <stdlib.h>
-#include <sys/param.h>
-#include <sys/time.h>
-#include <sys/types.h>
-#include <unistd.h>
-#endif
-
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <thread>
 
 namespace FOEDAG {
 
+/*!
+ * \brief The ProcessStats struct holds resources used by a process and all
+ * its descendants. Memory is in kiB, time in ms. On Linux the counters are
+ * sampled while the process runs, so the work done after the last sample is
+ * missed, and context switches are those of the main threads.
+ */
+struct ProcessStats {
+  uint64_t peakRss{0};
+  uint64_t peakPss{0};
+  uint64_t peakVirtual{0};
+  uint64_t userTime{0};
+  uint64_t systemTime{0};
+  uint64_t readBytes{0};
+  uint64_t writeBytes{0};
+  uint64_t voluntaryCtxSwitches{0};
+  uint64_t involuntaryCtxSwitches{0};
+  uint64_t maxProcesses{0};
+  uint64_t samples{0};
+
+  /*!
+   * \brief append stats of a process that ran after this one: peaks are
+   * maximized, counters are summed.
+   */
+  void append(const ProcessStats &other);
+};
+
 class ProcessUtils {
  public:
   ProcessUtils() = default;
@@ -55,12 +61,19 @@ class ProcessUtils {
 
   /*!
    * \brief Utilization
-   * \return max usage of virtual memory in kiB.
+   * \return peak resident memory of the process tree in kiB.
    */
   uint Utilization() const;
 
   /*!
-   * \brief Period sets the frequency of measurment
+   * \brief Stats available after Stop()
+   */
+  const ProcessStats &Stats() const;
+
+  /*!
+   * \brief Frequency sets the shortest period between measurements in ms.
+   * The period grows while memory usage is stable and drops back to this
+   * value when it changes.
    */
   void Frequency(uint p);
   void Start(int64_t processId);
@@ -68,12 +81,17 @@ class ProcessUtils {
 
  private:
   void cleanup();
+  void sample(int64_t processId, bool &changed);
 
-  uint m_max_utiliation{0};
+  ProcessStats m_stats{};
   uint m_frequency{10};
   bool m_stop{false};
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
   std::thread *m_thread{nullptr};
-  double m_vm{0};
+#if (defined(_MSC_VER) || defined(__CYGWIN__))
+  void *m_handle{nullptr};
+#endif
 };
 
 }  // namespace FOEDAG
@@ -0,0 +1,624 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "ProjectArchive.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace FOEDAG {
+
+namespace {
+
+constexpr size_t tarBlock{512};
+constexpr size_t readChunk{256 * 1024};
+constexpr auto manifestHeader{"# foedag archive manifest 1"};
+
+struct ScanEntry {
+  fs::path source;
+  std::string name;  // path in the archive
+  fs::file_type type{fs::file_type::none};
+  uint64_t size{0};
+  uint32_t mode{0644};
+  int64_t mtime{0};
+};
+
+// crc32 and adler32 of the content, both computed in a single read
+class ContentHash {
+ public:
+  void update(const char *data, size_t size) {
+    while (size > 0) {
+      const uInt chunk =
+          static_cast<uInt>(std::min<size_t>(size, 1024 * 1024 * 1024));
+      auto bytes = reinterpret_cast<const Bytef *>(data);
+      m_crc = crc32(m_crc, bytes, chunk);
+      m_adler = adler32(m_adler, bytes, chunk);
+      data += chunk;
+      size -= chunk;
+    }
+  }
+  std::string value() const {
+    char text[17];
+    snprintf(text, sizeof(text), "%08lx%08lx", m_crc & 0xffffffffUL,
+             m_adler & 0xffffffffUL);
+    return text;
+  }
+
+ private:
+  uLong m_crc{crc32(0L, Z_NULL, 0)};
+  uLong m_adler{adler32(0L, Z_NULL, 0)};
+};
+
+std::string hashFile(const fs::path &file, uint64_t size) {
+  std::ifstream stream{file, std::ios::binary};
+  std::vector<char> buffer(readChunk);
+  ContentHash hash;
+  while (size > 0 && stream) {
+    stream.read(buffer.data(), std::min<uint64_t>(size, buffer.size()));
+    const auto count = static_cast<size_t>(stream.gcount());
+    if (count == 0) break;
+    hash.update(buffer.data(), count);
+    size -= count;
+  }
+  return size == 0 ? hash.value() : std::string{};
+}
+
+// Compresses blocks on worker threads and writes them in order, each block
+// as a gzip member
+class BlockCompressor {
+ public:
+  BlockCompressor(std::ostream &out, unsigned threads, int level,
+                  size_t blockSize)
+      : m_out(out),
+        m_level(level),
+        m_blockSize(std::max<size_t>(blockSize, tarBlock)),
+        m_window(2 * threads) {
+    m_block.reserve(m_blockSize);
+    for (unsigned i = 0; i < threads; i++) m_workers.emplace_back([this]() {
+      work();
+    });
+  }
+  ~BlockCompressor() { stop(); }
+
+  void write(const char *data, size_t size) {
+    while (size > 0) {
+      const size_t count = std::min(size, m_blockSize - m_block.size());
+      m_block.append(data, count);
+      data += count;
+      size -= count;
+      if (m_block.size() == m_blockSize) submit();
+    }
+  }
+  bool finish() {
+    if (!m_block.empty()) submit();
+    while (!m_pending.empty()) writeFront();
+    stop();
+    return m_ok && m_out.good();
+  }
+
+ private:
+  struct Job {
+    std::string input;
+    std::string output;
+    bool done{false};
+    bool ok{false};
+  };
+
+  void submit() {
+    auto job = std::make_shared<Job>();
+    job->input.swap(m_block);
+    m_block.reserve(m_blockSize);
+    if (m_workers.empty()) {
+      job->ok = compress(*job);
+      job->done = true;
+      m_pending.push_back(job);
+      writeFront();
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_queue.push_back(job);
+      m_pending.push_back(job);
+    }
+    m_workAvailable.notify_one();
+    if (m_pending.size() >= m_window) writeFront();
+  }
+  void writeFront() {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      job = m_pending.front();
+      m_jobDone.wait(lock, [&job]() { return job->done; });
+      m_pending.pop_front();
+    }
+    m_ok = m_ok && job->ok;
+    m_out.write(job->output.data(), job->output.size());
+  }
+  void work() {
+    for (;;) {
+      std::shared_ptr<Job> job;
+      {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_workAvailable.wait(lock,
+                             [this]() { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) return;
+        job = m_queue.front();
+        m_queue.pop_front();
+      }
+      const bool ok = compress(*job);
+      {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        job->ok = ok;
+        job->done = true;
+      }
+      m_jobDone.notify_all();
+    }
+  }
+  bool compress(Job &job) const {
+    z_stream stream{};
+    // window bits + 16 for a gzip header and trailer
+    if (deflateInit2(&stream, m_level, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+      return false;
+    job.output.resize(deflateBound(&stream, job.input.size()));
+    stream.next_in = reinterpret_cast<Bytef *>(job.input.data());
+    stream.avail_in = static_cast<uInt>(job.input.size());
+    stream.next_out = reinterpret_cast<Bytef *>(job.output.data());
+    stream.avail_out = static_cast<uInt>(job.output.size());
+    const int status = deflate(&stream, Z_FINISH);
+    job.output.resize(stream.total_out);
+    deflateEnd(&stream);
+    std::string{}.swap(job.input);
+    return status == Z_STREAM_END;
+  }
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_stop = true;
+      m_queue.clear();
+    }
+    m_workAvailable.notify_all();
+    for (auto &worker : m_workers) worker.join();
+    m_workers.clear();
+  }
+
+  std::ostream &m_out;
+  const int m_level;
+  const size_t m_blockSize;
+  const size_t m_window;
+  std::string m_block;
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_workAvailable;
+  std::condition_variable m_jobDone;
+  std::deque<std::shared_ptr<Job>> m_queue;    // waiting for a worker
+  std::deque<std::shared_ptr<Job>> m_pending;  // waiting to be written
+  bool m_stop{false};
+  bool m_ok{true};
+};
+
+// Numeric header field: octal, or base-256 when the value doesn't fit (GNU)
+void tarNumber(char *field, size_t length, uint64_t value) {
+  if (value < (uint64_t{1} << (3 * (length - 1)))) {
+    snprintf(field, length, "%0*llo", static_cast<int>(length - 1),
+             static_cast<unsigned long long>(value));
+    return;
+  }
+  for (size_t i = length - 1; i > 0; i--) {
+    field[i] = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+  field[0] = static_cast<char>(0x80);
+}
+
+uint64_t tarNumber(const char *field, size_t length) {
+  uint64_t value{0};
+  if (static_cast<unsigned char>(field[0]) & 0x80) {
+    for (size_t i = 1; i < length; i++)
+      value = (value << 8) | static_cast<unsigned char>(field[i]);
+    return value;
+  }
+  for (size_t i = 0; i < length && field[i]; i++) {
+    if (field[i] >= '0' && field[i] <= '7') value = value * 8 + field[i] - '0';
+  }
+  return value;
+}
+
+std::array<char, tarBlock> tarHeader(const std::string &name, uint64_t size,
+                                     uint32_t mode, int64_t mtime, char type,
+                                     const std::string &link) {
+  std::array<char, tarBlock> header{};
+  std::memcpy(header.data(), name.data(), std::min<size_t>(name.size(), 100));
+  tarNumber(header.data() + 100, 8, mode);
+  tarNumber(header.data() + 108, 8, 0);
+  tarNumber(header.data() + 116, 8, 0);
+  tarNumber(header.data() + 124, 12, size);
+  tarNumber(header.data() + 136, 12, static_cast<uint64_t>(std::max<int64_t>(
+                                          mtime, 0)));
+  header[156] = type;
+  std::memcpy(header.data() + 157, link.data(),
+              std::min<size_t>(link.size(), 100));
+  std::memcpy(header.data() + 257, "ustar  ", 8);  // GNU format
+  std::memset(header.data() + 148, ' ', 8);
+  unsigned checksum{0};
+  for (char c : header) checksum += static_cast<unsigned char>(c);
+  snprintf(header.data() + 148, 8, "%06o", checksum);
+  return header;
+}
+
+// Headers of an entry, names too long for the header are written first in
+// GNU long name records
+std::string tarHeaders(const ScanEntry &entry, const std::string &link) {
+  std::string headers;
+  auto longName = [&headers](const std::string &value, char type) {
+    const auto header =
+        tarHeader("././@LongLink", value.size() + 1, 0644, 0, type, {});
+    headers.append(header.data(), header.size());
+    headers.append(value);
+    headers.append(tarBlock - value.size() % tarBlock, '\0');
+  };
+  if (link.size() > 100) longName(link, 'K');
+  if (entry.name.size() > 100) longName(entry.name, 'L');
+  char type{'0'};
+  uint64_t size{entry.size};
+  if (entry.type == fs::file_type::directory) {
+    type = '5';
+    size = 0;
+  } else if (entry.type == fs::file_type::symlink) {
+    type = '2';
+    size = 0;
+  }
+  const auto header =
+      tarHeader(entry.name, size, entry.mode, entry.mtime, type, link);
+  headers.append(header.data(), header.size());
+  return headers;
+}
+
+int64_t toTimeT(fs::file_time_type time) {
+  using namespace std::chrono;
+  const auto system = time_point_cast<system_clock::duration>(
+      time - fs::file_time_type::clock::now() + system_clock::now());
+  return system_clock::to_time_t(system);
+}
+
+// Identifies \a file cheaply when its name differs from the one looked for
+class FileMatcher {
+ public:
+  explicit FileMatcher(const fs::path &file)
+      : m_name(file.filename()), m_canonical(canonical(file)) {}
+  bool matches(const fs::path &path) const {
+    return path.filename() == m_name && canonical(path) == m_canonical;
+  }
+
+ private:
+  static fs::path canonical(const fs::path &path) {
+    std::error_code ec;
+    return fs::weakly_canonical(path, ec);
+  }
+  const fs::path m_name;
+  const fs::path m_canonical;
+};
+
+}  // namespace
+
+void ProjectArchive::addPath(const fs::path &path) { m_paths.push_back(path); }
+
+fs::path ProjectArchive::manifestPath(const fs::path &archive) {
+  return fs::path{archive.string() + ".manifest"};
+}
+
+ArchiveArtifact ProjectArchive::artifactType(const fs::path &file) {
+  static const std::map<std::string, ArchiveArtifact> extensions{
+      {".v", ArchiveSources},         {".sv", ArchiveSources},
+      {".vh", ArchiveSources},        {".svh", ArchiveSources},
+      {".vhd", ArchiveSources},       {".vhdl", ArchiveSources},
+      {".sdc", ArchiveSources},       {".pin", ArchiveSources},
+      {".pcf", ArchiveSources},       {".tcl", ArchiveSources},
+      {".ospr", ArchiveSources},      {".c", ArchiveSources},
+      {".cpp", ArchiveSources},       {".h", ArchiveSources},
+      {".blif", ArchiveSynthesis},    {".eblif", ArchiveSynthesis},
+      {".edif", ArchiveSynthesis},    {".edf", ArchiveSynthesis},
+      {".vqm", ArchiveSynthesis},     {".net", ArchivePlaceRoute},
+      {".place", ArchivePlaceRoute},  {".route", ArchivePlaceRoute},
+      {".sdf", ArchivePlaceRoute},    {".fasm", ArchiveBitstream},
+      {".bit", ArchiveBitstream},     {".bin", ArchiveBitstream},
+      {".cfgbit", ArchiveBitstream},  {".hex", ArchiveBitstream},
+      {".rpt", ArchiveReports},       {".html", ArchiveReports},
+      {".log", ArchiveLogs}};
+  // netlists written by the flow keep the source extension
+  const std::string stem = file.stem().string();
+  auto endsWith = [&stem](const std::string &suffix) {
+    return stem.size() >= suffix.size() &&
+           stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) ==
+               0;
+  };
+  if (endsWith("_post_synth")) return ArchiveSynthesis;
+  if (endsWith("_post_route")) return ArchivePlaceRoute;
+  std::string extension = file.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  auto it = extensions.find(extension);
+  return it == extensions.end() ? ArchiveOther : it->second;
+}
+
+std::vector<ArchiveEntry> ProjectArchive::readManifest(
+    const fs::path &manifest) {
+  std::vector<ArchiveEntry> entries;
+  std::ifstream stream{manifest};
+  std::string line;
+  if (!std::getline(stream, line) || line != manifestHeader) return entries;
+  while (std::getline(stream, line)) {
+    // hash, size, archive and path separated by tabs
+    ArchiveEntry entry;
+    size_t start{0};
+    std::array<std::string, 3> fields;
+    bool valid{true};
+    for (auto &field : fields) {
+      const size_t tab = line.find('\t', start);
+      if (tab == std::string::npos) {
+        valid = false;
+        break;
+      }
+      field = line.substr(start, tab - start);
+      start = tab + 1;
+    }
+    if (!valid) continue;
+    entry.hash = fields[0];
+    entry.size = std::strtoull(fields[1].c_str(), nullptr, 10);
+    entry.archive = fields[2];
+    entry.path = line.substr(start);
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+std::pair<bool, std::string> ProjectArchive::write(
+    const fs::path &archive, const ArchiveOptions &options) {
+  m_entries.clear();
+  const fs::path manifest = manifestPath(archive);
+  const std::string archiveName = archive.filename().string();
+
+  // Collect the entries first for the progress total
+  std::vector<ScanEntry> scan;
+  uint64_t total{0};
+  const FileMatcher archiveFile{archive};
+  const FileMatcher manifestFile{manifest};
+  for (const auto &root : m_paths) {
+    std::error_code ec;
+    if (!fs::exists(root, ec))
+      return {false, "Path " + root.string() + " doesn't exist"};
+    auto addEntry = [&](const fs::path &path, const std::string &name) {
+      const auto status = fs::symlink_status(path, ec);
+      if (ec) return;
+      if (archiveFile.matches(path) || manifestFile.matches(path)) return;
+      ScanEntry entry{path, name, status.type()};
+      if (entry.type == fs::file_type::regular) {
+        if ((artifactType(path) & options.artifacts) == 0) return;
+        entry.size = fs::file_size(path, ec);
+        if (ec) return;
+        total += entry.size;
+      } else if (entry.type == fs::file_type::directory) {
+        entry.name += '/';
+      } else if (entry.type != fs::file_type::symlink) {
+        return;
+      }
+      if (entry.type != fs::file_type::symlink) {
+        entry.mode = static_cast<uint32_t>(status.permissions()) & 0777;
+        entry.mtime = toTimeT(fs::last_write_time(path, ec));
+      }
+      scan.push_back(std::move(entry));
+    };
+    const std::string rootName = root.filename().string();
+    addEntry(root, rootName);
+    if (!fs::is_directory(root, ec)) continue;
+    for (auto it = fs::recursive_directory_iterator{
+             root, fs::directory_options::skip_permission_denied, ec};
+         it != fs::recursive_directory_iterator{}; it.increment(ec)) {
+      if (ec) break;
+      addEntry(it->path(),
+               rootName + "/" +
+                   it->path().lexically_relative(root).generic_string());
+    }
+  }
+  std::sort(scan.begin(), scan.end(),
+            [](const ScanEntry &left, const ScanEntry &right) {
+              return left.name < right.name;
+            });
+
+  std::map<std::string, ArchiveEntry> previous;
+  if (!options.previousManifest.empty()) {
+    for (auto &entry : readManifest(options.previousManifest))
+      previous.emplace(entry.path, std::move(entry));
+  }
+
+  std::ofstream out{archive, std::ios::binary | std::ios::trunc};
+  if (!out.good()) return {false, "Cannot open " + archive.string()};
+  unsigned threads = options.threads;
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  // one thread compresses inline
+  BlockCompressor compressor{out, threads > 1 ? threads : 0, options.level,
+                             options.blockSize};
+  auto cancelled = [&options]() {
+    return options.cancel && options.cancel->load();
+  };
+  auto abort = [&](const std::string &message) -> std::pair<bool, std::string> {
+    compressor.finish();
+    out.close();
+    std::error_code ec;
+    fs::remove(archive, ec);
+    return {false, message};
+  };
+
+  uint64_t done{0};
+  std::vector<char> buffer(readChunk);
+  for (const auto &entry : scan) {
+    if (cancelled()) return abort("Archiving cancelled");
+    std::string link;
+    if (entry.type == fs::file_type::symlink) {
+      std::error_code ec;
+      link = fs::read_symlink(entry.source, ec).generic_string();
+    }
+    if (entry.type == fs::file_type::regular) {
+      auto it = previous.find(entry.name);
+      if (it != previous.end() && it->second.size == entry.size &&
+          hashFile(entry.source, entry.size) == it->second.hash) {
+        m_entries.push_back(it->second);
+        done += entry.size;
+        if (options.progress) options.progress(done, total);
+        continue;
+      }
+    }
+    const std::string headers = tarHeaders(entry, link);
+    compressor.write(headers.data(), headers.size());
+    if (entry.type != fs::file_type::regular) continue;
+
+    // The header holds the size found by the scan: a file changing in the
+    // meantime is cut or padded to that size
+    std::ifstream stream{entry.source, std::ios::binary};
+    ContentHash hash;
+    uint64_t left{entry.size};
+    while (left > 0) {
+      if (cancelled()) return abort("Archiving cancelled");
+      size_t count{0};
+      if (stream) {
+        stream.read(buffer.data(), std::min<uint64_t>(left, buffer.size()));
+        count = static_cast<size_t>(stream.gcount());
+      }
+      if (count == 0) {
+        count = static_cast<size_t>(std::min<uint64_t>(left, buffer.size()));
+        std::fill_n(buffer.begin(), count, '\0');
+      }
+      hash.update(buffer.data(), count);
+      compressor.write(buffer.data(), count);
+      left -= count;
+      done += count;
+      if (options.progress) options.progress(done, total);
+    }
+    const size_t padding = (tarBlock - entry.size % tarBlock) % tarBlock;
+    if (padding != 0) {
+      std::fill_n(buffer.begin(), padding, '\0');
+      compressor.write(buffer.data(), padding);
+    }
+    m_entries.push_back({entry.name, entry.size, hash.value(), archiveName});
+  }
+  // end of archive
+  std::fill_n(buffer.begin(), 2 * tarBlock, '\0');
+  compressor.write(buffer.data(), 2 * tarBlock);
+  if (!compressor.finish()) return abort("Cannot write " + archive.string());
+  out.close();
+
+  std::ofstream manifestStream{manifest, std::ios::trunc};
+  manifestStream << manifestHeader << "\n";
+  for (const auto &entry : m_entries) {
+    manifestStream << entry.hash << "\t" << entry.size << "\t"
+                   << entry.archive << "\t" << entry.path << "\n";
+  }
+  if (!manifestStream.good())
+    return {false, "Cannot write " + manifest.string()};
+  return {true, {}};
+}
+
+std::pair<bool, std::string> ProjectArchive::verify(const fs::path &archive) {
+  const std::string archiveName = archive.filename().string();
+  std::map<std::string, ArchiveEntry> expected;
+  for (auto &entry : readManifest(manifestPath(archive))) {
+    if (entry.archive == archiveName)
+      expected.emplace(entry.path, std::move(entry));
+  }
+  gzFile file = gzopen(archive.string().c_str(), "rb");
+  if (!file) return {false, "Cannot open " + archive.string()};
+  std::unique_ptr<gzFile_s, int (*)(gzFile)> closer{file, gzclose};
+  auto readExactly = [file](char *data, size_t size) {
+    while (size > 0) {
+      const int count = gzread(
+          file, data, static_cast<unsigned>(std::min<size_t>(size, readChunk)));
+      if (count <= 0) return false;
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+    return true;
+  };
+
+  std::set<std::string> found;
+  std::vector<char> buffer(readChunk);
+  std::array<char, tarBlock> header{};
+  std::string longName;
+  for (;;) {
+    if (!readExactly(header.data(), header.size()))
+      return {false, "Unexpected end of " + archive.string()};
+    if (std::all_of(header.begin(), header.end(),
+                    [](char c) { return c == '\0'; }))
+      break;
+    const char type = header[156];
+    const uint64_t size = tarNumber(header.data() + 124, 12);
+    std::string name = longName.empty()
+                           ? std::string{header.data(),
+                                         strnlen(header.data(), 100)}
+                           : longName;
+    if (type != 'L') longName.clear();
+    ContentHash hash;
+    std::string content;
+    uint64_t left{size + (tarBlock - size % tarBlock) % tarBlock};
+    uint64_t data{size};
+    while (left > 0) {
+      const size_t count =
+          static_cast<size_t>(std::min<uint64_t>(left, buffer.size()));
+      if (!readExactly(buffer.data(), count))
+        return {false, "Unexpected end of " + archive.string()};
+      const size_t used = static_cast<size_t>(std::min<uint64_t>(data, count));
+      if (type == 'L' || type == 'K') content.append(buffer.data(), used);
+      hash.update(buffer.data(), used);
+      data -= used;
+      left -= count;
+    }
+    if (type == 'L') {
+      longName = content.c_str();
+      continue;
+    }
+    if (type != '0' && type != '\0') continue;
+    auto it = expected.find(name);
+    if (it == expected.end()) return {false, name + " is not in the manifest"};
+    if (it->second.size != size || it->second.hash != hash.value())
+      return {false, name + " doesn't match its hash"};
+    found.insert(name);
+  }
+  for (const auto &[path, entry] : expected) {
+    if (found.count(path) == 0) return {false, path + " is missing"};
+  }
+  return {true, {}};
+}
+
+}  // namespace FOEDAG
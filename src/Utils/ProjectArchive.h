@@ -0,0 +1,101 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace FOEDAG {
+
+// Kind of project file, used to select what goes in an archive
+enum ArchiveArtifact : uint32_t {
+  ArchiveSources = 1 << 0,     // project, design sources and constraints
+  ArchiveSynthesis = 1 << 1,   // synthesized netlists
+  ArchivePlaceRoute = 1 << 2,  // packing, placement and routing results
+  ArchiveBitstream = 1 << 3,   // bitstream and configuration files
+  ArchiveReports = 1 << 4,
+  ArchiveLogs = 1 << 5,
+  ArchiveOther = 1 << 6,
+  ArchiveAll = (1 << 7) - 1
+};
+
+struct ArchiveOptions {
+  uint32_t artifacts{ArchiveAll};
+  // compression threads, 0 to use all cores
+  unsigned threads{0};
+  int level{6};
+  // input is compressed in blocks of this size, one gzip member each
+  size_t blockSize{1024 * 1024};
+  // manifest of a previous archive: files it holds unchanged are not stored
+  // again, the new manifest points to the archive holding them
+  std::filesystem::path previousManifest{};
+  // bytes processed and total bytes, called from the calling thread
+  std::function<void(uint64_t done, uint64_t total)> progress{};
+  const std::atomic<bool>* cancel{nullptr};
+};
+
+struct ArchiveEntry {
+  std::string path;  // path in the archive
+  uint64_t size{0};
+  std::string hash;     // content hash
+  std::string archive;  // file name of the archive holding the content
+};
+
+/*!
+ * \brief The ProjectArchive class writes a .tar.gz of project folders without
+ * external tools. Compression runs on several threads: the tar stream is cut
+ * in blocks compressed independently and written as consecutive gzip
+ * members, which any gzip reader decodes as one stream. Next to the archive a
+ * manifest lists the content hash of every file, it is used to verify the
+ * archive and to leave out unchanged files from the next one.
+ */
+class ProjectArchive {
+ public:
+  // \a path is stored in the archive under its file name
+  void addPath(const std::filesystem::path& path);
+  std::pair<bool, std::string> write(const std::filesystem::path& archive,
+                                     const ArchiveOptions& options = {});
+  // entries of the last archive written, unchanged files included
+  const std::vector<ArchiveEntry>& entries() const { return m_entries; }
+
+  /*!
+   * \brief verify reads \a archive back and checks the files it holds against
+   * its manifest.
+   */
+  static std::pair<bool, std::string> verify(
+      const std::filesystem::path& archive);
+  static std::filesystem::path manifestPath(
+      const std::filesystem::path& archive);
+  static std::vector<ArchiveEntry> readManifest(
+      const std::filesystem::path& manifest);
+  static ArchiveArtifact artifactType(const std::filesystem::path& file);
+
+ private:
+  std::vector<std::filesystem::path> m_paths;
+  std::vector<ArchiveEntry> m_entries;
+};
+
+}  // namespace FOEDAG
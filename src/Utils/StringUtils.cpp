@@ -50,6 +50,19 @@ void StringUtils::tokenize(std::string_view str, std::string_view separator,
   }
 }
 
+void StringUtils::tokenize(std::string_view str, std::string_view separator,
+                           std::vector<std::string_view>& result,
+                           bool skipEmpty) {
+  std::string_view::size_type pos{0};
+  std::string_view::size_type n = str.find(separator, pos);
+  while (n != std::string_view::npos) {
+    if (!(n == pos && skipEmpty)) result.push_back(str.substr(pos, n - pos));
+    pos = n + separator.size();
+    n = str.find(separator, pos);
+  }
+  if (pos < str.size()) result.push_back(str.substr(pos));
+}
+
 std::vector<std::string> StringUtils::tokenize(std::string_view str,
                                                std::string_view separator,
                                                bool skipEmpty) {
@@ -55,6 +55,10 @@ class StringUtils final {
   static std::vector<std::string> tokenize(std::string_view str,
                                            std::string_view separator,
                                            bool skipEmpty = true);
+  // Same as above without copies, the tokens refer to the input string.
+  static void tokenize(std::string_view str, std::string_view separator,
+                       std::vector<std::string_view>& result,
+                       bool skipEmpty = true);
 
   // return true if 'strings' contains 'str' otherwise return false
   template <class Container, class Value>
@@ -0,0 +1,228 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Tracer.h"
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace FOEDAG {
+
+std::atomic<bool> Tracer::m_enabled{false};
+std::atomic<uint64_t> Tracer::m_session{0};
+
+namespace {
+
+struct TraceEvent {
+  char phase{};
+  uint64_t timestamp{};  // us since session start
+  const char *category{nullptr};
+  std::string name;
+};
+
+// Events are appended by the owning thread only. 'size' is published after
+// the event is written so the exporting thread reads complete events.
+struct TraceChunk {
+  static constexpr size_t capacity{1024};
+  std::array<TraceEvent, capacity> events;
+  std::atomic<size_t> size{0};
+  std::atomic<TraceChunk *> next{nullptr};
+};
+
+struct TraceBuffer {
+  explicit TraceBuffer(uint64_t s, uint32_t t)
+      : session(s), tid(t), head(new TraceChunk), tail(head) {}
+  ~TraceBuffer() {
+    while (head) {
+      auto next = head->next.load();
+      delete head;
+      head = next;
+    }
+  }
+  void append(char phase, uint64_t timestamp, const char *category,
+              std::string_view name) {
+    size_t size = tail->size.load(std::memory_order_relaxed);
+    if (size == TraceChunk::capacity) {
+      auto chunk = new TraceChunk;
+      tail->next.store(chunk, std::memory_order_release);
+      tail = chunk;
+      size = 0;
+    }
+    auto &event = tail->events[size];
+    event.phase = phase;
+    event.timestamp = timestamp;
+    event.category = category;
+    event.name.assign(name.data(), name.size());
+    tail->size.store(size + 1, std::memory_order_release);
+  }
+  const uint64_t session;
+  const uint32_t tid;
+  TraceChunk *head;
+  TraceChunk *tail;  // writer only
+};
+
+struct TraceSession {
+  std::mutex mutex;  // guards buffers, not taken while recording
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  std::atomic<std::chrono::steady_clock::rep> start{0};
+  uint32_t nextTid{1};
+};
+
+TraceSession &traceSession() {
+  static TraceSession session{};
+  return session;
+}
+
+TraceBuffer *threadBuffer(uint64_t session) {
+  thread_local std::shared_ptr<TraceBuffer> buffer;
+  if (!buffer || buffer->session != session) {
+    auto &s = traceSession();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    buffer = std::make_shared<TraceBuffer>(session, s.nextTid++);
+    // a session started meanwhile, this buffer will not be exported
+    if (session == Tracer::session()) s.buffers.push_back(buffer);
+  }
+  return buffer.get();
+}
+
+uint64_t now() {
+  const std::chrono::steady_clock::duration since{
+      std::chrono::steady_clock::now().time_since_epoch().count() -
+      traceSession().start.load(std::memory_order_relaxed)};
+  if (since.count() < 0) return 0;
+  return std::chrono::duration_cast<std::chrono::microseconds>(since).count();
+}
+
+void writeEscaped(std::ostream &out, const std::string &str) {
+  static const char *hex = "0123456789abcdef";
+  for (unsigned char c : str) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (c < 0x20)
+          out << "\\u00" << hex[c >> 4] << hex[c & 0xF];
+        else
+          out << c;
+    }
+  }
+}
+
+}  // namespace
+
+void Tracer::start() {
+  auto &s = traceSession();
+  std::lock_guard<std::mutex> lock{s.mutex};
+  m_enabled.store(false);
+  s.buffers.clear();
+  s.nextTid = 1;
+  s.start.store(std::chrono::steady_clock::now().time_since_epoch().count());
+  m_session.fetch_add(1, std::memory_order_acq_rel);
+  m_enabled.store(true);
+}
+
+bool Tracer::stop(const std::filesystem::path &file, std::string &error) {
+  m_enabled.store(false);
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  {
+    auto &s = traceSession();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    buffers = s.buffers;
+  }
+  std::ofstream out{file};
+  if (!out.is_open()) {
+    error = "Cannot open trace file " + file.string();
+    return false;
+  }
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first{true};
+  for (const auto &buffer : buffers) {
+    for (auto chunk = buffer->head; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      const size_t size = chunk->size.load(std::memory_order_acquire);
+      for (size_t i = 0; i < size; i++) {
+        const auto &event = chunk->events[i];
+        out << (first ? "\n" : ",\n") << "{\"ph\":\"" << event.phase
+            << "\",\"cat\":\"" << event.category << "\",\"name\":\"";
+        writeEscaped(out, event.name);
+        out << "\",\"ts\":" << event.timestamp << ",\"pid\":1,\"tid\":"
+            << buffer->tid << "}";
+        first = false;
+      }
+    }
+  }
+  out << "\n]}\n";
+  out.close();
+  if (!out) {
+    error = "Failed to write trace file " + file.string();
+    return false;
+  }
+  return true;
+}
+
+void Tracer::begin(const char *category, std::string_view name) {
+  if (!isEnabled()) return;
+  threadBuffer(session())->append('B', now(), category, name);
+}
+
+void Tracer::end(const char *category) {
+  if (!isEnabled()) return;
+  threadBuffer(session())->append('E', now(), category, {});
+}
+
+uint64_t Tracer::eventCount() {
+  auto &s = traceSession();
+  std::lock_guard<std::mutex> lock{s.mutex};
+  uint64_t count{0};
+  for (const auto &buffer : s.buffers) {
+    for (auto chunk = buffer->head; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire))
+      count += chunk->size.load(std::memory_order_acquire);
+  }
+  return count;
+}
+
+TraceScope::TraceScope(const char *category, std::string_view name) {
+  if (!Tracer::isEnabled()) return;
+  m_category = category;
+  m_session = Tracer::session();
+  Tracer::begin(category, name);
+}
+
+TraceScope::~TraceScope() {
+  if (m_session != 0 && m_session == Tracer::session())
+    Tracer::end(m_category);
+}
+
+}  // namespace FOEDAG
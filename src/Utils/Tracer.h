@@ -0,0 +1,95 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace FOEDAG {
+
+/*!
+ * \brief The Tracer class records begin/end events of flow spans and
+ * exports them as Chrome trace-event JSON (chrome://tracing, Perfetto).
+ * Each thread appends to its own buffer without locking, buffers are only
+ * read by stop(). When tracing is off, recording costs one atomic load.
+ */
+class Tracer {
+ public:
+  /*!
+   * \brief start drops events of the previous session and enables tracing.
+   */
+  static void start();
+
+  /*!
+   * \brief stop disables tracing and writes the recorded events to \a file.
+   * \return false and \a error if the file cannot be written.
+   */
+  static bool stop(const std::filesystem::path &file, std::string &error);
+
+  static bool isEnabled() {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief begin/end record a span on the calling thread. \a category must
+   * be a string literal. Spans must be properly nested per thread.
+   */
+  static void begin(const char *category, std::string_view name);
+  static void end(const char *category);
+
+  /*!
+   * \brief session counts start() calls, a span ended in another session
+   * than it began is dropped.
+   */
+  static uint64_t session() {
+    return m_session.load(std::memory_order_acquire);
+  }
+
+  /*!
+   * \brief eventCount number of events recorded in the current session.
+   */
+  static uint64_t eventCount();
+
+ private:
+  static std::atomic<bool> m_enabled;
+  static std::atomic<uint64_t> m_session;
+};
+
+/*!
+ * \brief The TraceScope class records a span for the lifetime of the
+ * object.
+ */
+class TraceScope {
+ public:
+  TraceScope(const char *category, std::string_view name);
+  ~TraceScope();
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+ private:
+  const char *m_category{nullptr};
+  uint64_t m_session{0};
+};
+
+}  // namespace FOEDAG
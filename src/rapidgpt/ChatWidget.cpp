@@ -58,10 +58,19 @@ void ChatWidget::keyPressEvent(QKeyEvent *event) {
     buttonClicked();
     return;
   }
+  if (event->key() == Qt::Key_Escape && !m_enable) {
+    emit stopRequested();
+    return;
+  }
   QWidget::keyPressEvent(event);
 }
 
 void ChatWidget::buttonClicked() {
+  // the button stops the answer while it comes
+  if (!m_enable) {
+    emit stopRequested();
+    return;
+  }
   auto text = ui->textEdit->toPlainText();
   if (!text.isEmpty()) {
     ui->textEdit->clear();
@@ -119,6 +128,17 @@ void ChatWidget::addMessage(const Message &message) {
           });
 }
 
+void ChatWidget::appendToLast(const QString &text) {
+  if (!m_widgets.isEmpty()) m_widgets.last()->appendText(text);
+}
+
+void ChatWidget::updateLast(const Message &message) {
+  if (!m_widgets.isEmpty()) {
+    m_widgets.last()->setText(message.content);
+    m_widgets.last()->setDelay(message.delay);
+  }
+}
+
 void ChatWidget::clear() {
   qDeleteAll(m_widgets);
   m_widgets.clear();
@@ -143,7 +163,9 @@ void ChatWidget::removeAt(int index) {
 void ChatWidget::setEnableToSend(bool enable) {
   m_enable = enable;
   ui->textEdit->setEnabled(enable);
-  ui->toolButtonSend->setEnabled(enable);
+  ui->toolButtonSend->setIcon(
+      QIcon{enable ? ":/images/message.png" : ":/images/stop.png"});
+  ui->toolButtonSend->setToolTip(enable ? QString{} : "Stop");
   ui->toolButtonDeleteAll->setEnabled(enable);
 }
 
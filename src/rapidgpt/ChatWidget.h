@@ -40,6 +40,9 @@ class ChatWidget : public QWidget {
   explicit ChatWidget(QWidget *parent = nullptr);
   ~ChatWidget() override;
   void addMessage(const Message &message);
+  // streaming answer goes to the last message
+  void appendToLast(const QString &text);
+  void updateLast(const Message &message);
   void clear();
 
   int count() const;
@@ -53,6 +56,7 @@ class ChatWidget : public QWidget {
   void cleanHistory();
   void regenerateLast();
   void removeMessageAt(int index);
+  void stopRequested();
 
  protected:
   void keyPressEvent(QKeyEvent *event) override;
@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDateTime>
 #include <QPainter>
 #include <QStyleOption>
+#include <QTextCursor>
 
 #include "ui_MessageOutput.h"
 
@@ -51,9 +52,7 @@ MessageOutput::MessageOutput(const Message &message, QWidget *parent)
 )");
 
   ui->labelTime->setText(message.date);
-  if (message.delay != 0)
-    ui->labelDelay->setText(
-        QString{"%1 Sec"}.arg(QString::number(message.delay, 'g', 3)));
+  setDelay(message.delay);
   ui->labelUser->setText(message.role);
   connect(ui->toolButtonDelete, &QToolButton::clicked, this,
           [this]() { emit buttonPressed(ButtonFlag::Delete); });
@@ -69,6 +68,22 @@ MessageOutput::~MessageOutput() { delete ui; }
 
 QString MessageOutput::text() const { return ui->labelText->toPlainText(); }
 
+void MessageOutput::setText(const QString &text) {
+  ui->labelText->setText(text);
+}
+
+void MessageOutput::appendText(const QString &text) {
+  QTextCursor cursor{ui->labelText->document()};
+  cursor.movePosition(QTextCursor::End);
+  cursor.insertText(text);
+}
+
+void MessageOutput::setDelay(double delay) {
+  if (delay != 0)
+    ui->labelDelay->setText(
+        QString{"%1 Sec"}.arg(QString::number(delay, 'g', 3)));
+}
+
 void MessageOutput::setButtonFlags(ButtonFlags flags) {
   m_buttonFlags = flags;
   ui->toolButtonEdit->setVisible((flags & ButtonFlag::Edit) != 0);
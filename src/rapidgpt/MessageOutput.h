@@ -40,6 +40,9 @@ class MessageOutput : public QWidget {
   explicit MessageOutput(const Message &message, QWidget *parent = nullptr);
   ~MessageOutput() override;
   QString text() const;
+  void setText(const QString &text);
+  void appendText(const QString &text);
+  void setDelay(double delay);
 
   void setButtonFlags(ButtonFlags flags);
 
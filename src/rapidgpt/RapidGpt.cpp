@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "RapidGpt.h"
 
+#include <QEventLoop>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -28,6 +29,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QMessageBox>
 
 #include "ChatWidget.h"
+#include "RapidGptCache.h"
 #include "RapidGptConnection.h"
 #include "Utils/FileUtils.h"
 #include "Utils/QtUtils.h"
@@ -43,7 +45,8 @@ RapidGpt::RapidGpt(const RapidGptSettings &settings,
     : QObject(parent),
       m_chatWidget(new ChatWidget),
       m_path(projectPath),
-      m_settings(settings) {
+      m_settings(settings),
+      m_cacheDir(RapidGptCache::defaultDir()) {
   connect(m_chatWidget, &ChatWidget::userText, this, &RapidGpt::sendUserText);
   connect(m_chatWidget, &ChatWidget::cleanHistory, this,
           &RapidGpt::cleanCurrentHistory);
@@ -51,6 +54,8 @@ RapidGpt::RapidGpt(const RapidGptSettings &settings,
           &RapidGpt::regenerateLast);
   connect(m_chatWidget, &ChatWidget::removeMessageAt, this,
           &RapidGpt::removeMessageAt);
+  connect(m_chatWidget, &ChatWidget::stopRequested, this,
+          &RapidGpt::cancelRequest);
   loadFromFile();
 }
 
@@ -65,7 +70,10 @@ void RapidGpt::setProjectPath(const std::filesystem::path &projectPath) {
   loadFromFile();
 }
 
+void RapidGpt::setCacheDir(const QString &dir) { m_cacheDir = dir; }
+
 void RapidGpt::fileContext(const QString &file) {
+  cancelRequest();
   m_chatWidget->clear();
   m_chatWidget->setEnableIncognitoMode(file.isEmpty());
   RapidGptContext context;
@@ -111,7 +119,7 @@ void RapidGpt::flush() {
 
 void RapidGpt::sendUserText(const QString &text) {
   m_chatWidget->addMessage({text, User, currentDate(), 0.0});
-  sendRapidGpt(text);
+  startRequest(text, true);
 }
 
 void RapidGpt::cleanCurrentHistory() {
@@ -145,7 +153,8 @@ void RapidGpt::regenerateLast() {
       flush();
     }
     auto lastUserMessage = m_files[m_currectFile].messages.takeLast();
-    sendRapidGpt(lastUserMessage.content);
+    // new answer is requested, the cached one is not used
+    startRequest(lastUserMessage.content, false);
   }
 }
 
@@ -218,26 +227,70 @@ QString RapidGpt::buildPath(const QString &relativePath) const {
 }
 
 bool RapidGpt::sendRapidGpt(const QString &text) {
-  auto result{true};
+  if (!startRequest(text, true)) return false;
+  bool result{false};
+  QEventLoop loop;
+  connect(this, &RapidGpt::requestFinished, &loop, [&loop, &result](bool ok) {
+    result = ok;
+    loop.quit();
+  });
+  loop.exec();
+  return result;
+}
+
+bool RapidGpt::startRequest(const QString &text, bool useCache) {
+  cancelRequest();
   m_errorString.clear();
+  m_answerShown = false;
   m_files[m_currectFile].messages.append({text, User, currentDate(), 0.0});
-  RapidGptConnection rapidGpt{m_settings};
-  RapidGptContext tmpContext = compileContext();
-  bool ok = rapidGpt.send(tmpContext);
+  if (m_connection) m_connection->deleteLater();
+  m_connection = new RapidGptConnection{m_settings, this};
+  // incognito chats are not kept, so their answers are not cached either
+  m_connection->setCacheDir(isIncognitoMode() ? QString{} : m_cacheDir);
+  connect(m_connection, &RapidGptConnection::textReceived, this,
+          &RapidGpt::answerText);
+  connect(m_connection, &RapidGptConnection::finished, this,
+          &RapidGpt::answerFinished);
+  if (!m_connection->start(compileContext(), useCache)) {
+    answerFinished(false);
+    return false;
+  }
+  return true;
+}
+
+void RapidGpt::cancelRequest() {
+  if (m_connection) m_connection->cancel();
+}
+
+void RapidGpt::answerText(const QString &text) {
+  if (!m_answerShown) {
+    m_chatWidget->addMessage({text, RapidGPT, currentDate(), 0.0});
+    m_answerShown = true;
+  } else {
+    m_chatWidget->appendToLast(text);
+  }
+}
+
+void RapidGpt::answerFinished(bool ok) {
   if (ok) {
-    auto res = rapidGpt.responseString();
-    Message m = {res, RapidGPT, currentDate(), rapidGpt.delay()};
-    m_chatWidget->addMessage(m);
+    Message m = {m_connection->responseString(), RapidGPT, currentDate(),
+                 m_connection->delay()};
+    if (m_answerShown)
+      m_chatWidget->updateLast(m);
+    else
+      m_chatWidget->addMessage(m);
     m_files[m_currectFile].messages.push_back(m);
     flush();
   } else {
-    m_errorString = rapidGpt.errorString();
-    if (m_showError)
+    // partial answer is dropped, the question stays to be regenerated
+    if (m_answerShown) m_chatWidget->removeAt(m_chatWidget->count() - 1);
+    m_errorString = m_connection->errorString();
+    if (m_showError && !m_connection->isCanceled())
       QMessageBox::critical(m_chatWidget, "Error", m_errorString);
-    result = false;
   }
+  m_answerShown = false;
   m_chatWidget->setEnableToSend(true);
-  return result;
+  emit requestFinished(ok);
 }
 
 QString RapidGpt::errorString() const { return m_errorString; }
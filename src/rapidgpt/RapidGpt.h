@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 namespace FOEDAG {
 
 class ChatWidget;
+class RapidGptConnection;
 class RapidGpt : public QObject {
   Q_OBJECT
 
@@ -42,21 +43,30 @@ class RapidGpt : public QObject {
   void setSettings(const RapidGptSettings &settings);
 
   void setProjectPath(const std::filesystem::path &projectPath);
+  // blocks until the answer is complete
   bool sendRapidGpt(const QString &text);
   QString errorString() const;
   void setShowError(bool showError);
   bool isIncognitoMode() const;
+  void setCacheDir(const QString &dir);
+
+ signals:
+  void requestFinished(bool ok);
 
  public slots:
   void fileContext(const QString &file);
+  void cancelRequest();
 
  private slots:
   void sendUserText(const QString &text);
   void cleanCurrentHistory();
   void regenerateLast();
   void removeMessageAt(int index);
+  void answerText(const QString &text);
+  void answerFinished(bool ok);
 
  private:
+  bool startRequest(const QString &text, bool useCache);
   void flush();
   QString GetFileContent() const;
   static QString currentDate();
@@ -74,6 +84,9 @@ class RapidGpt : public QObject {
   RapidGptSettings m_settings{};
   bool m_showError{true};
   QString m_errorString{};
+  QString m_cacheDir{};
+  RapidGptConnection *m_connection{nullptr};
+  bool m_answerShown{false};
 };
 
 }  // namespace FOEDAG
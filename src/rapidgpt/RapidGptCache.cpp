@@ -0,0 +1,104 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RapidGptCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+static const char *cacheFileSuffix{".rapidgpt"};
+
+namespace FOEDAG {
+
+RapidGptCache::RapidGptCache(const QString &dir) : m_dir(dir) {}
+
+void RapidGptCache::setDir(const QString &dir) { m_dir = dir; }
+
+QString RapidGptCache::dir() const { return m_dir; }
+
+bool RapidGptCache::isEnabled() const { return !m_dir.isEmpty(); }
+
+QString RapidGptCache::key(const QByteArray &request) {
+  return QString::fromLatin1(
+      QCryptographicHash::hash(request, QCryptographicHash::Sha256).toHex());
+}
+
+bool RapidGptCache::find(const QString &key, QString &response) const {
+  if (!isEnabled()) return false;
+  QFile file{filePath(key)};
+  if (!file.open(QFile::ReadOnly)) return false;
+  response = QString::fromUtf8(file.readAll());
+  return true;
+}
+
+bool RapidGptCache::insert(const QString &key, const QString &response) const {
+  if (!isEnabled()) return false;
+  if (!QDir{}.mkpath(m_dir)) return false;
+  // the file is replaced only once it is written completely
+  QSaveFile file{filePath(key)};
+  if (!file.open(QFile::WriteOnly)) return false;
+  file.write(response.toUtf8());
+  if (!file.commit()) return false;
+  prune();
+  return true;
+}
+
+void RapidGptCache::clear() const {
+  if (!isEnabled()) return;
+  QDir dir{m_dir};
+  const auto files =
+      dir.entryList({QString{"*"} + cacheFileSuffix}, QDir::Files);
+  for (const auto &file : files) dir.remove(file);
+}
+
+void RapidGptCache::setLimits(int maxEntries, int maxAgeDays) {
+  m_maxEntries = maxEntries;
+  m_maxAgeDays = maxAgeDays;
+}
+
+QString RapidGptCache::defaultDir() {
+  auto location =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (location.isEmpty()) return {};
+  return QDir{location}.filePath("rapidgpt");
+}
+
+QString RapidGptCache::filePath(const QString &key) const {
+  return QDir{m_dir}.filePath(key + cacheFileSuffix);
+}
+
+void RapidGptCache::prune() const {
+  QDir dir{m_dir};
+  // newest first
+  const auto files = dir.entryInfoList({QString{"*"} + cacheFileSuffix},
+                                       QDir::Files, QDir::Time);
+  const auto oldest = QDateTime::currentDateTime().addDays(-m_maxAgeDays);
+  for (int i = 0; i < files.size(); i++) {
+    if (i >= m_maxEntries || files.at(i).lastModified() < oldest)
+      QFile::remove(files.at(i).absoluteFilePath());
+  }
+}
+
+}  // namespace FOEDAG
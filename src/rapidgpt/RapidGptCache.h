@@ -0,0 +1,63 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+namespace FOEDAG {
+
+/*
+  On-disk cache of RapidGPT answers. An answer is stored in a file named
+  after the SHA-256 of the request, so the same prompt in the same context
+  with the same settings is answered without a round trip to the server.
+  Each insert removes answers older than the age limit and the oldest ones
+  beyond the entry limit.
+*/
+class RapidGptCache {
+ public:
+  explicit RapidGptCache(const QString &dir = {});
+
+  void setDir(const QString &dir);
+  QString dir() const;
+  // cache is disabled without a directory
+  bool isEnabled() const;
+
+  static QString key(const QByteArray &request);
+  bool find(const QString &key, QString &response) const;
+  bool insert(const QString &key, const QString &response) const;
+  void clear() const;
+  void setLimits(int maxEntries, int maxAgeDays);
+
+  // default location in the user cache directory
+  static QString defaultDir();
+
+ private:
+  QString filePath(const QString &key) const;
+  void prune() const;
+
+ private:
+  QString m_dir{};
+  int m_maxEntries{500};
+  int m_maxAgeDays{30};
+};
+
+}  // namespace FOEDAG
@@ -27,49 +27,103 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QUrl>
-#include <chrono>
+
+#include "RapidGptStreamParser.h"
 
 constexpr uint limit{32 * 1024};
-using Time = std::chrono::high_resolution_clock;
-using ms = std::chrono::milliseconds;
 
 // TODO unicode support
 
 namespace FOEDAG {
 
-RapidGptConnection::RapidGptConnection(const RapidGptSettings& settings)
-    : m_settings(settings), m_networkManager(new QNetworkAccessManager(this)) {
-  connect(m_networkManager, &QNetworkAccessManager::finished, this,
-          &RapidGptConnection::reply);
+RapidGptConnection::RapidGptConnection(const RapidGptSettings& settings,
+                                       QObject* parent)
+    : QObject(parent),
+      m_settings(settings),
+      m_networkManager(new QNetworkAccessManager(this)) {
   m_networkManager->setTransferTimeout();  // 30 sec
 }
 
-bool RapidGptConnection::send(const RapidGptContext& context) {
-  if (context.messages.count() == 0) return false;
-  if (m_settings.key.isEmpty()) {
-    m_errorString = "API Key is empty";
-    return false;
+RapidGptConnection::~RapidGptConnection() {
+  if (m_reply) {
+    m_reply->disconnect(this);
+    m_reply->abort();
   }
-  if (!validateUserInput(context)) {
-    m_errorString =
-        "File size exceeds limit\nThe selected file is too large. Please "
-        "choose a file that is not bigger than 32kB.";
+}
+
+bool RapidGptConnection::send(const RapidGptContext& context) {
+  bool result{false};
+  auto connection = connect(this, &RapidGptConnection::finished, this,
+                            [this, &result](bool ok) {
+                              result = ok;
+                              m_eventLoop.quit();
+                            });
+  if (start(context) && m_running) m_eventLoop.exec();
+  disconnect(connection);
+  return result;
+}
+
+bool RapidGptConnection::start(const RapidGptContext& context,
+                               bool useCache) {
+  if (m_running) {
+    m_errorString = "Request is in progress";
     return false;
   }
+  if (!validate(context)) return false;
   m_errorString.clear();
   m_response.clear();
-  QUrl url = QUrl(this->url());
-  QNetworkRequest req(url);
-  req.setRawHeader("Accept", "application/json");
+  m_delay = 0;
+  m_canceled = false;
+  m_running = true;
+  const uint request = ++m_request;
+  m_timer.start();
+
+  QByteArray body = toByteArray(context);
+  m_cacheKey = RapidGptCache::key(cacheRequest(body));
+  QString cached;
+  if (useCache && m_cache.find(m_cacheKey, cached)) {
+    // deliver it the same way as an answer from the server
+    QMetaObject::invokeMethod(
+        this,
+        [this, request, cached]() {
+          if (!m_running || request != m_request) return;
+          appendText(cached);
+          complete(true);
+        },
+        Qt::QueuedConnection);
+    return true;
+  }
+
+  QNetworkRequest req(QUrl{url()});
+  req.setRawHeader("Accept", "text/event-stream, application/json");
   req.setRawHeader("Content-Type", "application/json");
-  auto start = Time::now();
-  m_networkManager->post(req, toByteArray(context));
-  int res = m_eventLoop.exec();
-  auto end = Time::now();
-  auto fs = end - start;
-  ms d = std::chrono::duration_cast<ms>(fs);
-  m_delay = static_cast<double>(d.count()) / 1000.0;
-  return res == 0;
+  m_parser.reset();
+  m_reply = m_networkManager->post(req, body);
+  connect(m_reply, &QNetworkReply::readyRead, this,
+          &RapidGptConnection::readReply);
+  connect(m_reply, &QNetworkReply::finished, this, &RapidGptConnection::reply);
+  return true;
+}
+
+void RapidGptConnection::cancel() {
+  if (!m_running) return;
+  if (m_reply) {
+    auto reply = m_reply;
+    m_reply = nullptr;
+    reply->disconnect(this);
+    reply->abort();
+    reply->deleteLater();
+  }
+  m_canceled = true;
+  complete(false, "Canceled");
+}
+
+bool RapidGptConnection::isRunning() const { return m_running; }
+
+bool RapidGptConnection::isCanceled() const { return m_canceled; }
+
+void RapidGptConnection::setCacheDir(const QString& dir) {
+  m_cache.setDir(dir);
 }
 
 QString RapidGptConnection::errorString() const { return m_errorString; }
@@ -78,18 +132,36 @@ QString RapidGptConnection::responseString() const { return m_response; }
 
 double RapidGptConnection::delay() const { return m_delay; }
 
-void RapidGptConnection::reply(QNetworkReply* r) {
+void RapidGptConnection::readReply() {
+  if (!m_reply) return;
+  // error pages are not a part of the answer
+  if (m_reply->error() != QNetworkReply::NoError) return;
+  if (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() >=
+      400)
+    return;
+  if (!m_parser) {
+    m_parser = std::make_unique<RapidGptStreamParser>(
+        RapidGptStreamParser::formatFromContentType(
+            m_reply->rawHeader("Content-Type")));
+  }
+  appendText(m_parser->feed(m_reply->readAll()));
+}
+
+void RapidGptConnection::reply() {
+  if (!m_reply) return;
+  auto r = m_reply;
   if (r->error() != QNetworkReply::NoError) {
-    m_errorString = r->errorString();
-    m_eventLoop.exit(1);
-  } else {
-    QByteArray data = r->readAll();
-    auto doc = QJsonDocument::fromJson(data);
-    QJsonObject obj = doc.object();
-    auto message = obj.find("message");
-    if (message != obj.end()) m_response = message->toString();
-    m_eventLoop.exit(0);
+    m_reply = nullptr;
+    r->deleteLater();
+    complete(false, r->errorString());
+    return;
   }
+  readReply();
+  m_reply = nullptr;
+  r->deleteLater();
+  if (m_parser) appendText(m_parser->finish());
+  if (!m_response.isEmpty()) m_cache.insert(m_cacheKey, m_response);
+  complete(true);
 }
 
 QString RapidGptConnection::url() const {
@@ -99,6 +171,43 @@ QString RapidGptConnection::url() const {
       m_settings.key, m_settings.precision, m_settings.interactive);
 }
 
+QByteArray RapidGptConnection::cacheRequest(const QByteArray& body) const {
+  // the API key does not change the answer
+  return QString{"%1\n%2\n%3\n"}
+             .arg(m_settings.remoteUrl, m_settings.precision,
+                  m_settings.interactive)
+             .toUtf8() +
+         body;
+}
+
+bool RapidGptConnection::validate(const RapidGptContext& context) {
+  if (context.messages.count() == 0) return false;
+  if (m_settings.key.isEmpty()) {
+    m_errorString = "API Key is empty";
+    return false;
+  }
+  if (!validateUserInput(context)) {
+    m_errorString =
+        "File size exceeds limit\nThe selected file is too large. Please "
+        "choose a file that is not bigger than 32kB.";
+    return false;
+  }
+  return true;
+}
+
+void RapidGptConnection::appendText(const QString& text) {
+  if (text.isEmpty()) return;
+  m_response += text;
+  emit textReceived(text);
+}
+
+void RapidGptConnection::complete(bool ok, const QString& error) {
+  m_running = false;
+  m_errorString = error;
+  m_delay = static_cast<double>(m_timer.elapsed()) / 1000.0;
+  emit finished(ok);
+}
+
 bool RapidGptConnection::validateUserInput(const RapidGptContext& context) {
   if (std::any_of(context.messages.begin(), context.messages.end(),
                   [](const Message& msg) {
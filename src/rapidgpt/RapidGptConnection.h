@@ -20,8 +20,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
 
+#include <QElapsedTimer>
 #include <QEventLoop>
+#include <memory>
 
+#include "RapidGptCache.h"
 #include "RapidGptContext.h"
 #include "RapigGptSettingsWindow.h"
 
@@ -30,32 +33,60 @@ class QNetworkReply;
 
 namespace FOEDAG {
 
+class RapidGptStreamParser;
 class RapidGptConnection : public QObject {
   Q_OBJECT
 
  public:
-  explicit RapidGptConnection(const RapidGptSettings &settings);
+  explicit RapidGptConnection(const RapidGptSettings &settings,
+                              QObject *parent = nullptr);
+  ~RapidGptConnection() override;
   static QByteArray toByteArray(const RapidGptContext &context);
 
+  // blocks until the answer is complete
   bool send(const RapidGptContext &context);
+  // returns right away, the answer comes with textReceived() and finished()
+  bool start(const RapidGptContext &context, bool useCache = true);
+  void cancel();
+  bool isRunning() const;
+  bool isCanceled() const;
+  void setCacheDir(const QString &dir);
+
   QString errorString() const;
   QString responseString() const;
   double delay() const;  // seconds
 
+ signals:
+  void textReceived(const QString &text);
+  void finished(bool ok);
+
  private slots:
-  void reply(QNetworkReply *r);
+  void readReply();
+  void reply();
 
  private:
   QString url() const;
+  QByteArray cacheRequest(const QByteArray &body) const;
+  bool validate(const RapidGptContext &context);
+  void appendText(const QString &text);
+  void complete(bool ok, const QString &error = {});
   static bool validateUserInput(const RapidGptContext &context);
 
  private:
   RapidGptSettings m_settings{};
   QNetworkAccessManager *m_networkManager{nullptr};
+  QNetworkReply *m_reply{nullptr};
+  std::unique_ptr<RapidGptStreamParser> m_parser;
+  RapidGptCache m_cache{};
+  QString m_cacheKey{};
   QEventLoop m_eventLoop;
+  QElapsedTimer m_timer;
   QString m_errorString{};
   QString m_response{};
   double m_delay{};
+  bool m_running{false};
+  bool m_canceled{false};
+  uint m_request{0};
 };
 
 }  // namespace FOEDAG
@@ -0,0 +1,129 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RapidGptStreamParser.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace FOEDAG {
+
+RapidGptStreamParser::RapidGptStreamParser(Format format) : m_format(format) {}
+
+RapidGptStreamParser::Format RapidGptStreamParser::formatFromContentType(
+    const QByteArray &contentType) {
+  QByteArray type = contentType.toLower();
+  if (type.startsWith("text/event-stream")) return Format::EventStream;
+  if (type.startsWith("text/")) return Format::Text;
+  return Format::Json;
+}
+
+RapidGptStreamParser::Format RapidGptStreamParser::format() const {
+  return m_format;
+}
+
+QString RapidGptStreamParser::feed(const QByteArray &data) {
+  switch (m_format) {
+    case Format::Text:
+      return m_decoder.decode(data);
+    case Format::Json:
+      m_buffer.append(data);
+      return {};
+    case Format::EventStream:
+      break;
+  }
+  m_buffer.append(data);
+  QString text;
+  qsizetype start{0};
+  qsizetype end{0};
+  while ((end = m_buffer.indexOf('\n', start)) != -1) {
+    QByteArray line = m_buffer.mid(start, end - start);
+    start = end + 1;
+    if (line.endsWith('\r')) line.chop(1);
+    if (line.isEmpty()) {
+      // blank line completes the event
+      if (m_eventHasData) text += dispatch(m_eventData);
+      m_eventData.clear();
+      m_eventHasData = false;
+    } else if (line.startsWith("data:")) {
+      QByteArray value = line.mid(5);
+      if (value.startsWith(' ')) value.remove(0, 1);
+      if (m_eventHasData) m_eventData.append('\n');
+      m_eventData.append(value);
+      m_eventHasData = true;
+    }
+    // comments and other fields (event, id, retry) are not used
+  }
+  m_buffer.remove(0, start);
+  return text;
+}
+
+QString RapidGptStreamParser::finish() {
+  QString text;
+  switch (m_format) {
+    case Format::Text:
+      text = m_decoder.decode(QByteArray{});
+      break;
+    case Format::Json:
+      text = messageFromJson(m_buffer);
+      break;
+    case Format::EventStream:
+      // the last event may come without the blank line
+      if (!m_buffer.isEmpty()) text = feed("\n");
+      if (m_eventHasData) text += dispatch(m_eventData);
+      m_eventData.clear();
+      m_eventHasData = false;
+      break;
+  }
+  m_buffer.clear();
+  return text;
+}
+
+bool RapidGptStreamParser::done() const { return m_done; }
+
+QString RapidGptStreamParser::dispatch(const QByteArray &payload) {
+  if (m_done) return {};
+  if (payload == "[DONE]") {
+    m_done = true;
+    return {};
+  }
+  if (payload.startsWith('{')) {
+    bool ok{false};
+    QString message = messageFromJson(payload, &ok);
+    if (ok) return message;
+  }
+  return QString::fromUtf8(payload);
+}
+
+QString RapidGptStreamParser::messageFromJson(const QByteArray &data,
+                                              bool *ok) {
+  QJsonParseError error;
+  auto doc = QJsonDocument::fromJson(data, &error);
+  if (ok) *ok = (error.error == QJsonParseError::NoError) && doc.isObject();
+  QJsonObject obj = doc.object();
+  for (const char *field : {"message", "token", "content"}) {
+    auto value = obj.find(field);
+    if (value != obj.end()) return value->toString();
+  }
+  return {};
+}
+
+}  // namespace FOEDAG
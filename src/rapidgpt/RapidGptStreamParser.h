@@ -0,0 +1,62 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringDecoder>
+
+namespace FOEDAG {
+
+/*
+  Incremental decoder of a RapidGPT answer. Data is fed as it arrives and the
+  text decoded so far is returned right away for server-sent events and
+  plain chunked text. A JSON answer is decoded at finish() only.
+*/
+class RapidGptStreamParser {
+ public:
+  enum class Format { Json, EventStream, Text };
+
+  explicit RapidGptStreamParser(Format format = Format::Json);
+  static Format formatFromContentType(const QByteArray &contentType);
+
+  Format format() const;
+  // returns the text decoded from data, may be empty
+  QString feed(const QByteArray &data);
+  // decodes the rest of the buffered data
+  QString finish();
+  // the server sent the end of the stream marker
+  bool done() const;
+
+ private:
+  QString dispatch(const QByteArray &payload);
+  static QString messageFromJson(const QByteArray &data, bool *ok = nullptr);
+
+ private:
+  Format m_format{Format::Json};
+  QByteArray m_buffer{};
+  QByteArray m_eventData{};
+  bool m_eventHasData{false};
+  QStringDecoder m_decoder{QStringDecoder::Utf8};
+  bool m_done{false};
+};
+
+}  // namespace FOEDAG
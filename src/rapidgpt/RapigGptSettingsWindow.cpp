@@ -27,6 +27,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPushButton>
 #include <QVBoxLayout>
 
+#include "RapidGptCache.h"
 #include "ui_RapigGptSettingsWindow.h"
 
 static constexpr auto rapidGptKey{"rapidGpt/ApiKey"};
@@ -61,6 +62,13 @@ RapigGptSettingsWindow::RapigGptSettingsWindow(QSettings &settings,
   auto cancel = ui->buttonBox->button(QDialogButtonBox::Cancel);
   connect(ok, &QPushButton::clicked, this, &RapigGptSettingsWindow::accept);
   connect(cancel, &QPushButton::clicked, this, &RapigGptSettingsWindow::reject);
+  auto clearCache =
+      ui->buttonBox->addButton("Clear Cache", QDialogButtonBox::ResetRole);
+  clearCache->setToolTip("Remove the cached RapidGPT answers");
+  connect(clearCache, &QPushButton::clicked, this, [clearCache]() {
+    RapidGptCache{RapidGptCache::defaultDir()}.clear();
+    clearCache->setEnabled(false);
+  });
 
   ui->lineEditRemoteUrl->hide();
   ui->labelRemoteUrl->hide();
@@ -304,6 +304,60 @@ TEST(CFGCommon, test_number_to_unit_string) {
   EXPECT_EQ(CFG_convert_number_to_unit_string(123456789), "123456789");
 }
 
+TEST(CFGCommon, test_binary_diff) {
+  std::vector<uint8_t> data1(10000, 0x5A);
+  std::vector<uint8_t> data2 = data1;
+  std::vector<CFG_BIT_RANGE> ranges;
+  EXPECT_TRUE(CFG_diff_binary_data(&data1[0], data1.size(), &data2[0],
+                                   data2.size(), ranges));
+  EXPECT_EQ(ranges.size(), 0);
+  // Neighbour bits across bytes merge into one range
+  data2[1] ^= 0x80;
+  data2[2] ^= 0x03;
+  data2[9000] ^= 0x10;
+  EXPECT_FALSE(CFG_diff_binary_data(&data1[0], data1.size(), &data2[0],
+                                    data2.size(), ranges));
+  ASSERT_EQ(ranges.size(), 2);
+  EXPECT_EQ(ranges[0].start, 15);
+  EXPECT_EQ(ranges[0].size, 3);
+  EXPECT_EQ(ranges[1].start, 72004);
+  EXPECT_EQ(ranges[1].size, 1);
+  EXPECT_FALSE(CFG_diff_binary_data(&data1[0], data1.size(), &data2[0],
+                                    data2.size(), ranges, 1));
+  EXPECT_EQ(ranges.size(), 1);
+  // Extra bytes are different
+  EXPECT_FALSE(CFG_diff_binary_data(&data1[0], 10, &data1[0], 12, ranges));
+  ASSERT_EQ(ranges.size(), 1);
+  EXPECT_EQ(ranges[0].start, 80);
+  EXPECT_EQ(ranges[0].size, 16);
+  // Files
+  create_unittest_directory("CFGCommon");
+  CFG_write_binary_file("utst/CFGCommon/diff1.bin", &data1[0], data1.size());
+  CFG_write_binary_file("utst/CFGCommon/diff2.bin", &data2[0], data2.size());
+  EXPECT_TRUE(CFG_compare_two_binary_files("utst/CFGCommon/diff1.bin",
+                                           "utst/CFGCommon/diff1.bin"));
+  EXPECT_FALSE(CFG_compare_two_binary_files("utst/CFGCommon/diff1.bin",
+                                            "utst/CFGCommon/diff2.bin"));
+  EXPECT_FALSE(CFG_diff_two_binary_files("utst/CFGCommon/diff1.bin",
+                                         "utst/CFGCommon/diff2.bin", ranges));
+  EXPECT_EQ(ranges.size(), 2);
+  std::string text1 = "line1\nline2\n";
+  std::string text2 = "line1\nline2";
+  std::string text3 = "line1\nline3\n";
+  CFG_write_binary_file("utst/CFGCommon/diff1.txt", (const uint8_t*)(&text1[0]),
+                        text1.size());
+  CFG_write_binary_file("utst/CFGCommon/diff2.txt", (const uint8_t*)(&text2[0]),
+                        text2.size());
+  CFG_write_binary_file("utst/CFGCommon/diff3.txt", (const uint8_t*)(&text3[0]),
+                        text3.size());
+  EXPECT_TRUE(CFG_compare_two_text_files("utst/CFGCommon/diff1.txt",
+                                         "utst/CFGCommon/diff1.txt"));
+  EXPECT_TRUE(CFG_compare_two_text_files("utst/CFGCommon/diff1.txt",
+                                         "utst/CFGCommon/diff2.txt"));
+  EXPECT_FALSE(CFG_compare_two_text_files("utst/CFGCommon/diff1.txt",
+                                          "utst/CFGCommon/diff3.txt"));
+}
+
 TEST(CFGCommon, test_python) {
   std::map<std::string, CFG_Python_OBJ> pobjs = CFG_Python(
       {"a=1", "b=3", "c=a+b", "d='%d'%(c*b)"}, {"a", "b", "c", "d", "e", "f"});
@@ -404,3 +458,28 @@ TEST(CFGCommon, test_python_mgr) {
                          std::vector<CFG_Python_OBJ>({}));
   EXPECT_EQ(results.size(), 0);
 }
+
+TEST(CFGCommon, test_python_mgr_reuse) {
+  std::string current_dir = COMPILER_TCL_COMMON_GET_CURRENT_DIR();
+  std::string file = CFG_print("%s/python_file_test.py", current_dir.c_str());
+  {
+    CFG_Python_MGR mgr;
+    EXPECT_EQ(mgr.set_file(file, {}, true), "python_file_test");
+    EXPECT_TRUE(mgr.has_function("python_file_test", "func1"));
+    EXPECT_FALSE(mgr.has_function("python_file_test", "no_such_func"));
+    mgr.run({"import python_file_test", "python_file_test.marker = 7"}, {});
+  }
+  {
+    // Interpreter is still alive, unchanged module is reused
+    CFG_Python_MGR mgr;
+    mgr.set_file(file, {"marker"}, true);
+    EXPECT_EQ(mgr.results().size(), 1);
+    EXPECT_EQ(mgr.result_u32("marker"), 7);
+  }
+  {
+    // Default is a fresh import
+    CFG_Python_MGR mgr;
+    mgr.set_file(file, {"marker"});
+    EXPECT_EQ(mgr.results().size(), 0);
+  }
+}
@@ -610,6 +610,69 @@ TEST_F(HardwareManagerTest, GetDeviceDB) {
   EXPECT_EQ(db[0].type, GEMINI);
 }
 
+TEST_F(HardwareManagerTest, FindDeviceInfo) {
+  auto info = HardwareManager::find_device_info(0x10000db3);
+  ASSERT_NE(info, nullptr);
+  EXPECT_EQ(info->name, "OCLA");
+  EXPECT_EQ(info->type, OCLA);
+  EXPECT_EQ(HardwareManager::find_device_info(0x12345678), nullptr);
+}
+
+TEST_F(HardwareManagerTest, ScanIsCachedUntilInvalidate) {
+  Cable cable;
+  EXPECT_CALL(mockAdapter, scan(_))
+      .Times(2)
+      .WillRepeatedly(
+          Return(std::vector<uint32_t>{0x1000563d, 0x10000db3}));
+  EXPECT_EQ(hardwareManager.get_taps(cable).size(), 2);
+  EXPECT_EQ(hardwareManager.get_devices(cable).size(), 2);
+  hardwareManager.invalidate();
+  EXPECT_EQ(hardwareManager.get_taps(cable).size(), 2);
+}
+
+TEST_F(HardwareManagerTest, SharedSnapshot) {
+  Cable cable;
+  auto snapshot = std::make_shared<HardwareManager_SNAPSHOT>();
+  HardwareManager first{&mockAdapter, snapshot};
+  HardwareManager second{&mockAdapter, snapshot};
+  EXPECT_CALL(mockAdapter, scan(_))
+      .WillOnce(Return(std::vector<uint32_t>{0x1000563d}));
+  EXPECT_EQ(first.get_devices(cable).size(), 1);
+  auto devices = second.get_devices(cable);
+  ASSERT_EQ(devices.size(), 1);
+  EXPECT_EQ(devices[0].name, "Gemini");
+}
+
+TEST_F(HardwareManagerTest, ProcessSnapshot) {
+  Cable cable;
+  cable.name = "ProcessSnapshot";
+  EXPECT_EQ(HardwareManager::shared_snapshot(),
+            HardwareManager::shared_snapshot());
+  EXPECT_CALL(mockAdapter, scan(_))
+      .Times(2)
+      .WillRepeatedly(Return(std::vector<uint32_t>{0x1000563d}));
+  {
+    HardwareManager command{&mockAdapter, HardwareManager::shared_snapshot()};
+    EXPECT_EQ(command.get_devices(cable).size(), 1);
+  }
+  // a later command reuses the scan until the snapshot is refreshed
+  HardwareManager later{&mockAdapter, HardwareManager::shared_snapshot()};
+  EXPECT_EQ(later.get_devices(cable).size(), 1);
+  later.invalidate();
+  EXPECT_EQ(later.get_devices(cable).size(), 1);
+  later.invalidate();
+}
+
+TEST_F(HardwareManagerTest, EmptyScanIsNotCached) {
+  Cable cable;
+  EXPECT_CALL(mockAdapter, scan(_))
+      .WillOnce(Return(std::vector<uint32_t>{}))
+      .WillOnce(Return(std::vector<uint32_t>{0x1000563d}));
+  EXPECT_EQ(hardwareManager.get_devices(cable).size(), 0);
+  EXPECT_EQ(hardwareManager.get_devices(cable).size(), 1);
+  EXPECT_EQ(hardwareManager.get_devices(cable).size(), 1);
+}
+
 TEST(CheckRegexTest, MatchCaseInsensitive) {
   // Test when the regex pattern matches, case-insensitive
   std::vector<std::string> output;
@@ -0,0 +1,114 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Command/Logger.h"
+
+#include <csignal>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace FOEDAG;
+
+static std::string content(const std::string &file) {
+  std::ifstream stream{file};
+  std::stringstream buffer;
+  buffer << stream.rdbuf();
+  return buffer.str();
+}
+
+TEST(Logger, flushWritesQueuedText) {
+  const std::string file{"logger_test_flush.log"};
+  Logger logger{file};
+  logger.log("line");
+  logger << "text";
+  logger.write("-more", 5);
+  logger.flush();
+  EXPECT_EQ(content(file), "line\ntext-more");
+  std::filesystem::remove(file);
+}
+
+TEST(Logger, linesFromThreadsAreKept) {
+  const std::string file{"logger_test_threads.log"};
+  Logger logger{file};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&logger]() {
+      for (int i = 0; i < 1000; i++) logger.log("0123456789");
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  logger.flush();
+  const std::string text = content(file);
+  EXPECT_EQ(text.size(), 4 * 1000 * 11);
+  EXPECT_EQ(text.find_first_not_of("0123456789\n"), std::string::npos);
+  std::filesystem::remove(file);
+}
+
+TEST(Logger, closeAndReopenAppends) {
+  const std::string file{"logger_test_reopen.log"};
+  Logger logger{file};
+  logger.log("first");
+  logger.close();
+  EXPECT_EQ(content(file), "first\n");
+  logger.log("ignored");
+  logger.open();
+  logger.appendLog("second", LogSeverity::Error);
+  logger.close();
+  EXPECT_EQ(content(file), "first\nsecond");
+  std::filesystem::remove(file);
+}
+
+TEST(Logger, errorIsFlushedAtOnce) {
+  const std::string file{"logger_test_error.log"};
+  Logger logger{file};
+  LogFlushPolicy policy{};
+  policy.interval = std::chrono::hours{1};
+  policy.size = 1024 * 1024;
+  logger.setFlushPolicy(policy);
+  logger.log("ERROR: failed", LogSeverity::Error);
+  // no explicit flush, the logging thread flushes error text on its own
+  for (int i = 0; i < 200 && content(file).empty(); i++)
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  EXPECT_EQ(content(file), "ERROR: failed\n");
+  std::filesystem::remove(file);
+}
+
+#ifndef _WIN32
+TEST(Logger, crashStillRaisesSignal) {
+  const std::string file{"logger_test_crash.log"};
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  // the crash handler writes what the logging thread buffered, then the
+  // default action ends the process with the same signal
+  EXPECT_EXIT(
+      {
+        Logger logger{file};
+        for (int i = 0; i < 100000; i++) logger.log("0123456789");
+        std::abort();
+      },
+      testing::KilledBySignal(SIGABRT), "");
+  const std::string text = content(file);
+  EXPECT_EQ(text.find_first_not_of("0123456789\n"), std::string::npos);
+  std::filesystem::remove(file);
+}
+#endif
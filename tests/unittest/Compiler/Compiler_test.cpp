@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Compiler/Compiler.h"
 #include "Compiler/CompilerOpenFPGA.h"
+#include "compiler_tcl_infra_common.h"
 #include "gtest/gtest.h"
 
 using namespace FOEDAG;
@@ -32,3 +33,70 @@ TEST(Compiler, Init) {
   EXPECT_EQ(compiler->GetConfiguration(), nullptr);
   delete compiler;
 }
+
+TEST(Compiler, FlowTrace) {
+  compiler_tcl_common_setup();
+  const std::string file{"flow_trace_test.json"};
+  compiler_tcl_common_run("flow_trace start");
+  compiler_tcl_common_run("flow_trace stop " + file);
+  EXPECT_TRUE(std::filesystem::exists(file));
+  std::filesystem::remove(file);
+  compiler_tcl_common_run("flow_trace", TCL_ERROR);
+  compiler_tcl_common_run("flow_trace add variable v write", TCL_ERROR);
+
+  // the builtin Tcl trace is left untouched
+  compiler_tcl_common_run(
+      "set flow_trace_var 0; set flow_trace_hits 0; "
+      "trace add variable flow_trace_var write {incr flow_trace_hits; list}; "
+      "set flow_trace_var 1");
+  std::string hits = compiler_tcl_common_compiler()->TclInterp()->evalCmd(
+      "set flow_trace_hits");
+  EXPECT_EQ(hits, "1");
+}
+
+class PcfCompiler : public CompilerOpenFPGA {
+ public:
+  using CompilerOpenFPGA::ConvertSdcPinConstrainToPcf;
+};
+
+TEST(Compiler, ConvertSdcPinConstrainToPcf) {
+  PcfCompiler compiler;
+  std::vector<std::string> constraints{
+      "set_io a HR_1_0_0P",
+      "set_mode Mode_BP_SDR_A_TX HR_1_2_1P",
+      "set_io b HR_1_2_1P",
+      "set_mode Mode_BP_DDR_A_TX HR_1_2_1P",
+      "set_io c HR_1_2_1P c_int",
+      "# set_clock_pin -device_clock clk -design_clock clk",
+      "set_io d HR_1_4_2P -mode Mode_RATE_3 -internal_pin g2f_rx_dpa_lock"};
+  ASSERT_TRUE(compiler.ConvertSdcPinConstrainToPcf(constraints));
+  EXPECT_EQ(constraints,
+            (std::vector<std::string>{
+                "set_io a HR_1_0_0P -mode Mode_GPIO",
+                "set_io b HR_1_2_1P -mode Mode_BP_SDR_A_TX",
+                "set_io c HR_1_2_1P -mode Mode_BP_DDR_A_TX -internal_pin c_int",
+                "set_io d HR_1_4_2P -mode Mode_RATE_3 -internal_pin "
+                "g2f_rx_dpa_lock"}));
+
+  std::vector<std::string> invalid{"set_mode Mode_BP_SDR_A_TX"};
+  EXPECT_FALSE(compiler.ConvertSdcPinConstrainToPcf(invalid));
+}
+
+// Generated IO constraints of a high pin count package, runs in linear time
+TEST(Compiler, ConvertSdcPinConstrainToPcfLarge) {
+  constexpr int pins{50000};
+  std::vector<std::string> constraints;
+  constraints.reserve(pins + pins / 2);
+  for (int i = 0; i < pins; i++) {
+    const std::string gbox = "HR_" + std::to_string(i / 2);
+    if (i % 2 == 0)
+      constraints.push_back("set_mode Mode_BP_SDR_A_RX " + gbox);
+    constraints.push_back("set_io io_" + std::to_string(i) + " " + gbox);
+  }
+  PcfCompiler compiler;
+  ASSERT_TRUE(compiler.ConvertSdcPinConstrainToPcf(constraints));
+  ASSERT_EQ(constraints.size(), pins);
+  EXPECT_EQ(constraints.back(), "set_io io_" + std::to_string(pins - 1) +
+                                    " HR_" + std::to_string((pins - 1) / 2) +
+                                    " -mode Mode_BP_SDR_A_RX");
+}
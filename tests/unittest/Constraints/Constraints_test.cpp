@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Compiler/Constraints.h"
 
+#include <fstream>
+
 #include "compiler_tcl_infra_common.h"
 
 using namespace FOEDAG;
@@ -126,3 +128,135 @@ TEST_F(ConstraintsTest, compare_result) {
                 CFG_print("%s/property.golden.json", current_dir.c_str())),
             true);
 }
+
+TEST_F(ConstraintsTest, parsed_commands) {
+  Compiler* compiler = compiler_tcl_common_compiler();
+  ASSERT_NE(compiler, nullptr);
+  Constraints* constraints = compiler->getConstraints();
+  ASSERT_NE(constraints, nullptr);
+  constraints->reset();
+  constraints->addConstraint("create_clock -period 2.5 clk@0% ");
+  constraints->addConstraint("set_pin_loc din@*@ HR_1_0_0P ");
+  constraints->addConstraint("set_property mode MODE_BP_SDR_A_TX g1 ");
+  constraints->addConstraint("set_property IOSTANDARD LVCMOS_18_H g1 ");
+  constraints->addConstraint("set_mode MODE_BP_SDR_A_TX g2 ");
+  constraints->addConstraint("set_clock_pin -device_clock c0 -design_clock c ");
+  const auto& commands = constraints->getCommands();
+  ASSERT_EQ(commands.size(), 6);
+  EXPECT_EQ(commands[0].kind, SdcCommand::Kind::Timing);
+  EXPECT_EQ(commands[0].text, "create_clock -period 2.5 clk[0] ");
+  EXPECT_EQ(commands[0].words,
+            (std::vector<std::string>{"create_clock", "-period", "2.5",
+                                      "clk[0]"}));
+  EXPECT_EQ(commands[1].kind, SdcCommand::Kind::PinLocation);
+  EXPECT_EQ(commands[1].words.at(1), "din{*}");
+  EXPECT_EQ(commands[2].kind, SdcCommand::Kind::ModeProperty);
+  EXPECT_EQ(commands[3].kind, SdcCommand::Kind::Property);
+  EXPECT_EQ(commands[4].kind, SdcCommand::Kind::Mode);
+  EXPECT_EQ(commands[5].kind, SdcCommand::Kind::ClockPin);
+
+  constraints->addConstraint("set_max_delay 1 -from a -to b ");
+  EXPECT_EQ(constraints->getCommands().size(), 7);
+  constraints->reset();
+  EXPECT_TRUE(constraints->getCommands().empty());
+}
+
+TEST_F(ConstraintsTest, source_key) {
+  Compiler* compiler = compiler_tcl_common_compiler();
+  ASSERT_NE(compiler, nullptr);
+  Constraints* constraints = compiler->getConstraints();
+  ASSERT_NE(constraints, nullptr);
+  constraints->reset();
+  EXPECT_TRUE(constraints->SourceKey().empty());
+  constraints->addConstraint("create_clock -period 2 clk ");
+  constraints->SetSourceKey("design.sdc:1");
+  EXPECT_EQ(constraints->SourceKey(), "design.sdc:1");
+  // constraints changed after they were read
+  constraints->addKeep("clk");
+  EXPECT_TRUE(constraints->SourceKey().empty());
+  constraints->SetSourceKey("design.sdc:1");
+  constraints->reset();
+  EXPECT_TRUE(constraints->SourceKey().empty());
+}
+
+TEST_F(ConstraintsTest, read_sdc) {
+  Compiler* compiler = compiler_tcl_common_compiler();
+  ASSERT_NE(compiler, nullptr);
+  Constraints* constraints = compiler->getConstraints();
+  ASSERT_NE(constraints, nullptr);
+  constraints->reset();
+  {
+    std::ofstream sdc{"read_sdc_test.sdc"};
+    sdc << "set_max_delay $read_sdc_test_delay -from din[0] -to dout\n"
+        << "proc sdc_clock {} { return clk }\n"
+        << "set_false_path -from [sdc_clock] -to [get_clocks clk2]\n"
+        << "read_sdc_test_proc\n";
+  }
+  // Variables and procs of the main interpreter are visible to SDC files
+  compiler_tcl_common_run(
+      "set read_sdc_test_delay 2; proc read_sdc_test_proc {} {}");
+  compiler_tcl_common_run("read_sdc read_sdc_test.sdc");
+  const auto& all = constraints->getConstraints();
+  ASSERT_EQ(all.size(), 2);
+  EXPECT_EQ(all[0], "set_max_delay 2 -from din@0% -to dout ");
+  EXPECT_EQ(all[1], "set_false_path -from clk -to [get_clocks clk2] ");
+  const auto& keeps = constraints->GetKeeps();
+  EXPECT_EQ(keeps.count("din@0%"), 1);
+  EXPECT_EQ(keeps.count("dout"), 1);
+  EXPECT_EQ(keeps.count("clk"), 1);
+  EXPECT_EQ(keeps.count("clk2"), 1);
+
+  {
+    std::ofstream sdc{"read_sdc_test.sdc"};
+    sdc << "set_max_delay 1 -from a -to b\n"
+        << "read_sdc_test_unknown\n";
+  }
+  compiler_tcl_common_run("read_sdc read_sdc_test.sdc", TCL_ERROR);
+  compiler_tcl_common_run("read_sdc read_sdc_test_missing.sdc", TCL_ERROR);
+
+  // procs of the SDC files read before the reset are gone
+  constraints->reset();
+  {
+    std::ofstream sdc{"read_sdc_test.sdc"};
+    sdc << "set_false_path -from [sdc_clock] -to b\n";
+  }
+  compiler_tcl_common_run("read_sdc read_sdc_test.sdc", TCL_ERROR);
+
+  // clear_property in an SDC file does not delete the running interpreter
+  {
+    std::ofstream sdc{"read_sdc_test.sdc"};
+    sdc << "set_max_delay 1 -from a -to b\n"
+        << "proc read_sdc_test_stale {} {}\n"
+        << "clear_property\n"
+        << "set_max_delay 2 -from c -to d\n";
+  }
+  compiler_tcl_common_run("read_sdc read_sdc_test.sdc");
+  ASSERT_EQ(constraints->getConstraints().size(), 1);
+  EXPECT_EQ(constraints->getConstraints()[0], "set_max_delay 2 -from c -to d ");
+  {
+    std::ofstream sdc{"read_sdc_test.sdc"};
+    sdc << "read_sdc_test_stale\n";
+  }
+  compiler_tcl_common_run("read_sdc read_sdc_test.sdc", TCL_ERROR);
+  constraints->reset();
+}
+
+TEST_F(ConstraintsTest, read_sdc_throughput) {
+  Compiler* compiler = compiler_tcl_common_compiler();
+  ASSERT_NE(compiler, nullptr);
+  Constraints* constraints = compiler->getConstraints();
+  ASSERT_NE(constraints, nullptr);
+  constraints->reset();
+  constexpr size_t lines{100000};
+  {
+    std::ofstream sdc{"read_sdc_large_test.sdc"};
+    for (size_t i = 0; i < lines; i++) {
+      sdc << "set_max_delay 1.5 -from din[" << i % 1000 << "] -to dout["
+          << i % 100 << "]\n";
+    }
+  }
+  compiler_tcl_common_run("read_sdc read_sdc_large_test.sdc");
+  EXPECT_EQ(constraints->getConstraints().size(), lines);
+  EXPECT_EQ(constraints->GetKeeps().size(), 1100);
+  constraints->reset();
+}
@@ -22,8 +22,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "IPGenerate/IPGenerator.h"
 
 #include "Compiler/Compiler.h"
+#include "IPGenerate/IPTemplateCache.h"
 #include "NewProject/ProjectManager/project_manager.h"
 #include "ProjNavigator/tcl_command_integration.h"
+#include "Utils/FileUtils.h"
 #include "gtest/gtest.h"
 
 namespace FOEDAG {
@@ -148,4 +150,87 @@ TEST(IPGenerate, CheckAllIPPath) {
   EXPECT_EQ(ipGen->GetProjectIPsPath(), "run_1/IPs");
 }
 
+TEST(IPGenerate, JobsOption) {
+  Compiler* compiler = new Compiler();
+  std::ostringstream err;
+  compiler->SetErrStream(&err);
+  const char* argv[] = {"ipgenerate", "-jobs", "4"};
+  int index = 1;
+  EXPECT_TRUE(compiler->parseIPGenJobs(3, argv, index));
+  EXPECT_EQ(index, 2);
+  EXPECT_EQ(compiler->IPGenJobs(), 4);
+
+  const char* notNumber[] = {"ipgenerate", "-jobs", "many"};
+  index = 1;
+  EXPECT_FALSE(compiler->parseIPGenJobs(3, notNumber, index));
+  const char* missing[] = {"ipgenerate", "-jobs"};
+  index = 1;
+  EXPECT_FALSE(compiler->parseIPGenJobs(2, missing, index));
+  EXPECT_EQ(compiler->IPGenJobs(), 4);
+  EXPECT_FALSE(err.str().empty());
+}
+
+TEST(IPGenerate, RunGeneratorsInOrder) {
+  const std::filesystem::path python = FileUtils::LocateExecFile("python3");
+  if (python.empty()) GTEST_SKIP() << "python3 is not available";
+  IPCatalog* ipCat = new IPCatalog();
+  Compiler* compiler = new Compiler();
+  IPGenerator* ipGen = new IPGenerator(ipCat, compiler);
+  ProjectManager* pm = new ProjectManager{};
+  Project::Instance()->setProjectName("testProject");
+  compiler->setGuiTclSync(new TclCommandIntegration{pm, nullptr});
+  std::ostringstream out;
+  compiler->SetOutStream(&out);
+
+  std::vector<Connector*> connections;
+  std::vector<Value*> parameters;
+  IPDefinition* def = new IPDefinition(IPDefinition::IPType::Other, "MOCK_IP",
+                                       "MOCK_IP_wrapper", "path_to_nowhere",
+                                       connections, parameters);
+  std::vector<SParameter> params;
+  // the first generator finishes last, the report keeps the job order
+  std::vector<IPGenerator::GenerateJob> jobs;
+  for (int i = 0; i < 3; i++) {
+    IPInstance* instance =
+        new IPInstance("MOCK_IP", "version_num", def, params,
+                       "ip_" + std::to_string(i), "out_file");
+    const std::string sleep = std::to_string(0.2 * (3 - i));
+    jobs.push_back(
+        {instance, {"-c", "import time; time.sleep(" + sleep + ")"}});
+  }
+  EXPECT_TRUE(ipGen->RunGenerators(python, jobs, 3));
+  const std::string log = out.str();
+  const size_t first = log.find("ip_0 generated");
+  const size_t second = log.find("ip_1 generated");
+  const size_t third = log.find("ip_2 generated");
+  ASSERT_NE(first, std::string::npos);
+  EXPECT_LT(first, second);
+  EXPECT_LT(second, third);
+  EXPECT_NE(third, std::string::npos);
+}
+
+TEST(IPGenerate, IPTemplateCache) {
+  const std::filesystem::path dir{"ip_template_cache_test"};
+  const std::filesystem::path generator = dir / "test_gen.py";
+  FileUtils::MkDirs(dir);
+  FileUtils::WriteToFile(generator, "print('v1')");
+
+  IPTemplateCache cache{dir / "cache", "python3"};
+  std::string jsonTemplate{};
+  EXPECT_FALSE(cache.lookup(generator, jsonTemplate));
+
+  cache.store(generator, "{\"parameters\": []}");
+  EXPECT_TRUE(cache.lookup(generator, jsonTemplate));
+  EXPECT_EQ(jsonTemplate, "{\"parameters\": []}");
+
+  // other interpreter doesn't share entries
+  IPTemplateCache otherPython{dir / "cache", "python3.other"};
+  EXPECT_FALSE(otherPython.lookup(generator, jsonTemplate));
+
+  // generator content changed
+  FileUtils::WriteToFile(generator, "print('v2')");
+  EXPECT_FALSE(cache.lookup(generator, jsonTemplate));
+  FileUtils::RmDirRecursively(dir);
+}
+
 }  // namespace FOEDAG
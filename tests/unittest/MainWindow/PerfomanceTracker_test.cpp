@@ -68,3 +68,27 @@ TEST(PerfomanceTracker, updateTable) {
   EXPECT_EQ(pTracker.widget()->item(0, 1)->text(), "1");
   EXPECT_EQ(pTracker.widget()->item(0, 2)->text(), "1");
 }
+
+TEST(PerfomanceTracker, processStats) {
+  PerfomanceTracker pTracker{};
+
+  TaskManager mManager{nullptr};
+  pTracker.setTaskManager(&mManager);
+
+  ProcessUtilization utils{2000, 2048};
+  utils.stats.peakPss = 1024;
+  utils.stats.userTime = 1500;
+  utils.stats.writeBytes = 3 * 1024 * 1024;
+  utils.stats.voluntaryCtxSwitches = 10;
+  utils.stats.involuntaryCtxSwitches = 5;
+  mManager.task(ANALYSIS)->setUtilization(utils);
+  pTracker.update();
+
+  auto view = pTracker.widget();
+  EXPECT_EQ(view->item(0, 2)->text(), "2");
+  EXPECT_EQ(view->item(0, 3)->text(), "1");
+  EXPECT_EQ(view->item(0, 4)->text(), "1.5");
+  EXPECT_EQ(view->item(0, 5)->text(), "N/A");
+  EXPECT_EQ(view->item(0, 7)->text(), "3");
+  EXPECT_EQ(view->item(0, 8)->text(), "15");
+}
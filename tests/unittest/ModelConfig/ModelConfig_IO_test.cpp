@@ -81,7 +81,7 @@ TEST_F(ModelConfig_IO, gen_ppdb) {
       "-routing_config %s/apis/routing_configurator.py "
       "-routing_config_model %s/apis/1vg28_routing.py "
       "-property_json model_config.property.json "
-      "-is_unittest -pll_workaround 0 "
+      "-is_unittest -pll_workaround 0 -routing_json io_routing.json "
       "model_config.ppdb.json",
       current_dir.c_str(), current_dir.c_str(), current_dir.c_str(),
       current_dir.c_str());
@@ -97,7 +97,7 @@ TEST_F(ModelConfig_IO, gen_ppdb_negative) {
       "-config_mapping %s/apis/config_attributes.mapping.json "
       "-routing_config %s/apis/routing_configurator.py "
       "-routing_config_model %s/apis/1vg28_routing.py "
-      "-is_unittest "
+      "-is_unittest -routing_json io_routing.json "
       "model_config.negative.ppdb.json",
       current_dir.c_str(), current_dir.c_str(), current_dir.c_str(),
       current_dir.c_str());
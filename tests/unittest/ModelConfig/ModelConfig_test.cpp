@@ -19,6 +19,7 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "Configuration/ModelConfig/ModelConfig.h"
 #include "compiler_tcl_infra_common.h"
 
 class ModelConfig : public ::testing::Test {
@@ -129,6 +130,76 @@ TEST_F(ModelConfig, model_config) {
   compiler_tcl_common_run("model_config dump_ric TOP model_config_top_ric.txt");
 }
 
+TEST_F(ModelConfig, diff) {
+  std::string golden_dir = COMPILER_TCL_COMMON_GET_CURRENT_GOLDEN_DIR();
+  std::vector<std::string> report;
+  std::string tcl_cmd = CFG_print(
+      "model_config diff -format WORD -report model_config_diff_word.txt "
+      "%s/model_config_word.txt model_config_word.txt",
+      golden_dir.c_str());
+  compiler_tcl_common_run(tcl_cmd);
+  CFG_read_text_file("model_config_diff_word.txt", report, false);
+  ASSERT_EQ(report.size(), 1);
+  EXPECT_NE(report[0].find("0 bit(s) differ in 0 attribute(s)"),
+            std::string::npos);
+  // Change one attribute and find it back from the images
+  compiler_tcl_common_run(
+      "model_config set_attr -feature IO -instance SUB2_A -name ATTR3 -value "
+      "0x11");
+  compiler_tcl_common_run(
+      "model_config write -format BIN model_config_diff_bin.bin");
+  compiler_tcl_common_run(
+      "model_config set_attr -feature IO -instance SUB2_A -name ATTR3 -value "
+      "0x155");
+  tcl_cmd = CFG_print(
+      "model_config diff -format BIN -report model_config_diff_bin.txt "
+      "%s/model_config_bin.bin model_config_diff_bin.bin",
+      golden_dir.c_str());
+  compiler_tcl_common_run(tcl_cmd);
+  report.clear();
+  CFG_read_text_file("model_config_diff_bin.txt", report, false);
+  ASSERT_EQ(report.size(), 2);
+  EXPECT_NE(report[0].find("3 bit(s) differ in 1 attribute(s)"),
+            std::string::npos);
+  EXPECT_EQ(report[1],
+            "  Block SUB2_A [] ATTR3 - Addr: 0x00000017, Size:  9, Value: "
+            "(0x00000155) -> (0x00000011)");
+}
+
+TEST_F(ModelConfig, set_attrs) {
+  // Same settings as model_config test but applied in bulk
+  std::string current_dir = COMPILER_TCL_COMMON_GET_CURRENT_DIR();
+  std::string golden_dir = COMPILER_TCL_COMMON_GET_CURRENT_GOLDEN_DIR();
+  compiler_tcl_common_run("model_config set_model -feature IO TOP");
+  std::string tcl_cmd = CFG_print("model_config set_api %s/model_config.json",
+                                  current_dir.c_str());
+  compiler_tcl_common_run(tcl_cmd);
+  tcl_cmd = CFG_print("model_config set_attrs -feature IO -file %s",
+                      (current_dir + "/model_config_attrs.txt").c_str());
+  compiler_tcl_common_run(tcl_cmd);
+  FOEDAG::model_config_set_attrs(
+      {{"SUB2_A", "ATTR1", "ENUM2"}, {"SUB2_A", "ATTR2", "ENUM2"}}, "IO");
+  compiler_tcl_common_run(
+      "model_config set_attrs {SUB2_A ATTR3 0x155} "
+      "{SUB2_A mode {MODE3 **arg0=1 --ATTR1=1 --ATTR2=2}}");
+  for (auto design : {"model_config_design_null_instances.json",
+                      "model_config_design_empty_instances.json",
+                      "model_config_design.json"}) {
+    tcl_cmd = CFG_print("model_config set_design %s/%s", current_dir.c_str(),
+                        design);
+    compiler_tcl_common_run(tcl_cmd);
+  }
+  compiler_tcl_common_run(
+      "model_config write -format DETAIL model_config_set_attrs_detail.txt");
+  EXPECT_TRUE(CFG_compare_two_text_files(
+      "model_config_set_attrs_detail.txt",
+      CFG_print("%s/model_config_detail.txt", golden_dir.c_str()), true));
+  // Bad triple
+  compiler_tcl_common_run("model_config set_attrs {SUB2_A ATTR3}", 1);
+  EXPECT_THROW(FOEDAG::model_config_set_attrs({{"SUB2_A", "NO_ATTR", "1"}}),
+               std::exception);
+}
+
 TEST_F(ModelConfig, compare_result) {
   std::string golden_dir = COMPILER_TCL_COMMON_GET_CURRENT_GOLDEN_DIR();
   compare_unittest_file(false, "model_config_bit.txt", "ModelConfig",
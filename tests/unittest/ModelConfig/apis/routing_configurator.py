@@ -1449,7 +1449,15 @@ class CONFIGURATOR:
     file = open(path_file)
     routings = json.load(file)
     file.close()
+    routings = self.solve_routings_data(routings, clean)
+    file = open(path_file, "w")
+    json.dump(routings, file, indent=2)
+    file.close()
+
+  def solve_routings_data(self, routings, clean):
+
     assert isinstance(routings, list) and len(routings)
+    self.reset_config_results()
     # Reset
     restart_routings = []
     for routing in routings:
@@ -1556,9 +1564,7 @@ class CONFIGURATOR:
               thread.routing["potential paths"] = []
               thread.routing["config mux"] = []
               thread.routing["status"] = False
-    file = open(path_file, "w")
-    json.dump(routings, file, indent=2)
-    file.close()
+    return routings
 
   def solve_routing(self, commands):
 
@@ -1688,5 +1694,51 @@ def cpp_entry(top_file, json_file):
   main(False)
   return [True]
 
+# Configurators kept alive by the embedded interpreter, keyed by top model
+# file. An entry is reloaded when any of its model files changes.
+CONFIGURATORS = {}
+
+def get_model_signature(files):
+
+  signature = []
+  for file in files:
+    stat = os.stat(file)
+    signature.append((file, stat.st_mtime_ns, stat.st_size))
+  return signature
+
+def get_configurator(top_file):
+
+  key = os.path.abspath(top_file)
+  if key in CONFIGURATORS:
+    (signature, configurator) = CONFIGURATORS[key]
+    if signature == get_model_signature(
+      [configurator.top_model_file_md5] + configurator.models_md5
+    ):
+      return configurator
+  configurator = CONFIGURATOR(top_file, True, 0, False)
+  CONFIGURATORS[key] = (
+    get_model_signature(
+      [configurator.top_model_file_md5] + configurator.models_md5
+    ),
+    configurator,
+  )
+  return configurator
+
+def cpp_entry_batch(top_files, requests, json_files):
+
+  assert isinstance(top_files, list)
+  assert isinstance(requests, list) and len(requests) == len(top_files)
+  assert isinstance(json_files, list) and len(json_files) == len(top_files)
+  results = []
+  for (top_file, request, json_file) in zip(top_files, requests, json_files):
+    configurator = get_configurator(top_file)
+    routings = configurator.solve_routings_data(json.loads(request), False)
+    if len(json_file):
+      file = open(json_file, "w")
+      json.dump(routings, file, indent=2)
+      file.close()
+    results.append(json.dumps(routings, separators=(",", ":")))
+  return results
+
 if __name__ == "__main__":
   main(True)
\ No newline at end of file
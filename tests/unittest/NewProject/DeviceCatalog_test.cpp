@@ -0,0 +1,143 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QBuffer>
+#include <QFile>
+
+#include "NewProject/ProjectManager/DeviceCatalog.h"
+#include "gtest/gtest.h"
+using namespace FOEDAG;
+
+static const char *deviceXml = R"(<device_list>
+  <device name="dev1" series="s1" family="f1" package="p1" pin_count="10">
+    <resource type="io" num="20"/>
+    <internal type="vpr_arch" file="arch.xml"/>
+  </device>
+  <device name="dev2" series="s1" family="f1" package="p2">
+    <resource type="lut" label="LUTs" num="8000"/>
+  </device>
+</device_list>)";
+
+static void writeFile(const QString &name, const QByteArray &content) {
+  QFile file{name};
+  file.open(QFile::WriteOnly | QFile::Truncate);
+  file.write(content);
+}
+
+TEST(DeviceCatalog, parse) {
+  QByteArray content{deviceXml};
+  QBuffer buffer{&content};
+  buffer.open(QBuffer::ReadOnly);
+  auto list = DeviceCatalog::parse(&buffer);
+  EXPECT_EQ(list->status, DeviceList::Ok);
+  ASSERT_EQ(list->devices.size(), 2);
+
+  auto dev1 = list->find("dev1");
+  ASSERT_EQ(dev1.size(), 1);
+  EXPECT_EQ(dev1.first()->pinCount, "10");
+  ASSERT_EQ(dev1.first()->internals.size(), 1);
+  EXPECT_EQ(dev1.first()->internals.first().file, "arch.xml");
+  EXPECT_EQ(list->find("dev2").first()->resources.first().label, "LUTs");
+  EXPECT_TRUE(list->find("dev3").isEmpty());
+  EXPECT_EQ(list->bySeries["s1"]["f1"].keys(), QStringList({"p1", "p2"}));
+}
+
+TEST(DeviceCatalog, parseMalformed) {
+  QByteArray content{"<device_list><device name=\"a\">"};
+  QBuffer buffer{&content};
+  buffer.open(QBuffer::ReadOnly);
+  auto list = DeviceCatalog::parse(&buffer);
+  EXPECT_EQ(list->status, DeviceList::Malformed);
+  EXPECT_TRUE(list->devices.isEmpty());
+}
+
+TEST(DeviceCatalog, cacheAndInvalidate) {
+  const QString file{"device_catalog_test.xml"};
+  writeFile(file, deviceXml);
+  auto catalog = DeviceCatalog::Instance();
+  auto first = catalog->deviceList(file.toStdString());
+  EXPECT_EQ(first->status, DeviceList::Ok);
+  EXPECT_EQ(catalog->deviceList(file.toStdString()), first);
+
+  writeFile(file, "<device_list><device name=\"other\"/></device_list>");
+  auto changed = catalog->deviceList(file.toStdString());
+  EXPECT_NE(changed, first);
+  EXPECT_EQ(changed->devices.size(), 1);
+
+  catalog->invalidate(file.toStdString());
+  EXPECT_NE(catalog->deviceList(file.toStdString()), changed);
+  QFile::remove(file);
+}
+
+TEST(DeviceCatalog, missingFile) {
+  auto list = DeviceCatalog::Instance()->deviceList("missing_device_list.xml");
+  EXPECT_EQ(list->status, DeviceList::CannotOpen);
+}
+
+TEST(DeviceCatalog, fixedLayouts) {
+  const QString file{"device_catalog_arch.xml"};
+  writeFile(file, R"(<architecture><layout>
+    <fixed_layout name="small" width="10" height="12"/>
+    <fixed_layout name="big" width="100" height="120"/>
+  </layout></architecture>)");
+  QString error{};
+  auto layouts =
+      DeviceCatalog::Instance()->fixedLayouts(file.toStdString(), error);
+  ASSERT_NE(layouts, nullptr);
+  EXPECT_EQ(layouts->size(), 2);
+  EXPECT_EQ(layouts->value("big").first, "100");
+  EXPECT_EQ(layouts->value("big").second, "120");
+  QFile::remove(file);
+}
+
+TEST(DeviceCatalog, resolve) {
+  namespace fs = std::filesystem;
+  const fs::path base{fs::absolute("device_catalog_base")};
+  const fs::path other{fs::absolute("device_catalog_other")};
+  fs::create_directories(base);
+  fs::create_directories(other);
+  const fs::path cwd = fs::current_path();
+  auto catalog = DeviceCatalog::Instance();
+
+  // a missing file is found once it is created
+  bool exists{true};
+  catalog->resolve(base, "resolve_arch.xml", exists);
+  EXPECT_FALSE(exists);
+  writeFile(QString::fromStdString((base / "resolve_arch.xml").string()), "");
+  EXPECT_EQ(catalog->resolve(base, "resolve_arch.xml", exists),
+            base / "resolve_arch.xml");
+  EXPECT_TRUE(exists);
+
+  // the working directory takes precedence and is part of the lookup
+  writeFile(QString::fromStdString((other / "resolve_arch.xml").string()), "");
+  fs::current_path(other);
+  EXPECT_EQ(fs::absolute(catalog->resolve(base, "resolve_arch.xml", exists)),
+            other / "resolve_arch.xml");
+  EXPECT_TRUE(exists);
+  fs::current_path(cwd);
+  EXPECT_EQ(catalog->resolve(base, "resolve_arch.xml", exists),
+            base / "resolve_arch.xml");
+
+  fs::remove_all(base);
+  fs::remove_all(other);
+  catalog->resolve(base, "resolve_arch.xml", exists);
+  EXPECT_FALSE(exists);
+}
@@ -75,30 +75,30 @@ TEST(PackagePinsLoader, LoadAllPins) {
   auto bank0 = model.pinData().at(0);
   EXPECT_EQ(bank0.name, "Bank 0");
   EXPECT_EQ(bank0.pinData.count(), 3);
-  EXPECT_EQ(bank0.pinData.at(0).data.at(PinName), "A1");
-  EXPECT_EQ(bank0.pinData.at(0).data.at(BallName), "A1");
-  EXPECT_EQ(bank0.pinData.at(1).data.at(PinName), "A2");
-  EXPECT_EQ(bank0.pinData.at(1).data.at(BallName), "A2");
-  EXPECT_EQ(bank0.pinData.at(2).data.at(PinName), "A3");
-  EXPECT_EQ(bank0.pinData.at(2).data.at(BallName), "A3");
+  EXPECT_EQ(bank0.pinData.value(0, PinName), "A1");
+  EXPECT_EQ(bank0.pinData.value(0, BallName), "A1");
+  EXPECT_EQ(bank0.pinData.value(1, PinName), "A2");
+  EXPECT_EQ(bank0.pinData.value(1, BallName), "A2");
+  EXPECT_EQ(bank0.pinData.value(2, PinName), "A3");
+  EXPECT_EQ(bank0.pinData.value(2, BallName), "A3");
 
   auto bank1 = model.pinData().at(1);
   EXPECT_EQ(bank1.name, "Bank 1");
   EXPECT_EQ(bank1.pinData.count(), 3);
-  EXPECT_EQ(bank1.pinData.at(0).data.at(PinName), "A4");
-  EXPECT_EQ(bank1.pinData.at(0).data.at(BallName), "A4");
-  EXPECT_EQ(bank1.pinData.at(1).data.at(PinName), "A5");
-  EXPECT_EQ(bank1.pinData.at(1).data.at(BallName), "A5");
-  EXPECT_EQ(bank1.pinData.at(2).data.at(PinName), "A6");
-  EXPECT_EQ(bank1.pinData.at(2).data.at(BallName), "A6");
+  EXPECT_EQ(bank1.pinData.value(0, PinName), "A4");
+  EXPECT_EQ(bank1.pinData.value(0, BallName), "A4");
+  EXPECT_EQ(bank1.pinData.value(1, PinName), "A5");
+  EXPECT_EQ(bank1.pinData.value(1, BallName), "A5");
+  EXPECT_EQ(bank1.pinData.value(2, PinName), "A6");
+  EXPECT_EQ(bank1.pinData.value(2, BallName), "A6");
 
   auto bank2 = model.pinData().at(2);
   EXPECT_EQ(bank2.name, "Bank 2");
   EXPECT_EQ(bank2.pinData.count(), 2);
-  EXPECT_EQ(bank2.pinData.at(0).data.at(PinName), "A7");
-  EXPECT_EQ(bank2.pinData.at(0).data.at(BallName), "A7");
-  EXPECT_EQ(bank2.pinData.at(1).data.at(PinName), "A8");
-  EXPECT_EQ(bank2.pinData.at(1).data.at(BallName), "A8");
+  EXPECT_EQ(bank2.pinData.value(0, PinName), "A7");
+  EXPECT_EQ(bank2.pinData.value(0, BallName), "A7");
+  EXPECT_EQ(bank2.pinData.value(1, PinName), "A8");
+  EXPECT_EQ(bank2.pinData.value(1, BallName), "A8");
 }
 
 TEST(PackagePinsLoader, LoadHeaderGeneral) {
@@ -0,0 +1,62 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PinAssignment/PackagePinsModel.h"
+
+#include "gtest/gtest.h"
+
+using namespace FOEDAG;
+
+TEST(PackagePinTable, Append) {
+  PackagePinTable table;
+  table.append({"A1", "bank0", "Y"});
+  table.append({"A2", "bank0"});
+  table.append({"A3", "bank1", "Y", "extra"});
+
+  EXPECT_EQ(table.count(), 3);
+  EXPECT_EQ(table.columnCount(), 4);
+  EXPECT_EQ(table.value(0, 0), "A1");
+  EXPECT_EQ(table.value(1, 1), "bank0");
+  EXPECT_EQ(table.value(1, 2), QString{});
+  EXPECT_EQ(table.value(0, 3), QString{});
+  EXPECT_EQ(table.value(2, 3), "extra");
+  EXPECT_EQ(table.value(3, 0), QString{});
+  EXPECT_EQ(table.value(0, 4), QString{});
+  EXPECT_EQ(table.row(1), (QStringList{"A2", "bank0", "", ""}));
+
+  table.clear();
+  EXPECT_EQ(table.count(), 0);
+  EXPECT_EQ(table.columnCount(), 0);
+}
+
+TEST(PackagePinsModel, ConvertPinNameUsage) {
+  PackagePinsModel model;
+  model.insertBallData("A1", "10");
+  model.insertBallData("A2", "20");
+
+  EXPECT_EQ(model.convertPinNameUsage("A1"), "A1");
+  EXPECT_EQ(model.convertPinNameUsage("20"), "A2");
+  EXPECT_EQ(model.convertPinNameUsage("unknown"), QString{});
+
+  model.setUseBallId(true);
+  EXPECT_EQ(model.convertPinNameUsage("A1"), "10");
+  EXPECT_EQ(model.convertPinNameUsage("20"), "20");
+}
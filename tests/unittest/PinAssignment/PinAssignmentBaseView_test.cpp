@@ -22,7 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "PinAssignment/PinAssignmentBaseView.h"
 
 #include <QComboBox>
-#include <QStringListModel>
+#include <QStyleOptionViewItem>
 
 #include "gtest/gtest.h"
 
@@ -33,113 +33,121 @@ class PinAssignmentBaseViewTest : public PinAssignmentBaseView {
   static constexpr int COL0{0};
   static constexpr int COL1{1};
   static constexpr int COL2{2};
-  QComboBox *combo0{nullptr};
-  QComboBox *combo1{nullptr};
   QTreeWidgetItem *item{nullptr};
+  QTreeWidgetItem *item2{nullptr};
+  QStringList changes;
   PinAssignmentBaseViewTest() : PinAssignmentBaseView{nullptr} {
     setColumnCount(3);
+    setIndexedColumn(COL0);
     item = new QTreeWidgetItem(this);
-    QStringListModel *model = new QStringListModel;
-    model->setStringList({"item0", "item1", "item2"});
-    combo0 = new QComboBox;
-    combo0->setModel(model);
-    setItemWidget(item, COL0, combo0);
-
-    combo1 = new QComboBox;
-    combo1->setModel(model);
-    setItemWidget(item, COL1, combo1);
-
+    setEditor(item, COL0, EditorEnabled);
+    setEditor(item, COL1, EditorDisabled);
     item->setText(COL2, "text");
+    item2 = new QTreeWidgetItem(this);
+    setEditor(item2, COL0, EditorEnabled);
   }
 
-  void setComboDataTest(const QModelIndex &index, const QString &data) {
-    setComboData(index, data);
+  void setComboDataTest(QTreeWidgetItem *i, int col, const QString &data) {
+    setComboData(i, col, data);
   }
-  void setComboDataTest(const QModelIndex &index, int col,
-                        const QString &data) {
-    setComboData(index, col, data);
+  void setComboTextTest(QTreeWidgetItem *i, int col, const QString &text,
+                        bool notify) {
+    setComboText(i, col, text, notify);
   }
-  QComboBox *GetComboTest(const QModelIndex &index) { return GetCombo(index); }
-  QComboBox *GetComboTest(const QModelIndex &index, int col) {
-    return GetCombo(index, col);
+  void removeDuplicationsTest(const QString &text, QTreeWidgetItem *current) {
+    removeDuplications(text, current);
   }
-  QComboBox *GetComboTest(QTreeWidgetItem *item, int col) {
-    return GetCombo(item, col);
+  QString comboTextTest(QTreeWidgetItem *i, int col) const {
+    return comboText(i, col);
+  }
+  QList<QTreeWidgetItem *> comboItemsTest(const QString &text) const {
+    return comboItems(text);
+  }
+  QModelIndex index(QTreeWidgetItem *i, int col) const {
+    return indexFromItem(i, col);
   }
-};
-
-TEST(PinAssignmentBaseView, setComboDataIndexOnlyValid) {
-  PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL0);
-  view.setComboDataTest(index, "item2");
-
-  EXPECT_EQ(view.combo0->currentIndex(), 2);
-  EXPECT_EQ(view.combo1->currentIndex(), 0);
-}
-
-TEST(PinAssignmentBaseView, setComboDataIndexOnlyInvalid) {
-  PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL0);
-  view.setComboDataTest(index, "anything");
-
-  EXPECT_EQ(view.combo0->currentIndex(), 0);
-  EXPECT_EQ(view.combo1->currentIndex(), 0);
-}
-
-TEST(PinAssignmentBaseView, setComboDataColumnOnlyValid) {
-  PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL0);
-  view.setComboDataTest(index, PinAssignmentBaseViewTest::COL1, "item2");
 
-  EXPECT_EQ(view.combo0->currentIndex(), 0);
-  EXPECT_EQ(view.combo1->currentIndex(), 2);
-}
+ protected:
+  QStringList choices(QTreeWidgetItem *, int column) const override {
+    if (column == COL2) return {};
+    return {"", "item0", "item1", "item2"};
+  }
+  void comboDataChanged(QTreeWidgetItem *, int column,
+                        const QString &previous) override {
+    changes.append(QString("%1:%2").arg(column).arg(previous));
+  }
+};
 
-TEST(PinAssignmentBaseView, setComboDataColumnOnlyInvalid) {
+TEST(PinAssignmentBaseView, setComboDataValid) {
   PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL0);
-  view.setComboDataTest(index, PinAssignmentBaseViewTest::COL1, "anything");
+  view.setComboDataTest(view.item, PinAssignmentBaseViewTest::COL1, "item2");
 
-  EXPECT_EQ(view.combo0->currentIndex(), 0);
-  EXPECT_EQ(view.combo1->currentIndex(), 0);
+  EXPECT_EQ(view.comboTextTest(view.item, PinAssignmentBaseViewTest::COL0),
+            QString{});
+  EXPECT_EQ(view.comboTextTest(view.item, PinAssignmentBaseViewTest::COL1),
+            "item2");
+  EXPECT_EQ(view.changes, QStringList{"1:"});
 }
 
-TEST(PinAssignmentBaseView, GetComboIndexValid) {
+TEST(PinAssignmentBaseView, setComboDataInvalid) {
   PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL0);
-  EXPECT_EQ(view.GetComboTest(index), view.combo0);
-}
+  view.setComboDataTest(view.item, PinAssignmentBaseViewTest::COL0,
+                        "anything");
 
-TEST(PinAssignmentBaseView, GetComboIndexInvalid) {
-  PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL2);
-  EXPECT_EQ(index.isValid(), true);
-  EXPECT_EQ(view.GetComboTest(index), nullptr);
+  EXPECT_EQ(view.comboTextTest(view.item, PinAssignmentBaseViewTest::COL0),
+            QString{});
+  EXPECT_TRUE(view.changes.isEmpty());
 }
 
-TEST(PinAssignmentBaseView, GetComboColumnValid) {
+TEST(PinAssignmentBaseView, ComboTextKeepsItemText) {
   PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL0);
-  EXPECT_EQ(view.GetComboTest(index, PinAssignmentBaseViewTest::COL1),
-            view.combo1);
-}
+  view.setComboTextTest(view.item, PinAssignmentBaseViewTest::COL2, "combo",
+                        false);
 
-TEST(PinAssignmentBaseView, GetComboColumnInvalid) {
-  PinAssignmentBaseViewTest view{};
-  auto index = view.model()->index(0, PinAssignmentBaseViewTest::COL0);
-  EXPECT_EQ(index.isValid(), true);
-  EXPECT_EQ(view.GetComboTest(index, PinAssignmentBaseViewTest::COL2), nullptr);
+  EXPECT_EQ(view.item->text(PinAssignmentBaseViewTest::COL2), "text");
+  EXPECT_EQ(view.comboTextTest(view.item, PinAssignmentBaseViewTest::COL2),
+            "combo");
+  EXPECT_TRUE(view.changes.isEmpty());
 }
 
-TEST(PinAssignmentBaseView, GetComboItemValid) {
+TEST(PinAssignmentBaseView, RemoveDuplications) {
   PinAssignmentBaseViewTest view{};
-  auto item = view.item;
-  EXPECT_EQ(view.GetComboTest(item, PinAssignmentBaseViewTest::COL1),
-            view.combo1);
+  view.setComboDataTest(view.item, PinAssignmentBaseViewTest::COL0, "item1");
+  view.setComboDataTest(view.item2, PinAssignmentBaseViewTest::COL0, "item1");
+  EXPECT_EQ(view.comboItemsTest("item1").count(), 2);
+
+  view.removeDuplicationsTest("item1", view.item2);
+  EXPECT_EQ(view.comboTextTest(view.item, PinAssignmentBaseViewTest::COL0),
+            QString{});
+  EXPECT_EQ(view.comboItemsTest("item1"),
+            QList<QTreeWidgetItem *>{view.item2});
+  EXPECT_EQ(view.changes, (QStringList{"0:", "0:", "0:item1"}));
 }
 
-TEST(PinAssignmentBaseView, GetComboItemInvalid) {
+TEST(PinAssignmentBaseView, EditorOnDemand) {
   PinAssignmentBaseViewTest view{};
-  auto item = view.item;
-  EXPECT_EQ(view.GetComboTest(item, PinAssignmentBaseViewTest::COL2), nullptr);
+  QWidget parent;
+  QStyleOptionViewItem option;
+  auto delegate = view.itemDelegate();
+
+  EXPECT_EQ(delegate->createEditor(
+                &parent, option,
+                view.index(view.item, PinAssignmentBaseViewTest::COL1)),
+            nullptr);  // disabled
+  EXPECT_EQ(delegate->createEditor(
+                &parent, option,
+                view.index(view.item, PinAssignmentBaseViewTest::COL2)),
+            nullptr);  // no editor
+
+  auto index = view.index(view.item, PinAssignmentBaseViewTest::COL0);
+  auto editor =
+      qobject_cast<QComboBox *>(delegate->createEditor(&parent, option, index));
+  ASSERT_NE(editor, nullptr);
+  EXPECT_EQ(editor->count(), 4);
+
+  editor->setCurrentIndex(2);
+  delegate->setModelData(editor, view.model(), index);
+  EXPECT_EQ(view.comboTextTest(view.item, PinAssignmentBaseViewTest::COL0),
+            "item1");
+  EXPECT_EQ(view.changes, QStringList{"0:"});
 }
@@ -26,17 +26,17 @@ using namespace FOEDAG;
 
 TEST(PinsBaseModel, PinMap) {
   PinsBaseModel model;
-  model.update("port1", "pin1");
-  model.update("port2", "pin2");
-  QMap<QString, QString> expectedMap{{"port1", "pin1"}, {"port2", "pin2"}};
-  QMap<QString, QString> actualMap = model.pinMap();
-  EXPECT_EQ(actualMap, expectedMap);
+  model.update("port1", "pin1", 0);
+  model.update("port2", "pin2", 0);
+  QMap<QString, std::pair<QString, int>> expectedMap{
+      {"port1", {"pin1", 0}}, {"port2", {"pin2", 0}}};
+  EXPECT_EQ(model.pinMap(), expectedMap);
 }
 
 TEST(PinsBaseModel, Exists) {
   PinsBaseModel model;
-  model.update("port1", "pin1");
-  model.update("port2", "pin2");
+  model.update("port1", "pin1", 0);
+  model.update("port2", "pin2", 0);
   EXPECT_EQ(model.exists("port2", "pin2"), true);
   EXPECT_EQ(model.exists("port1", "pin1"), true);
 
@@ -46,20 +46,47 @@ TEST(PinsBaseModel, Exists) {
 
 TEST(PinsBaseModel, UpdatePinEmpty) {
   PinsBaseModel model;
-  model.update("port1", "pin1");
-  model.update("port2", "pin2");
-  model.update("port1", QString{});
+  model.update("port1", "pin1", 0);
+  model.update("port2", "pin2", 0);
+  model.update("port1", QString{}, 0);
   EXPECT_EQ(model.exists("port2", "pin2"), true);
   EXPECT_EQ(model.exists("port1", "pin1"), false);
   EXPECT_EQ(model.exists("port1", QString{}), false);
+  EXPECT_EQ(model.getPort("pin1"), QStringList{});
 }
 
 TEST(PinsBaseModel, UpdatePortEmpty) {
   PinsBaseModel model;
-  model.update("port1", "pin1");
-  model.update("port2", "pin2");
-  model.update(QString{}, "pin1");
+  model.update("port1", "pin1", 0);
+  model.update("port2", "pin2", 0);
+  model.update(QString{}, "pin1", 0);
   EXPECT_EQ(model.exists("port2", "pin2"), true);
-  EXPECT_EQ(model.exists("port1", "pin1"), false);
+  EXPECT_EQ(model.exists("port1", "pin1"), true);
   EXPECT_EQ(model.exists("port1", QString{}), false);
 }
+
+TEST(PinsBaseModel, GetPort) {
+  PinsBaseModel model;
+  model.update("port2", "pin1", 0);
+  model.update("port1", "pin1", 1);
+  model.update("port3", "pin2", 0);
+  EXPECT_EQ(model.getPort("pin1"), (QStringList{"port1", "port2"}));
+  EXPECT_EQ(model.getPort("pin2"), QStringList{"port3"});
+  EXPECT_EQ(model.getPort("pin3"), QStringList{});
+
+  // reassigned port is removed from its previous pin
+  model.update("port2", "pin2", 1);
+  EXPECT_EQ(model.getPort("pin1"), QStringList{"port1"});
+  EXPECT_EQ(model.getPort("pin2"), (QStringList{"port2", "port3"}));
+}
+
+TEST(PinsBaseModel, GetIndex) {
+  PinsBaseModel model;
+  EXPECT_EQ(model.getIndex("pin1"), 0);
+  model.update("port1", "pin1", 0);
+  model.update("port2", "pin1", 1);
+  model.update("port3", "pin1", 2);
+  EXPECT_EQ(model.getIndex("pin1"), 3);
+  model.remove("port2", "pin1", 1);
+  EXPECT_EQ(model.getIndex("pin1"), 1);
+}
@@ -30,11 +30,11 @@ std::pair<bool, QString> TestLoader::load(const QString &fileName) {
   QStringList oneLine = QStringList::fromVector(tmp);
   PackagePinGroup group{};
   oneLine[PinName] = "pin1";
-  group.pinData.append({oneLine});
+  group.pinData.append(oneLine);
   oneLine[PinName] = "pin2";
-  group.pinData.append({oneLine});
+  group.pinData.append(oneLine);
   oneLine[PinName] = "pin3";
-  group.pinData.append({oneLine});
+  group.pinData.append(oneLine);
   m_model->append(group);
   m_model->initListModel();
 
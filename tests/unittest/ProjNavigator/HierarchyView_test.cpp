@@ -21,9 +21,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "ProjNavigator/HierarchyView.h"
 
-#include <QTreeWidget>
+#include <QTreeView>
 #include <QtTest/QSignalSpy>
 
+#include "ProjNavigator/HierarchyModel.h"
 #include "gtest/gtest.h"
 
 using namespace FOEDAG;
@@ -34,52 +35,119 @@ static const fs::path FilePathProj2{":/ProjNavigator/hier_info_1.json"};
 static const fs::path FilePathCorrupted{
     ":/ProjNavigator/hier_info_corrupted.json"};
 
+// the file is parsed in a worker, wait for the model update
+static bool waitUpdated(QSignalSpy &spy) {
+  return spy.count() > 0 || spy.wait(10000);
+}
+
+static bool load(HierarchyView &view, const fs::path &file) {
+  QSignalSpy spy{&view, &HierarchyView::updated};
+  view.setPortsFile(file);
+  return waitUpdated(spy);
+}
+
+// children are created when the view expands the item
+static int childCount(QAbstractItemModel *model, const QModelIndex &index) {
+  if (model->canFetchMore(index)) model->fetchMore(index);
+  return model->rowCount(index);
+}
+
 TEST(HierarchyView, constructor) {
   HierarchyView view{FilePathProj1};
+  QSignalSpy spy{&view, &HierarchyView::updated};
+  ASSERT_TRUE(waitUpdated(spy));
   ASSERT_NE(view.widget(), nullptr);
-  ASSERT_EQ(view.widget()->topLevelItemCount(), 1);
-  ASSERT_EQ(view.widget()->topLevelItem(0)->childCount(), 0);
+  auto model = view.model();
+  ASSERT_EQ(model->rowCount(), 1);
+  ASSERT_EQ(childCount(model, model->index(0, 0)), 0);
 }
 
 TEST(HierarchyView, setPortsFileCorruptedFile) {
   HierarchyView view{{}};
-  view.setPortsFile(FilePathCorrupted);
+  ASSERT_TRUE(load(view, FilePathCorrupted));
   ASSERT_NE(view.widget(), nullptr);
-  ASSERT_EQ(view.widget()->topLevelItemCount(), 0);
+  ASSERT_EQ(view.model()->rowCount(), 0);
 }
 
 TEST(HierarchyView, setPortsFile) {
-  HierarchyView view{FilePathProj1};
-  ASSERT_NE(view.widget(), nullptr);
-  ASSERT_EQ(view.widget()->topLevelItemCount(), 1);
-  ASSERT_EQ(view.widget()->topLevelItem(0)->childCount(), 0);
-
-  view.setPortsFile(FilePathProj2);
-  ASSERT_EQ(view.widget()->topLevelItemCount(), 1);
-  ASSERT_EQ(view.widget()->topLevelItem(0)->childCount(), 1);
-  ASSERT_EQ(view.widget()->topLevelItem(0)->child(0)->childCount(), 4);
-
-  auto child = view.widget()->topLevelItem(0)->child(0);
-  EXPECT_EQ(child->child(0)->childCount(), 0);
-  EXPECT_EQ(child->child(1)->childCount(), 4);
-  EXPECT_EQ(child->child(2)->childCount(), 0);
-  EXPECT_EQ(child->child(3)->childCount(), 16);
+  HierarchyView view{{}};
+  ASSERT_TRUE(load(view, FilePathProj1));
+  auto model = view.model();
+  ASSERT_EQ(model->rowCount(), 1);
+  ASSERT_EQ(childCount(model, model->index(0, 0)), 0);
+
+  ASSERT_TRUE(load(view, FilePathProj2));
+  const QModelIndex top = model->index(0, 0);
+  ASSERT_EQ(model->rowCount(), 1);
+  ASSERT_EQ(childCount(model, top), 1);
+  const QModelIndex u1 = model->index(0, 0, top);
+  ASSERT_EQ(childCount(model, u1), 4);
+
+  EXPECT_EQ(childCount(model, model->index(0, 0, u1)), 0);
+  EXPECT_EQ(childCount(model, model->index(1, 0, u1)), 4);
+  EXPECT_EQ(childCount(model, model->index(2, 0, u1)), 0);
+  EXPECT_EQ(childCount(model, model->index(3, 0, u1)), 16);
+
+  QModelIndex child = model->index(1, 0, u1);
+  for (int i = 0; i < 4; i++)
+    EXPECT_EQ(childCount(model, model->index(i, 0, child)), 4);
+
+  child = model->index(3, 0, u1);
+  for (int i = 0; i < 16; i++)
+    EXPECT_EQ(childCount(model, model->index(i, 0, child)), 28);
+}
 
-  child = view.widget()->topLevelItem(0)->child(0)->child(1);
-  for (int i = 0; i < 4; i++) EXPECT_EQ(child->child(i)->childCount(), 4);
+TEST(HierarchyView, lazyChildren) {
+  HierarchyView view{{}};
+  ASSERT_TRUE(load(view, FilePathProj2));
+  auto model = view.model();
+  const QModelIndex u1 = model->index(0, 0, model->index(0, 0));
+  EXPECT_TRUE(model->hasChildren(u1));
+  EXPECT_TRUE(model->canFetchMore(u1));
+  EXPECT_EQ(model->rowCount(u1), 0);
+  model->fetchMore(u1);
+  EXPECT_FALSE(model->canFetchMore(u1));
+  EXPECT_EQ(model->rowCount(u1), 4);
+  EXPECT_EQ(model->index(0, 0).data(HierarchyModel::TopItemRole).toBool(),
+            true);
+  EXPECT_EQ(u1.data(HierarchyModel::TopItemRole).toBool(), false);
+  EXPECT_EQ(u1.data(HierarchyModel::InstLineRole).toInt(), 18);
+}
 
-  child = view.widget()->topLevelItem(0)->child(0)->child(3);
-  for (int i = 0; i < 16; i++) EXPECT_EQ(child->child(i)->childCount(), 28);
+TEST(HierarchyView, updateKeepsExpanded) {
+  HierarchyView view{{}};
+  ASSERT_TRUE(load(view, FilePathProj2));
+  auto model = view.model();
+  const QModelIndex u1 = model->index(0, 0, model->index(0, 0));
+  view.widget()->expand(u1);
+  childCount(model, u1);
+  QPersistentModelIndex inner{model->index(3, 0, u1)};
+  view.widget()->expand(inner);
+  ASSERT_EQ(childCount(model, inner), 16);
+
+  QSignalSpy removed{model, &HierarchyModel::rowsRemoved};
+  QSignalSpy reset{model, &HierarchyModel::modelReset};
+  ASSERT_TRUE(load(view, FilePathProj2));
+  EXPECT_EQ(removed.count(), 0);
+  EXPECT_EQ(reset.count(), 0);
+  ASSERT_TRUE(inner.isValid());
+  EXPECT_TRUE(view.widget()->isExpanded(inner));
+  EXPECT_EQ(model->rowCount(inner), 16);
+
+  // the top module has other instances in this design
+  ASSERT_TRUE(load(view, FilePathProj1));
+  EXPECT_FALSE(inner.isValid());
+  EXPECT_EQ(model->rowCount(), 1);
+  EXPECT_EQ(childCount(model, model->index(0, 0)), 0);
 }
 
 TEST(HierarchyView, clean) {
-  HierarchyView view{FilePathProj1};
-  ASSERT_NE(view.widget(), nullptr);
-  ASSERT_EQ(view.widget()->topLevelItemCount(), 1);
-  ASSERT_EQ(view.widget()->topLevelItem(0)->childCount(), 0);
+  HierarchyView view{{}};
+  ASSERT_TRUE(load(view, FilePathProj1));
+  ASSERT_EQ(view.model()->rowCount(), 1);
 
   view.clean();
-  ASSERT_EQ(view.widget()->topLevelItemCount(), 0);
+  ASSERT_EQ(view.model()->rowCount(), 0);
 }
 
 TEST(HierarchyView, topModuleFile) {
@@ -87,7 +155,7 @@ TEST(HierarchyView, topModuleFile) {
   fs::path expectedPath{":/ProjNavigator/dut.v"};
   expectedPath = expectedPath.lexically_normal();
   QSignalSpy signalSpy{&view, &HierarchyView::topModuleFile};
-  view.setPortsFile(FilePathProj1);
+  ASSERT_TRUE(load(view, FilePathProj1));
 
   EXPECT_EQ(signalSpy.count(), 1);
   auto arguments = signalSpy.takeFirst();
@@ -0,0 +1,140 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Simulation/SimulationModelCache.h"
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace fs = std::filesystem;
+using namespace FOEDAG;
+
+class SimulationModelCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    fs::remove_all(m_dir);
+    fs::create_directories(m_dir / "include");
+    write("tb.v", "module tb; endmodule\n");
+    write("include/defs.vh", "`define WIDTH 8\n");
+  }
+  void TearDown() override { fs::remove_all(m_dir); }
+  void write(const std::string& file, const std::string& content) {
+    std::ofstream{m_dir / file} << content;
+  }
+  std::string key(SimulationModelCache& cache,
+                  const std::string& settings = "iverilog -s tb") {
+    return cache.key({"-DRTL_SIM=1", "-Iinclude", "tb.v"}, m_dir, settings,
+                     {});
+  }
+  const fs::path m_dir{"model_cache_test"};
+};
+
+TEST_F(SimulationModelCacheTest, HitAfterStore) {
+  SimulationModelCache cache{m_dir};
+  const std::string first = key(cache);
+  EXPECT_FALSE(cache.hit(first));
+  EXPECT_TRUE(cache.store(first));
+
+  // a new instance reads the manifest back
+  SimulationModelCache reloaded{m_dir};
+  EXPECT_TRUE(reloaded.hit(key(reloaded)));
+  EXPECT_FALSE(reloaded.hit(key(reloaded, "iverilog -s other")));
+  reloaded.invalidate();
+  EXPECT_FALSE(reloaded.hit(first));
+}
+
+TEST_F(SimulationModelCacheTest, SourceChangesMiss) {
+  SimulationModelCache cache{m_dir};
+  const std::string first = key(cache);
+  cache.store(first);
+
+  write("tb.v", "module tb; initial $finish; endmodule\n");
+  const std::string source = key(cache);
+  EXPECT_NE(source, first);
+
+  write("include/defs.vh", "`define WIDTH 16\n");
+  EXPECT_NE(key(cache), source);
+}
+
+TEST_F(SimulationModelCacheTest, FileListChangesMiss) {
+  fs::create_directories(m_dir / "lists");
+  write("dut.v", "module dut; endmodule\n");
+  write("lists/nested.f", "// nested list, relative to the list\n../dut.v\n");
+  write("sources.f", "tb.v\n-F lists/nested.f\n");
+  SimulationModelCache cache{m_dir};
+  auto listKey = [&]() {
+    return cache.key({"-f", "sources.f"}, m_dir, "verilator", {});
+  };
+  const std::string first = listKey();
+  cache.store(first);
+  EXPECT_EQ(listKey(), first);
+
+  // a file named in the list changes
+  write("tb.v", "module tb; initial $finish; endmodule\n");
+  const std::string source = listKey();
+  EXPECT_NE(source, first);
+
+  // a file named in a nested -F list changes
+  write("dut.v", "module dut(input clk); endmodule\n");
+  EXPECT_NE(listKey(), source);
+}
+
+TEST_F(SimulationModelCacheTest, SearchedHeaderChangesMiss) {
+  fs::create_directories(m_dir / "rtl" / "sub");
+  write("rtl/top.sv", "`include \"sub/defs.svh\"\nmodule top; endmodule\n");
+  write("rtl/sub/defs.svh", "`define DEPTH 4\n");
+  write("rtl/local.svh", "`define MODE 1\n");
+  SimulationModelCache cache{m_dir};
+  auto sourceKey = [&]() {
+    return cache.key({"verilator", "rtl/top.sv"}, m_dir, "verilator", {});
+  };
+  const std::string first = sourceKey();
+  cache.store(first);
+
+  // included by a subpath of the source directory
+  write("rtl/sub/defs.svh", "`define DEPTH 16\n");
+  const std::string subpath = sourceKey();
+  EXPECT_NE(subpath, first);
+
+  // next to the source
+  write("rtl/local.svh", "`define MODE 10\n");
+  EXPECT_NE(sourceKey(), subpath);
+}
+
+TEST_F(SimulationModelCacheTest, DependencyFileInputs) {
+  fs::create_directories(m_dir / "obj_dir");
+  fs::create_directories(m_dir / "shared");
+  write("shared/pkg.svh", "`define PKG 1\n");
+  write("obj_dir/Vtb__ver.d",
+        "obj_dir/Vtb.cpp obj_dir/Vtb.h : \\\n  tb.v \\\n  shared/pkg.svh\n");
+  SimulationModelCache cache{m_dir};
+  const std::string first = key(cache);
+  EXPECT_TRUE(cache.store(first, m_dir / "obj_dir" / "Vtb__ver.d"));
+
+  // outputs below the model directory do not change the key
+  write("obj_dir/Vtb.cpp", "// generated\n");
+  SimulationModelCache reloaded{m_dir};
+  EXPECT_TRUE(reloaded.hit(key(reloaded)));
+  write("shared/pkg.svh", "`define PKG 100\n");
+  SimulationModelCache changed{m_dir};
+  EXPECT_FALSE(changed.hit(key(changed)));
+}
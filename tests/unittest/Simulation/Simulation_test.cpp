@@ -20,6 +20,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "Simulation/Simulator.h"
+
+#include <sstream>
+
 #include "gtest/gtest.h"
 
 using namespace FOEDAG;
@@ -124,3 +127,54 @@ TEST(Simulator, UserSimulationType) {
   EXPECT_EQ(simulator, Simulator::SimulatorType::Verilator);
   EXPECT_EQ(ok, false);
 }
+
+TEST(Simulator, ReadRegressionTests) {
+  std::istringstream in{
+      "# name top plusargs\n"
+      "smoke tb_top\n"
+      "\n"
+      "seed_1  tb_top +SEED=1 +VERBOSE\n"
+      "other\ttb_other\n"};
+  std::vector<Simulator::RegressionTest> tests;
+  std::string error;
+  EXPECT_TRUE(Simulator::ReadRegressionTests(in, tests, error));
+  ASSERT_EQ(tests.size(), 3);
+  EXPECT_EQ(tests.at(0).name, "smoke");
+  EXPECT_TRUE(tests.at(0).plusargs.empty());
+  EXPECT_EQ(tests.at(1).top, "tb_top");
+  EXPECT_EQ(tests.at(1).plusargs,
+            std::vector<std::string>({"+SEED=1", "+VERBOSE"}));
+  EXPECT_EQ(tests.at(2).top, "tb_other");
+
+  std::istringstream missingTop{"smoke tb_top\nbroken\n"};
+  EXPECT_FALSE(Simulator::ReadRegressionTests(missingTop, tests, error));
+  EXPECT_EQ(error, "Line 2: expected <name> <top> ?<plusarg>...?");
+}
+
+TEST(Simulator, IsValidRegressionTestName) {
+  EXPECT_TRUE(Simulator::IsValidRegressionTestName("seed_1"));
+  EXPECT_TRUE(Simulator::IsValidRegressionTestName("smoke.fast"));
+  EXPECT_FALSE(Simulator::IsValidRegressionTestName(""));
+  EXPECT_FALSE(Simulator::IsValidRegressionTestName("."));
+  EXPECT_FALSE(Simulator::IsValidRegressionTestName(".."));
+  EXPECT_FALSE(Simulator::IsValidRegressionTestName("../escape"));
+  EXPECT_FALSE(Simulator::IsValidRegressionTestName("/tmp/abs"));
+  EXPECT_FALSE(Simulator::IsValidRegressionTestName("sub\\dir"));
+  EXPECT_FALSE(Simulator::IsValidRegressionTestName("C:name"));
+}
+
+TEST(Simulator, RegressionSummary) {
+  using Result = Simulator::RegressionResult;
+  std::vector<Result> results(3);
+  results[0] = {"smoke", "tb_top", Result::Pass, 0,
+                std::chrono::milliseconds{10}, "smoke/sim.rpt"};
+  results[1] = {"seed_1", "tb_top", Result::Fail, 3,
+                std::chrono::milliseconds{20}, "seed_1/sim.rpt"};
+  results[2] = {"other", "tb_other", Result::BuildFailed};
+  const std::string summary = Simulator::RegressionSummary(results);
+  EXPECT_NE(summary.find("smoke   tb_top    PASS"), std::string::npos);
+  EXPECT_NE(summary.find("FAIL (3)"), std::string::npos);
+  EXPECT_NE(summary.find("BUILD FAILED"), std::string::npos);
+  EXPECT_NE(summary.find("Tests: 3, passed: 1, failed: 2, run time: 30 ms"),
+            std::string::npos);
+}
@@ -0,0 +1,178 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/EventBus.h"
+
+#include <fstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+using namespace FOEDAG;
+
+TEST(EventBus, noConsumer) {
+  EXPECT_FALSE(EventBus::isEnabled());
+  EventBus::progress("test", "step", 1, 2);
+  EventBus::attach();
+  std::vector<FlowEvent> events;
+  EXPECT_EQ(EventBus::drain(events), 0);
+  EventBus::detach();
+}
+
+TEST(EventBus, order) {
+  EventBus::attach();
+  EventBus::stageStart("compiler", "Synthesis");
+  EventBus::progress("compiler", "Synthesis", 1, 10);
+  EventBus::message("compiler", "info", "hello");
+  EventBus::stageEnd("compiler", "Synthesis", true);
+  std::vector<FlowEvent> events;
+  EXPECT_EQ(EventBus::drain(events), 4);
+  EventBus::detach();
+  ASSERT_EQ(events.size(), 4);
+  EXPECT_EQ(events[0].type, FlowEvent::Type::StageStart);
+  EXPECT_EQ(events[1].type, FlowEvent::Type::Progress);
+  EXPECT_EQ(events[2].text, "hello");
+  EXPECT_EQ(events[3].type, FlowEvent::Type::StageEnd);
+  EXPECT_EQ(events[3].value, 1);
+  for (size_t i = 1; i < events.size(); i++)
+    EXPECT_LT(events[i - 1].sequence, events[i].sequence);
+}
+
+TEST(EventBus, dropOldest) {
+  EventBus::attach();
+  EventBus::stageStart("compiler", "Routing");
+  const size_t count = EventBus::Capacity + 100;
+  for (size_t i = 0; i < count; i++)
+    EventBus::progress("compiler", "Routing", i, count);
+  std::vector<FlowEvent> events;
+  EventBus::drain(events);
+  EventBus::detach();
+  EXPECT_EQ(EventBus::dropped(), 100);
+  ASSERT_EQ(events.size(), EventBus::Capacity + 1);
+  EXPECT_EQ(events.front().type, FlowEvent::Type::StageStart);
+  EXPECT_EQ(events[1].value, 100);
+  EXPECT_EQ(events.back().value, count - 1);
+}
+
+TEST(EventBus, coalesce) {
+  EventBus::attach();
+  EventBus::logChunk("compiler", "line 1\n");
+  EventBus::progress("simulator", "rtl", 1, 3);
+  EventBus::logChunk("compiler", "line 2\n");
+  EventBus::stageStart("simulator", "gate");
+  EventBus::progress("simulator", "rtl", 2, 3);
+  EventBus::progress("simulator", "gate", 1, 3);
+  EventBus::logChunk("compiler", "line 3\n");
+  EventBus::metric("compiler", "duration_ms", 5);
+  std::vector<FlowEvent> events;
+  EventBus::drain(events);
+  EventBus::detach();
+  EventBus::coalesce(events);
+  ASSERT_EQ(events.size(), 5);
+  EXPECT_EQ(events[0].type, FlowEvent::Type::StageStart);
+  EXPECT_EQ(events[1].name, "rtl");
+  EXPECT_EQ(events[1].value, 2);
+  EXPECT_EQ(events[2].name, "gate");
+  EXPECT_EQ(events[3].text, "line 1\nline 2\nline 3\n");
+  EXPECT_EQ(events[4].type, FlowEvent::Type::Metric);
+}
+
+TEST(EventBus, stream) {
+  EventBus::attach();
+  {
+    EventBusStream out{"compiler"};
+    out << "partial";
+    out << " line\nnext";
+  }
+  std::vector<FlowEvent> events;
+  EventBus::drain(events);
+  EventBus::detach();
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0].text, "partial line\n");
+  EXPECT_EQ(events[1].text, "next");
+  EXPECT_EQ(events[1].type, FlowEvent::Type::LogChunk);
+}
+
+TEST(EventBus, producers) {
+  EventBus::attach();
+  constexpr int perThread{20000};
+  auto work = [](const std::string &source) {
+    for (int i = 0; i < perThread; i++) {
+      if (i % 1000 == 0)
+        EventBus::message(source, "info", std::to_string(i));
+      else
+        EventBus::progress(source, "step", i, perThread);
+    }
+  };
+  std::atomic<bool> done{false};
+  size_t messages{0};
+  size_t received{0};
+  std::thread consumer{[&]() {
+    std::vector<FlowEvent> events;
+    bool last{false};
+    while (!last) {
+      last = done.load();
+      events.clear();
+      received += EventBus::drain(events);
+      for (const auto &e : events)
+        if (e.type == FlowEvent::Type::Message) messages++;
+    }
+  }};
+  std::thread t1{work, "compiler"};
+  std::thread t2{work, "simulator"};
+  std::thread t3{work, "programmer"};
+  t1.join();
+  t2.join();
+  t3.join();
+  done = true;
+  consumer.join();
+  EventBus::detach();
+  EXPECT_EQ(messages, 60);
+  EXPECT_EQ(received + EventBus::dropped(), 3 * perThread);
+}
+
+TEST(EventBus, eventLog) {
+  std::string error;
+  const std::string file{"event_log_test.jsonl"};
+  ASSERT_TRUE(EventLog::start(file, error)) << error;
+  EXPECT_TRUE(EventBus::isEnabled());
+  EXPECT_FALSE(EventLog::start(file, error));
+  EventBus::stageStart("compiler", "Placement");
+  EventBus::message("compiler", "error", "bad \"pin\"\n");
+  EventBus::progress("programmer", "fpga", 50, 100);
+  ASSERT_TRUE(EventLog::stop(error)) << error;
+  EXPECT_FALSE(EventBus::isEnabled());
+  EXPECT_FALSE(EventLog::stop(error));
+
+  std::ifstream in{file};
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(in, line);) lines.push_back(line);
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_NE(lines[0].find(
+                "\"type\":\"stage_start\",\"source\":\"compiler\","
+                "\"name\":\"Placement\"}"),
+            std::string::npos);
+  EXPECT_NE(
+      lines[1].find("\"name\":\"error\",\"text\":\"bad \\\"pin\\\"\\n\"}"),
+      std::string::npos);
+  EXPECT_NE(lines[2].find("\"value\":50,\"total\":100}"), std::string::npos);
+  in.close();
+  std::filesystem::remove(file);
+}
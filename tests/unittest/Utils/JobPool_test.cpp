@@ -0,0 +1,169 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/JobPool.h"
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+using namespace FOEDAG;
+
+TEST(JobPool, results) {
+  JobPool pool{3};
+  EXPECT_EQ(pool.size(), 3);
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 20; i++) {
+    auto square = [i](const CancellationToken &) { return i * i; };
+    futures.push_back(pool.submit("square", square));
+  }
+  for (int i = 0; i < 20; i++) EXPECT_EQ(futures[i].get(), i * i);
+  auto failed = pool.submit("throw", [](const CancellationToken &) {
+    throw std::runtime_error("failed");
+  });
+  EXPECT_THROW(failed.get(), std::runtime_error);
+}
+
+TEST(JobPool, fixedThreads) {
+  JobPool pool{2};
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 8; i++) {
+    futures.push_back(pool.submit("busy", [&](const CancellationToken &) {
+      const int now = ++running;
+      int max = maxRunning.load();
+      while (now > max && !maxRunning.compare_exchange_weak(max, now)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{5});
+      running--;
+    }));
+  }
+  for (auto &f : futures) f.get();
+  EXPECT_LE(maxRunning.load(), 2);
+}
+
+TEST(JobPool, cancel) {
+  JobPool pool{1};
+  std::promise<void> started;
+  CancellationToken running;
+  auto first = pool.submit(
+      "running",
+      [&started](const CancellationToken &token) {
+        started.set_value();
+        int steps{0};
+        while (!token.isCancelled()) {
+          std::this_thread::sleep_for(std::chrono::milliseconds{1});
+          steps++;
+        }
+        return steps;
+      },
+      running);
+  CancellationToken queued;
+  bool ran{false};
+  auto second = pool.submit(
+      "queued", [&ran](const CancellationToken &) { ran = true; }, queued);
+  started.get_future().wait();
+  EXPECT_EQ(pool.pending(), 1);
+  pool.cancelAll();
+  EXPECT_TRUE(running.isCancelled());
+  EXPECT_TRUE(queued.isCancelled());
+  EXPECT_GE(first.get(), 0);
+  EXPECT_THROW(second.get(), JobCancelled);
+  EXPECT_FALSE(ran);
+
+  // a cancelled token does not affect the next jobs
+  EXPECT_EQ(pool.submit("next", [](const CancellationToken &) { return 1; })
+                .get(),
+            1);
+}
+
+TEST(JobPool, nested) {
+  JobPool pool{1};
+  auto outer = pool.submit("outer", [&pool](const CancellationToken &) {
+    auto inner =
+        pool.submit("inner", [](const CancellationToken &) { return 2; });
+    return inner.get() + 1;
+  });
+  ASSERT_EQ(outer.wait_for(std::chrono::seconds{5}), std::future_status::ready);
+  EXPECT_EQ(outer.get(), 3);
+}
+
+TEST(JobPool, parallelFor) {
+  JobPool pool{3};
+  std::vector<int> squares(30);
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  // from a worker, nested jobs still run on the other workers
+  auto outer = pool.submit("outer", [&](const CancellationToken &) {
+    pool.parallelFor("square", squares.size(), 0,
+                     [&](size_t i, const CancellationToken &) {
+                       int now = ++running;
+                       int max = maxRunning;
+                       while (now > max &&
+                              !maxRunning.compare_exchange_weak(max, now)) {
+                       }
+                       std::this_thread::sleep_for(
+                           std::chrono::milliseconds{5});
+                       squares[i] = static_cast<int>(i * i);
+                       running--;
+                     });
+  });
+  ASSERT_EQ(outer.wait_for(std::chrono::seconds{5}), std::future_status::ready);
+  outer.get();
+  for (size_t i = 0; i < squares.size(); i++)
+    EXPECT_EQ(squares[i], static_cast<int>(i * i));
+  EXPECT_GE(maxRunning, 2);
+  EXPECT_LE(maxRunning, 3);
+
+  EXPECT_THROW(pool.parallelFor("throw", 4, 2,
+                                [](size_t i, const CancellationToken &) {
+                                  if (i == 2)
+                                    throw std::runtime_error("failed");
+                                }),
+               std::runtime_error);
+}
+
+TEST(JobPool, timingHook) {
+  std::mutex mutex;
+  std::vector<JobTiming> timings;
+  {
+    JobPool pool{1};
+    pool.setTimingHook([&](const JobTiming &timing) {
+      std::lock_guard<std::mutex> lock{mutex};
+      timings.push_back(timing);
+    });
+    pool.submit("sleep", [](const CancellationToken &) {
+          std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }).get();
+    CancellationToken token;
+    token.cancel();
+    auto skipped =
+        pool.submit("skipped", [](const CancellationToken &) {}, token);
+    EXPECT_THROW(skipped.get(), JobCancelled);
+  }
+  ASSERT_EQ(timings.size(), 2);
+  EXPECT_EQ(timings[0].name, "sleep");
+  EXPECT_GE(timings[0].runMs(), 20);
+  EXPECT_GE(timings[0].waitMs(), 0);
+  EXPECT_FALSE(timings[0].cancelled);
+  EXPECT_EQ(timings[1].name, "skipped");
+  EXPECT_TRUE(timings[1].cancelled);
+}
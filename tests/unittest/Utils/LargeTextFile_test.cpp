@@ -0,0 +1,152 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/LargeTextFile.h"
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace fs = std::filesystem;
+using namespace FOEDAG;
+
+static void writeFile(const fs::path& file, const std::string& content) {
+  std::ofstream ofs{file, std::ios::binary};
+  ofs << content;
+}
+
+TEST(LargeTextFile, IndexLines) {
+  fs::path file{"large_text_file_lines.rpt"};
+  writeFile(file, "first\r\nsecond\n\nlast line\n");
+  LargeTextFile text;
+  std::string error;
+  ASSERT_TRUE(text.open(file, error)) << error;
+  EXPECT_EQ(text.size(), fs::file_size(file));
+  EXPECT_EQ(text.line(0), std::string_view{});  // not indexed yet
+
+  std::atomic<bool> stop{false};
+  text.indexLines(stop);
+  EXPECT_TRUE(text.indexed());
+  ASSERT_EQ(text.lineCount(), 4);
+  EXPECT_EQ(text.line(0), "first");
+  EXPECT_EQ(text.line(1), "second");
+  EXPECT_EQ(text.line(2), "");
+  EXPECT_EQ(text.line(3), "last line");
+  EXPECT_EQ(text.line(4), "");
+  EXPECT_EQ(text.lineOffset(1), 7);
+  EXPECT_EQ(text.lineAt(0), 0);
+  EXPECT_EQ(text.lineAt(8), 1);
+  EXPECT_EQ(text.lineAt(text.size() - 1), 3);
+  EXPECT_EQ(text.maxLineLength(), 10);
+}
+
+TEST(LargeTextFile, IndexManyLines) {
+  fs::path file{"large_text_file_many.rpt"};
+  std::string content;
+  for (int i = 0; i < 100000; i++) content += std::to_string(i) + "\n";
+  content += "no line break";
+  writeFile(file, content);
+  LargeTextFile text;
+  std::string error;
+  ASSERT_TRUE(text.open(file, error)) << error;
+  std::atomic<bool> stop{false};
+  text.indexLines(stop);
+  ASSERT_EQ(text.lineCount(), 100001);
+  EXPECT_EQ(text.line(12345), "12345");
+  EXPECT_EQ(text.line(100000), "no line break");
+}
+
+TEST(LargeTextFile, Find) {
+  fs::path file{"large_text_file_find.rpt"};
+  writeFile(file, "Slack: -0.5\nslack: 1.0\nSLACK: 2.0\n");
+  LargeTextFile text;
+  std::string error;
+  ASSERT_TRUE(text.open(file, error)) << error;
+
+  EXPECT_EQ(text.find("slack", 0, true, true), 12);
+  EXPECT_EQ(text.find("slack", 0, true, false), 0);
+  EXPECT_EQ(text.find("slack", 1, true, false), 12);
+  EXPECT_EQ(text.find("slack", text.size(), false, false), 23);
+  EXPECT_EQ(text.find("slack", 23, false, false), 12);
+  EXPECT_EQ(text.find("slack", 12, false, true), LargeTextFile::npos);
+  EXPECT_EQ(text.find("hold", 0, true, false), LargeTextFile::npos);
+  // bounded search, as used to wrap around
+  EXPECT_EQ(text.find("slack", 0, true, true, nullptr, 16),
+            LargeTextFile::npos);
+  EXPECT_EQ(text.find("slack", 0, true, true, nullptr, 17), 12);
+  EXPECT_EQ(text.find("slack", text.size(), false, true, nullptr, 13),
+            LargeTextFile::npos);
+  EXPECT_EQ(text.find("slack", text.size(), false, true, nullptr, 12),
+            12);
+}
+
+TEST(LargeTextFile, FindAcrossBlocks) {
+  fs::path file{"large_text_file_blocks.rpt"};
+  std::string content(3 * 1024 * 1024, 'x');
+  // spans the boundary of the first read block
+  content.replace(1024 * 1024 - 3, 6, "needle");
+  writeFile(file, content);
+  LargeTextFile text;
+  std::string error;
+  ASSERT_TRUE(text.open(file, error)) << error;
+  EXPECT_EQ(text.find("needle", 0, true, true), 1024 * 1024 - 3);
+  EXPECT_EQ(text.find("NEEDLE", text.size(), false, false),
+            1024 * 1024 - 3);
+  std::atomic<bool> stop{true};
+  EXPECT_EQ(text.find("needle", 0, true, true, &stop), LargeTextFile::npos);
+}
+
+TEST(LargeTextFile, TruncatedWhileOpen) {
+  fs::path file{"large_text_file_truncated.rpt"};
+  writeFile(file, "first\nsecond\nthird\n");
+  LargeTextFile text;
+  std::string error;
+  ASSERT_TRUE(text.open(file, error)) << error;
+  std::atomic<bool> stop{false};
+  text.indexLines(stop);
+  ASSERT_EQ(text.lineCount(), 3);
+  // a tool rewrites its log on rerun
+  writeFile(file, "new\n");
+  EXPECT_EQ(text.line(0), "new");
+  EXPECT_EQ(text.line(2), "");
+  EXPECT_EQ(text.find("third", 0, true, true), LargeTextFile::npos);
+}
+
+TEST(LargeTextFile, EmptyFile) {
+  fs::path file{"large_text_file_empty.rpt"};
+  writeFile(file, {});
+  LargeTextFile text;
+  std::string error;
+  ASSERT_TRUE(text.open(file, error)) << error;
+  std::atomic<bool> stop{false};
+  text.indexLines(stop);
+  EXPECT_EQ(text.lineCount(), 1);
+  EXPECT_EQ(text.line(0), "");
+  EXPECT_EQ(text.find("x", 0, true, true), LargeTextFile::npos);
+}
+
+TEST(LargeTextFile, MissingFile) {
+  LargeTextFile text;
+  std::string error;
+  EXPECT_FALSE(text.open("large_text_file_missing.rpt", error));
+  EXPECT_FALSE(error.empty());
+  EXPECT_FALSE(text.isOpen());
+}
@@ -0,0 +1,83 @@
+/*
+Copyright 2022 The Foedag team
+
+GPL License
+
+Copyright (c) 2022 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/LogUtils.h"
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace fs = std::filesystem;
+using namespace FOEDAG;
+
+static std::string readFile(const fs::path& file) {
+  std::ifstream ifs{file};
+  return {std::istreambuf_iterator<char>(ifs),
+          std::istreambuf_iterator<char>()};
+}
+
+static size_t count(const std::string& str, const std::string& what) {
+  size_t result{0};
+  for (auto pos = str.find(what); pos != std::string::npos;
+       pos = str.find(what, pos + 1))
+    result++;
+  return result;
+}
+
+TEST(LogUtils, OpenLogPrintsHeaderFirst) {
+  fs::path file{"log_utils_open.rpt"};
+  {
+    std::ofstream log;
+    ASSERT_TRUE(LogUtils::OpenLog(log, file));
+    log << "first run\n";
+  }
+  {
+    std::ofstream log;
+    ASSERT_TRUE(LogUtils::OpenLog(log, file, true));
+    log << "appended\n";
+  }
+  const std::string content = readFile(file);
+  EXPECT_EQ(count(content, "Log Time"), 1);
+  EXPECT_LT(content.find("Log Time"), content.find("first run"));
+  EXPECT_NE(content.find("first run\nappended\n"), std::string::npos);
+  fs::remove(file);
+}
+
+TEST(LogUtils, AddHeaderToEmptyLog) {
+  fs::path file{"log_utils_empty.rpt"};
+  std::ofstream{file};
+  LogUtils::AddHeaderToLog(file);
+  EXPECT_NE(readFile(file).find("Log Time"), std::string::npos);
+  EXPECT_FALSE(fs::exists(LogUtils::HeaderPath(file)));
+  fs::remove(file);
+}
+
+TEST(LogUtils, AddHeaderToToolLogUsesSidecar) {
+  fs::path file{"log_utils_tool.rpt"};
+  const std::string toolOutput{"written by a tool\n"};
+  std::ofstream{file} << toolOutput;
+  LogUtils::AddHeaderToLog(file);
+  EXPECT_EQ(readFile(file), toolOutput);
+  const fs::path header = LogUtils::HeaderPath(file);
+  EXPECT_NE(readFile(header).find("Log Time"), std::string::npos);
+  fs::remove(file);
+  fs::remove(header);
+}
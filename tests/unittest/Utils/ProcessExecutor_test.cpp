@@ -0,0 +1,129 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/ProcessExecutor.h"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+using namespace FOEDAG;
+
+TEST(ProcessExecutor, SplitCommand) {
+  using Args = std::vector<std::string>;
+  EXPECT_EQ(ProcessExecutor::SplitCommand("vpr  arch.xml\tdesign.blif"),
+            Args({"vpr", "arch.xml", "design.blif"}));
+  EXPECT_EQ(ProcessExecutor::SplitCommand("tool -p \"a b\" \"c\" \"\" x"),
+            Args({"tool", "-p", "a b", "c", "", "x"}));
+  EXPECT_EQ(ProcessExecutor::SplitCommand("cc -DX=\"s\" \"a b\"c"),
+            Args({"cc", "-DX=\"s\"", "a bc"}));
+  EXPECT_TRUE(ProcessExecutor::SplitCommand("  ").empty());
+}
+
+TEST(ProcessExecutor, JoinCommand) {
+  const std::vector<std::string> argv{"tool", "a b", "", "c"};
+  const std::string command = ProcessExecutor::JoinCommand(argv);
+  EXPECT_EQ(command, "tool \"a b\" \"\" c");
+  EXPECT_EQ(ProcessExecutor::SplitCommand(command), argv);
+}
+
+#ifndef _WIN32
+TEST(ProcessExecutor, WorkingDirAndEnvironment) {
+  const auto dir = std::filesystem::temp_directory_path();
+  ProcessExecutor executor;
+  std::ostringstream out;
+  ProcessRequest request{};
+  request.argv = {"/bin/sh", "-c", "pwd; echo $FOEDAG_EXECUTOR_TEST"};
+  request.workingDir = dir;
+  request.environment = {{"FOEDAG_EXECUTOR_TEST", "value"}};
+  request.out = {&out};
+  const auto cwd = std::filesystem::current_path();
+  auto result = executor.run(request);
+  EXPECT_EQ(result.status, ProcessResult::Finished);
+  EXPECT_EQ(result.code(), 0);
+  EXPECT_EQ(std::filesystem::current_path(), cwd);
+  std::istringstream lines{out.str()};
+  std::string pwd, env;
+  std::getline(lines, pwd);
+  std::getline(lines, env);
+  EXPECT_TRUE(std::filesystem::equivalent(pwd, dir));
+  EXPECT_EQ(env, "value");
+}
+
+TEST(ProcessExecutor, ExitCodeAndStderr) {
+  ProcessExecutor executor;
+  std::ostringstream err;
+  ProcessRequest request{};
+  request.argv = {"/bin/sh", "-c", "echo failed >&2; exit 3"};
+  request.err = {&err};
+  auto result = executor.run(request);
+  EXPECT_EQ(result.code(), 3);
+  EXPECT_EQ(err.str(), "failed\n");
+}
+
+TEST(ProcessExecutor, FailedToStart) {
+  ProcessExecutor executor;
+  ProcessRequest request{};
+  request.argv = {"foedag_missing_executable"};
+  auto result = executor.run(request);
+  EXPECT_EQ(result.status, ProcessResult::FailedToStart);
+  EXPECT_EQ(result.code(), -1);
+}
+
+TEST(ProcessExecutor, Timeout) {
+  ProcessExecutor executor;
+  ProcessRequest request{};
+  request.argv = {"/bin/sh", "-c", "sleep 10"};
+  request.timeoutMs = 100;
+  auto result = executor.run(request);
+  EXPECT_EQ(result.status, ProcessResult::Timeout);
+}
+
+TEST(ProcessExecutor, Cancel) {
+  ProcessExecutor executor;
+  ProcessResult result{};
+  std::thread worker{[&]() {
+    ProcessRequest request{};
+    request.argv = {"/bin/sh", "-c", "sleep 10"};
+    request.started = [&executor](int64_t) { executor.cancel(); };
+    result = executor.run(request);
+  }};
+  worker.join();
+  EXPECT_EQ(result.status, ProcessResult::Cancelled);
+}
+
+TEST(ProcessExecutor, CancelToken) {
+  ProcessExecutor executor;
+  ProcessRequest request{};
+  // ignores SIGTERM, so it is killed after the grace period
+  request.argv = {"/bin/sh", "-c", "trap '' TERM; sleep 10"};
+  request.started = [&request](int64_t) { request.cancel.cancel(); };
+  ProcessRequest other{};
+  other.argv = {"/bin/sh", "-c", "exit 3"};
+  const auto start = std::chrono::steady_clock::now();
+  auto result = executor.run(request);
+  EXPECT_EQ(result.status, ProcessResult::Cancelled);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{9});
+  // the token of one request does not cancel the others
+  EXPECT_EQ(executor.run(other).code(), 3);
+}
+#endif
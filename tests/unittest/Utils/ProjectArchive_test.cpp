@@ -0,0 +1,152 @@
+/*
+Copyright 2023 The Foedag team
+
+GPL License
+
+Copyright (c) 2023 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/ProjectArchive.h"
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace fs = std::filesystem;
+using namespace FOEDAG;
+
+class ProjectArchiveTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    fs::remove_all(m_project);
+    fs::create_directories(m_project / "run_1" / "synth_1");
+    fs::create_directories(m_project / std::string(120, 'd'));
+    writeFile(m_project / "top.v", "module top; endmodule\n");
+    writeFile(m_project / "run_1" / "synth_1" / "synth.log", "log\n");
+    writeFile(m_project / std::string(120, 'd') / "top.route", "route\n");
+    std::ofstream place{m_project / "run_1" / "top.place"};
+    for (int i = 0; i < 100000; i++) place << "block_" << i << " 1 2 0\n";
+  }
+  void TearDown() override {
+    fs::remove_all(m_project);
+    for (auto archive : {m_archive, m_next}) {
+      fs::remove(archive);
+      fs::remove(ProjectArchive::manifestPath(archive));
+    }
+  }
+  static void writeFile(const fs::path& file, const std::string& content) {
+    std::ofstream ofs{file, std::ios::binary};
+    ofs << content;
+  }
+  static std::vector<std::string> paths(const ProjectArchive& archive) {
+    std::vector<std::string> paths;
+    for (const auto& entry : archive.entries()) paths.push_back(entry.path);
+    return paths;
+  }
+
+  const fs::path m_project{"project_archive_test"};
+  const fs::path m_archive{"project_archive_test.tar.gz"};
+  const fs::path m_next{"project_archive_test_next.tar.gz"};
+};
+
+TEST_F(ProjectArchiveTest, WriteAndVerify) {
+  ProjectArchive archive;
+  archive.addPath(m_project);
+  ArchiveOptions options;
+  options.threads = 4;
+  options.blockSize = 64 * 1024;  // several gzip members
+  uint64_t done{0};
+  uint64_t total{0};
+  options.progress = [&done, &total](uint64_t d, uint64_t t) {
+    done = d;
+    total = t;
+  };
+  auto result = archive.write(m_archive, options);
+  ASSERT_TRUE(result.first) << result.second;
+  EXPECT_EQ(done, total);
+  const std::string longName =
+      "project_archive_test/" + std::string(120, 'd') + "/top.route";
+  EXPECT_EQ(paths(archive), (std::vector<std::string>{
+                                longName,
+                                "project_archive_test/run_1/synth_1/synth.log",
+                                "project_archive_test/run_1/top.place",
+                                "project_archive_test/top.v"}));
+  result = ProjectArchive::verify(m_archive);
+  EXPECT_TRUE(result.first) << result.second;
+
+  // a manifest not matching the archive
+  auto manifest = ProjectArchive::manifestPath(m_archive);
+  std::ifstream in{manifest};
+  std::string text{std::istreambuf_iterator<char>{in}, {}};
+  in.close();
+  text[text.find('\n') + 1] ^= 1;
+  writeFile(manifest, text);
+  EXPECT_FALSE(ProjectArchive::verify(m_archive).first);
+}
+
+TEST_F(ProjectArchiveTest, Filters) {
+  ProjectArchive archive;
+  archive.addPath(m_project);
+  ArchiveOptions options;
+  options.artifacts = ArchiveSources | ArchiveLogs;
+  auto result = archive.write(m_archive, options);
+  ASSERT_TRUE(result.first) << result.second;
+  EXPECT_EQ(paths(archive), (std::vector<std::string>{
+                                "project_archive_test/run_1/synth_1/synth.log",
+                                "project_archive_test/top.v"}));
+  EXPECT_TRUE(ProjectArchive::verify(m_archive).first);
+}
+
+TEST_F(ProjectArchiveTest, SkipUnchanged) {
+  ProjectArchive archive;
+  archive.addPath(m_project);
+  ASSERT_TRUE(archive.write(m_archive).first);
+  writeFile(m_project / "top.v", "module top2; endmodule\n");
+  ArchiveOptions options;
+  options.previousManifest = ProjectArchive::manifestPath(m_archive);
+  auto result = archive.write(m_next, options);
+  ASSERT_TRUE(result.first) << result.second;
+  ASSERT_EQ(archive.entries().size(), 4);
+  for (const auto& entry : archive.entries()) {
+    const bool changed = entry.path == "project_archive_test/top.v";
+    EXPECT_EQ(entry.archive, changed ? m_next.string() : m_archive.string())
+        << entry.path;
+  }
+  result = ProjectArchive::verify(m_next);
+  EXPECT_TRUE(result.first) << result.second;
+}
+
+TEST_F(ProjectArchiveTest, Cancel) {
+  ProjectArchive archive;
+  archive.addPath(m_project);
+  std::atomic<bool> cancel{true};
+  ArchiveOptions options;
+  options.cancel = &cancel;
+  EXPECT_FALSE(archive.write(m_archive, options).first);
+  EXPECT_FALSE(fs::exists(m_archive));
+}
+
+TEST(ProjectArchive, ArtifactType) {
+  EXPECT_EQ(ProjectArchive::artifactType("top.v"), ArchiveSources);
+  EXPECT_EQ(ProjectArchive::artifactType("top_post_synth.v"),
+            ArchiveSynthesis);
+  EXPECT_EQ(ProjectArchive::artifactType("top.eblif"), ArchiveSynthesis);
+  EXPECT_EQ(ProjectArchive::artifactType("top.ROUTE"), ArchivePlaceRoute);
+  EXPECT_EQ(ProjectArchive::artifactType("top.bit"), ArchiveBitstream);
+  EXPECT_EQ(ProjectArchive::artifactType("timing.rpt"), ArchiveReports);
+  EXPECT_EQ(ProjectArchive::artifactType("vpr.log"), ArchiveLogs);
+  EXPECT_EQ(ProjectArchive::artifactType("data.json"), ArchiveOther);
+}
@@ -108,6 +108,20 @@ TEST_F(MultiLineTest, tokenizeLongSeparator_2) {
   EXPECT_EQ(*tokenized_lines.begin(), "test0SEPtest1SEPtest2SEP");
 }
 
+TEST(StringUtilsTest, tokenizeViews) {
+  const std::string testStr{"set_io  din HR_1_0_0P "};
+  std::vector<std::string_view> tokens;
+  StringUtils::tokenize(testStr, " ", tokens);
+  ASSERT_EQ(tokens.size(), 3);
+  EXPECT_EQ(tokens[0], "set_io");
+  EXPECT_EQ(tokens[1], "din");
+  EXPECT_EQ(tokens[2], "HR_1_0_0P");
+  EXPECT_EQ(tokens[1].data(), testStr.data() + 8);
+  tokens.clear();
+  StringUtils::tokenize(testStr, " ", tokens, false);
+  EXPECT_EQ(tokens.size(), 4);
+}
+
 TEST_F(MultiLineTest, tokenizeTestSkipEmpty_0) {
   auto testStr{"  string   with   empty    spaces  "};
   auto tokenized_lines = StringUtils::tokenize(testStr, " ", true);
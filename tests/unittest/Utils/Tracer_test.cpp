@@ -0,0 +1,81 @@
+/*
+Copyright 2022 The Foedag team
+
+GPL License
+
+Copyright (c) 2022 The Open-Source FPGA Foundation
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Utils/Tracer.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+using namespace FOEDAG;
+
+TEST(Tracer, disabledByDefault) {
+  EXPECT_FALSE(Tracer::isEnabled());
+  { TraceScope scope{"test", "not recorded"}; }
+  Tracer::start();
+  EXPECT_EQ(Tracer::eventCount(), 0);
+  std::string error;
+  EXPECT_TRUE(Tracer::stop("tracer_empty.json", error));
+  std::filesystem::remove("tracer_empty.json");
+}
+
+TEST(Tracer, spansFromThreads) {
+  Tracer::start();
+  EXPECT_TRUE(Tracer::isEnabled());
+  auto work = []() {
+    for (int i = 0; i < 2000; i++) {
+      TraceScope scope{"test", "span \"" + std::to_string(i) + "\""};
+    }
+  };
+  std::thread t1{work};
+  std::thread t2{work};
+  t1.join();
+  t2.join();
+  EXPECT_EQ(Tracer::eventCount(), 8000);
+
+  std::string error;
+  EXPECT_TRUE(Tracer::stop("tracer_test.json", error));
+  EXPECT_FALSE(Tracer::isEnabled());
+  std::ifstream file{"tracer_test.json"};
+  std::stringstream content;
+  content << file.rdbuf();
+  const std::string json = content.str();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+  EXPECT_NE(json.find("\"name\":\"span \\\"1999\\\"\""), std::string::npos);
+  EXPECT_NE(json.find("\"tid\":2"), std::string::npos);
+  file.close();
+  std::filesystem::remove("tracer_test.json");
+}
+
+TEST(Tracer, scopeAcrossSessions) {
+  Tracer::start();
+  {
+    TraceScope scope{"test", "old"};
+    Tracer::start();
+  }
+  // end of a span begun in the previous session is dropped
+  EXPECT_EQ(Tracer::eventCount(), 0);
+  std::string error;
+  Tracer::stop("tracer_sessions.json", error);
+  std::filesystem::remove("tracer_sessions.json");
+}
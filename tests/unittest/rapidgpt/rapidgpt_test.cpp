@@ -21,11 +21,92 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "rapidgpt/RapidGpt.h"
 
+#include <QDir>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <memory>
+
 #include "gtest/gtest.h"
+#include "rapidgpt/ChatWidget.h"
+#include "rapidgpt/RapidGptCache.h"
 #include "rapidgpt/RapidGptConnection.h"
+#include "rapidgpt/RapidGptStreamParser.h"
 
 using namespace FOEDAG;
 
+namespace {
+
+// Stand-in of the RapidGPT server. Every request is answered with chunked
+// transfer encoding, one chunk every 20 ms. Without complete the answer is
+// never finished.
+class StreamServer : public QTcpServer {
+ public:
+  StreamServer(const QByteArray &contentType, const QList<QByteArray> &chunks,
+               bool complete = true)
+      : m_contentType(contentType), m_chunks(chunks), m_complete(complete) {
+    listen(QHostAddress::LocalHost);
+  }
+  int requests() const { return m_requests; }
+  QString url() const {
+    return QString{"http://127.0.0.1:%1"}.arg(serverPort());
+  }
+
+ protected:
+  void incomingConnection(qintptr handle) override {
+    auto socket = new QTcpSocket{this};
+    socket->setSocketDescriptor(handle);
+    auto request = std::make_shared<QByteArray>();
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket, request]() {
+      request->append(socket->readAll());
+      auto headerEnd = request->indexOf("\r\n\r\n");
+      if (headerEnd == -1) return;
+      qsizetype length{0};
+      for (const auto &line : request->left(headerEnd).split('\n')) {
+        if (line.toLower().startsWith("content-length:"))
+          length = line.mid(15).trimmed().toLongLong();
+      }
+      if (request->size() < headerEnd + 4 + length) return;
+      request->clear();
+      answer(socket);
+    });
+  }
+
+ private:
+  void answer(QTcpSocket *socket) {
+    m_requests++;
+    socket->write("HTTP/1.1 200 OK\r\nContent-Type: " + m_contentType +
+                  "\r\nTransfer-Encoding: chunked\r\n\r\n");
+    int delay{0};
+    for (const auto &chunk : m_chunks) {
+      delay += 20;
+      QTimer::singleShot(delay, socket, [socket, chunk]() {
+        socket->write(QByteArray::number(chunk.size(), 16) + "\r\n" + chunk +
+                      "\r\n");
+      });
+    }
+    if (m_complete) {
+      QTimer::singleShot(delay + 20, socket,
+                         [socket]() { socket->write("0\r\n\r\n"); });
+    }
+  }
+
+  QByteArray m_contentType;
+  QList<QByteArray> m_chunks;
+  bool m_complete{true};
+  int m_requests{0};
+};
+
+RapidGptContext question() {
+  RapidGptContext context;
+  context.messages.push_back({"question"});
+  return context;
+}
+
+}  // namespace
+
 TEST(RapidGpt, sendWithoutKey) {
   RapidGptContext context;
   context.messages.push_back({"test"});
@@ -89,3 +170,117 @@ TEST(RapidGpt, setProjectPath) {
   rapidGpt.setProjectPath(path);
   EXPECT_EQ(rapidGpt.isIncognitoMode(), true);
 }
+
+TEST(RapidGpt, streamEventStream) {
+  StreamServer server{"text/event-stream",
+                      {"data: {\"message\": \"Hel\"}\n\n",
+                       "data: {\"message\": \"lo\"}\n", "\ndata: [DONE]\n\n"}};
+  RapidGptConnection connection{{"key", {}, {}, server.url()}};
+  QSignalSpy finished{&connection, &RapidGptConnection::finished};
+  int textWhileRunning{0};
+  QObject::connect(&connection, &RapidGptConnection::textReceived,
+                   [&connection, &textWhileRunning]() {
+                     if (connection.isRunning()) textWhileRunning++;
+                   });
+  EXPECT_EQ(connection.start(question()), true);
+  ASSERT_EQ(finished.wait(5000), true);
+  EXPECT_EQ(finished.at(0).at(0).toBool(), true);
+  EXPECT_GE(textWhileRunning, 1);
+  EXPECT_EQ(connection.responseString(), "Hello");
+}
+
+TEST(RapidGpt, cachedAnswer) {
+  QTemporaryDir dir;
+  StreamServer server{"text/plain", {"Hello ", "world"}};
+  RapidGptConnection connection{{"key", {}, {}, server.url()}};
+  connection.setCacheDir(dir.path());
+  EXPECT_EQ(connection.send(question()), true);
+  EXPECT_EQ(connection.responseString(), "Hello world");
+  EXPECT_EQ(connection.send(question()), true);
+  EXPECT_EQ(connection.responseString(), "Hello world");
+  EXPECT_EQ(server.requests(), 1);
+
+  // cache is skipped to regenerate the answer
+  QSignalSpy finished{&connection, &RapidGptConnection::finished};
+  EXPECT_EQ(connection.start(question(), false), true);
+  ASSERT_EQ(finished.wait(5000), true);
+  EXPECT_EQ(server.requests(), 2);
+}
+
+TEST(RapidGpt, cancel) {
+  QTemporaryDir dir;
+  StreamServer server{"text/event-stream", {"data: part\n\n"}, false};
+  RapidGptConnection connection{{"key", {}, {}, server.url()}};
+  connection.setCacheDir(dir.path());
+  QSignalSpy text{&connection, &RapidGptConnection::textReceived};
+  QSignalSpy finished{&connection, &RapidGptConnection::finished};
+  EXPECT_EQ(connection.start(question()), true);
+  ASSERT_EQ(text.wait(5000), true);
+  connection.cancel();
+  EXPECT_EQ(connection.isRunning(), false);
+  EXPECT_EQ(connection.isCanceled(), true);
+  ASSERT_EQ(finished.count(), 1);
+  EXPECT_EQ(finished.at(0).at(0).toBool(), false);
+  EXPECT_EQ(connection.responseString(), "part");
+  EXPECT_EQ(QDir{dir.path()}.entryList(QDir::Files).isEmpty(), true);
+}
+
+TEST(RapidGpt, sendRapidGptStreamsToChat) {
+  QTemporaryDir dir;
+  StreamServer server{"text/plain", {"an", "swer"}};
+  RapidGpt rapidGpt{{"key", {}, {}, server.url()}, {}};
+  rapidGpt.setCacheDir(dir.path());
+  rapidGpt.setShowError(false);
+  EXPECT_EQ(rapidGpt.sendRapidGpt("some text"), true);
+  auto chat = qobject_cast<ChatWidget *>(rapidGpt.widget());
+  ASSERT_NE(chat, nullptr);
+  EXPECT_EQ(chat->count(), 1);
+  // incognito answers are not cached
+  EXPECT_EQ(QDir{dir.path()}.entryList(QDir::Files).isEmpty(), true);
+}
+
+TEST(RapidGptCache, limits) {
+  QTemporaryDir dir;
+  RapidGptCache cache{dir.path()};
+  cache.setLimits(2, 30);
+  EXPECT_EQ(cache.insert(RapidGptCache::key("a"), "a"), true);
+  EXPECT_EQ(cache.insert(RapidGptCache::key("b"), "b"), true);
+  EXPECT_EQ(cache.insert(RapidGptCache::key("c"), "c"), true);
+  EXPECT_EQ(QDir{dir.path()}.entryList(QDir::Files).count(), 2);
+  cache.clear();
+  EXPECT_EQ(QDir{dir.path()}.entryList(QDir::Files).isEmpty(), true);
+}
+
+TEST(RapidGptStreamParser, eventStream) {
+  RapidGptStreamParser parser{RapidGptStreamParser::Format::EventStream};
+  EXPECT_EQ(parser.feed("data: {\"message\":\"a\"}\r\n"), QString{});
+  EXPECT_EQ(parser.feed("\r\ndata: b"), "a");
+  EXPECT_EQ(parser.feed("c\n: comment\n\n"), "bc");
+  EXPECT_EQ(parser.feed("data: [DONE]\n\ndata: late\n\n"), QString{});
+  EXPECT_EQ(parser.done(), true);
+}
+
+TEST(RapidGptStreamParser, text) {
+  RapidGptStreamParser parser{RapidGptStreamParser::Format::Text};
+  QByteArray data{"\xc3\xa9"};
+  EXPECT_EQ(parser.feed(data.left(1)), QString{});
+  EXPECT_EQ(parser.feed(data.mid(1)), QString::fromUtf8(data));
+}
+
+TEST(RapidGptStreamParser, json) {
+  RapidGptStreamParser parser;
+  EXPECT_EQ(parser.feed("{\"mess"), QString{});
+  EXPECT_EQ(parser.feed("age\": \"answer\"}"), QString{});
+  EXPECT_EQ(parser.finish(), "answer");
+}
+
+TEST(RapidGptStreamParser, formatFromContentType) {
+  using Format = RapidGptStreamParser::Format;
+  EXPECT_EQ(RapidGptStreamParser::formatFromContentType(
+                "text/event-stream; charset=utf-8"),
+            Format::EventStream);
+  EXPECT_EQ(RapidGptStreamParser::formatFromContentType("text/plain"),
+            Format::Text);
+  EXPECT_EQ(RapidGptStreamParser::formatFromContentType("application/json"),
+            Format::Json);
+}